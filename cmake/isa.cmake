@@ -0,0 +1,41 @@
+# Function multiversioning for x86 instruction set extensions
+#
+# With AER_ISA_TIERS set, the hot simulation kernels (marked with
+# AER_TARGET_CLONES in the sources) are compiled once for the baseline
+# architecture and once for every listed tier. The best variant supported by
+# the CPU is selected by the dynamic loader when the binary is loaded, so a
+# single portable binary still uses wide vector instructions on newer CPUs.
+#
+# Only GCC and Clang on x86-64 ELF platforms (Linux) are supported.
+
+set(AER_ISA_TIERS "" CACHE STRING
+	"List of instruction set tiers for kernel clones: sse4.2;avx;avx2;avx512f (empty to disable)")
+
+if(NOT AER_ISA_TIERS)
+	return()
+endif()
+
+if(NOT CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang" OR APPLE OR WIN32)
+	message(FATAL_ERROR "AER_ISA_TIERS is only supported with GCC and Clang compilers on Linux")
+endif()
+if(CMAKE_CXX_COMPILER_ID MATCHES "Clang" AND CMAKE_CXX_COMPILER_VERSION VERSION_LESS 14.0)
+	message(FATAL_ERROR "AER_ISA_TIERS requires Clang 14 or newer")
+endif()
+if(NOT CMAKE_SYSTEM_PROCESSOR MATCHES "x86_64|AMD64|amd64")
+	message(FATAL_ERROR "AER_ISA_TIERS is only supported on x86-64")
+endif()
+
+set(AER_ISA_CLONES "")
+foreach(tier ${AER_ISA_TIERS})
+	if(NOT tier MATCHES "^(sse4\\.2|avx|avx2|avx512f)$")
+		message(FATAL_ERROR "Unknown instruction set tier in AER_ISA_TIERS: ${tier}")
+	endif()
+	string(REPLACE "." "_" tier_define "${tier}")
+	string(TOUPPER "${tier_define}" tier_define)
+	set_property(DIRECTORY APPEND PROPERTY COMPILE_DEFINITIONS AER_ISA_${tier_define})
+	set(AER_ISA_CLONES "${AER_ISA_CLONES},\"${tier}\"")
+endforeach()
+
+message(STATUS "Building kernel clones for instruction sets: default;${AER_ISA_TIERS}")
+set_property(DIRECTORY APPEND PROPERTY COMPILE_DEFINITIONS
+	"AER_TARGET_CLONES=__attribute__((target_clones(\"default\"${AER_ISA_CLONES})))")
@@ -0,0 +1,90 @@
+# Profile-guided optimization (PGO)
+#
+# A PGO build takes two steps:
+#   1. Configure with -DAER_PGO=generate, build the instrumented simulator and
+#      run the training corpus with the "pgo_train" target. The corpus is
+#      generated by contrib/pgo/generate_corpus.py in the build directory and
+#      the profile is written to AER_PGO_PROFILE_DIR.
+#   2. Configure with -DAER_PGO=use and the same AER_PGO_PROFILE_DIR and build
+#      again. This also applies to the Terra addon build.
+#
+# Only GCC and Clang are supported.
+
+set(AER_PGO "" CACHE STRING "Profile-guided optimization mode: generate|use (empty to disable)")
+set(AER_PGO_PROFILE_DIR "${CMAKE_BINARY_DIR}/pgo-profile" CACHE PATH
+	"Directory where profile-guided optimization data is written and read")
+
+# Adds the "pgo_train" target generating the training corpus and running it
+# with an instrumented simulator executable
+function(add_pgo_train_target target)
+	if(NOT AER_PGO STREQUAL "generate")
+		return()
+	endif()
+	find_package(PythonInterp REQUIRED)
+	set(CORPUS_DIR "${CMAKE_BINARY_DIR}/pgo-corpus")
+	add_custom_target(pgo_train
+		COMMAND ${PYTHON_EXECUTABLE} ${PROJECT_SOURCE_DIR}/contrib/pgo/generate_corpus.py ${CORPUS_DIR}
+		COMMAND ${CMAKE_COMMAND}
+			-DSIMULATOR=$<TARGET_FILE:${target}>
+			-DQOBJ_DIR=${CORPUS_DIR}
+			-DPROFILE_DIR=${AER_PGO_PROFILE_DIR}
+			-DLLVM_PROFDATA=${LLVM_PROFDATA}
+			-P ${PROJECT_SOURCE_DIR}/cmake/pgo_train.cmake
+		DEPENDS ${target}
+		COMMENT "Running profile-guided optimization training corpus"
+		VERBATIM)
+endfunction()
+
+if(NOT AER_PGO)
+	return()
+endif()
+
+if(NOT CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+	message(FATAL_ERROR "AER_PGO is only supported with GCC and Clang compilers")
+endif()
+
+get_filename_component(AER_PGO_PROFILE_DIR "${AER_PGO_PROFILE_DIR}" ABSOLUTE)
+
+# Clang writes raw profiles that have to be merged with llvm-profdata
+if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+	set(AER_PGO_PROFILE "${AER_PGO_PROFILE_DIR}/aer.profdata")
+	find_program(LLVM_PROFDATA NAMES llvm-profdata xcrun)
+	if(LLVM_PROFDATA MATCHES "xcrun$")
+		set(LLVM_PROFDATA "${LLVM_PROFDATA};llvm-profdata")
+	endif()
+else()
+	set(AER_PGO_PROFILE "${AER_PGO_PROFILE_DIR}")
+	# Name profiles relative to the build directory, so that a profile can be
+	# used from another build directory
+	enable_cxx_compiler_flag_if_supported("-fprofile-prefix-path=${CMAKE_BINARY_DIR}")
+endif()
+
+if(AER_PGO STREQUAL "generate")
+	message(STATUS "Building instrumented binaries for profile-guided optimization")
+	file(MAKE_DIRECTORY "${AER_PGO_PROFILE_DIR}")
+	set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -fprofile-generate=${AER_PGO_PROFILE_DIR}")
+	# Counters are updated from several OpenMP threads
+	enable_cxx_compiler_flag_if_supported("-fprofile-update=atomic")
+elseif(AER_PGO STREQUAL "use")
+	if(NOT EXISTS "${AER_PGO_PROFILE}")
+		message(FATAL_ERROR "Profile ${AER_PGO_PROFILE} not found. Build with -DAER_PGO=generate and run the pgo_train target first.")
+	endif()
+	message(STATUS "Using profile-guided optimization data from ${AER_PGO_PROFILE}")
+	set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -fprofile-use=${AER_PGO_PROFILE}")
+	if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+		enable_cxx_compiler_flag_if_supported("-Wno-profile-instr-unprofiled")
+		enable_cxx_compiler_flag_if_supported("-Wno-profile-instr-out-of-date")
+	else()
+		# Counters of OpenMP regions may be slightly inconsistent
+		enable_cxx_compiler_flag_if_supported("-fprofile-correction")
+		# Code not covered by the training corpus is optimized as usual
+		enable_cxx_compiler_flag_if_supported("-fprofile-partial-training")
+		if(SKBUILD)
+			# GCC profiles are stored per object file, so only profiles
+			# recorded by an instrumented Terra addon can be used for it
+			message(WARNING "GCC only uses profiles recorded by the same object files. Profiles from the standalone simulator are not applied to the Terra addon.")
+		endif()
+	endif()
+else()
+	message(FATAL_ERROR "Invalid AER_PGO value '${AER_PGO}' (expected generate or use)")
+endif()
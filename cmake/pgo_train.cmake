@@ -0,0 +1,34 @@
+# Runs the profile-guided optimization training corpus
+#
+# Usage:
+#   cmake -DSIMULATOR=<instrumented qasm_simulator> -DQOBJ_DIR=<corpus dir>
+#         -DPROFILE_DIR=<profile dir> [-DLLVM_PROFDATA=<llvm-profdata>]
+#         -P pgo_train.cmake
+
+file(GLOB QOBJS "${QOBJ_DIR}/*.json")
+if(NOT QOBJS)
+	message(FATAL_ERROR "No training qobj found in ${QOBJ_DIR}")
+endif()
+
+foreach(QOBJ ${QOBJS})
+	get_filename_component(QOBJ_NAME "${QOBJ}" NAME)
+	message(STATUS "Training: ${QOBJ_NAME}")
+	execute_process(COMMAND "${SIMULATOR}" "${QOBJ}"
+		RESULT_VARIABLE RESULT
+		OUTPUT_QUIET)
+	if(NOT RESULT EQUAL 0)
+		message(FATAL_ERROR "Training run failed for ${QOBJ_NAME}")
+	endif()
+endforeach()
+
+# Clang raw profiles are merged into a single indexed profile
+if(LLVM_PROFDATA)
+	file(GLOB PROFRAW "${PROFILE_DIR}/*.profraw")
+	execute_process(COMMAND ${LLVM_PROFDATA} merge -output=${PROFILE_DIR}/aer.profdata ${PROFRAW}
+		RESULT_VARIABLE RESULT)
+	if(NOT RESULT EQUAL 0)
+		message(FATAL_ERROR "Failed to merge profiles in ${PROFILE_DIR}")
+	endif()
+endif()
+
+message(STATUS "Profile written to ${PROFILE_DIR}")
@@ -0,0 +1,281 @@
+# This code is part of Qiskit.
+#
+# (C) Copyright IBM 2018, 2019.
+#
+# This code is licensed under the Apache License, Version 2.0. You may
+# obtain a copy of this license in the LICENSE.txt file in the root directory
+# of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+#
+# Any modifications or derivative works of this code must retain this
+# copyright notice, and modified files need to carry a notice indicating
+# that they have been altered from the originals.
+"""
+Generate the profile-guided optimization training corpus.
+
+The corpus is a set of qobj files run by the instrumented qasm_simulator
+of an AER_PGO=generate build (see the pgo_train target). It covers the
+simulation methods and the instructions whose code paths should be
+profiled. The circuits are random with a fixed seed, so the corpus is the
+same on every run.
+
+Usage: python generate_corpus.py <output directory>
+"""
+
+import json
+import math
+import os
+import random
+import sys
+
+ALL_GATES = ["u1", "u2", "u3", "cx", "cz", "cy", "swap", "cu1", "ccx", "x",
+             "y", "z", "h", "s", "sdg", "t", "tdg", "id"]
+CLIFFORD_GATES = ["cx", "cz", "swap", "x", "y", "z", "h", "s", "sdg", "id"]
+
+
+def angle():
+    """Return a random angle."""
+    return round(random.uniform(0, 2 * math.pi), 6)
+
+
+def random_gates(num_qubits, depth, gates):
+    """Return instructions of random gates on random qubits."""
+    instructions = []
+    for _ in range(depth):
+        name = random.choice(gates)
+        if name == "u1":
+            op = {"qubits": [random.randrange(num_qubits)], "params": [angle()]}
+        elif name == "u2":
+            op = {"qubits": [random.randrange(num_qubits)],
+                  "params": [angle(), angle()]}
+        elif name == "u3":
+            op = {"qubits": [random.randrange(num_qubits)],
+                  "params": [angle(), angle(), angle()]}
+        elif name in ("cx", "cz", "cy", "swap"):
+            op = {"qubits": random.sample(range(num_qubits), 2)}
+        elif name == "cu1":
+            op = {"qubits": random.sample(range(num_qubits), 2),
+                  "params": [angle()]}
+        elif name == "ccx":
+            op = {"qubits": random.sample(range(num_qubits), 3)}
+        else:
+            op = {"qubits": [random.randrange(num_qubits)]}
+        op["name"] = name
+        instructions.append(op)
+    return instructions
+
+
+def measure_all(num_qubits):
+    """Return measurements of each qubit into its own memory slot."""
+    return [{"name": "measure", "qubits": [q], "memory": [q]}
+            for q in range(num_qubits)]
+
+
+def random_unitary(dim):
+    """Return a random unitary matrix as a list of [real, imag] entries."""
+    columns = []
+    for _ in range(dim):
+        vec = [complex(random.uniform(-1, 1), random.uniform(-1, 1))
+               for _ in range(dim)]
+        for col in columns:
+            overlap = sum(x.conjugate() * y for x, y in zip(col, vec))
+            vec = [y - overlap * x for x, y in zip(col, vec)]
+        norm = math.sqrt(sum(abs(y) ** 2 for y in vec))
+        columns.append([y / norm for y in vec])
+    return [[[round(columns[j][i].real, 12), round(columns[j][i].imag, 12)]
+             for j in range(dim)] for i in range(dim)]
+
+
+def random_state(dim):
+    """Return a random normalized vector as a list of [real, imag] entries."""
+    vec = [complex(random.uniform(-1, 1), random.uniform(-1, 1))
+           for _ in range(dim)]
+    norm = math.sqrt(sum(abs(x) ** 2 for x in vec))
+    return [[x.real / norm, x.imag / norm] for x in vec]
+
+
+def snapshots(num_qubits):
+    """Return probability and expectation value snapshots."""
+    return [
+        {"name": "snapshot", "type": "probabilities", "label": "probs",
+         "qubits": [0, 1, 2]},
+        {"name": "snapshot", "type": "expectation_value_pauli",
+         "label": "pauli", "qubits": [0, 1, num_qubits - 1],
+         "params": [[[1, 0], "XZY"], [[0.5, 0], "ZZI"]]},
+        {"name": "snapshot", "type": "expectation_value_matrix",
+         "label": "matrix",
+         "params": [[[1, 0], [[[0, 1], random_unitary(4)]]]]}]
+
+
+def noise_model():
+    """Return a noise model with Pauli, Kraus and readout errors."""
+    prob = 0.01
+    depol1 = [[{"name": name, "qubits": [0]}] for name in ("id", "x", "y", "z")]
+    depol2 = [[{"name": a, "qubits": [0]}, {"name": b, "qubits": [1]}]
+              for a in ("id", "x", "z") for b in ("id", "x", "z")]
+    gamma = 0.05
+    amp_damp = [[[[1, 0], [0, 0]], [[0, 0], [math.sqrt(1 - gamma), 0]]],
+                [[[0, 0], [math.sqrt(gamma), 0]], [[0, 0], [0, 0]]]]
+    return {"errors": [
+        {"type": "qerror", "operations": ["u2", "u3"],
+         "probabilities": [1 - 3 * prob / 4] + [prob / 4] * 3,
+         "instructions": depol1},
+        {"type": "qerror", "operations": ["cx"],
+         "probabilities": [1 - 8 * prob / 9] + [prob / 9] * 8,
+         "instructions": depol2},
+        {"type": "qerror", "operations": ["x", "h"], "probabilities": [1],
+         "instructions": [[{"name": "kraus", "qubits": [0],
+                            "params": amp_damp}]]},
+        {"type": "roerror", "operations": ["measure"],
+         "probabilities": [[0.95, 0.05], [0.1, 0.9]]}]}
+
+
+def experiment(num_qubits, instructions, name, shots=None):
+    """Return a qobj experiment."""
+    config = {"n_qubits": num_qubits, "memory_slots": num_qubits}
+    if shots:
+        config["shots"] = shots
+    return {"header": {"name": name}, "config": config,
+            "instructions": instructions}
+
+
+def write_qobj(directory, name, experiments, config):
+    """Write a qobj file with the experiments."""
+    qobj_config = {"shots": 100, "seed_simulator": 42}
+    qobj_config.update(config)
+    qobj = {"qobj_id": "pgo_" + name, "schema_version": "1.0.0",
+            "type": "QASM", "experiments": experiments, "config": qobj_config}
+    with open(os.path.join(directory, name + ".json"), "w") as file:
+        json.dump(qobj, file, indent=1)
+        file.write("\n")
+
+
+def statevector(directory):
+    """Ideal gates with measure sampling, snapshots, matrices and fusion."""
+    num_qubits = 16
+    gates = random_gates(num_qubits, 400, ALL_GATES) + measure_all(num_qubits)
+    snaps = random_gates(num_qubits, 200, ALL_GATES) + snapshots(num_qubits)
+    matrices = random_gates(num_qubits, 100, ALL_GATES)
+    for _ in range(10):
+        matrices.append({"name": "unitary",
+                         "qubits": random.sample(range(num_qubits), 2),
+                         "params": [random_unitary(4)]})
+        matrices.append({"name": "multiplexer",
+                         "qubits": random.sample(range(num_qubits), 3),
+                         "params": [random_unitary(2) for _ in range(4)]})
+        matrices.append({"name": "initialize",
+                         "qubits": random.sample(range(num_qubits), 2),
+                         "params": random_state(4)})
+    matrices += random_gates(num_qubits, 100, ALL_GATES)
+    matrices += measure_all(num_qubits)
+    write_qobj(directory, "statevector",
+               [experiment(num_qubits, gates, "gates"),
+                experiment(num_qubits, snaps, "snapshots", shots=1),
+                experiment(num_qubits, matrices, "matrices", shots=10)],
+               {"method": "statevector", "shots": 1000})
+
+    num_qubits = 18
+    fusion = random_gates(num_qubits, 400, ["u3", "cx", "u1", "h"])
+    fusion += measure_all(num_qubits)
+    write_qobj(directory, "statevector_fusion",
+               [experiment(num_qubits, fusion, "fusion")],
+               {"method": "statevector", "shots": 1000,
+                "fusion_enable": True, "fusion_threshold": 14})
+
+
+def statevector_conditional(directory):
+    """Mid-circuit measurement, reset and conditionals without sampling."""
+    num_qubits = 10
+    instructions = random_gates(num_qubits, 50, ALL_GATES)
+    for reg in range(5):
+        qubit = random.randrange(num_qubits)
+        instructions += [
+            {"name": "measure", "qubits": [qubit], "memory": [qubit],
+             "register": [qubit]},
+            {"name": "x", "qubits": [(qubit + 1) % num_qubits],
+             "conditional": qubit},
+            {"name": "bfunc", "mask": hex(1 << qubit), "relation": "==",
+             "val": hex(1 << qubit), "register": num_qubits + reg},
+            {"name": "reset", "qubits": [random.randrange(num_qubits)]}]
+        instructions += random_gates(num_qubits, 30, ALL_GATES)
+    exp = experiment(num_qubits, instructions + measure_all(num_qubits),
+                     "conditional")
+    exp["config"]["register_slots"] = num_qubits + 5
+    write_qobj(directory, "statevector_conditional", [exp],
+               {"method": "statevector", "shots": 200})
+
+
+def noise(directory):
+    """Noise simulation with the statevector and density matrix methods."""
+    num_qubits = 8
+    instructions = random_gates(num_qubits, 120,
+                                ["u2", "u3", "cx", "x", "h", "s"])
+    instructions += measure_all(num_qubits)
+    for method in ["statevector", "density_matrix"]:
+        write_qobj(directory, method + "_noise",
+                   [experiment(num_qubits, instructions, "noise")],
+                   {"method": method, "shots": 200,
+                    "noise_model": noise_model()})
+
+
+def stabilizer(directory):
+    """Clifford circuit with mid-circuit measurement and reset."""
+    num_qubits = 100
+    instructions = random_gates(num_qubits, 2000, CLIFFORD_GATES)
+    instructions += [{"name": "measure", "qubits": [q], "memory": [q]}
+                     for q in range(0, num_qubits, 7)]
+    instructions += [{"name": "reset", "qubits": [3]}]
+    instructions += random_gates(num_qubits, 500, CLIFFORD_GATES)
+    instructions += measure_all(num_qubits)
+    write_qobj(directory, "stabilizer",
+               [experiment(num_qubits, instructions, "clifford")],
+               {"method": "stabilizer", "shots": 100})
+
+
+def matrix_product_state(directory):
+    """Layers of rotations and CX gates on neighbouring qubits."""
+    num_qubits = 16
+    instructions = []
+    for layer in range(4):
+        instructions += [{"name": "u3", "qubits": [q],
+                          "params": [angle(), angle(), angle()]}
+                         for q in range(num_qubits)]
+        instructions += [{"name": "cx", "qubits": [q, q + 1]}
+                         for q in range(layer % 2, num_qubits - 1, 2)]
+    instructions += [{"name": "snapshot", "type": "probabilities",
+                      "label": "probs", "qubits": [0, 5, 11]}]
+    instructions += measure_all(num_qubits)
+    write_qobj(directory, "matrix_product_state",
+               [experiment(num_qubits, instructions, "mps")],
+               {"method": "matrix_product_state", "shots": 20})
+
+
+def extended_stabilizer(directory):
+    """Clifford circuit with a few T gates."""
+    num_qubits = 12
+    instructions = random_gates(num_qubits, 150, CLIFFORD_GATES)
+    for _ in range(4):
+        instructions.insert(random.randrange(len(instructions)),
+                            {"name": "t", "qubits": [random.randrange(num_qubits)]})
+    instructions += measure_all(num_qubits)
+    write_qobj(directory, "extended_stabilizer",
+               [experiment(num_qubits, instructions, "ch")],
+               {"method": "extended_stabilizer", "shots": 20,
+                "extended_stabilizer_mixing_time": 200})
+
+
+def main(directory):
+    """Write the corpus to the directory."""
+    os.makedirs(directory, exist_ok=True)
+    random.seed(2019)
+    statevector(directory)
+    statevector_conditional(directory)
+    noise(directory)
+    stabilizer(directory)
+    matrix_product_state(directory)
+    extended_stabilizer(directory)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+    main(sys.argv[1])
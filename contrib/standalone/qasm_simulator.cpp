@@ -14,6 +14,7 @@
 
 //#define DEBUG // Uncomment for verbose debugging output
 #include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <string>
 
@@ -90,7 +91,7 @@ int main(int argc, char **argv) {
 
   std::ostream &out = std::cout; // output stream
   int indent = 4;
-  json_t qobj;
+  std::string qobj_file;
   json_t config;
 
   if(argc == 1){ // NOLINT
@@ -119,31 +120,34 @@ int main(int argc, char **argv) {
         }
         break;
       case CmdArguments::INPUT_DATA:
-        try {
-          qobj = JSON::load(std::string(argv[pos])); // NOLINT
-          pos = argc; //Exit from the loop
-        }catch(std::exception &e){
-          std::string msg = "Invalid input (" +  std::string(e.what()) + ")";
-          failed(msg, out, indent);
-          return 1;
-        }
+        qobj_file = std::string(argv[pos]); // NOLINT
+        pos = argc; //Exit from the loop
         break;
     }
   }
 
+  // Open the qobj file, which is read while it is loaded
+  std::ifstream ifile;
+  if (qobj_file != "stdin" && qobj_file != "-") {
+    ifile.open(qobj_file);
+    if (!ifile && !qobj_file.empty()) {
+      failed("Invalid input (no such file or directory)", out, indent);
+      return 1;
+    }
+  }
+  std::istream &qobj_stream = (qobj_file == "stdin" || qobj_file == "-") ? std::cin : ifile;
+
   // Execute simulation
   try {
 
-    // Check for command line config
-    // and if present add to qobj config
-    json_t& config_all = qobj["config"];
-    if (!config.empty()) // NOLINT
-      config_all.update(config.begin(), config.end());
-
     // Initialize simulator
+    // The command line config is added to the qobj config
     AER::Simulator::QasmController sim;
-    auto result = sim.execute(qobj);
-    out << result.dump(4) << std::endl;
+    JSON::Reader reader(qobj_stream);
+    JSON::Writer writer(out, indent);
+    auto result = sim.execute(reader, writer, config);
+    writer.flush();
+    out << std::endl;
 
     // Check if execution was successful.
     bool success = false;
@@ -37,10 +37,13 @@
 #endif
 
 // Base Controller
+#include "framework/isa.hpp"
 #include "framework/qobj.hpp"
 #include "framework/data.hpp"
 #include "framework/rng.hpp"
 #include "framework/creg.hpp"
+#include "framework/topology.hpp"
+#include "misc/hacks.hpp"
 #include "noise/noise_model.hpp"
 #include "transpile/circuitopt.hpp"
 #include "transpile/truncate_qubits.hpp"
@@ -73,6 +76,12 @@ namespace Base {
  * spawned by the higher level threads. If no parallelization is used for
  * 1 and 2, all available threads will be used for 3.
  *
+ * When circuits or shots are executed in parallel on a machine with several
+ * sockets, NUMA nodes or L3 cache domains, each circuit or shot thread is
+ * bound to a domain, together with the threads it uses for 3, so that a
+ * state is updated by threads sharing its memory. The CPUs of the threads
+ * executing a circuit are returned as "thread_binding" in its metadata.
+ *
  * -------------------------
  * Config settings:
  *
@@ -89,6 +98,13 @@ namespace Base {
  * - "max_memory_mb" (int): Sets the maximum size of memory for a store.
  *      If a state needs more, an error is thrown. If set to 0, the maximum
  *      will be automatically set to the system memory size [Default: 0].
+ * - "dry_run" (bool): Skip the simulation and return an estimate of the
+ *      simulation method, memory and runtime of each experiment in the
+ *      experiment metadata [Default: False].
+ * - "thread_binding" (str): Domains to bind parallel circuit or shot
+ *      threads to: "none", "socket", "numa", "l3", or "auto" for NUMA nodes,
+ *      sockets or L3 caches, whichever the machine has more than one of
+ *      [Default: "auto"].
  *
  * Config settings from Data class:
  *
@@ -113,6 +129,20 @@ public:
   // class.
   virtual json_t execute(const json_t &qobj);
 
+  // Load a QOBJ from a streaming JSON reader and execute on the State type
+  // class. The qobj and noise model are read without building them as
+  // JSON. The fields of config replace those of the qobj config.
+  virtual json_t execute(JSON::Reader &qobj_reader,
+                         const json_t &config = json_t());
+
+  // Load a QOBJ from a streaming JSON reader, execute it and write the result
+  // with a JSON writer. The data of each experiment is written directly from
+  // the output data, without converting it to JSON. The returned result is
+  // the written result without the experiment data.
+  virtual json_t execute(JSON::Reader &qobj_reader,
+                         JSON::Writer &result_writer,
+                         const json_t &config = json_t());
+
   //-----------------------------------------------------------------------
   // Config settings
   //-----------------------------------------------------------------------
@@ -137,12 +167,33 @@ protected:
   // Circuit Execution
   //-----------------------------------------------------------------------
 
+  // Load a qobj with load_qobj(qobj, noise_model), set the config from the
+  // qobj config and execute the qobj circuits. The output data of each
+  // circuit is returned in data and is not added to the result.
+  template <typename Lambda>
+  json_t execute_qobj(Lambda &&load_qobj, std::vector<OutputData> &data);
+
+  // Execute a qobj loaded from a streaming JSON reader
+  json_t execute_qobj(JSON::Reader &qobj_reader, const json_t &config,
+                      std::vector<OutputData> &data);
+
+  // Add the output data of each successful experiment to its result
+  void add_experiment_data(json_t &result,
+                           const std::vector<OutputData> &data) const;
+
+  // Write a result with the output data of each successful experiment
+  void write_result(const json_t &result,
+                    const std::vector<OutputData> &data,
+                    JSON::Writer &writer) const;
+
   // Parallel execution of a circuit
   // This function manages parallel shot configuration and internally calls
-  // the `run_circuit` method for each shot thread
+  // the `run_circuit` method for each shot thread. The output data is
+  // returned in data and is not added to the result.
   virtual json_t execute_circuit(Circuit &circ,
                                  Noise::NoiseModel &noise,
-                                 const json_t &config);
+                                 const json_t &config,
+                                 OutputData &data);
 
   // Abstract method for executing a circuit.
   // This method must initialize a state and return output data for
@@ -153,6 +204,19 @@ protected:
                                  uint_t shots,
                                  uint_t rng_seed) const = 0;
 
+  // Distribute shots over parallel_shots_ threads. Thread i calls
+  // func(shots_i, seed + i), which returns the output data of its shots,
+  // and the output data of all threads are combined in thread order.
+  template <typename Lambda>
+  OutputData run_parallel_shots(uint_t shots, uint_t seed, Lambda &&func) const;
+
+  // Return an estimate of the resources needed to execute a circuit
+  // without running it. The returned object is added to the experiment
+  // metadata in dry run mode.
+  virtual json_t estimate_circuit(const Circuit &circ,
+                                  const Noise::NoiseModel &noise,
+                                  const json_t &config) const;
+
   //-------------------------------------------------------------------------
   // State validation
   //-------------------------------------------------------------------------
@@ -221,6 +285,14 @@ protected:
   // Get system memory size
   size_t get_system_memory_mb();
 
+  // Read the CPUs of the thread binding domains of the machine
+  void set_binding_domains();
+
+  // Return the number of state update threads of a state created in the
+  // calling thread: parallel_state_update_, capped at the CPUs of its
+  // domain if the thread is bound to one
+  int state_update_threads() const;
+
   // The maximum number of threads to use for various levels of parallelization
   int max_parallel_threads_;
 
@@ -237,8 +309,21 @@ protected:
   int parallel_shots_;
   int parallel_state_update_;
 
+  // Thread binding config and the CPUs of each domain parallel circuit
+  // or shot threads are bound to
+  std::string thread_binding_ = "auto";
+  Topology::Domain binding_domain_ = Topology::Domain::none;
+  std::vector<Topology::cpuset_t> binding_domains_;
+
   // Truncate qubits
   bool truncate_qubits_ = true;
+
+  // Only estimate the resources of circuits
+  bool dry_run_ = false;
+
+  // Shots are distributed over parallel threads inside run_circuit, so that
+  // a circuit can be prepared once and shared by all shot threads
+  bool run_circuit_parallel_shots_ = false;
 };
 
 
@@ -258,6 +343,14 @@ void Controller::set_config(const json_t &config) {
   // Load qubit truncation
   JSON::get_value(truncate_qubits_, "truncate_enable", config);
 
+  // Load dry run mode
+  JSON::get_value(dry_run_, "dry_run", config);
+
+  // Load thread binding domains
+  if (JSON::get_value(thread_binding_, "thread_binding", config) &&
+      thread_binding_ != "auto")
+    Topology::domain_from_string(thread_binding_);
+
   // Load OpenMP maximum thread settings
   if (JSON::check_key("max_parallel_threads", config))
     JSON::get_value(max_parallel_threads_, "max_parallel_threads", config);
@@ -302,6 +395,8 @@ void Controller::set_config(const json_t &config) {
 void Controller::clear_config() {
   clear_parallelization();
   validation_threshold_ = 1e-8;
+  dry_run_ = false;
+  thread_binding_ = "auto";
 }
 
 void Controller::clear_parallelization() {
@@ -384,6 +479,37 @@ void Controller::set_parallelization_circuit(const Circuit& circ,
 }
 
 
+void Controller::set_binding_domains() {
+  binding_domain_ = Topology::Domain::none;
+  binding_domains_.clear();
+  const auto allowed = Topology::thread_affinity();
+  if (allowed.size() < 2)
+    return;
+  std::vector<Topology::Domain> candidates;
+  if (thread_binding_ == "auto")
+    candidates = {Topology::Domain::numa, Topology::Domain::socket,
+                  Topology::Domain::l3};
+  else
+    candidates = {Topology::domain_from_string(thread_binding_)};
+  for (const auto domain : candidates) {
+    if (domain == Topology::Domain::none)
+      continue;
+    auto domains = Topology::read_domains(domain, allowed);
+    if (domains.size() > 1) {
+      binding_domain_ = domain;
+      binding_domains_ = std::move(domains);
+      return;
+    }
+  }
+}
+
+
+int Controller::state_update_threads() const {
+  const int cpus = Topology::bound_cpus();
+  return (cpus > 0) ? std::min(parallel_state_update_, cpus) : parallel_state_update_;
+}
+
+
 size_t Controller::get_system_memory_mb(){
   size_t total_physical_memory = 0;
 #if defined(__linux__) || defined(__APPLE__)
@@ -456,6 +582,17 @@ bool Controller::validate_memory_requirements(const state_t &state,
   return true;
 }
 
+//-------------------------------------------------------------------------
+// Resource estimation
+//-------------------------------------------------------------------------
+
+json_t Controller::estimate_circuit(const Circuit &circ,
+                                    const Noise::NoiseModel &noise,
+                                    const json_t &config) const {
+  (void)circ; (void)noise; (void)config;
+  throw std::runtime_error("AER::Base::Controller: dry_run is not supported by this simulator.");
+}
+
 //-------------------------------------------------------------------------
 // Circuit optimization
 //-------------------------------------------------------------------------
@@ -468,6 +605,8 @@ void Controller::optimize_circuit(Circuit &circ,
   Operations::OpSet allowed_opset;
   allowed_opset.optypes = state.allowed_ops();
   allowed_opset.gates = state.allowed_gates();
+  for (const auto &gate : state.internal_gates())
+    allowed_opset.gates.insert(gate);
   allowed_opset.snapshots = state.allowed_snapshots();
 
   for (std::shared_ptr<Transpile::CircuitOptimization> opt: optimizations_) {
@@ -480,6 +619,86 @@ void Controller::optimize_circuit(Circuit &circ,
 //-------------------------------------------------------------------------
 
 json_t Controller::execute(const json_t &qobj_js) {
+  std::vector<OutputData> data;
+  json_t result = execute_qobj(
+    [&](Qobj &qobj, Noise::NoiseModel &noise_model) {
+      qobj.load_qobj_from_json(qobj_js);
+      // Load noise model
+      JSON::get_value(noise_model, "noise_model", qobj.config);
+    }, data);
+  add_experiment_data(result, data);
+  return result;
+}
+
+json_t Controller::execute(JSON::Reader &qobj_reader, const json_t &config) {
+  std::vector<OutputData> data;
+  json_t result = execute_qobj(qobj_reader, config, data);
+  add_experiment_data(result, data);
+  return result;
+}
+
+json_t Controller::execute(JSON::Reader &qobj_reader,
+                           JSON::Writer &result_writer,
+                           const json_t &config) {
+  std::vector<OutputData> data;
+  json_t result = execute_qobj(qobj_reader, config, data);
+  write_result(result, data, result_writer);
+  return result;
+}
+
+json_t Controller::execute_qobj(JSON::Reader &qobj_reader,
+                                const json_t &config,
+                                std::vector<OutputData> &data) {
+  return execute_qobj([&](Qobj &qobj, Noise::NoiseModel &noise_model) {
+    auto read_noise_model = [&](const std::string &key, JSON::Reader &reader) {
+      if (key != "noise_model")
+        return false;
+      noise_model.load_from_stream(reader);
+      return true;
+    };
+    qobj.load_qobj_from_stream(qobj_reader, read_noise_model, config);
+    // Load noise model given in config
+    JSON::get_value(noise_model, "noise_model", qobj.config);
+  }, data);
+}
+
+void Controller::add_experiment_data(json_t &result,
+                                     const std::vector<OutputData> &data) const {
+  if (!JSON::check_key("results", result))
+    return;
+  auto &results = result["results"];
+  for (size_t j = 0; j < results.size() && j < data.size(); ++j) {
+    if (JSON::check_key("success", results[j]) &&
+        results[j]["success"].get<bool>())
+      results[j]["data"] = data[j];
+  }
+}
+
+void Controller::write_result(const json_t &result,
+                              const std::vector<OutputData> &data,
+                              JSON::Writer &writer) const {
+  JSON::Writer::Members members;
+  if (JSON::check_key("results", result)) {
+    members["results"] = [&](JSON::Writer &w) {
+      const auto &results = result["results"];
+      w.begin_array();
+      for (size_t j = 0; j < results.size(); ++j) {
+        JSON::Writer::Members experiment;
+        if (j < data.size() && JSON::check_key("success", results[j]) &&
+            results[j]["success"].get<bool>())
+          experiment["data"] = [&](JSON::Writer &dw) {data[j].write(dw);};
+        w.object(results[j], experiment);
+      }
+      w.end_array();
+    };
+  }
+  writer.set_omp_threads(max_parallel_threads_);
+  writer.object(result, members);
+}
+
+template <typename Lambda>
+json_t Controller::execute_qobj(Lambda &&load_qobj,
+                                std::vector<OutputData> &data) {
   // Start QOBJ timer
   auto timer_start = myclock_t::now();
 
@@ -497,15 +716,17 @@ json_t Controller::execute(const json_t &qobj_js) {
   // a valid JSON output containing the error message.
   Qobj qobj;
   Noise::NoiseModel noise_model;
-  json_t config;
   try {
-    qobj.load_qobj_from_json(qobj_js);
+    load_qobj(qobj, noise_model);
     // Check for config
-    if (JSON::get_value(config, "config", qobj_js)) {
+    if (!qobj.config.is_null()) {
+      // Fix for MacOS and OpenMP library double initialization crash.
+      // Issue: https://github.com/Qiskit/qiskit-aer/issues/1
+      std::string path;
+      if (JSON::get_value(path, "library_dir", qobj.config))
+        Hacks::maybe_load_openmp(path);
       // Set config
-      set_config(config);
-      // Load noise model
-      JSON::get_value(noise_model, "noise_model", config);
+      set_config(qobj.config);
     }
   }
   catch (std::exception &e) {
@@ -543,6 +764,9 @@ json_t Controller::execute(const json_t &qobj_js) {
   #endif
     result["metadata"]["parallel_experiments"] = parallel_experiments_;
     result["metadata"]["max_memory_mb"] = max_memory_mb_;
+    result["metadata"]["simd_isa"] = simd_isa();
+    set_binding_domains();
+    result["metadata"]["thread_binding"] = Topology::domain_to_string(binding_domain_);
     const int num_circuits = qobj.circuits.size();
 
   #ifdef _OPENMP
@@ -551,15 +775,29 @@ json_t Controller::execute(const json_t &qobj_js) {
   #endif
     // Initialize container to store parallel circuit output
     result["results"] = std::vector<json_t>(num_circuits);
+    data.resize(num_circuits);
     if (parallel_experiments_ > 1) {
       // Parallel circuit execution
       #pragma omp parallel for num_threads(parallel_experiments_)
       for (int j = 0; j < num_circuits; ++j) {
+        // Bind the circuit thread and its state update threads to a domain
+      #ifdef _OPENMP
+        const int worker = omp_get_thread_num();
+      #else
+        const int worker = 0;
+      #endif
+        const auto cpus = Topology::worker_cpus(binding_domains_, worker,
+                                                parallel_experiments_);
+        Topology::ThreadBinding binding(cpus, parallel_state_update_);
         // Make a copy of the noise model for each circuit execution
         auto circ_noise_model = noise_model;
         result["results"][j] = execute_circuit(qobj.circuits[j],
                                                circ_noise_model,
-                                               config);
+                                               qobj.config,
+                                               data[j]);
+        if (binding.bound())
+          result["results"][j]["metadata"]["thread_binding"] =
+            std::vector<std::string>({Topology::format_cpulist(cpus)});
       }
     } else {
       // Serial circuit execution
@@ -568,7 +806,8 @@ json_t Controller::execute(const json_t &qobj_js) {
         auto circ_noise_model = noise_model;
         result["results"][j] = execute_circuit(qobj.circuits[j],
                                                circ_noise_model,
-                                               config);
+                                               qobj.config,
+                                               data[j]);
       }
     }
 
@@ -595,21 +834,75 @@ json_t Controller::execute(const json_t &qobj_js) {
 }
 
 
+template <typename Lambda>
+OutputData Controller::run_parallel_shots(uint_t shots, uint_t seed,
+                                          Lambda &&func) const {
+  // Single shot thread execution
+  if (parallel_shots_ <= 1)
+    return func(shots, seed);
+
+  // Calculate shots per thread
+  std::vector<uint_t> subshots;
+  for (int j = 0; j < parallel_shots_; ++j) {
+    subshots.push_back(shots / parallel_shots_);
+  }
+  // If shots is not perfectly divisible by threads, assign the remainder
+  for (int j=0; j < int(shots % parallel_shots_); ++j) {
+    subshots[j] += 1;
+  }
+
+  // Vector to store parallel thread output data
+  std::vector<OutputData> par_data(parallel_shots_);
+  std::vector<std::string> error_msgs(parallel_shots_);
+  std::vector<std::string> bindings(parallel_shots_);
+  #pragma omp parallel for if (parallel_shots_ > 1) num_threads(parallel_shots_)
+  for (int i = 0; i < parallel_shots_; i++) {
+    // Bind the shot thread and its state update threads to a domain
+    const auto cpus = Topology::worker_cpus(binding_domains_, i,
+                                            parallel_shots_);
+    Topology::ThreadBinding binding(cpus, parallel_state_update_);
+    if (binding.bound())
+      bindings[i] = Topology::format_cpulist(cpus);
+    try {
+      par_data[i] = func(subshots[i], seed + i);
+    } catch (std::runtime_error &error) {
+      error_msgs[i] = error.what();
+    }
+  }
+
+  for (std::string error_msg: error_msgs)
+    if (error_msg != "")
+      throw std::runtime_error(error_msg);
+
+  // Accumulate results across shots
+  OutputData data;
+  for (auto &datum : par_data) {
+    data.combine(datum);
+  }
+  if (!bindings.front().empty()) {
+    json_t metadata;
+    metadata["thread_binding"] = bindings;
+    data.add_additional_data("metadata", metadata);
+  }
+  return data;
+}
+
 json_t Controller::execute_circuit(Circuit &circ,
                                    Noise::NoiseModel& noise,
-                                   const json_t &config) {
+                                   const json_t &config,
+                                   OutputData &data) {
 
   // Start individual circuit timer
   auto timer_start = myclock_t::now(); // state circuit timer
 
   // Initialize circuit json return
   json_t result;
-  OutputData data;
   data.set_config(config);
 
   // Execute in try block so we can catch errors and return the error message
   // for individual circuit failures.
   try {
+    const uint_t num_qubits = circ.num_qubits;
     // Truncate unused qubits from circuit and noise model
     if (truncate_qubits_) {
       Transpile::TruncateQubits truncate_pass;
@@ -620,45 +913,28 @@ json_t Controller::execute_circuit(Circuit &circ,
     if (!explicit_parallelization_ && parallel_experiments_ == 1) {
       set_parallelization_circuit(circ, noise);
     }
-    // Single shot thread execution
-    if (parallel_shots_ <= 1) {
+    // Estimate resources without executing the circuit
+    if (dry_run_) {
+      json_t estimate = estimate_circuit(circ, noise, config);
+      estimate["dry_run"] = true;
+      estimate["truncate_qubits"] = (circ.num_qubits < num_qubits);
+      estimate["num_qubits"] = circ.num_qubits;
+      data.add_additional_data("metadata", estimate);
+    }
+    // Shot threads are managed by run_circuit
+    else if (run_circuit_parallel_shots_) {
       auto tmp_data = run_circuit(circ, noise, config, circ.shots, circ.seed);
       data.combine(tmp_data);
+    }
     // Parallel shot thread execution
-    } else {
-      // Calculate shots per thread
-      std::vector<unsigned int> subshots;
-      for (int j = 0; j < parallel_shots_; ++j) {
-        subshots.push_back(circ.shots / parallel_shots_);
-      }
-      // If shots is not perfectly divisible by threads, assign the remainder
-      for (int j=0; j < int(circ.shots % parallel_shots_); ++j) {
-        subshots[j] += 1;
-      }
-
-      // Vector to store parallel thread output data
-      std::vector<OutputData> par_data(parallel_shots_);
-      std::vector<std::string> error_msgs(parallel_shots_);
-      #pragma omp parallel for if (parallel_shots_ > 1) num_threads(parallel_shots_)
-      for (int i = 0; i < parallel_shots_; i++) {
-        try {
-          par_data[i] = run_circuit(circ, noise, config, subshots[i], circ.seed + i);
-        } catch (std::runtime_error &error) {
-          error_msgs[i] = error.what();
-        }
-      }
-
-      for (std::string error_msg: error_msgs)
-        if (error_msg != "")
-          throw std::runtime_error(error_msg);
-
-      // Accumulate results across shots
-      for (auto &datum : par_data) {
-        data.combine(datum);
-      }
+    else {
+      auto tmp_data = run_parallel_shots(circ.shots, circ.seed,
+        [&](uint_t shots, uint_t seed) {
+          return run_circuit(circ, noise, config, shots, seed);
+        });
+      data.combine(tmp_data);
     }
     // Report success
-    result["data"] = data;
     result["success"] = true;
     result["status"] = std::string("DONE");
 
@@ -668,13 +944,9 @@ json_t Controller::execute_circuit(Circuit &circ,
     result["seed_simulator"] = circ.seed;
     // Move any metadata from the subclass run_circuit data
     // to the experiment result's metadata field
-    if (JSON::check_key("metadata", result["data"])) {
-
-      for(auto& metadata: result["data"]["metadata"].items()) {
-        result["metadata"][metadata.key()] = metadata.value();
-      }
-      // Remove the metadata field from data
-      result["data"].erase("metadata");
+    json_t metadata = data.extract_additional_data("metadata");
+    for (auto& item : metadata.items()) {
+      result["metadata"][item.key()] = item.value();
     }
     result["metadata"]["parallel_shots"] = parallel_shots_;
     result["metadata"]["parallel_state_update"] = parallel_state_update_;
@@ -72,6 +72,11 @@ public:
   // For example this could include {"u1", "u2", "u3", "U", "cx", "CX"}
   virtual stringset_t allowed_gates() const = 0;
 
+  // Return the set of gate instruction names that are supported by the
+  // state class but only inserted by circuit optimizations. They are not
+  // allowed in qobj circuits.
+  virtual stringset_t internal_gates() const {return {};}
+
   // Return the set of qobj gate instruction names supported by the state class
   // For example this could include {"probabilities", "pauli_observable"}
   virtual stringset_t allowed_snapshots() const = 0;
@@ -120,6 +125,38 @@ public:
                                             uint_t shots,
                                             RngEngine &rng);
 
+  //-----------------------------------------------------------------------
+  // Optional: shot branching
+  //
+  // These methods are only required for a State subclass to be compatible
+  // with the shot branching optimization of a general QasmController
+  //-----------------------------------------------------------------------
+
+  // Return the probabilities of the random outcomes of an operation on the
+  // current state, or an empty vector if the outcome of the operation is
+  // deterministic
+  virtual rvector_t branch_probabilities(const Operations::Op &op);
+
+  // Apply an operation with a fixed outcome of probability prob from
+  // branch_probabilities
+  virtual void apply_branch(const Operations::Op &op,
+                            uint_t outcome,
+                            double prob);
+
+  // Save a copy of the current state that is restored by pop_branch
+  virtual void push_branch();
+
+  // Restore the state saved by the last call of push_branch
+  virtual void pop_branch();
+
+  //-----------------------------------------------------------------------
+  // Optional: gradient snapshots
+  //-----------------------------------------------------------------------
+
+  // Enable recording the operations of each shot needed by gradient
+  // snapshots. Controllers disable it for circuits without them.
+  virtual void set_gradient_tape(bool enable) {(void)enable;}
+
   //=======================================================================
   // Standard Methods
   //
@@ -229,6 +266,36 @@ std::vector<reg_t> State<state_t>::sample_measure(const reg_t &qubits,
 }
 
 
+template <class state_t>
+rvector_t State<state_t>::branch_probabilities(const Operations::Op &op) {
+  (ignore_argument)op;
+  return rvector_t();
+}
+
+
+template <class state_t>
+void State<state_t>::apply_branch(const Operations::Op &op,
+                                  uint_t outcome,
+                                  double prob) {
+  (ignore_argument)outcome;
+  (ignore_argument)prob;
+  throw std::invalid_argument(name() + " state does not support shot branching"
+                              " for instruction \'" + op.name + "\'.");
+}
+
+
+template <class state_t>
+void State<state_t>::push_branch() {
+  throw std::runtime_error(name() + " state does not support shot branching.");
+}
+
+
+template <class state_t>
+void State<state_t>::pop_branch() {
+  throw std::runtime_error(name() + " state does not support shot branching.");
+}
+
+
 
 template <class state_t>
 bool State<state_t>::validate_opset(const Operations::OpSet &opset) const {
@@ -0,0 +1,124 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_framework_bounded_queue_hpp_
+#define _aer_framework_bounded_queue_hpp_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace AER {
+
+//============================================================================
+// Bounded queue
+//============================================================================
+
+// A first-in first-out queue of at most capacity items shared between
+// producer and consumer threads. Push blocks while the queue is full and
+// pop blocks while it is empty. Closing the queue wakes all waiting threads:
+// further pushes fail, and pops fail once the remaining items are taken.
+
+template <class T>
+class BoundedQueue {
+public:
+  explicit BoundedQueue(size_t capacity = 1)
+    : capacity_(capacity > 0 ? capacity : 1) {}
+
+  BoundedQueue(const BoundedQueue &) = delete;
+  BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+  // Add an item, waiting for space. Return false if the queue is closed.
+  bool push(T &&item);
+
+  // Take the oldest item, waiting for one. Return false if the queue is
+  // closed and empty.
+  bool pop(T &item);
+
+  // Close the queue
+  void close();
+
+  bool closed() const;
+  size_t size() const;
+  size_t capacity() const {return capacity_;}
+
+protected:
+  const size_t capacity_;
+  std::deque<T> items_;
+  bool closed_ = false;
+  mutable std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+};
+
+//============================================================================
+// Implementations
+//============================================================================
+
+template <class T>
+bool BoundedQueue<T>::push(T &&item) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  not_full_.wait(lock, [this]() {return closed_ || items_.size() < capacity_;});
+  if (closed_)
+    return false;
+  items_.push_back(std::move(item));
+  lock.unlock();
+  not_empty_.notify_one();
+  return true;
+}
+
+
+template <class T>
+bool BoundedQueue<T>::pop(T &item) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  not_empty_.wait(lock, [this]() {return closed_ || !items_.empty();});
+  if (items_.empty())
+    return false;
+  item = std::move(items_.front());
+  items_.pop_front();
+  lock.unlock();
+  not_full_.notify_one();
+  return true;
+}
+
+
+template <class T>
+void BoundedQueue<T>::close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+  }
+  not_full_.notify_all();
+  not_empty_.notify_all();
+}
+
+
+template <class T>
+bool BoundedQueue<T>::closed() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return closed_;
+}
+
+
+template <class T>
+size_t BoundedQueue<T>::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return items_.size();
+}
+
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
+#endif
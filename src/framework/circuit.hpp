@@ -55,6 +55,11 @@ public:
   Circuit(const json_t &circ);
   Circuit(const json_t &circ, const json_t &qobj_config);
 
+  // Construct a circuit from a list of ops and the header and config of a
+  // qobj experiment. The config should include the qobj config values that
+  // are not overwritten by the experiment config.
+  Circuit(std::vector<Op> &&_ops, const json_t &header, const json_t &config);
+
   // Automatically set the number of qubits, memory, registers based on ops
   void set_sizes();
 
@@ -84,6 +89,10 @@ public:
 
 private:
   Operations::OpSet opset_;  // Set of operation types contained in circuit
+
+  // Set the op types, sizes and shots for the current ops from a
+  // qobj experiment config
+  void load_config(const json_t &config);
 };
 
 // Json conversion function
@@ -142,6 +151,19 @@ Circuit::Circuit(const json_t &circ, const json_t &qobj_config) : Circuit() {
     ops.emplace_back(Operations::json_to_op(jop));
   }
 
+  // Load metadata
+  JSON::get_value(header, "header", circ);
+  load_config(config);
+}
+
+Circuit::Circuit(std::vector<Op> &&_ops, const json_t &_header,
+                 const json_t &config) : Circuit() {
+  ops = std::move(_ops);
+  header = _header;
+  load_config(config);
+}
+
+void Circuit::load_config(const json_t &config) {
   // Set optype information
   opset_ = Operations::OpSet(ops);
 
@@ -149,7 +171,6 @@ Circuit::Circuit(const json_t &circ, const json_t &qobj_config) : Circuit() {
   set_sizes();
 
   // Load metadata
-  JSON::get_value(header, "header", circ);
   JSON::get_value(shots, "shots", config);
 
   // Check for specified memory slots
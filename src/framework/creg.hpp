@@ -15,6 +15,8 @@
 #ifndef _aer_framework_creg_hpp_
 #define _aer_framework_creg_hpp_
 
+#include <numeric>
+
 #include "framework/operations.hpp"
 #include "framework/utils.hpp"
 #include "framework/rng.hpp"
@@ -76,6 +78,12 @@ public:
   // Apply readout error instruction to classical registers
   void apply_roerror(const Operations::Op &op, RngEngine &rng);
 
+  // Distribute shots with the current classical bit values over the
+  // outcomes of a readout error instruction without sampling each shot.
+  // Returns the classical registers of the outcomes with their shots.
+  std::vector<std::pair<ClassicalRegister, uint_t>>
+  apply_roerror(const Operations::Op &op, uint_t shots, RngEngine &rng) const;
+
   // Store a measurement outcome in the specified memory and register bit locations
   void store_measure(const reg_t &outcome, const reg_t &memory, const reg_t &registers);
 
@@ -87,6 +95,24 @@ protected:
 
   // Measurement config settings
   bool return_hex_strings_ = true;       // Set to false for bit-string output
+
+  // Return the number of factors of a readout error instruction, and the
+  // positions of the assigned and control bits of a factor. Instructions
+  // without factors have a single factor assigning all bits.
+  static size_t roerror_num_factors(const Operations::Op &op);
+  static reg_t roerror_qubits(const Operations::Op &op, size_t factor);
+  static reg_t roerror_controls(const Operations::Op &op, size_t factor);
+
+  // Return the ideal value of the assigned bits (low bits) and control bits
+  // (high bits) of a readout error factor
+  uint_t roerror_input(const Operations::Op &op,
+                       const reg_t &qubits,
+                       const reg_t &controls) const;
+
+  // Store the outcome of a readout error factor in the assigned bits
+  void store_roerror(const Operations::Op &op,
+                     const reg_t &qubits,
+                     uint_t outcome);
 };
 
 //============================================================================
@@ -226,6 +252,53 @@ void ClassicalRegister::apply_bfunc(const Operations::Op &op) {
   }
 }
 
+size_t ClassicalRegister::roerror_num_factors(const Operations::Op &op) {
+  return op.roerror_factors.empty() ? 1 : op.roerror_factors.size() / 2;
+}
+
+
+reg_t ClassicalRegister::roerror_qubits(const Operations::Op &op, size_t factor) {
+  if (!op.roerror_factors.empty())
+    return op.roerror_factors[2 * factor];
+  reg_t qubits(op.memory.size());
+  std::iota(qubits.begin(), qubits.end(), 0);
+  return qubits;
+}
+
+
+reg_t ClassicalRegister::roerror_controls(const Operations::Op &op, size_t factor) {
+  if (!op.roerror_factors.empty())
+    return op.roerror_factors[2 * factor + 1];
+  return reg_t();
+}
+
+
+uint_t ClassicalRegister::roerror_input(const Operations::Op &op,
+                                        const reg_t &qubits,
+                                        const reg_t &controls) const {
+  uint_t val = 0;
+  for (size_t pos = 0; pos < qubits.size() + controls.size(); ++pos) {
+    const auto q = (pos < qubits.size()) ? qubits[pos] : controls[pos - qubits.size()];
+    if (creg_memory_[creg_memory_.size() - 1 - op.memory[q]] == '1')
+      val |= (1ULL << pos);
+  }
+  return val;
+}
+
+
+void ClassicalRegister::store_roerror(const Operations::Op &op,
+                                      const reg_t &qubits,
+                                      uint_t outcome) {
+  for (size_t pos = 0; pos < qubits.size(); ++pos) {
+    const char val = ((outcome >> pos) & 1ULL) ? '1' : '0';
+    creg_memory_[creg_memory_.size() - 1 - op.memory[qubits[pos]]] = val;
+    // and the same error to register classical bits if they are used
+    if (!op.registers.empty())
+      creg_register_[creg_register_.size() - 1 - op.registers[qubits[pos]]] = val;
+  }
+}
+
+
 // Apply readout error instruction to classical registers
 void ClassicalRegister::apply_roerror(const Operations::Op &op, RngEngine &rng) {
   
@@ -233,28 +306,55 @@ void ClassicalRegister::apply_roerror(const Operations::Op &op, RngEngine &rng)
   if (op.type != Operations::OpType::roerror) {
     throw std::invalid_argument("ClassicalRegister::apply_roerror Input is not a readout error op.");
   }
-  
-  // Get current classical bit (and optionally register bit) values
-  std::string mem_str;
-  
-  // Get values of bits as binary string
-  // We iterate from the end of the list of memory bits
-  for (auto it = op.memory.rbegin(); it < op.memory.rend(); ++it) {
-    auto bit = *it;
-    mem_str.push_back(creg_memory_[creg_memory_.size() - 1 - bit]);
+
+  // Sample the outcome of each factor from the ideal bit values before
+  // storing any outcome, since factors may be conditioned on the same bits
+  const size_t num_factors = roerror_num_factors(op);
+  std::vector<reg_t> qubits(num_factors);
+  reg_t outcomes(num_factors);
+  size_t offset = 0;
+  for (size_t f = 0; f < num_factors; ++f) {
+    qubits[f] = roerror_qubits(op, f);
+    const auto controls = roerror_controls(op, f);
+    outcomes[f] = rng.rand_int(op.probs[offset + roerror_input(op, qubits[f], controls)]);
+    offset += 1ULL << (qubits[f].size() + controls.size());
   }
-  auto mem_val = std::stoull(mem_str, nullptr, 2);
-  auto outcome = rng.rand_int(op.probs[mem_val]);
-  auto noise_str = Utils::int2string(outcome, 2, op.memory.size());
-  for (size_t pos = 0; pos < op.memory.size(); ++pos) {
-    auto bit = op.memory[pos];
-    creg_memory_[creg_memory_.size() - 1 - bit] = noise_str[noise_str.size() - 1 - pos];
+  for (size_t f = 0; f < num_factors; ++f)
+    store_roerror(op, qubits[f], outcomes[f]);
+}
+
+
+std::vector<std::pair<ClassicalRegister, uint_t>>
+ClassicalRegister::apply_roerror(const Operations::Op &op,
+                                 uint_t shots,
+                                 RngEngine &rng) const {
+  // Check input is readout error op
+  if (op.type != Operations::OpType::roerror) {
+    throw std::invalid_argument("ClassicalRegister::apply_roerror Input is not a readout error op.");
   }
-  // and the same error to register classical bits if they are used
-  for (size_t pos = 0; pos < op.registers.size(); ++pos) {
-    auto bit = op.registers[pos];
-    creg_register_[creg_register_.size() - 1 - bit] = noise_str[noise_str.size() - 1 - pos];
+
+  // Factors are independent for given ideal bit values, so the shots are
+  // split over the outcomes of each factor in turn
+  std::vector<std::pair<ClassicalRegister, uint_t>> cregs({{*this, shots}});
+  size_t offset = 0;
+  for (size_t f = 0; f < roerror_num_factors(op); ++f) {
+    const auto qubits = roerror_qubits(op, f);
+    const auto controls = roerror_controls(op, f);
+    const auto &probs = op.probs[offset + roerror_input(op, qubits, controls)];
+    offset += 1ULL << (qubits.size() + controls.size());
+    std::vector<std::pair<ClassicalRegister, uint_t>> next;
+    for (const auto &creg : cregs) {
+      const auto counts = rng.rand_multinomial(creg.second, probs);
+      for (uint_t outcome = 0; outcome < counts.size(); ++outcome) {
+        if (counts[outcome] > 0) {
+          next.emplace_back(creg.first, counts[outcome]);
+          next.back().first.store_roerror(op, qubits, outcome);
+        }
+      }
+    }
+    cregs = std::move(next);
   }
+  return cregs;
 }
 
 //------------------------------------------------------------------------------
@@ -16,6 +16,7 @@
 #define _aer_framework_data_hpp_
 
 #include "framework/json.hpp"
+#include "framework/json_writer.hpp"
 #include "framework/snapshot.hpp"
 #include "framework/utils.hpp"
 
@@ -40,8 +41,8 @@ public:
   // Measurement
   //----------------------------------------------------------------
 
-  // Add a single memory value to the counts map
-  void add_memory_count(const std::string &memory);
+  // Add a memory value to the counts map for a number of shots
+  void add_memory_count(const std::string &memory, uint_t shots = 1);
 
   // Add a single memory value to the memory vector
   void add_memory_singleshot(const std::string &memory);
@@ -49,6 +50,11 @@ public:
   // Add a single register value to the register vector
   void add_register_singleshot(const std::string &reg);
 
+  // Return true if the memory or register value of each shot is returned
+  inline bool singleshot_measure_enabled() const {
+    return return_memory_ || return_register_;
+  }
+
   //----------------------------------------------------------------
   // Snapshots
   //----------------------------------------------------------------
@@ -61,6 +67,12 @@ public:
                                const std::string &label,
                                const T &datum);
 
+  // Add a new complex vector or matrix datum to the snapshot of the
+  // specified type and label. It is kept typed until the data is serialized.
+  void add_singleshot_snapshot(const std::string &type,
+                               const std::string &label,
+                               JSON::ComplexArray &&datum);
+
   // Add a new datum to the snapshot of the specified type and label
   // This will use the json conversion method `to_json` for
   // data type T
@@ -73,6 +85,12 @@ public:
                             const T &datum,
                             bool variance = false);
 
+  // Set the number of shots each following averaged snapshot datum is
+  // recorded for. This is used when a datum is shared by several shots.
+  void set_average_snapshot_weight(uint_t weight) {
+    average_snapshot_weight_ = weight;
+  }
+
   // Delete all singleshot snapshots of a given type
   void clear_singleshot_snapshot(const std::string &type);
 
@@ -94,8 +112,15 @@ public:
   template <typename T>
   void add_additional_data(const std::string &key, const T &data);
 
+  // Add a complex vector or matrix that is kept typed until the data is
+  // serialized. This replaces any additional data with the same key.
+  void add_additional_data(const std::string &key, JSON::ComplexArray &&data);
+
   void clear_additional_data(const std::string &key);
 
+  // Remove and return the additional data with the given key, or null
+  json_t extract_additional_data(const std::string &key);
+
   //----------------------------------------------------------------
   // Config
   //----------------------------------------------------------------
@@ -109,6 +134,10 @@ public:
   // Serialize engine data to JSON
   json_t json() const;
 
+  // Write engine data with a JSON writer. This is equivalent to writing
+  // json() but complex arrays are written without converting them to JSON.
+  void write(JSON::Writer &writer) const;
+
   // Combine engines for accumulating data
   // Second engine should no longer be used after combining
   // as this function should use move semantics to minimize copying
@@ -132,9 +161,14 @@ protected:
   // Snapshots
   stringmap_t<SingleShotSnapshot> singleshot_snapshots_;
   stringmap_t<AverageSnapshot> average_snapshots_;
+  uint_t average_snapshot_weight_ = 1; // shots of each averaged datum
 
   // Miscelaneous data
   json_t additional_data_;
+  stringmap_t<JSON::ComplexArray> additional_arrays_;
+
+  // Serialize engine data to JSON, optionally skipping complex arrays
+  json_t json(bool arrays) const;
 
   //----------------------------------------------------------------
   // Config
@@ -159,10 +193,10 @@ void OutputData::set_config(const json_t &config) {
 }
 
 
-void OutputData::add_memory_count(const std::string &memory) {
+void OutputData::add_memory_count(const std::string &memory, uint_t shots) {
   // Memory bits value
   if (return_counts_ && !memory.empty()) {
-    counts_[memory] += 1;
+    counts_[memory] += shots;
   }
 }
 
@@ -191,6 +225,15 @@ void OutputData::add_singleshot_snapshot(const std::string &type,
 }
 
 
+void OutputData::add_singleshot_snapshot(const std::string &type,
+                                         const std::string &label,
+                                         JSON::ComplexArray &&datum) {
+  if (return_snapshots_) {
+    singleshot_snapshots_[type].add_data(label, std::move(datum));
+  }
+}
+
+
 template <typename T>
 void OutputData::add_average_snapshot(const std::string &type,
                                       const std::string &label,
@@ -199,7 +242,8 @@ void OutputData::add_average_snapshot(const std::string &type,
                                       bool variance) {
   if (return_snapshots_) {   
     json_t js = datum; // use implicit to_json conversion function for T
-    average_snapshots_[type].add_data(label, memory, js, variance);
+    average_snapshots_[type].add_data(label, memory, js, variance,
+                                      average_snapshot_weight_);
   }
 }
 
@@ -234,6 +278,7 @@ template <typename T>
 void OutputData::add_additional_data(const std::string &key, const T &data) {
   if (return_additional_data_) {
     json_t js = data; // use implicit to_json conversion function for T
+    additional_arrays_.erase(key);
     if (JSON::check_key(key, additional_data_))
       additional_data_[key].update(js.begin(), js.end());
     else
@@ -242,8 +287,32 @@ void OutputData::add_additional_data(const std::string &key, const T &data) {
 }
 
 
+void OutputData::add_additional_data(const std::string &key,
+                                     JSON::ComplexArray &&data) {
+  if (return_additional_data_) {
+    if (additional_data_.is_object())
+      additional_data_.erase(key);
+    additional_arrays_[key] = std::move(data);
+  }
+}
+
+
 void OutputData::clear_additional_data(const std::string &key) {
   additional_data_.erase(key);
+  additional_arrays_.erase(key);
+}
+
+
+json_t OutputData::extract_additional_data(const std::string &key) {
+  json_t js;
+  if (JSON::check_key(key, additional_data_)) {
+    js = std::move(additional_data_[key]);
+    additional_data_.erase(key);
+  } else if (additional_arrays_.find(key) != additional_arrays_.end()) {
+    js = additional_arrays_[key].json();
+    additional_arrays_.erase(key);
+  }
+  return js;
 }
 
 
@@ -257,6 +326,7 @@ void OutputData::clear() {
   average_snapshots_.clear();
   // Clear additional data
   additional_data_.clear();
+  additional_arrays_.clear();
 }
 
 
@@ -292,6 +362,12 @@ OutputData& OutputData::combine(OutputData &data) {
         additional_data_[it.key()][it2.key()] = it2.value();
       }
     }
+    additional_arrays_.erase(it.key());
+  }
+  for (auto &pair : data.additional_arrays_) {
+    if (additional_data_.is_object())
+      additional_data_.erase(pair.first);
+    additional_arrays_[pair.first] = std::move(pair.second);
   }
 
   // Clear any remaining data from other container
@@ -302,9 +378,18 @@ OutputData& OutputData::combine(OutputData &data) {
 
 
 json_t OutputData::json() const {
+  return json(true);
+}
+
+
+json_t OutputData::json(bool arrays) const {
 
   // Initialize output as additional data JSON
   json_t tmp = additional_data_;
+  if (arrays) {
+    for (const auto &pair : additional_arrays_)
+      tmp[pair.first] = pair.second.json();
+  }
 
   // Add standard data
   // This will override any additional data fields if they use keys:
@@ -326,6 +411,8 @@ json_t OutputData::json() const {
     // Note these will override the average snapshots
     // if they share the same type string
     for (auto &pair : singleshot_snapshots_) {
+      if (!arrays && pair.second.has_arrays())
+        continue;
       tmp["snapshots"][pair.first] = pair.second.json();
     }
   }
@@ -336,6 +423,43 @@ json_t OutputData::json() const {
 }
 
 
+void OutputData::write(JSON::Writer &writer) const {
+  bool arrays = false;
+  if (return_snapshots_) {
+    for (const auto &pair : singleshot_snapshots_)
+      arrays |= pair.second.has_arrays();
+  }
+  if (!arrays && additional_arrays_.empty()) {
+    writer.value(json());
+    return;
+  }
+  // Write the complex arrays directly into the JSON of the other data
+  json_t tmp = json(false);
+  JSON::Writer::Members members;
+  for (const auto &pair : additional_arrays_) {
+    // Standard data fields override additional data
+    if (!JSON::check_key(pair.first, tmp)) {
+      const auto &datum = pair.second;
+      members[pair.first] = [&datum](JSON::Writer &w) {datum.write(w);};
+    }
+  }
+  if (arrays) {
+    members["snapshots"] = [this, &tmp](JSON::Writer &w) {
+      JSON::Writer::Members snapshots;
+      for (const auto &pair : singleshot_snapshots_) {
+        const auto &snapshot = pair.second;
+        if (snapshot.has_arrays())
+          snapshots[pair.first] = [&snapshot](JSON::Writer &sw) {
+            snapshot.write(sw);
+          };
+      }
+      w.object(tmp["snapshots"], snapshots);
+    };
+  }
+  writer.object(tmp, members);
+}
+
+
 //------------------------------------------------------------------------------
 // Implicit JSON conversion function
 //------------------------------------------------------------------------------
@@ -0,0 +1,57 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_framework_isa_hpp_
+#define _aer_framework_isa_hpp_
+
+#include <string>
+
+// Functions marked with AER_TARGET_CLONES are compiled for every instruction
+// set tier of the AER_ISA_TIERS build option, and the variant matching the
+// CPU is selected when the binary is loaded. The build system defines the
+// macro together with an AER_ISA_<TIER> flag for each tier.
+#ifndef AER_TARGET_CLONES
+#define AER_TARGET_CLONES
+#endif
+
+namespace AER {
+
+// Return the instruction set of the kernel variants used on this CPU
+inline std::string simd_isa() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+#ifdef AER_ISA_AVX512F
+  if (__builtin_cpu_supports("avx512f"))
+    return "avx512f";
+#endif
+#ifdef AER_ISA_AVX2
+  if (__builtin_cpu_supports("avx2"))
+    return "avx2";
+#endif
+#ifdef AER_ISA_AVX
+  if (__builtin_cpu_supports("avx"))
+    return "avx";
+#endif
+#ifdef AER_ISA_SSE4_2
+  if (__builtin_cpu_supports("sse4.2"))
+    return "sse4.2";
+#endif
+#endif
+  return "default";
+}
+
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
+#endif
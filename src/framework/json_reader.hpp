@@ -0,0 +1,701 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_framework_json_reader_hpp_
+#define _aer_framework_json_reader_hpp_
+
+#include <algorithm>
+#include <cerrno>
+#include <clocale>
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "framework/json.hpp"
+#include "framework/matrix.hpp"
+
+namespace JSON {
+
+//============================================================================
+// Streaming JSON reader
+//============================================================================
+
+// A reader that parses a JSON text as a stream of events without building a
+// document. The text is validated as it is read, and syntax errors throw an
+// std::invalid_argument with the byte offset of the error.
+//
+// Values can be consumed event by event, read directly into typed containers
+// with `read`, or built as a json_t with `value` when they are small.
+//
+// Example: read the "data" field of an object as a complex matrix
+//
+//   Reader reader(stream);
+//   reader.begin_object();
+//   std::string key;
+//   while (reader.next_key(key)) {
+//     if (key == "data")
+//       reader.read(mat);
+//     else
+//       reader.skip();
+//   }
+
+class Reader {
+public:
+
+  enum class Event {
+    begin_object, end_object, begin_array, end_array,
+    key, string, number, boolean, null, end
+  };
+
+  // Read a JSON text from an input stream in blocks of block_size bytes
+  explicit Reader(std::istream &in, size_t block_size = 1ULL << 16);
+
+  // Read a JSON text from a character buffer. The buffer is not copied and
+  // must outlive the reader.
+  Reader(const char *data, size_t size);
+  explicit Reader(const std::string &str) : Reader(str.data(), str.size()) {}
+  explicit Reader(std::string &&str) = delete;
+
+  Reader(const Reader &) = delete;
+  Reader &operator=(const Reader &) = delete;
+
+  //-----------------------------------------------------------------------
+  // Events
+  //-----------------------------------------------------------------------
+
+  // Return the next event without consuming it
+  Event peek();
+
+  // Consume and return the next event. The value of a key, string, number
+  // or boolean event is returned by `str`, `number` or `boolean`.
+  Event next();
+
+  // Return the key or string of the last event, or the characters of a
+  // number event
+  const std::string &str() const {return str_;}
+
+  // Return the value of the last number event
+  double number() const;
+
+  // Return true if the last number event is an integer
+  bool integer() const {return integer_;}
+
+  // Return the value of the last boolean event
+  bool boolean() const {return boolean_;}
+
+  //-----------------------------------------------------------------------
+  // Structure
+  //-----------------------------------------------------------------------
+
+  // Consume the beginning of an object or array, or throw if the next
+  // value is not an object or array
+  void begin_object();
+  void begin_array();
+
+  // Set key to the next key of the current object and return true, or
+  // consume the end of the object and return false
+  bool next_key(std::string &key);
+
+  // Return true if the current array has another element, or consume the
+  // end of the array and return false
+  bool next_element();
+
+  // Consume the end of the text, or throw if there is more than a single
+  // JSON value
+  void end();
+
+  //-----------------------------------------------------------------------
+  // Values
+  //-----------------------------------------------------------------------
+
+  // Consume the next value without building it
+  void skip();
+
+  // Consume the next value and return it as a json_t
+  json_t value();
+
+  // Consume the next value into a variable. Booleans, numbers, strings,
+  // complex numbers, vectors and matrices are read directly, and other
+  // types are converted from a json_t.
+  template <typename T>
+  void read(T &var);
+
+  // Throw an std::invalid_argument with the current byte offset
+  [[noreturn]] void error(const std::string &msg) const;
+
+protected:
+
+  enum class State {value, object_first, array_first, key, after_value, done};
+
+  // Read the next event from the text
+  Event read_event();
+
+  // Character input
+  int get();
+  int peek_char();
+  bool refill();
+  void skip_whitespace();
+
+  // Lexers for the current value
+  void lex_string();
+  void lex_number(int c);
+  void lex_literal(const char *rest);
+
+  std::istream *in_ = nullptr;
+  std::vector<char> buffer_;
+  const char *block_ = nullptr;   // current block of the text
+  const char *pos_ = nullptr;
+  const char *end_ = nullptr;
+  size_t offset_ = 0;             // bytes of the text before the block
+
+  State state_ = State::value;
+  std::vector<char> stack_;    // open objects '{' and arrays '['
+
+  bool peeked_ = false;
+  Event event_ = Event::null;
+  std::string str_;
+  bool boolean_ = false;
+  bool integer_ = false;
+};
+
+//============================================================================
+// Typed values
+//============================================================================
+
+inline void read_value(Reader &reader, bool &var);
+inline void read_value(Reader &reader, std::string &var);
+inline void read_value(Reader &reader, json_t &var);
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic<T>::value> read_value(Reader &reader, T &var);
+
+template <typename T>
+void read_value(Reader &reader, std::complex<T> &var);
+
+template <typename T>
+void read_value(Reader &reader, std::vector<T> &var);
+
+template <typename T>
+void read_value(Reader &reader, matrix<T> &var);
+
+template <typename T>
+std::enable_if_t<!std::is_arithmetic<T>::value> read_value(Reader &reader, T &var);
+
+//============================================================================
+// Implementation: Reader
+//============================================================================
+
+Reader::Reader(std::istream &in, size_t block_size)
+  : in_(&in), buffer_(std::max<size_t>(block_size, 1)) {}
+
+Reader::Reader(const char *data, size_t size)
+  : block_(data), pos_(data), end_(data + size) {}
+
+void Reader::error(const std::string &msg) const {
+  const size_t pos = offset_ + (pos_ - block_);
+  throw std::invalid_argument("JSON: " + msg + " at byte " + std::to_string(pos) + ".");
+}
+
+bool Reader::refill() {
+  if (in_ == nullptr || !*in_)
+    return false;
+  offset_ += end_ - block_;
+  in_->read(buffer_.data(), buffer_.size());
+  block_ = buffer_.data();
+  pos_ = block_;
+  end_ = pos_ + in_->gcount();
+  return pos_ != end_;
+}
+
+int Reader::get() {
+  if (pos_ == end_ && !refill())
+    return EOF;
+  return static_cast<unsigned char>(*pos_++);
+}
+
+int Reader::peek_char() {
+  if (pos_ == end_ && !refill())
+    return EOF;
+  return static_cast<unsigned char>(*pos_);
+}
+
+void Reader::skip_whitespace() {
+  for (int c = peek_char(); c == ' ' || c == '\n' || c == '\r' || c == '\t';
+       c = peek_char())
+    pos_++;
+}
+
+Reader::Event Reader::peek() {
+  if (!peeked_) {
+    event_ = read_event();
+    peeked_ = true;
+  }
+  return event_;
+}
+
+Reader::Event Reader::next() {
+  if (peeked_) {
+    peeked_ = false;
+    return event_;
+  }
+  event_ = read_event();
+  return event_;
+}
+
+Reader::Event Reader::read_event() {
+  while (true) {
+    skip_whitespace();
+    const int c = get();
+    switch (state_) {
+      case State::done: {
+        if (c != EOF)
+          error("unexpected character after the end of the value");
+        return Event::end;
+      }
+      case State::after_value: {
+        if (c == ',' && !stack_.empty()) {
+          state_ = (stack_.back() == '{') ? State::key : State::value;
+          continue;
+        }
+        if ((c == '}' || c == ']') && !stack_.empty()) {
+          if ((c == '}') != (stack_.back() == '{'))
+            error("mismatched closing bracket");
+          stack_.pop_back();
+          state_ = stack_.empty() ? State::done : State::after_value;
+          return (c == '}') ? Event::end_object : Event::end_array;
+        }
+        error("expected ',' or closing bracket");
+      }
+      case State::object_first:
+      case State::key: {
+        if (c == '}' && state_ == State::object_first) {
+          stack_.pop_back();
+          state_ = stack_.empty() ? State::done : State::after_value;
+          return Event::end_object;
+        }
+        if (c != '"')
+          error("expected object key");
+        lex_string();
+        skip_whitespace();
+        if (get() != ':')
+          error("expected ':' after object key");
+        state_ = State::value;
+        return Event::key;
+      }
+      case State::array_first:
+      case State::value: {
+        if (c == ']' && state_ == State::array_first) {
+          stack_.pop_back();
+          state_ = stack_.empty() ? State::done : State::after_value;
+          return Event::end_array;
+        }
+        // Values other than objects and arrays are followed by a separator
+        state_ = State::after_value;
+        switch (c) {
+          case '{':
+            stack_.push_back('{');
+            state_ = State::object_first;
+            return Event::begin_object;
+          case '[':
+            stack_.push_back('[');
+            state_ = State::array_first;
+            return Event::begin_array;
+          case '"':
+            lex_string();
+            break;
+          case 't':
+            lex_literal("rue");
+            boolean_ = true;
+            break;
+          case 'f':
+            lex_literal("alse");
+            boolean_ = false;
+            break;
+          case 'n':
+            lex_literal("ull");
+            break;
+          case EOF:
+            error("unexpected end of input");
+          default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+              lex_number(c);
+              break;
+            }
+            error("unexpected character");
+        }
+        if (stack_.empty())
+          state_ = State::done;
+        switch (c) {
+          case '"': return Event::string;
+          case 't':
+          case 'f': return Event::boolean;
+          case 'n': return Event::null;
+          default: return Event::number;
+        }
+      }
+    }
+  }
+}
+
+void Reader::lex_literal(const char *rest) {
+  for (; *rest != '\0'; rest++) {
+    if (get() != *rest)
+      error("invalid literal");
+  }
+}
+
+void Reader::lex_number(int c) {
+  // Validate the number grammar while copying its characters
+  str_.clear();
+  integer_ = true;
+  auto digits = [&]() {
+    if (peek_char() < '0' || peek_char() > '9')
+      error("invalid number");
+    while (peek_char() >= '0' && peek_char() <= '9')
+      str_.push_back(static_cast<char>(get()));
+  };
+  if (c == '-') {
+    str_.push_back('-');
+    c = get();
+    if (c < '0' || c > '9')
+      error("invalid number");
+  }
+  str_.push_back(static_cast<char>(c));
+  if (c != '0') {
+    while (peek_char() >= '0' && peek_char() <= '9')
+      str_.push_back(static_cast<char>(get()));
+  }
+  if (peek_char() == '.') {
+    integer_ = false;
+    str_.push_back(static_cast<char>(get()));
+    digits();
+  }
+  if (peek_char() == 'e' || peek_char() == 'E') {
+    integer_ = false;
+    str_.push_back(static_cast<char>(get()));
+    if (peek_char() == '+' || peek_char() == '-')
+      str_.push_back(static_cast<char>(get()));
+    digits();
+  }
+}
+
+void Reader::lex_string() {
+  str_.clear();
+  auto hex4 = [&]() {
+    unsigned val = 0;
+    for (int i = 0; i < 4; i++) {
+      const int c = get();
+      val <<= 4;
+      if (c >= '0' && c <= '9') val |= c - '0';
+      else if (c >= 'a' && c <= 'f') val |= c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F') val |= c - 'A' + 10;
+      else error("invalid unicode escape");
+    }
+    return val;
+  };
+  while (true) {
+    // Copy runs of unescaped characters from the current block
+    const char *start = pos_;
+    while (pos_ != end_ && *pos_ != '"' && *pos_ != '\\' &&
+           static_cast<unsigned char>(*pos_) >= 0x20)
+      pos_++;
+    str_.append(start, pos_);
+    const int c = get();
+    if (c == '"')
+      return;
+    if (c == EOF)
+      error("unterminated string");
+    if (c < 0x20)
+      error("control character in string");
+    if (c != '\\') {
+      // The run ended at the end of a block
+      str_.push_back(static_cast<char>(c));
+      continue;
+    }
+    const int e = get();
+    switch (e) {
+      case '"': str_.push_back('"'); break;
+      case '\\': str_.push_back('\\'); break;
+      case '/': str_.push_back('/'); break;
+      case 'b': str_.push_back('\b'); break;
+      case 'f': str_.push_back('\f'); break;
+      case 'n': str_.push_back('\n'); break;
+      case 'r': str_.push_back('\r'); break;
+      case 't': str_.push_back('\t'); break;
+      case 'u': {
+        unsigned cp = hex4();
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+          if (get() != '\\' || get() != 'u')
+            error("invalid unicode surrogate pair");
+          const unsigned low = hex4();
+          if (low < 0xDC00 || low > 0xDFFF)
+            error("invalid unicode surrogate pair");
+          cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+          error("invalid unicode surrogate pair");
+        }
+        // Encode as UTF-8
+        if (cp < 0x80) {
+          str_.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+          str_.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+          str_.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+          str_.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+          str_.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+          str_.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+          str_.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+          str_.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+          str_.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+          str_.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+        break;
+      }
+      default:
+        error("invalid escape in string");
+    }
+  }
+}
+
+double Reader::number() const {
+  // strtod reads the decimal point of the C locale, so under a locale with
+  // another decimal point the JSON one is swapped for it (as in the
+  // nlohmann lexer)
+  const char point = *std::localeconv()->decimal_point;
+  if (point == '.')
+    return std::strtod(str_.c_str(), nullptr);
+  std::string str = str_;
+  std::replace(str.begin(), str.end(), '.', point);
+  return std::strtod(str.c_str(), nullptr);
+}
+
+void Reader::begin_object() {
+  if (next() != Event::begin_object)
+    error("expected object");
+}
+
+void Reader::begin_array() {
+  if (next() != Event::begin_array)
+    error("expected array");
+}
+
+bool Reader::next_key(std::string &key) {
+  if (next() == Event::end_object)
+    return false;
+  if (event_ != Event::key)
+    error("expected object key");
+  key = str_;
+  return true;
+}
+
+bool Reader::next_element() {
+  if (peek() != Event::end_array)
+    return true;
+  next();
+  return false;
+}
+
+void Reader::end() {
+  if (next() != Event::end)
+    error("unexpected value after the end of the text");
+}
+
+void Reader::skip() {
+  size_t depth = 0;
+  do {
+    switch (next()) {
+      case Event::begin_object:
+      case Event::begin_array:
+        depth++;
+        break;
+      case Event::end_object:
+      case Event::end_array:
+        depth--;
+        break;
+      case Event::key:
+        break;
+      case Event::end:
+        error("unexpected end of input");
+      default:
+        break;
+    }
+  } while (depth > 0);
+}
+
+json_t Reader::value() {
+  switch (next()) {
+    case Event::begin_object: {
+      json_t js = json_t::object();
+      std::string key;
+      while (next_key(key))
+        js[key] = value();
+      return js;
+    }
+    case Event::begin_array: {
+      json_t js = json_t::array();
+      while (next_element())
+        js.push_back(value());
+      return js;
+    }
+    case Event::string:
+      return json_t(str_);
+    case Event::boolean:
+      return json_t(boolean_);
+    case Event::null:
+      return json_t();
+    case Event::number: {
+      // Integers are stored as in the json_t parser, and integers that
+      // overflow 64 bits as floating point numbers
+      if (integer_) {
+        errno = 0;
+        if (str_[0] == '-') {
+          const auto val = std::strtoll(str_.c_str(), nullptr, 10);
+          if (errno != ERANGE)
+            return json_t(static_cast<int64_t>(val));
+        } else {
+          const auto val = std::strtoull(str_.c_str(), nullptr, 10);
+          if (errno != ERANGE)
+            return json_t(static_cast<uint64_t>(val));
+        }
+      }
+      return json_t(number());
+    }
+    default:
+      error("expected value");
+  }
+}
+
+template <typename T>
+void Reader::read(T &var) {
+  read_value(*this, var);
+}
+
+//============================================================================
+// Implementation: Typed values
+//============================================================================
+
+void read_value(Reader &reader, bool &var) {
+  if (reader.next() != Reader::Event::boolean)
+    reader.error("expected boolean");
+  var = reader.boolean();
+}
+
+void read_value(Reader &reader, std::string &var) {
+  if (reader.next() != Reader::Event::string)
+    reader.error("expected string");
+  var = reader.str();
+}
+
+void read_value(Reader &reader, json_t &var) {
+  var = reader.value();
+}
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic<T>::value> read_value(Reader &reader, T &var) {
+  if (reader.next() != Reader::Event::number)
+    reader.error("expected number");
+  const auto &str = reader.str();
+  if (std::is_integral<T>::value && reader.integer()) {
+    if (str[0] == '-')
+      var = static_cast<T>(std::strtoll(str.c_str(), nullptr, 10));
+    else
+      var = static_cast<T>(std::strtoull(str.c_str(), nullptr, 10));
+  } else {
+    var = static_cast<T>(reader.number());
+  }
+}
+
+template <typename T>
+void read_value(Reader &reader, std::complex<T> &var) {
+  // A complex number is a real number or a pair [real, imag]
+  if (reader.peek() == Reader::Event::number) {
+    T re;
+    read_value(reader, re);
+    var = std::complex<T>(re);
+    return;
+  }
+  if (reader.peek() != Reader::Event::begin_array)
+    reader.error("invalid complex number");
+  reader.next();
+  T re, im;
+  if (!reader.next_element())
+    reader.error("invalid complex number");
+  read_value(reader, re);
+  if (!reader.next_element())
+    reader.error("invalid complex number");
+  read_value(reader, im);
+  if (reader.next_element())
+    reader.error("invalid complex number");
+  var = std::complex<T>(re, im);
+}
+
+template <typename T>
+void read_value(Reader &reader, std::vector<T> &var) {
+  reader.begin_array();
+  var.clear();
+  while (reader.next_element()) {
+    var.emplace_back();
+    read_value(reader, var.back());
+  }
+}
+
+template <typename T>
+void read_value(Reader &reader, matrix<T> &var) {
+  // Read the rows into a row-major buffer since the number of rows is only
+  // known at the end
+  if (reader.peek() != Reader::Event::begin_array)
+    reader.error("invalid matrix (not array)");
+  reader.next();
+  std::vector<T> data;
+  size_t nrows = 0;
+  size_t ncols = 0;
+  while (reader.next_element()) {
+    if (reader.peek() != Reader::Event::begin_array)
+      reader.error("invalid matrix (rows different sizes)");
+    reader.next();
+    size_t cols = 0;
+    while (reader.next_element()) {
+      data.emplace_back();
+      read_value(reader, data.back());
+      cols++;
+    }
+    if (nrows == 0)
+      ncols = cols;
+    else if (cols != ncols)
+      reader.error("invalid matrix (rows different sizes)");
+    nrows++;
+  }
+  if (nrows == 0)
+    reader.error("invalid matrix (empty array)");
+  var = matrix<T>(nrows, ncols);
+  for (size_t r = 0; r < nrows; r++)
+    for (size_t c = 0; c < ncols; c++)
+      var(r, c) = data[ncols * r + c];
+}
+
+template <typename T>
+std::enable_if_t<!std::is_arithmetic<T>::value> read_value(Reader &reader, T &var) {
+  var = reader.value().get<T>();
+}
+
+//------------------------------------------------------------------------------
+} // end namespace JSON
+//------------------------------------------------------------------------------
+#endif
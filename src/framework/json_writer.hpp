@@ -0,0 +1,498 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_framework_json_writer_hpp_
+#define _aer_framework_json_writer_hpp_
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "framework/json.hpp"
+
+namespace JSON {
+
+//============================================================================
+// Streaming JSON writer
+//============================================================================
+
+// A writer that serializes a JSON text as it is produced, without building a
+// document. The text is identical to `json_t::dump` of the equivalent
+// document: floating point numbers use the same shortest round-trip
+// formatting, and pretty printing uses the same layout, with objects
+// indented and arrays on a single line.
+//
+// Small values are written from a json_t with `value` or `object`. Complex
+// vectors and matrices are formatted directly from their typed data, with
+// large arrays formatted in parallel blocks.
+//
+// Example: write {"counts": {...}, "statevector": [[re, im], ...]}
+//
+//   Writer writer(stream, 4);
+//   writer.begin_object();
+//   writer.key("counts");
+//   writer.value(counts);
+//   writer.key("statevector");
+//   writer.complex_vector(data, size, 1e-10);
+//   writer.end_object();
+
+class Writer {
+public:
+
+  using Members = std::map<std::string, std::function<void(Writer&)>>;
+
+  // Write a JSON text to the end of a string. If indent is non-negative the
+  // text is pretty printed with that indent, otherwise it is compact.
+  explicit Writer(std::string &out, int indent = -1);
+
+  // Write a JSON text to an output stream in blocks of block_size characters
+  explicit Writer(std::ostream &out, int indent = -1,
+                  size_t block_size = 1ULL << 20);
+
+  // Write any remaining buffered text to the output stream
+  ~Writer() {flush();}
+
+  Writer(const Writer &) = delete;
+  Writer &operator=(const Writer &) = delete;
+
+  // Set the number of threads used for formatting large arrays
+  void set_omp_threads(int threads);
+
+  //-----------------------------------------------------------------------
+  // Structure
+  //-----------------------------------------------------------------------
+
+  // Begin and end an object or array
+  void begin_object();
+  void end_object();
+  void begin_array();
+  void end_array();
+
+  // Write the key of the next member of the current object
+  void key(const std::string &key);
+
+  //-----------------------------------------------------------------------
+  // Values
+  //-----------------------------------------------------------------------
+
+  // Write a value from a json_t
+  void value(const json_t &js);
+
+  // Write an object with the members of js and the members written by the
+  // functions in members, in key order. A member written by a function
+  // replaces the member of js with the same key.
+  void object(const json_t &js, const Members &members);
+
+  // Write a complex vector as a list of [real, imag] pairs. Real and
+  // imaginary parts with absolute value not above a positive chop_threshold
+  // are written as 0.
+  template <typename T>
+  void complex_vector(const std::complex<T> *data, size_t size,
+                      double chop_threshold = 0);
+
+  // Write a complex matrix stored in column-major order as a list of rows.
+  // An empty matrix is written as null.
+  template <typename T>
+  void complex_matrix(const std::complex<T> *data, size_t rows, size_t cols,
+                      double chop_threshold = 0);
+
+  // Write the buffered text to the output stream
+  void flush();
+
+protected:
+
+  struct Container {
+    bool object;
+    bool empty;
+  };
+
+  // Write the separator before the next value of an array
+  void separator();
+
+  // Write a list of size elements, formatted by element(out, j) into a
+  // string. cost is the number of complex values in an element.
+  template <typename Lambda>
+  void list(size_t size, size_t cost, Lambda &&element);
+
+  // Append a number formatted as by json_t::dump
+  static void append_number(std::string &out, double x);
+
+  // Append a complex number as a [real, imag] pair
+  template <typename T>
+  void append_complex(std::string &out, std::complex<T> z,
+                      double chop) const;
+
+  std::string buffer_;
+  std::string &out_;
+  std::ostream *stream_ = nullptr;
+  size_t block_size_ = 0;
+
+  bool pretty_;
+  unsigned int indent_;
+  std::vector<Container> stack_;
+  unsigned int level_ = 0;  // number of open objects
+  std::string comma_;       // array element separator
+
+  int omp_threads_ = 1;
+  // Number of complex values above which arrays are formatted in parallel
+  const size_t omp_threshold_ = 1ULL << 14;
+};
+
+
+//============================================================================
+// Complex array output data
+//============================================================================
+
+// A complex vector or matrix kept in its typed form until it is serialized,
+// either as a json_t or directly by a Writer. Matrices are stored in
+// column-major order and serialized as a list of rows. Real and imaginary
+// parts with absolute value not above a positive chop threshold are
+// serialized as 0.
+
+class ComplexArray {
+public:
+  ComplexArray() = default;
+
+  // Copy a complex vector
+  template <typename T>
+  ComplexArray(const std::complex<T> *data, size_t size,
+               double chop_threshold);
+
+  // Copy a complex matrix stored in column-major order
+  template <typename T>
+  ComplexArray(const std::complex<T> *data, size_t rows, size_t cols,
+               double chop_threshold);
+
+  // Return the array as a json_t
+  json_t json() const;
+
+  // Write the array
+  void write(Writer &writer) const;
+
+protected:
+  std::vector<std::complex<double>> data_;
+  size_t rows_ = 0;
+  size_t cols_ = 0;
+  bool matrix_ = false;
+  double chop_threshold_ = 0;
+};
+
+inline void to_json(json_t &js, const ComplexArray &arr) {
+  js = arr.json();
+}
+
+
+//============================================================================
+// Implementation: Writer
+//============================================================================
+
+Writer::Writer(std::string &out, int indent)
+  : out_(out), pretty_(indent >= 0),
+    indent_(indent >= 0 ? static_cast<unsigned int>(indent) : 0),
+    comma_(pretty_ ? ", " : ",") {}
+
+
+Writer::Writer(std::ostream &out, int indent, size_t block_size)
+  : out_(buffer_), stream_(&out), block_size_(block_size),
+    pretty_(indent >= 0),
+    indent_(indent >= 0 ? static_cast<unsigned int>(indent) : 0),
+    comma_(pretty_ ? ", " : ",") {
+  buffer_.reserve(block_size_);
+}
+
+
+void Writer::set_omp_threads(int threads) {
+  if (threads > 0)
+    omp_threads_ = threads;
+}
+
+
+void Writer::flush() {
+  if (stream_ != nullptr && !out_.empty()) {
+    stream_->write(out_.data(), out_.size());
+    out_.clear();
+  }
+}
+
+
+void Writer::separator() {
+  if (stack_.empty() || stack_.back().object)
+    return;
+  if (!stack_.back().empty)
+    out_.append(comma_);
+  stack_.back().empty = false;
+}
+
+
+void Writer::begin_object() {
+  separator();
+  out_.push_back('{');
+  stack_.push_back({true, true});
+  level_++;
+}
+
+
+void Writer::begin_array() {
+  separator();
+  out_.push_back('[');
+  stack_.push_back({false, true});
+}
+
+
+void Writer::end_object() {
+  if (stack_.empty() || !stack_.back().object)
+    throw std::logic_error("JSON::Writer: end_object outside of an object.");
+  const bool empty = stack_.back().empty;
+  stack_.pop_back();
+  level_--;
+  if (!empty && pretty_) {
+    out_.push_back('\n');
+    out_.append(level_ * indent_, ' ');
+  }
+  out_.push_back('}');
+  if (stream_ != nullptr && out_.size() >= block_size_)
+    flush();
+}
+
+
+void Writer::end_array() {
+  if (stack_.empty() || stack_.back().object)
+    throw std::logic_error("JSON::Writer: end_array outside of an array.");
+  stack_.pop_back();
+  out_.push_back(']');
+  if (stream_ != nullptr && out_.size() >= block_size_)
+    flush();
+}
+
+
+void Writer::key(const std::string &key) {
+  if (stack_.empty() || !stack_.back().object)
+    throw std::logic_error("JSON::Writer: key outside of an object.");
+  if (!stack_.back().empty)
+    out_.push_back(',');
+  stack_.back().empty = false;
+  if (pretty_) {
+    out_.push_back('\n');
+    out_.append(level_ * indent_, ' ');
+  }
+  // Escape the key as json_t::dump does
+  nlohmann::detail::serializer<json_t> serializer(
+    nlohmann::detail::output_adapter<char>(out_), ' ');
+  serializer.dump(json_t(key), false, false, 0);
+  out_.push_back(':');
+  if (pretty_)
+    out_.push_back(' ');
+}
+
+
+void Writer::value(const json_t &js) {
+  separator();
+  nlohmann::detail::serializer<json_t> serializer(
+    nlohmann::detail::output_adapter<char>(out_), ' ');
+  serializer.dump(js, pretty_, false, indent_, indent_ * level_);
+  if (stream_ != nullptr && out_.size() >= block_size_)
+    flush();
+}
+
+
+void Writer::object(const json_t &js, const Members &members) {
+  if (!js.is_null() && !js.is_object())
+    throw std::invalid_argument("JSON::Writer: value is not an object.");
+  begin_object();
+  // Both are sorted by key, so merge them in key order
+  auto it = js.is_object() ? js.begin() : js.end();
+  auto member = members.begin();
+  while (it != js.end() || member != members.end()) {
+    if (member == members.end() ||
+        (it != js.end() && it.key() < member->first)) {
+      key(it.key());
+      value(it.value());
+      ++it;
+    } else {
+      if (it != js.end() && it.key() == member->first)
+        ++it;
+      key(member->first);
+      member->second(*this);
+      ++member;
+    }
+  }
+  end_object();
+}
+
+
+void Writer::append_number(std::string &out, double x) {
+  if (!std::isfinite(x)) {
+    out.append("null", 4);
+    return;
+  }
+  char buffer[64];
+  const char *end = nlohmann::detail::to_chars(buffer, buffer + 64, x);
+  out.append(buffer, static_cast<size_t>(end - buffer));
+}
+
+
+template <typename T>
+void Writer::append_complex(std::string &out, std::complex<T> z,
+                            double chop) const {
+  double re = z.real();
+  double im = z.imag();
+  if (chop > 0) {
+    if (std::abs(re) <= chop)
+      re = 0.;
+    if (std::abs(im) <= chop)
+      im = 0.;
+  }
+  out.push_back('[');
+  append_number(out, re);
+  out.append(comma_);
+  append_number(out, im);
+  out.push_back(']');
+}
+
+
+template <typename Lambda>
+void Writer::list(size_t size, size_t cost, Lambda &&element) {
+  begin_array();
+  if (size == 0) {
+    end_array();
+    return;
+  }
+  stack_.back().empty = false;
+  cost = std::max<size_t>(cost, 1);
+
+  // Format blocks of elements in parallel, each thread into its own string,
+  // and append them in order
+  const size_t threads = (size * cost > omp_threshold_ && omp_threads_ > 1)
+                       ? static_cast<size_t>(omp_threads_) : 1;
+  const size_t block = std::max<size_t>(threads * omp_threshold_ / cost, 1);
+  std::vector<std::string> parts(threads);
+
+  for (size_t start = 0; start < size; start += block) {
+    const size_t stop = std::min(start + block, size);
+    const size_t chunk = (stop - start + threads - 1) / threads;
+    const int64_t END = threads;
+    #pragma omp parallel for if (threads > 1) num_threads(threads)
+    for (int64_t t = 0; t < END; t++) {
+      auto &part = parts[t];
+      part.clear();
+      const size_t first = start + t * chunk;
+      const size_t last = std::min(first + chunk, stop);
+      for (size_t j = first; j < last; j++) {
+        if (j > 0)
+          part.append(comma_);
+        element(part, j);
+      }
+    }
+    for (const auto &part : parts)
+      out_.append(part);
+    if (stream_ != nullptr && out_.size() >= block_size_)
+      flush();
+  }
+  end_array();
+}
+
+
+template <typename T>
+void Writer::complex_vector(const std::complex<T> *data, size_t size,
+                            double chop_threshold) {
+  list(size, 1, [&](std::string &out, size_t j) {
+    append_complex(out, data[j], chop_threshold);
+  });
+}
+
+
+template <typename T>
+void Writer::complex_matrix(const std::complex<T> *data, size_t rows,
+                            size_t cols, double chop_threshold) {
+  if (rows == 0 || cols == 0) {
+    value(json_t());
+    return;
+  }
+  list(rows, cols, [&](std::string &out, size_t i) {
+    out.push_back('[');
+    for (size_t j = 0; j < cols; j++) {
+      if (j > 0)
+        out.append(comma_);
+      append_complex(out, data[i + rows * j], chop_threshold);
+    }
+    out.push_back(']');
+  });
+}
+
+
+//============================================================================
+// Implementation: ComplexArray
+//============================================================================
+
+template <typename T>
+ComplexArray::ComplexArray(const std::complex<T> *data, size_t size,
+                           double chop_threshold)
+  : data_(data, data + size), rows_(size), cols_(1),
+    chop_threshold_(chop_threshold) {}
+
+
+template <typename T>
+ComplexArray::ComplexArray(const std::complex<T> *data, size_t rows,
+                           size_t cols, double chop_threshold)
+  : data_(data, data + rows * cols), rows_(rows), cols_(cols),
+    matrix_(true), chop_threshold_(chop_threshold) {}
+
+
+json_t ComplexArray::json() const {
+  const auto chop = [this](std::complex<double> z) {
+    if (chop_threshold_ > 0) {
+      if (std::abs(z.real()) <= chop_threshold_)
+        z.real(0.);
+      if (std::abs(z.imag()) <= chop_threshold_)
+        z.imag(0.);
+    }
+    return json_t(z);
+  };
+  if (!matrix_) {
+    json_t js = json_t::array();
+    for (const auto &z : data_)
+      js.push_back(chop(z));
+    return js;
+  }
+  if (rows_ == 0 || cols_ == 0)
+    return json_t();
+  json_t js = json_t::array();
+  for (size_t i = 0; i < rows_; i++) {
+    json_t row = json_t::array();
+    for (size_t j = 0; j < cols_; j++)
+      row.push_back(chop(data_[i + rows_ * j]));
+    js.push_back(std::move(row));
+  }
+  return js;
+}
+
+
+void ComplexArray::write(Writer &writer) const {
+  if (matrix_)
+    writer.complex_matrix(data_.data(), rows_, cols_, chop_threshold_);
+  else
+    writer.complex_vector(data_.data(), data_.size(), chop_threshold_);
+}
+
+//------------------------------------------------------------------------------
+} // end namespace JSON
+//------------------------------------------------------------------------------
+#endif
@@ -23,6 +23,7 @@
 
 #include "framework/types.hpp"
 #include "framework/json.hpp"
+#include "framework/json_reader.hpp"
 #include "framework/utils.hpp"
 
 namespace AER {
@@ -36,9 +37,13 @@ enum class RegComparison {Equal, NotEqual, Less, LessEqual, Greater, GreaterEqua
 // Enum class for operation types
 enum class OpType {
   gate, measure, reset, bfunc, barrier, snapshot,
-  matrix, multiplexer, kraus, superop, roerror, noise_switch, initialize
+  matrix, multiplexer, kraus, superop, roerror, noise_switch, initialize,
+  pauli_rotation, clifford
 };
 
+// Enum class for the structure of the matrix of matrix operations
+enum class MatrixStructure {dense, diagonal, monomial, controlled};
+
 inline std::ostream& operator<<(std::ostream& stream, const OpType& type) {
   switch (type) {
   case OpType::gate:
@@ -80,6 +85,12 @@ inline std::ostream& operator<<(std::ostream& stream, const OpType& type) {
   case OpType::initialize:
     stream << "initialize";
     break;
+  case OpType::pauli_rotation:
+    stream << "pauli_rotation";
+    break;
+  case OpType::clifford:
+    stream << "clifford";
+    break;
   default:
     stream << "unknown";
   }
@@ -117,8 +128,22 @@ struct Op {
   // Mat and Kraus
   std::vector<cmatrix_t> mats;
 
+  // Matrix structure (matrix ops), set by set_matrix_structure
+  MatrixStructure mat_structure = MatrixStructure::dense;
+  reg_t mat_rows;        // (opt) row of the non-zero entry of each column (monomial)
+  reg_t mat_controls;    // (opt) positions of the control qubits in qubits (controlled)
+  cvector_t mat_entries; // (opt) diagonal (diagonal), non-zero entry of each
+                         // column (monomial), or vectorized matrix on the
+                         // target qubits (controlled)
+
+  // Clifford (clifford ops), set by make_clifford
+  reg_t clifford_images; // image of each Pauli P(x, z) on the qubits indexed by
+                         // x + 2^N z, packed as x + 2^N z' + 4^N sign
+
   // Readout error
   std::vector<rvector_t> probs;
+  std::vector<reg_t> roerror_factors; // (opt) positions of the assigned and
+                                      // control bits of each factor
 
   // Snapshots
   using pauli_component_t = std::pair<complex_t, std::string>; // Pair (coeff, label_string)
@@ -389,6 +414,99 @@ inline void check_duplicate_qubits(const Op &op) {
                                 R"(" instruction ("qubits" are not unique).)");
 }
 
+//------------------------------------------------------------------------------
+// Matrix structure
+//------------------------------------------------------------------------------
+
+// Detect the structure of the matrix of a matrix op, ignoring entries below
+// the threshold, so that simulators can apply it with a diagonal, monomial
+// (permutation with phases) or controlled kernel instead of a dense one.
+// A matrix is controlled on the qubits for which all columns with the qubit
+// in the |0> state are those of the identity.
+inline void set_matrix_structure(Op &op, double threshold = 1e-12) {
+  op.mat_structure = MatrixStructure::dense;
+  op.mat_rows.clear();
+  op.mat_controls.clear();
+  op.mat_entries.clear();
+  const size_t N = op.qubits.size();
+  if (op.mats.empty() || op.mats[0].GetRows() != 1ULL << N ||
+      op.mats[0].GetColumns() != 1ULL << N)
+    return;
+  const cmatrix_t &mat = op.mats[0];
+  const size_t dim = 1ULL << N;
+
+  // Monomial and diagonal matrices have one non-zero entry in each column
+  reg_t rows(dim);
+  bool monomial = true;
+  for (size_t j = 0; j < dim && monomial; ++j) {
+    size_t count = 0;
+    for (size_t i = 0; i < dim; ++i) {
+      if (std::abs(mat(i, j)) > threshold) {
+        rows[j] = i;
+        ++count;
+      }
+    }
+    monomial = (count == 1);
+  }
+  if (monomial) {
+    bool diagonal = true;
+    for (size_t j = 0; j < dim; ++j) {
+      op.mat_entries.push_back(mat(rows[j], j));
+      diagonal &= (rows[j] == j);
+    }
+    if (diagonal) {
+      op.mat_structure = MatrixStructure::diagonal;
+    } else {
+      op.mat_structure = MatrixStructure::monomial;
+      op.mat_rows = std::move(rows);
+    }
+    return;
+  }
+
+  // Controlled matrices
+  uint_t ctrl_mask = 0;
+  for (size_t pos = 0; pos < N; ++pos) {
+    bool control = true;
+    for (size_t j = 0; j < dim && control; ++j) {
+      if ((j >> pos) & 1)
+        continue;
+      for (size_t i = 0; i < dim && control; ++i)
+        control = std::abs(mat(i, j) - ((i == j) ? 1. : 0.)) <= threshold;
+    }
+    if (control) {
+      op.mat_controls.push_back(pos);
+      ctrl_mask |= 1ULL << pos;
+    }
+  }
+  if (op.mat_controls.empty())
+    return;
+  // Indexes of the matrix with all controls in the |1> state
+  reg_t inds;
+  for (size_t i = 0; i < dim; ++i) {
+    if ((i & ctrl_mask) == ctrl_mask)
+      inds.push_back(i);
+  }
+  for (const auto j : inds)
+    for (const auto i : inds)
+      op.mat_entries.push_back(mat(i, j));
+  op.mat_structure = MatrixStructure::controlled;
+}
+
+// Return the control and target qubits of a controlled matrix op
+inline void matrix_control_qubits(const Op &op, reg_t &controls, reg_t &targets) {
+  controls.clear();
+  targets.clear();
+  size_t pos = 0;
+  for (size_t j = 0; j < op.qubits.size(); ++j) {
+    if (pos < op.mat_controls.size() && op.mat_controls[pos] == j) {
+      controls.push_back(op.qubits[j]);
+      ++pos;
+    } else {
+      targets.push_back(op.qubits[j]);
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 // Generator functions
 //------------------------------------------------------------------------------
@@ -401,6 +519,7 @@ inline Op make_unitary(const reg_t &qubits, const cmatrix_t &mat, std::string la
   op.mats = {mat};
   if (label != "")
     op.string_params = {label};
+  set_matrix_structure(op);
   return op;
 }
 
@@ -421,6 +540,7 @@ inline Op make_fusion(const reg_t &qubits, const cmatrix_t &mat, const std::vect
   op.mats = {mat};
   if (label != "")
     op.string_params = {label};
+  set_matrix_structure(op);
 
   return op;
 }
@@ -516,6 +636,204 @@ inline Op make_multiplexer(const reg_t &qubits,
   return op;
 }
 
+// Pauli rotation phase * exp(-i theta/2 P) where the Pauli label P is stored
+// in string_params. As for Pauli snapshots the label is little-endian: its
+// last character acts on qubits[0].
+inline Op make_pauli_rotation(const reg_t &qubits, const std::string &pauli,
+                              double theta, complex_t phase = 1.) {
+  Op op;
+  op.type = OpType::pauli_rotation;
+  op.name = "pauli_rotation";
+  op.qubits = qubits;
+  op.params = {theta};
+  if (phase != 1.)
+    op.params.push_back(phase);
+  op.string_params = {pauli};
+  return op;
+}
+
+// Maximum number of qubits of a clifford instruction. Its image table has
+// 4^N entries, packed in N-bit fields of a uint_t.
+const uint_t max_clifford_qubits = 10;
+
+// Return the images under a Clifford gate on N qubits of all Paulis
+// P(x, z) = prod_j i^(x_j z_j) X_j^x_j Z_j^z_j on the qubits, indexed by
+// x + 2^N z. The image is the product of the images of X_j and Z_j in this
+// order, given by the signed labels of the destabilizers and stabilizers,
+// and is packed as x' + 2^N z' + 4^N for a negative sign.
+inline reg_t clifford_images(const std::vector<std::string> &labels) {
+  const uint_t N = labels.size() / 2;
+  const uint_t DIM = 1ULL << (2 * N);
+
+  // Images of X_j (row j) and Z_j (row N + j) as bit masks on the qubits
+  reg_t row_x(2 * N, 0), row_z(2 * N, 0), row_sign(2 * N, 0);
+  for (uint_t row = 0; row < 2 * N; row++) {
+    const std::string &label = labels[row];
+    const uint_t offset = (!label.empty() && label[0] == '-') ? 1 : 0;
+    row_sign[row] = offset;
+    for (uint_t q = 0; q < N; q++) {
+      const char pauli = label[offset + q];
+      row_x[row] |= uint_t(pauli == 'X' || pauli == 'Y') << q;
+      row_z[row] |= uint_t(pauli == 'Z' || pauli == 'Y') << q;
+    }
+  }
+  const auto count_ones = [](uint_t v) {
+    int ones = 0;
+    for (; v; v &= v - 1)
+      ++ones;
+    return ones;
+  };
+
+  reg_t images(DIM, 0);
+  for (uint_t k = 0; k < DIM; k++) {
+    const uint_t kx = k & ((1ULL << N) - 1), kz = k >> N;
+    uint_t x = 0, z = 0;
+    int exponent = count_ones(kx & kz);
+    for (uint_t j = 0; j < N; j++) {
+      for (const uint_t row : {j, N + j}) {
+        if (!(((row < N) ? kx : kz) >> j & 1))
+          continue;
+        const uint_t px = row_x[row], pz = row_z[row];
+        // exponent of i in P(x, z) P(px, pz) = i^g P(x + px, z + pz)
+        exponent += count_ones(px & z) + 2 * count_ones(px & z & pz)
+                    + 2 * count_ones(px & z & x);
+        exponent -= count_ones(x & pz) + 2 * count_ones(x & pz & z)
+                    + 2 * count_ones(x & pz & px);
+        exponent += 2 * row_sign[row];
+        x ^= px;
+        z ^= pz;
+      }
+    }
+    const uint_t sign = (((exponent % 4) + 4) % 4 == 2);
+    images[k] = x | (z << N) | (sign << (2 * N));
+  }
+  return images;
+}
+
+// Clifford gate given by its tableau: the images of X and Z on each of its
+// qubits under conjugation, as destabilizer and stabilizer labels in the
+// format of stabilizer snapshots, where character j acts on qubits[j] and a
+// leading '-' is a negative sign. The labels are stored in string_params,
+// destabilizers first.
+inline Op make_clifford(const reg_t &qubits,
+                        const std::vector<std::string> &destabilizers,
+                        const std::vector<std::string> &stabilizers) {
+  Op op;
+  op.type = OpType::clifford;
+  op.name = "clifford";
+  op.qubits = qubits;
+  op.string_params = destabilizers;
+  op.string_params.insert(op.string_params.end(), stabilizers.begin(),
+                          stabilizers.end());
+  op.clifford_images = clifford_images(op.string_params);
+  return op;
+}
+
+// Return true if the labels are the tableau of a Clifford gate: each is a
+// signed Pauli on all qubits, and each destabilizer anticommutes with the
+// stabilizer on the same qubit and commutes with all other rows.
+inline bool is_clifford_tableau(const std::vector<std::string> &destabilizers,
+                                const std::vector<std::string> &stabilizers) {
+  const size_t num_qubits = destabilizers.size();
+  if (stabilizers.size() != num_qubits)
+    return false;
+  // Symplectic bits of the rows
+  std::vector<std::vector<bool>> xs, zs;
+  for (const auto labels : {&destabilizers, &stabilizers}) {
+    for (const auto &label : *labels) {
+      const std::string pauli = (!label.empty() && label[0] == '-') ? label.substr(1) : label;
+      if (pauli.size() != num_qubits || pauli.find_first_not_of("IXYZ") != std::string::npos)
+        return false;
+      std::vector<bool> x(num_qubits), z(num_qubits);
+      for (size_t q = 0; q < num_qubits; ++q) {
+        x[q] = (pauli[q] == 'X' || pauli[q] == 'Y');
+        z[q] = (pauli[q] == 'Z' || pauli[q] == 'Y');
+      }
+      xs.push_back(x);
+      zs.push_back(z);
+    }
+  }
+  for (size_t i = 0; i < 2 * num_qubits; ++i)
+    for (size_t j = i + 1; j < 2 * num_qubits; ++j) {
+      bool anticommute = false;
+      for (size_t q = 0; q < num_qubits; ++q)
+        anticommute ^= (xs[i][q] && zs[j][q]) ^ (zs[i][q] && xs[j][q]);
+      if (anticommute != (j == i + num_qubits))
+        return false;
+    }
+  return true;
+}
+
+// Compute the tableau of a unitary matrix in the format of make_clifford.
+// Return false if the matrix does not map each Pauli X and Z on one qubit
+// to a signed Pauli under conjugation, that is if it is not a Clifford.
+inline bool clifford_tableau(const cmatrix_t &mat,
+                             std::vector<std::string> &destabilizers,
+                             std::vector<std::string> &stabilizers,
+                             double threshold = 1e-7) {
+  const uint_t dim = mat.GetRows();
+  uint_t num_qubits = 0;
+  while ((1ULL << num_qubits) < dim)
+    ++num_qubits;
+  if (mat.GetColumns() != dim || (1ULL << num_qubits) != dim)
+    return false;
+  destabilizers.clear();
+  stabilizers.clear();
+  const complex_t i(0., 1.);
+  const auto count_ones = [](uint_t v) {
+    uint_t ones = 0;
+    for (; v; v &= v - 1)
+      ++ones;
+    return ones;
+  };
+
+  for (uint_t row = 0; row < 2 * num_qubits; ++row) {
+    const uint_t qubit = row % num_qubits;
+    const uint_t bit = 1ULL << qubit;
+    const bool z_image = (row >= num_qubits);
+    // Image M = U P U^dagger of P = X or Z on the qubit
+    cmatrix_t image(dim, dim);
+    for (uint_t r = 0; r < dim; ++r)
+      for (uint_t c = 0; c < dim; ++c) {
+        complex_t val = 0.;
+        for (uint_t b = 0; b < dim; ++b)
+          val += z_image ? ((b & bit) ? -1. : 1.) * mat(r, b) * std::conj(mat(c, b))
+                         : mat(r, b ^ bit) * std::conj(mat(c, b));
+        image(r, c) = val;
+      }
+    // Find M = c X^x Z^z from its columns, where X^x Z^z |b> = (-1)^(z.b) |b + x>
+    uint_t x = 0;
+    while (x < dim && std::abs(image(x, 0)) < 0.5)
+      ++x;
+    if (x == dim)
+      return false;
+    const complex_t coeff = image(x, 0);
+    uint_t z = 0;
+    for (uint_t q = 0; q < num_qubits; ++q)
+      if (std::real(image(x ^ (1ULL << q), 1ULL << q) / coeff) < 0.)
+        z |= 1ULL << q;
+    for (uint_t c = 0; c < dim; ++c)
+      for (uint_t r = 0; r < dim; ++r) {
+        const complex_t expected = (r == (c ^ x)) ? (count_ones(z & c) % 2 ? -coeff : coeff) : 0.;
+        if (std::abs(image(r, c) - expected) > threshold)
+          return false;
+      }
+    // X^x Z^z = (-i)^w P with w the number of Y factors of the Pauli P
+    complex_t sign = coeff;
+    for (uint_t w = count_ones(x & z); w > 0; --w)
+      sign *= -i;
+    if (std::abs(std::imag(sign)) > threshold || std::abs(std::abs(sign) - 1.) > threshold)
+      return false;
+    std::string label = (std::real(sign) < 0.) ? "-" : "";
+    for (uint_t q = 0; q < num_qubits; ++q) {
+      const bool xq = (x >> q) & 1, zq = (z >> q) & 1;
+      label.push_back(xq ? (zq ? 'Y' : 'X') : (zq ? 'Z' : 'I'));
+    }
+    (z_image ? stabilizers : destabilizers).push_back(label);
+  }
+  return true;
+}
+
 inline Op make_kraus(const reg_t &qubits, const std::vector<cmatrix_t> &mats) {
   Op op;
   op.type = OpType::kraus;
@@ -534,6 +852,17 @@ inline Op make_roerror(const reg_t &memory, const std::vector<rvector_t> &probs)
   return op;
 }
 
+// Factored readout error: factors holds the positions in memory of the
+// assigned and control bits of each factor [qubits0, controls0, qubits1, ...]
+// and probs the assignment probability vectors of all factors in order
+inline Op make_roerror(const reg_t &memory,
+                       const std::vector<reg_t> &factors,
+                       const std::vector<rvector_t> &probs) {
+  Op op = make_roerror(memory, probs);
+  op.roerror_factors = factors;
+  return op;
+}
+
 //------------------------------------------------------------------------------
 // JSON conversion
 //------------------------------------------------------------------------------
@@ -551,6 +880,7 @@ Op json_to_op_measure(const json_t &js);
 Op json_to_op_reset(const json_t &js);
 Op json_to_op_bfunc(const json_t &js);
 Op json_to_op_initialize(const json_t &js);
+Op json_to_op_initialize(const json_t &js, cvector_t &&params);
 
 // Snapshots
 Op json_to_op_snapshot(const json_t &js);
@@ -559,10 +889,17 @@ Op json_to_op_snapshot_matrix(const json_t &js);
 Op json_to_op_snapshot_pauli(const json_t &js);
 
 // Matrices
+// The overloads with a mats argument use it in place of the "params" field
 Op json_to_op_unitary(const json_t &js);
+Op json_to_op_unitary(const json_t &js, std::vector<cmatrix_t> &&mats);
 Op json_to_op_superop(const json_t &js);
+Op json_to_op_superop(const json_t &js, std::vector<cmatrix_t> &&mats);
 Op json_to_op_multiplexer(const json_t &js);
+Op json_to_op_multiplexer(const json_t &js, std::vector<cmatrix_t> &&mats);
+Op json_to_op_pauli_rotation(const json_t &js);
+Op json_to_op_clifford(const json_t &js);
 Op json_to_op_kraus(const json_t &js);
+Op json_to_op_kraus(const json_t &js, std::vector<cmatrix_t> &&mats);
 Op json_to_op_noise_switch(const json_t &js);
 
 // Classical bits
@@ -572,6 +909,14 @@ Op json_to_op_roerror(const json_t &js);
 enum class Allowed {Yes, No};
 void add_condtional(const Allowed val, Op& op, const json_t &js);
 
+// Streaming deserialization
+// Read the next instruction object from a streaming JSON reader. If the
+// "name" field comes before the "params" field, the matrices of unitary,
+// superop, kraus and multiplexer instructions and the vector of initialize
+// are read directly without building them as JSON. The other fields are
+// read as JSON and converted as by json_to_op.
+Op read_op(JSON::Reader &reader);
+
 
 //------------------------------------------------------------------------------
 // Implementation: JSON deserialization
@@ -608,6 +953,10 @@ Op json_to_op(const json_t &js) {
     return json_to_op_noise_switch(js);
   if (name == "multiplexer")
     return json_to_op_multiplexer(js);
+  if (name == "pauli_rotation")
+    return json_to_op_pauli_rotation(js);
+  if (name == "clifford")
+    return json_to_op_clifford(js);
   if (name == "kraus")
     return json_to_op_kraus(js);
   if (name == "roerror")
@@ -633,6 +982,13 @@ json_t op_to_json(const Op &op) {
     ret["register"] = op.registers;
   if (!op.mats.empty())
     ret["mats"] = op.mats;
+  if (op.type == OpType::pauli_rotation)
+    ret["pauli"] = op.string_params[0];
+  if (op.type == OpType::clifford) {
+    const auto half = op.string_params.begin() + op.qubits.size();
+    ret["destabilizers"] = std::vector<std::string>(op.string_params.begin(), half);
+    ret["stabilizers"] = std::vector<std::string>(half, op.string_params.end());
+  }
   return ret;
 }
 
@@ -749,11 +1105,17 @@ Op json_to_op_reset(const json_t &js) {
 
 
 Op json_to_op_initialize(const json_t &js) {
+  cvector_t params;
+  JSON::get_value(params, "params", js);
+  return json_to_op_initialize(js, std::move(params));
+}
+
+Op json_to_op_initialize(const json_t &js, cvector_t &&params) {
   Op op;
   op.type = OpType::initialize;
   op.name = "initialize";
   JSON::get_value(op.qubits, "qubits", js);
-  JSON::get_value(op.params, "params", js);
+  op.params = std::move(params);
 
   // Conditional
   add_condtional(Allowed::No, op, js);
@@ -839,11 +1201,17 @@ Op json_to_op_roerror(const json_t &js) {
 //------------------------------------------------------------------------------
 
 Op json_to_op_unitary(const json_t &js) {
+  std::vector<cmatrix_t> mats;
+  JSON::get_value(mats, "params", js);
+  return json_to_op_unitary(js, std::move(mats));
+}
+
+Op json_to_op_unitary(const json_t &js, std::vector<cmatrix_t> &&mats) {
   Op op;
   op.type = OpType::matrix;
   op.name = "unitary";
   JSON::get_value(op.qubits, "qubits", js);
-  JSON::get_value(op.mats, "params", js);
+  op.mats = std::move(mats);
   // Validation
   check_empty_qubits(op);
   check_duplicate_qubits(op);
@@ -859,6 +1227,7 @@ Op json_to_op_unitary(const json_t &js) {
   std::string label;
   JSON::get_value(label, "label", js);
   op.string_params.push_back(label);
+  set_matrix_structure(op);
 
   // Conditional
   add_condtional(Allowed::Yes, op, js);
@@ -866,12 +1235,18 @@ Op json_to_op_unitary(const json_t &js) {
 }
 
 Op json_to_op_superop(const json_t &js) {
+  std::vector<cmatrix_t> mats;
+  JSON::get_value(mats, "params", js);
+  return json_to_op_superop(js, std::move(mats));
+}
+
+Op json_to_op_superop(const json_t &js, std::vector<cmatrix_t> &&mats) {
   // Warning: we don't check superoperator is valid!
   Op op;
   op.type = OpType::superop;
   op.name = "superop";
   JSON::get_value(op.qubits, "qubits", js);
-  JSON::get_value(op.mats, "params", js);
+  op.mats = std::move(mats);
   // Check conditional
   add_condtional(Allowed::Yes, op, js);
   // Validation
@@ -884,12 +1259,16 @@ Op json_to_op_superop(const json_t &js) {
 }
 
 Op json_to_op_multiplexer(const json_t &js) {
+  std::vector<cmatrix_t> mats;
+  JSON::get_value(mats, "params", js);
+  return json_to_op_multiplexer(js, std::move(mats));
+}
+
+Op json_to_op_multiplexer(const json_t &js, std::vector<cmatrix_t> &&mats) {
   // Parse parameters
   reg_t qubits;
-  std::vector<cmatrix_t> mats;
   std::string label;
   JSON::get_value(qubits, "qubits", js);
-  JSON::get_value(mats, "params", js);
   JSON::get_value(label, "label", js);
   // Construct op
   auto op = make_multiplexer(qubits, mats, label);
@@ -898,12 +1277,86 @@ Op json_to_op_multiplexer(const json_t &js) {
   return op;
 }
 
+Op json_to_op_pauli_rotation(const json_t &js) {
+  Op op;
+  op.type = OpType::pauli_rotation;
+  op.name = "pauli_rotation";
+  JSON::get_value(op.qubits, "qubits", js);
+  JSON::get_value(op.params, "params", js);
+  std::string pauli;
+  JSON::get_value(pauli, "pauli", js);
+  op.string_params = {pauli};
+
+  // Validation
+  check_empty_qubits(op);
+  check_duplicate_qubits(op);
+  if (op.params.empty() || op.params.size() > 2) {
+    throw std::invalid_argument("\"pauli_rotation\" params must be an angle and an optional phase.");
+  }
+  if (pauli.size() != op.qubits.size()) {
+    throw std::invalid_argument("\"pauli_rotation\" Pauli label doesn't match qubits.");
+  }
+  if (pauli.find_first_not_of("IXYZ") != std::string::npos) {
+    throw std::invalid_argument("\"pauli_rotation\" Pauli label is invalid.");
+  }
+  // Conditional
+  add_condtional(Allowed::Yes, op, js);
+  return op;
+}
+
+Op json_to_op_clifford(const json_t &js) {
+  reg_t qubits;
+  JSON::get_value(qubits, "qubits", js);
+  if (qubits.size() > max_clifford_qubits) {
+    throw std::invalid_argument("\"clifford\" acts on more than " +
+                                std::to_string(max_clifford_qubits) + " qubits.");
+  }
+  std::vector<std::string> destabilizers, stabilizers;
+  if (JSON::check_key("params", js)) {
+    // Tableau of a Clifford unitary matrix
+    std::vector<cmatrix_t> mats;
+    JSON::get_value(mats, "params", js);
+    if (mats.size() != 1 || mats[0].GetRows() != 1ULL << qubits.size()) {
+      throw std::invalid_argument("\"clifford\" params must be a single matrix on its qubits.");
+    }
+    if (!Utils::is_unitary(mats[0], 1e-7) ||
+        !clifford_tableau(mats[0], destabilizers, stabilizers)) {
+      throw std::invalid_argument("\"clifford\" matrix is not a Clifford unitary.");
+    }
+  } else {
+    JSON::get_value(destabilizers, "destabilizers", js);
+    JSON::get_value(stabilizers, "stabilizers", js);
+    for (const auto labels : {&destabilizers, &stabilizers})
+      for (auto &label : *labels)
+        if (!label.empty() && label[0] == '+')
+          label.erase(0, 1);
+    if (destabilizers.size() != qubits.size() ||
+        !is_clifford_tableau(destabilizers, stabilizers)) {
+      throw std::invalid_argument("\"clifford\" tableau is invalid.");
+    }
+  }
+  auto op = make_clifford(qubits, destabilizers, stabilizers);
+
+  // Validation
+  check_empty_qubits(op);
+  check_duplicate_qubits(op);
+  // Conditional
+  add_condtional(Allowed::Yes, op, js);
+  return op;
+}
+
 Op json_to_op_kraus(const json_t &js) {
+  std::vector<cmatrix_t> mats;
+  JSON::get_value(mats, "params", js);
+  return json_to_op_kraus(js, std::move(mats));
+}
+
+Op json_to_op_kraus(const json_t &js, std::vector<cmatrix_t> &&mats) {
   Op op;
   op.type = OpType::kraus;
   op.name = "kraus";
   JSON::get_value(op.qubits, "qubits", js);
-  JSON::get_value(op.mats, "params", js);
+  op.mats = std::move(mats);
 
   // Validation
   check_empty_qubits(op);
@@ -1050,6 +1503,46 @@ Op json_to_op_snapshot_matrix(const json_t &js) {
   return op;
 }
 
+//------------------------------------------------------------------------------
+// Implementation: Streaming deserialization
+//------------------------------------------------------------------------------
+
+Op read_op(JSON::Reader &reader) {
+  json_t js = json_t::object();
+  std::string name;
+  std::vector<cmatrix_t> mats;
+  cvector_t params;
+  bool streamed = false;
+
+  reader.begin_object();
+  std::string key;
+  while (reader.next_key(key)) {
+    if (key == "params" && (name == "unitary" || name == "superop" ||
+                            name == "kraus" || name == "multiplexer")) {
+      reader.read(mats);
+      streamed = true;
+    } else if (key == "params" && name == "initialize") {
+      reader.read(params);
+      streamed = true;
+    } else {
+      js[key] = reader.value();
+      if (key == "name" && js[key].is_string())
+        name = js[key].get<std::string>();
+    }
+  }
+  if (!streamed)
+    return json_to_op(js);
+  if (name == "initialize")
+    return json_to_op_initialize(js, std::move(params));
+  if (name == "unitary")
+    return json_to_op_unitary(js, std::move(mats));
+  if (name == "superop")
+    return json_to_op_superop(js, std::move(mats));
+  if (name == "kraus")
+    return json_to_op_kraus(js, std::move(mats));
+  return json_to_op_multiplexer(js, std::move(mats));
+}
+
 //------------------------------------------------------------------------------
 } // end namespace Operations
 //------------------------------------------------------------------------------
@@ -17,6 +17,7 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -56,6 +57,21 @@ public:
   void load_qobj_from_json(const json_t &js);
   void load_qobj_from_file(const std::string file);
   inline void load_qobj_from_string(const std::string &input);
+
+  // Load a qobj from a streaming JSON reader without building the qobj as
+  // JSON, reading to the end of the text. Each qobj config field for which
+  // config_reader returns true is read by it and not stored in config. The
+  // fields of config_override replace those of the qobj config.
+  using ConfigReader = std::function<bool(const std::string &key,
+                                          JSON::Reader &reader)>;
+  void load_qobj_from_stream(JSON::Reader &reader,
+                             const ConfigReader &config_reader = nullptr,
+                             const json_t &config_override = json_t());
+
+private:
+
+  // Set fixed seeds for the circuits if the qobj has a seed
+  void set_circuit_seeds();
 };
 
 inline void from_json(const json_t &js, Qobj &qobj) {qobj = Qobj(js);}
@@ -99,17 +115,123 @@ void Qobj::load_qobj_from_json(const json_t &js) {
   }
   // Parse experiments
   const json_t &circs = js["experiments"];
-  uint_t seed_shift = 0;
   for (const auto &circ : circs) {
-    Circuit circuit(circ, config);
-    // override random seed with fixed seed if set
-    // We shift the seed for each successive experiment
-    // So that results aren't correlated between experiments
-    if (seed >= 0) {
-      circuit.set_seed(seed + seed_shift);
-      seed_shift += 2113; // Shift the seed
+    circuits.emplace_back(circ, config);
+  }
+  set_circuit_seeds();
+}
+
+
+void Qobj::load_qobj_from_stream(JSON::Reader &reader,
+                                 const ConfigReader &config_reader,
+                                 const json_t &config_override) {
+  // Experiments are kept until the end of the qobj since the config they
+  // are combined with may come after them
+  struct Experiment {
+    std::vector<Operations::Op> ops;
+    json_t header;
+    json_t config;
+  };
+  std::vector<Experiment> experiments;
+  bool has_id = false;
+  bool has_experiments = false;
+
+  reader.begin_object();
+  std::string key;
+  while (reader.next_key(key)) {
+    if (key == "qobj_id") {
+      reader.read(id);
+      has_id = true;
+    } else if (key == "type") {
+      reader.read(type);
+    } else if (key == "header") {
+      header = reader.value();
+    } else if (key == "config") {
+      if (reader.peek() == JSON::Reader::Event::null) {
+        reader.skip();
+        continue;
+      }
+      config = json_t::object();
+      reader.begin_object();
+      std::string config_key;
+      while (reader.next_key(config_key)) {
+        if (!config_reader || !config_reader(config_key, reader))
+          config[config_key] = reader.value();
+      }
+    } else if (key == "experiments") {
+      has_experiments = true;
+      reader.begin_array();
+      while (reader.next_element()) {
+        Experiment exp;
+        bool has_instructions = false;
+        reader.begin_object();
+        std::string exp_key;
+        while (reader.next_key(exp_key)) {
+          if (exp_key == "instructions") {
+            has_instructions = true;
+            reader.begin_array();
+            while (reader.next_element())
+              exp.ops.push_back(Operations::read_op(reader));
+          } else if (exp_key == "header") {
+            exp.header = reader.value();
+          } else if (exp_key == "config") {
+            exp.config = reader.value();
+          } else {
+            reader.skip();
+          }
+        }
+        if (has_instructions == false) {
+          throw std::invalid_argument("Invalid Qobj experiment: no \"instructions\" field.");
+        }
+        experiments.push_back(std::move(exp));
+      }
+    } else {
+      reader.skip();
     }
-    circuits.push_back(circuit);
+  }
+  reader.end();
+
+  // Validate as in load_qobj_from_json
+  if (has_id == false) {
+    throw std::invalid_argument(R"(Invalid qobj: no "qobj_id" field)");
+  }
+  if (type != "QASM") {
+    throw std::invalid_argument(R"(Invalid qobj: currently only "type" = "QASM" is supported.)");
+  }
+  if (has_experiments == false) {
+    throw std::invalid_argument(R"(Invalid qobj: no "experiments" field.)");
+  }
+  if (config_override.is_object()) {
+    for (auto it = config_override.cbegin(); it != config_override.cend(); ++it)
+      config[it.key()] = it.value();
+  }
+  // Check for fixed seed
+  JSON::get_value(seed, "seed", config); // DEPRECIATED: Remove in 0.3.
+  JSON::get_value(seed, "seed_simulator", config);
+
+  // Build circuits
+  for (auto &exp : experiments) {
+    json_t circ_config = config;
+    if (exp.config.is_object()) {
+      for (auto it = exp.config.cbegin(); it != exp.config.cend(); ++it)
+        circ_config[it.key()] = it.value(); // overwrite qobj config values
+    }
+    circuits.emplace_back(std::move(exp.ops), exp.header, circ_config);
+  }
+  set_circuit_seeds();
+}
+
+
+void Qobj::set_circuit_seeds() {
+  // override random seed with fixed seed if set
+  // We shift the seed for each successive experiment
+  // So that results aren't correlated between experiments
+  if (seed < 0)
+    return;
+  uint_t seed_shift = 0;
+  for (auto &circuit : circuits) {
+    circuit.set_seed(seed + seed_shift);
+    seed_shift += 2113; // Shift the seed
   }
 }
 
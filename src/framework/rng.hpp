@@ -79,6 +79,14 @@ public:
    */
   uint_t rand_int(const std::vector<double> &probs);
 
+  /**
+   * Distribute n trials over the outcomes of a discrete distribution
+   * @param n the number of trials
+   * @param probs the probabilities of the outcomes
+   * @returns the number of trials for each outcome
+   */
+  std::vector<uint_t> rand_multinomial(uint_t n, const std::vector<double> &probs);
+
   /**
    * Default constructor initialize RNG engine with a random seed
    */
@@ -97,6 +105,16 @@ public:
   // Set a fixed seed for the RNG engine
   void set_seed(uint_t seed) { rng.seed(seed); };
 
+  /**
+   * Derive the seed of the n-th of a family of independent streams from a
+   * base seed, eg. for the rng of each shot of a circuit. Consecutive base
+   * seeds and indices are mixed so that their streams do not overlap.
+   * @param seed the base seed
+   * @param n the index of the stream
+   * @return the seed of stream n
+   */
+  static uint_t derive_seed(uint_t seed, uint_t n);
+
 private:
   std::mt19937 rng; // Mersenne twister rng engine
 };
@@ -107,6 +125,14 @@ private:
  *
  ******************************************************************************/
 
+uint_t RngEngine::derive_seed(uint_t seed, uint_t n) {
+  // SplitMix64 finalizer of the n-th step from the base seed
+  uint64_t z = static_cast<uint64_t>(seed) + 0x9E3779B97F4A7C15ULL * (static_cast<uint64_t>(n) + 1);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
 double RngEngine::rand(double a, double b) {
   double p = std::uniform_real_distribution<double>(a, b)(rng);
   return p;
@@ -129,6 +155,31 @@ uint_t RngEngine::rand_int(const std::vector<double> &probs) {
   return n;
 }
 
+// multinomial distribution sampled as a sequence of binomial distributions
+std::vector<uint_t> RngEngine::rand_multinomial(uint_t n,
+                                                const std::vector<double> &probs) {
+  std::vector<uint_t> counts(probs.size(), 0);
+  // The remaining trials are assigned to the last possible outcome
+  size_t last = probs.size();
+  while (last > 0 && !(probs[last - 1] > 0))
+    --last;
+  if (last == 0)
+    return counts;
+  double rest = 0.;
+  for (size_t j = 0; j < last; ++j)
+    rest += probs[j];
+  for (size_t j = 0; j + 1 < last && n > 0; ++j) {
+    if (probs[j] > 0) {
+      const double p = (rest > probs[j]) ? probs[j] / rest : 1.;
+      counts[j] = std::binomial_distribution<uint_t>(n, p)(rng);
+      n -= counts[j];
+      rest -= probs[j];
+    }
+  }
+  counts[last - 1] += n;
+  return counts;
+}
+
 //------------------------------------------------------------------------------
 } // End namespace QISKIT
 #endif
@@ -15,6 +15,7 @@
 #ifndef _aer_framework_snapshot_hpp_
 #define _aer_framework_snapshot_hpp_
 
+#include "framework/json_writer.hpp"
 #include "framework/types.hpp"
 
 namespace AER {
@@ -37,27 +38,44 @@ public:
     data_[key].push_back(tmp);
   }
 
+  // Add a new complex vector or matrix datum to the snapshot at the
+  // specified key. It is kept typed until the snapshot is serialized, after
+  // any JSON data at the same key.
+  inline void add_data(const std::string &key, JSON::ComplexArray &&datum) {
+    arrays_[key].push_back(std::move(datum));
+  }
+
   // Combine with another snapshot object clearing each inner map
   // as it is copied, and then clearing the resulting object.
   void combine(SingleShotSnapshot &snapshot);
 
   // Clear all data from current snapshot
-  inline void clear() {data_.clear();}
+  inline void clear() {data_.clear(); arrays_.clear();}
 
   // Clear all snapshot data for a given label
-  inline void erase(const std::string &label) {data_.erase(label);}
+  inline void erase(const std::string &label) {
+    data_.erase(label);
+    arrays_.erase(label);
+  }
 
   // Dump all snapshots to JSON;
   json_t json() const;
 
+  // Write all snapshots without converting complex arrays to JSON
+  void write(JSON::Writer &writer) const;
+
   // Return true if snapshot container is empty
-  inline bool empty() const {return data_.empty();}
+  inline bool empty() const {return data_.empty() && arrays_.empty();}
+
+  // Return true if the snapshot contains complex array data
+  inline bool has_arrays() const {return !arrays_.empty();}
 
 private:
 
   // Internal Storage
   // Map key is the snapshot label string
   stringmap_t<std::vector<json_t>> data_;
+  stringmap_t<std::vector<JSON::ComplexArray>> arrays_;
 };
 
 
@@ -84,7 +102,8 @@ public:
   // Add another datum by adding to accum and incrementing count by 1.
   // If variance is set to true the square of the datum will also be accumulated
   // and can be used to compute the sample variance.
-  void add(json_t &datum, bool variance = false);
+  // If weight is greater than 1 the datum is added as weight equal datum.
+  void add(json_t &datum, bool variance = false, uint_t weight = 1);
 
   // Combine with another AverageData class by combining accum and count members
   // This clears the values of the combined rhs argument
@@ -107,6 +126,9 @@ protected:
   // Recursively divide a json object
   static json_t divide_helper(const json_t &data, double val);
 
+  // Recursively multiply a json object
+  static json_t multiply_helper(const json_t &data, double val);
+
 };
 
 
@@ -126,9 +148,10 @@ public:
   inline void add_data(const std::string &key,
                        const std::string &memory,
                        T &datum,
-                       bool variance = false) {
+                       bool variance = false,
+                       uint_t weight = 1) {
     json_t tmp = datum;
-    data_[key][memory].add(datum, variance);
+    data_[key][memory].add(datum, variance, weight);
   }
 
   // Combine with another snapshot object clearing each inner map
@@ -168,6 +191,13 @@ void SingleShotSnapshot::combine(SingleShotSnapshot &snapshot) {
                             std::make_move_iterator(new_data.end()));
     new_data.clear();
   }
+  for (auto &data : snapshot.arrays_) {
+    auto &slot = arrays_[data.first];
+    auto &new_data = data.second;
+    slot.insert(slot.end(), std::make_move_iterator(new_data.begin()),
+                            std::make_move_iterator(new_data.end()));
+    new_data.clear();
+  }
   snapshot.clear(); // clear added snapshot
 }
 
@@ -177,10 +207,44 @@ json_t SingleShotSnapshot::json() const {
   for (const auto &pair : data_) {
     result[pair.first] = pair.second;
   }
+  for (const auto &pair : arrays_) {
+    auto &slot = result[pair.first];
+    for (const auto &datum : pair.second)
+      slot.push_back(datum.json());
+  }
   return result;
 }
 
 
+void SingleShotSnapshot::write(JSON::Writer &writer) const {
+  if (arrays_.empty()) {
+    writer.value(json());
+    return;
+  }
+  json_t result;
+  for (const auto &pair : data_) {
+    if (arrays_.find(pair.first) == arrays_.end())
+      result[pair.first] = pair.second;
+  }
+  JSON::Writer::Members members;
+  for (const auto &pair : arrays_) {
+    const auto &label = pair.first;
+    members[label] = [this, &label](JSON::Writer &w) {
+      w.begin_array();
+      const auto it = data_.find(label);
+      if (it != data_.end()) {
+        for (const auto &datum : it->second)
+          w.value(datum);
+      }
+      for (const auto &datum : arrays_.at(label))
+        datum.write(w);
+      w.end_array();
+    };
+  }
+  writer.object(result, members);
+}
+
+
 //------------------------------------------------------------------------------
 // Implementation: AverageSnapshot class methods
 //------------------------------------------------------------------------------
@@ -223,11 +287,20 @@ json_t AverageSnapshot::json() const {
 //------------------------------------------------------------------------------
 
 
-void AverageData::add(json_t &datum, bool variance) {
-  count_ += 1;
-  accum_helper(accum_, datum);
+void AverageData::add(json_t &datum, bool variance, uint_t weight) {
+  if (weight == 0)
+    return;
+  count_ += weight;
+  if (weight == 1) {
+    accum_helper(accum_, datum);
+  } else {
+    json_t weighted = multiply_helper(datum, weight);
+    accum_helper(accum_, weighted);
+  }
   if (variance) {
     json_t squared = square_helper(datum);
+    if (weight > 1)
+      squared = multiply_helper(squared, weight);
     accum_helper(accum_squared_, squared);
   }
 }
@@ -296,6 +369,25 @@ json_t AverageData::divide_helper(const json_t &data, double val) {
 }
 
 
+json_t AverageData::multiply_helper(const json_t &data, double val) {
+  json_t mult;
+  if (data.is_number()) {
+    double tmp = data;
+    tmp *= val;
+    mult = tmp;
+  } else if (data.is_array()) {
+    for (size_t pos = 0; pos < data.size(); pos++)
+      mult.push_back(multiply_helper(data[pos], val));
+  } else if (data.is_object()) {
+    for (auto it = data.begin(); it != data.end(); ++it)
+      mult[it.key()] = multiply_helper(it.value(), val);
+  } else {
+    throw std::invalid_argument("Input JSON data cannot be multiplied.");
+  }
+  return mult;
+}
+
+
 void AverageData::accum_helper(json_t &lhs, json_t &rhs, bool subtract) {
   if (lhs.is_null()) {
     lhs = rhs;
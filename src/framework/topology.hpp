@@ -0,0 +1,353 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_framework_topology_hpp_
+#define _aer_framework_topology_hpp_
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace AER {
+namespace Topology {
+
+//============================================================================
+// Machine topology and thread binding
+//============================================================================
+
+// The machine topology is read from the Linux sysfs tree as groups of CPUs
+// sharing a socket, a NUMA node or an L3 cache. Threads are bound to these
+// domains with sched_setaffinity. On other platforms no domains are found
+// and binding does nothing.
+
+// Sorted list of CPU ids
+using cpuset_t = std::vector<int>;
+
+enum class Domain {none, socket, numa, l3};
+
+// Convert between a domain type and its config string:
+// "none", "socket", "numa" or "l3"
+Domain domain_from_string(const std::string &str);
+std::string domain_to_string(Domain domain);
+
+// Parse and format a sysfs CPU list such as "0-3,8,10-11"
+cpuset_t parse_cpulist(const std::string &str);
+std::string format_cpulist(const cpuset_t &cpus);
+
+// Return the first line of a file, or an empty string if it can't be read
+std::string read_line(const std::string &path);
+
+// Return the CPUs of each domain of a given type read from a sysfs root
+// directory, sorted by their first CPU. Domains are restricted to the CPUs in
+// allowed if it is not empty, and domains with no such CPUs are omitted.
+// An empty list is returned if the topology cannot be read.
+std::vector<cpuset_t> read_domains(Domain domain, const cpuset_t &allowed,
+                                   const std::string &sysfs = "/sys/devices/system");
+
+// Return the CPUs the calling thread may run on, or an empty set if thread
+// affinity is not supported
+cpuset_t thread_affinity();
+
+// Restrict the calling thread to a set of CPUs. Return false if this is not
+// supported or fails.
+bool set_thread_affinity(const cpuset_t &cpus);
+
+// Return the CPUs of the domain of worker i of n workers spread evenly over
+// the domains. If there are more workers than domains, consecutive workers
+// share a domain, otherwise some domains have no worker. A worker never
+// spans several domains, so that the threads of its state stay within one.
+cpuset_t worker_cpus(const std::vector<cpuset_t> &domains, int i, int n);
+
+// Return the number of CPUs the calling thread is bound to by a
+// ThreadBinding, or 0 if it is not bound
+int bound_cpus();
+
+//----------------------------------------------------------------------------
+// Thread binding guard
+//----------------------------------------------------------------------------
+
+// Bind the calling thread, and a team of team_threads OpenMP threads started
+// from it, to a set of CPUs. The team is capped at the number of CPUs. The
+// previous affinity of the calling thread is restored for all of them when
+// the binding goes out of scope.
+//
+// Threads of nested parallel regions are either created by the calling
+// thread, and inherit its affinity, or reused from an earlier team of the
+// same size, which is bound here.
+
+class ThreadBinding {
+public:
+  ThreadBinding(const cpuset_t &cpus, int team_threads = 1);
+  ~ThreadBinding();
+
+  ThreadBinding(const ThreadBinding &) = delete;
+  ThreadBinding &operator=(const ThreadBinding &) = delete;
+
+  // Return true if the calling thread was bound
+  bool bound() const {return bound_;}
+
+protected:
+  // Set the affinity of the calling thread and its team
+  void bind(const cpuset_t &cpus) const;
+
+  // Number of CPUs of the binding of the calling thread
+  static int &bound_cpus_();
+
+  cpuset_t previous_;
+  int previous_bound_cpus_ = 0;
+  int team_threads_;
+  bool bound_ = false;
+
+  friend int bound_cpus();
+};
+
+
+//============================================================================
+// Implementations
+//============================================================================
+
+Domain domain_from_string(const std::string &str) {
+  if (str == "none")
+    return Domain::none;
+  if (str == "socket")
+    return Domain::socket;
+  if (str == "numa")
+    return Domain::numa;
+  if (str == "l3")
+    return Domain::l3;
+  throw std::invalid_argument("Topology: invalid domain \"" + str + "\".");
+}
+
+
+std::string domain_to_string(Domain domain) {
+  switch (domain) {
+    case Domain::socket:
+      return "socket";
+    case Domain::numa:
+      return "numa";
+    case Domain::l3:
+      return "l3";
+    default:
+      return "none";
+  }
+}
+
+
+cpuset_t parse_cpulist(const std::string &str) {
+  cpuset_t cpus;
+  std::stringstream ss(str);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    range.erase(std::remove_if(range.begin(), range.end(), ::isspace),
+                range.end());
+    if (range.empty())
+      continue;
+    const auto dash = range.find('-');
+    try {
+      const int first = std::stoi(range.substr(0, dash));
+      const int last = (dash == std::string::npos)
+                     ? first : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last; cpu++)
+        cpus.push_back(cpu);
+    } catch (std::exception &) {
+      throw std::invalid_argument("Topology: invalid CPU list \"" + str + "\".");
+    }
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+
+std::string format_cpulist(const cpuset_t &cpus) {
+  std::string str;
+  for (size_t j = 0; j < cpus.size(); j++) {
+    size_t k = j;
+    while (k + 1 < cpus.size() && cpus[k + 1] == cpus[k] + 1)
+      k++;
+    if (!str.empty())
+      str += ",";
+    str += std::to_string(cpus[j]);
+    if (k > j)
+      str += "-" + std::to_string(cpus[k]);
+    j = k;
+  }
+  return str;
+}
+
+
+std::string read_line(const std::string &path) {
+  std::ifstream file(path);
+  std::string line;
+  if (file)
+    std::getline(file, line);
+  return line;
+}
+
+
+std::vector<cpuset_t> read_domains(Domain domain, const cpuset_t &allowed,
+                                   const std::string &sysfs) {
+  std::vector<cpuset_t> domains;
+  try {
+    if (domain == Domain::numa) {
+      for (int node : parse_cpulist(read_line(sysfs + "/node/online")))
+        domains.push_back(parse_cpulist(read_line(
+          sysfs + "/node/node" + std::to_string(node) + "/cpulist")));
+    } else if (domain == Domain::socket || domain == Domain::l3) {
+      std::map<std::string, cpuset_t> groups;
+      for (int cpu : parse_cpulist(read_line(sysfs + "/cpu/online"))) {
+        const std::string dir = sysfs + "/cpu/cpu" + std::to_string(cpu);
+        if (domain == Domain::socket) {
+          const auto id = read_line(dir + "/topology/physical_package_id");
+          if (!id.empty())
+            groups[id].push_back(cpu);
+          continue;
+        }
+        // Find the cache of level 3 and group CPUs by the CPUs sharing it
+        for (int index = 0; ; index++) {
+          const std::string cache = dir + "/cache/index" + std::to_string(index);
+          const auto level = read_line(cache + "/level");
+          if (level.empty())
+            break;
+          if (level == "3") {
+            const auto shared = read_line(cache + "/shared_cpu_list");
+            if (!shared.empty())
+              groups[format_cpulist(parse_cpulist(shared))].push_back(cpu);
+            break;
+          }
+        }
+      }
+      for (auto &group : groups)
+        domains.push_back(std::move(group.second));
+    }
+  } catch (std::exception &) {
+    return std::vector<cpuset_t>();
+  }
+
+  // Restrict to the allowed CPUs
+  std::vector<cpuset_t> result;
+  for (auto &cpus : domains) {
+    if (!allowed.empty()) {
+      cpuset_t tmp;
+      std::set_intersection(cpus.begin(), cpus.end(),
+                            allowed.begin(), allowed.end(),
+                            std::back_inserter(tmp));
+      cpus = std::move(tmp);
+    }
+    if (!cpus.empty())
+      result.push_back(std::move(cpus));
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+
+cpuset_t thread_affinity() {
+  cpuset_t cpus;
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+      if (CPU_ISSET(cpu, &mask))
+        cpus.push_back(cpu);
+  }
+#endif
+  return cpus;
+}
+
+
+bool set_thread_affinity(const cpuset_t &cpus) {
+#ifdef __linux__
+  if (cpus.empty())
+    return false;
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (int cpu : cpus)
+    if (cpu >= 0 && cpu < CPU_SETSIZE)
+      CPU_SET(cpu, &mask);
+  return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+  return false;
+#endif
+}
+
+
+cpuset_t worker_cpus(const std::vector<cpuset_t> &domains, int i, int n) {
+  const int num_domains = domains.size();
+  if (num_domains < 2 || n < 2 || i < 0 || i >= n)
+    return cpuset_t();
+  return domains[static_cast<size_t>(i) * num_domains / n];
+}
+
+
+int bound_cpus() {
+  return ThreadBinding::bound_cpus_();
+}
+
+
+int &ThreadBinding::bound_cpus_() {
+  static thread_local int cpus = 0;
+  return cpus;
+}
+
+
+ThreadBinding::ThreadBinding(const cpuset_t &cpus, int team_threads)
+  : team_threads_(std::min<int>(team_threads, cpus.size())) {
+  if (cpus.empty())
+    return;
+  previous_ = thread_affinity();
+  if (previous_.empty() || !set_thread_affinity(cpus))
+    return;
+  bound_ = true;
+  previous_bound_cpus_ = bound_cpus_();
+  bound_cpus_() = cpus.size();
+  bind(cpus);
+}
+
+
+ThreadBinding::~ThreadBinding() {
+  if (bound_) {
+    set_thread_affinity(previous_);
+    bind(previous_);
+    bound_cpus_() = previous_bound_cpus_;
+  }
+}
+
+
+void ThreadBinding::bind(const cpuset_t &cpus) const {
+  if (team_threads_ > 1) {
+    #pragma omp parallel num_threads(team_threads_)
+    {
+      set_thread_affinity(cpus);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+} // end namespace Topology
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
+#endif
@@ -311,6 +311,10 @@ bool is_symmetrix(const matrix<T> &mat, double threshold);
 template <class T>
 bool is_cptp_kraus(const std::vector<matrix<T>> &kraus, double threshold);
 
+// Return true if the imaginary parts of all entries are below the threshold
+template <class T>
+bool is_real(const matrix<std::complex<T>> &mat, double threshold);
+
 //------------------------------------------------------------------------------
 // Vector functions
 //------------------------------------------------------------------------------
@@ -319,6 +323,10 @@ bool is_cptp_kraus(const std::vector<matrix<T>> &kraus, double threshold);
 template <typename T>
 double is_unit_vector(const std::vector<T> &vec);
 
+// Return true if the imaginary parts of all entries are below the threshold
+template <typename T>
+bool is_real(const std::vector<std::complex<T>> &vec, double threshold);
+
 // Conjugate a vector
 template <typename T>
 std::vector<std::complex<T>> conjugate(const std::vector<std::complex<T>> &v);
@@ -1183,10 +1191,28 @@ bool is_cptp_kraus(const std::vector<matrix<T>> &mats, double threshold) {
   return is_identity(cptp, threshold);
 }
 
+template <class T>
+bool is_real(const matrix<std::complex<T>> &mat, double threshold) {
+  for (size_t i = 0; i < mat.size(); i++) {
+    if (std::abs(std::imag(mat[i])) > threshold)
+      return false;
+  }
+  return true;
+}
+
 //==============================================================================
 // Implementations: Vector functions
 //==============================================================================
 
+template <typename T>
+bool is_real(const std::vector<std::complex<T>> &vec, double threshold) {
+  for (const auto &val : vec) {
+    if (std::abs(std::imag(val)) > threshold)
+      return false;
+  }
+  return true;
+}
+
 template <class T>
 bool is_unit_vector(const std::vector<T> &vec, double threshold) {
   return (std::abs(norm<T>(vec) - 1.0) < threshold);
@@ -98,6 +98,10 @@ public:
   // Load a noise model from JSON
   void load_from_json(const json_t &js);
 
+  // Load a noise model from a streaming JSON reader. The instructions of
+  // quantum errors are read without building them as JSON.
+  void load_from_stream(JSON::Reader &reader);
+
   // Add a QuantumError to the noise model
   void add_quantum_error(const QuantumError &error,
                          const stringset_t &op_labels,
@@ -170,6 +174,12 @@ private:
   NoiseOps sample_noise_x90_u2(uint_t qubit, complex_t phi, complex_t lambda,
                                RngEngine &rng) const;
 
+  // Add an error from an entry of the "errors" list of a noise model JSON.
+  // If circuits is not null it is used in place of the "instructions" field
+  // of a quantum error.
+  void load_error(const json_t &gate_js,
+                  const std::vector<NoiseOps> *circuits = nullptr);
+
   // Add a local quantum error to the noise model for specific qubits
   void add_local_quantum_error(const QuantumError &error,
                                const stringset_t &op_labels,
@@ -473,6 +483,7 @@ NoiseModel::NoiseOps NoiseModel::sample_noise_helper(const Operations::Op &op,
         const auto mat = op2unitary(first_op);
         if (!mat.empty()) {
           current.mats[0] = current.mats[0] * mat;
+          Operations::set_matrix_structure(current);
           return NoiseOps({current});
         }
       } else if (first_op.type == Operations::OpType::matrix) {
@@ -480,6 +491,7 @@ NoiseModel::NoiseOps NoiseModel::sample_noise_helper(const Operations::Op &op,
         const auto mat = op2unitary(second_op);
         if (!mat.empty()) {
           current.mats[0] = mat * current.mats[0];
+          Operations::set_matrix_structure(current);
           return NoiseOps({current});
         }
       }
@@ -1019,6 +1031,19 @@ void NoiseModel::remap_qubits(const std::unordered_map<uint_t, uint_t> &mapping)
     "probabilities": [[P(0|0), P(0|1)], [P(1|0), P(1|1)]]
     "gate_qubits": [[0]]  // error only apples when op is on these qubits (blank for all)
   }
+
+  Factored Readout Error (product of correlated factors)
+  {
+    "type": "roerror",
+    "operations": ["measure"],
+    "factors": [
+      {"qubits": [0], "probabilities": [[P(0|0), P(1|0)], [P(0|1), P(1|1)]]},
+      {"qubits": [1], "controls": [0],  // conditioned on ideal bit 0 (c)
+       "probabilities": [[P(0|1=0,c=0), P(1|1=0,c=0)], [P(0|1=1,c=0), P(1|1=1,c=0)],
+                         [P(0|1=0,c=1), P(1|1=0,c=1)], [P(0|1=1,c=1), P(1|1=1,c=1)]]}
+    ],
+    "gate_qubits": [[0, 1]]
+  }
 */
 
 void NoiseModel::load_from_json(const json_t &js) {
@@ -1042,43 +1067,112 @@ void NoiseModel::load_from_json(const json_t &js) {
       throw std::invalid_argument("Invalid noise_params JSON: \"error\" field is not a list");
     }
     for (const auto &gate_js : js["errors"]) {
-      std::string type;
-      JSON::get_value(type, "type", gate_js);
-      stringset_t ops; // want set so ops are unique, and we can pull out measure
-      JSON::get_value(ops, "operations", gate_js);
-      std::vector<reg_t> gate_qubits;
-      JSON::get_value(gate_qubits, "gate_qubits", gate_js);
-      std::vector<reg_t> noise_qubits;
-      JSON::get_value(noise_qubits, "noise_qubits", gate_js);
-
-      // We treat measure as a separate error op so that it can be applied before
-      // the measure operation, rather than after like the other gates
-      if (ops.find("measure") != ops.end() && type != "roerror") {
-        ops.erase("measure"); // remove measure from set of ops
-        if (type != "qerror")
-          throw std::invalid_argument("NoiseModel: Invalid noise type (" + type + ")");
-        QuantumError error;
-        error.load_from_json(gate_js);
-        error.set_errors_before(); // set errors before the op
-        add_quantum_error(error, {"measure"}, gate_qubits, noise_qubits);
+      load_error(gate_js);
+    }
+  }
+}
+
+void NoiseModel::load_from_stream(JSON::Reader &reader) {
+
+  // If JSON is null stop
+  if (reader.peek() == JSON::Reader::Event::null) {
+    reader.skip();
+    return;
+  }
+
+  // Check JSON is an object
+  if (reader.peek() != JSON::Reader::Event::begin_object) {
+    throw std::invalid_argument("Invalid noise_params JSON: not an object.");
+  }
+
+  reader.begin_object();
+  std::string key;
+  while (reader.next_key(key)) {
+    if (key == "x90_gates") {
+      const json_t x90_gates = reader.value();
+      if (!x90_gates.is_null())
+        set_x90_gates(x90_gates);
+    } else if (key == "errors" && reader.peek() != JSON::Reader::Event::null) {
+      if (reader.peek() != JSON::Reader::Event::begin_array) {
+        throw std::invalid_argument("Invalid noise_params JSON: \"error\" field is not a list");
       }
-      // Load the remaining ops as errors that come after op
-      if (type == "qerror") {
-        QuantumError error;
-        error.load_from_json(gate_js);
-        add_quantum_error(error, ops, gate_qubits, noise_qubits);
-      } else if (type == "roerror") {
-        // We do not allow non-local readout errors
-        if (!noise_qubits.empty()) {
-          throw std::invalid_argument("Readout error must be a local error");
+      reader.begin_array();
+      while (reader.next_element()) {
+        // Read the error as JSON except for its instructions
+        json_t gate_js = json_t::object();
+        std::vector<NoiseOps> circuits;
+        bool has_circuits = false;
+        reader.begin_object();
+        std::string error_key;
+        while (reader.next_key(error_key)) {
+          if (error_key == "instructions") {
+            has_circuits = true;
+            reader.begin_array();
+            while (reader.next_element()) {
+              circuits.emplace_back();
+              reader.begin_array();
+              while (reader.next_element())
+                circuits.back().push_back(Operations::read_op(reader));
+            }
+          } else {
+            gate_js[error_key] = reader.value();
+          }
         }
-        ReadoutError error; // readout error goes after
-        error.load_from_json(gate_js);
-        add_readout_error(error, gate_qubits);
-      }else {
-        throw std::invalid_argument("NoiseModel: Invalid noise type (" + type + ")");
+        load_error(gate_js, has_circuits ? &circuits : nullptr);
       }
+    } else {
+      reader.skip();
+    }
+  }
+}
+
+void NoiseModel::load_error(const json_t &gate_js,
+                            const std::vector<NoiseOps> *circuits) {
+  std::string type;
+  JSON::get_value(type, "type", gate_js);
+  stringset_t ops; // want set so ops are unique, and we can pull out measure
+  JSON::get_value(ops, "operations", gate_js);
+  std::vector<reg_t> gate_qubits;
+  JSON::get_value(gate_qubits, "gate_qubits", gate_js);
+  std::vector<reg_t> noise_qubits;
+  JSON::get_value(noise_qubits, "noise_qubits", gate_js);
+
+  auto load_quantum_error = [&](QuantumError &error) {
+    if (circuits == nullptr) {
+      error.load_from_json(gate_js);
+      return;
+    }
+    rvector_t probs;
+    JSON::get_value(probs, "probabilities", gate_js);
+    error.set_circuits(*circuits, probs);
+  };
+
+  // We treat measure as a separate error op so that it can be applied before
+  // the measure operation, rather than after like the other gates
+  if (ops.find("measure") != ops.end() && type != "roerror") {
+    ops.erase("measure"); // remove measure from set of ops
+    if (type != "qerror")
+      throw std::invalid_argument("NoiseModel: Invalid noise type (" + type + ")");
+    QuantumError error;
+    load_quantum_error(error);
+    error.set_errors_before(); // set errors before the op
+    add_quantum_error(error, {"measure"}, gate_qubits, noise_qubits);
+  }
+  // Load the remaining ops as errors that come after op
+  if (type == "qerror") {
+    QuantumError error;
+    load_quantum_error(error);
+    add_quantum_error(error, ops, gate_qubits, noise_qubits);
+  } else if (type == "roerror") {
+    // We do not allow non-local readout errors
+    if (!noise_qubits.empty()) {
+      throw std::invalid_argument("Readout error must be a local error");
     }
+    ReadoutError error; // readout error goes after
+    error.load_from_json(gate_js);
+    add_readout_error(error, gate_qubits);
+  }else {
+    throw std::invalid_argument("NoiseModel: Invalid noise type (" + type + ")");
   }
 }
 
@@ -51,6 +51,19 @@ public:
   // identity matrix
   void set_probabilities(const std::vector<rvector_t> &probs);
 
+  // Set the assignment probabilities as a product of correlated factors.
+  // Factor f assigns the measured bits at positions qubits[f] and its
+  // probabilities are conditioned on the ideal values of these bits and of
+  // the bits at positions controls[f]. The probabilities of each factor are
+  // a list of 2^(q + c) vectors of 2^q probabilities for q qubits and c
+  // controls, indexed by the ideal value of the qubits (low bits) and the
+  // controls (high bits). Tensor products of single bit errors have
+  // no controls, and Markov chains have a neighbouring bit as control.
+  // The qubits of different factors must be distinct.
+  void set_factors(const std::vector<reg_t> &qubits,
+                   const std::vector<reg_t> &controls,
+                   const std::vector<std::vector<rvector_t>> &probs);
+
   //-----------------------------------------------------------------------
   // Utility
   //-----------------------------------------------------------------------
@@ -69,6 +82,15 @@ protected:
   // Vector of assignment probability vectors
   std::vector<rvector_t> assignment_probabilities_; 
 
+  // Qubit and control positions of the factors of a factored error given
+  // as a list [qubits0, controls0, qubits1, controls1, ...]. The assignment
+  // probability vectors of all factors are stored in order in
+  // assignment_probabilities_.
+  std::vector<reg_t> factor_bits_;
+
+  // Check that a vector of probabilities is valid and normalized
+  void check_probabilities(const rvector_t &probs) const;
+
   // threshold for checking probabilities
   double threshold_ = 1e-10;
 };
@@ -80,6 +102,12 @@ protected:
 ReadoutError::NoiseOps ReadoutError::sample_noise(const reg_t &memory,
                                                   RngEngine &rng) const {
   (void)rng; // RNG is unused for readout error since it is handled by engine
+  if (!factor_bits_.empty()) {
+    // The factors must refer to measured bits
+    if (memory.size() < get_num_qubits())
+      throw std::invalid_argument("ReadoutError: number of qubits don't match readout error factors.");
+    return {Operations::make_roerror(memory, factor_bits_, assignment_probabilities_)};
+  }
   // Check assignment fidelity matrix is correct size
   if (memory.size() > get_num_qubits())
     throw std::invalid_argument("ReadoutError: number of qubits don't match assignment probability matrix.");
@@ -88,20 +116,66 @@ ReadoutError::NoiseOps ReadoutError::sample_noise(const reg_t &memory,
 }
 
 
+void ReadoutError::check_probabilities(const rvector_t &probs) const {
+  double total = 0.0;
+  for (const auto &p : probs) {
+    if (p < 0 || p > 1) {
+      throw std::invalid_argument("ReadoutError probability is not valid (p=" + std::to_string(p) +").");
+    }
+    total += p;
+  }
+  if (std::abs(total - 1) > threshold_)
+    throw std::invalid_argument("ReadoutError probability vector is not normalized.");
+}
+
+
 void ReadoutError::set_probabilities(const std::vector<rvector_t> &probs) {
   assignment_probabilities_ = probs;
+  factor_bits_.clear();
   set_num_qubits(assignment_probabilities_.size());
-  for (const auto  &ps : assignment_probabilities_) {
-    double total = 0.0;
-    for (const auto &p : ps) {
-      if (p < 0 || p > 1) {
-        throw std::invalid_argument("ReadoutError probability is not valid (p=" + std::to_string(p) +").");
-      }
-      total += p;
+  for (const auto  &ps : assignment_probabilities_)
+    check_probabilities(ps);
+}
+
+
+void ReadoutError::set_factors(const std::vector<reg_t> &qubits,
+                               const std::vector<reg_t> &controls,
+                               const std::vector<std::vector<rvector_t>> &probs) {
+  if (qubits.size() != probs.size() || controls.size() > qubits.size())
+    throw std::invalid_argument("ReadoutError: invalid number of factors.");
+  assignment_probabilities_.clear();
+  factor_bits_.clear();
+  std::set<uint_t> assigned;
+  uint_t num_qubits = 0;
+  for (size_t f = 0; f < qubits.size(); ++f) {
+    const reg_t ctrls = (f < controls.size()) ? controls[f] : reg_t();
+    std::set<uint_t> bits(ctrls.begin(), ctrls.end());
+    for (const auto &q : qubits[f]) {
+      if (!assigned.insert(q).second)
+        throw std::invalid_argument("ReadoutError: factors assign qubit " +
+                                    std::to_string(q) + " more than once.");
+      bits.insert(q);
     }
-    if (std::abs(total - 1) > threshold_)
-      throw std::invalid_argument("ReadoutError probability vector is not normalized.");
+    if (qubits[f].empty() || bits.size() != qubits[f].size() + ctrls.size())
+      throw std::invalid_argument("ReadoutError: invalid factor qubits.");
+    const uint_t num_bits = bits.size();
+    if (num_bits > 16)
+      throw std::invalid_argument("ReadoutError: factor on too many qubits.");
+    num_qubits = std::max<uint_t>(num_qubits, *bits.rbegin() + 1);
+    // Check probability vectors for each ideal value of qubits and controls
+    if (probs[f].size() != 1ULL << num_bits)
+      throw std::invalid_argument("ReadoutError: factor has an invalid number of probability vectors.");
+    for (const auto &ps : probs[f]) {
+      if (ps.size() != 1ULL << qubits[f].size())
+        throw std::invalid_argument("ReadoutError: factor probability vector has an invalid length.");
+      check_probabilities(ps);
+    }
+    factor_bits_.push_back(qubits[f]);
+    factor_bits_.push_back(ctrls);
+    assignment_probabilities_.insert(assignment_probabilities_.end(),
+                                     probs[f].begin(), probs[f].end());
   }
+  set_num_qubits(num_qubits);
 }
 
 
@@ -111,6 +185,22 @@ void ReadoutError::load_from_json(const json_t &js) {
   if (!probs.empty()) {
     set_probabilities(probs);
   }
+  // Factored readout error
+  if (JSON::check_key("factors", js)) {
+    std::vector<reg_t> qubits, controls;
+    std::vector<std::vector<rvector_t>> factor_probs;
+    for (const auto &factor : js["factors"]) {
+      reg_t factor_qubits, factor_controls;
+      std::vector<rvector_t> ps;
+      JSON::get_value(factor_qubits, "qubits", factor);
+      JSON::get_value(factor_controls, "controls", factor);
+      JSON::get_value(ps, "probabilities", factor);
+      qubits.push_back(factor_qubits);
+      controls.push_back(factor_controls);
+      factor_probs.push_back(ps);
+    }
+    set_factors(qubits, controls, factor_probs);
+  }
 }
 
 //-------------------------------------------------------------------------
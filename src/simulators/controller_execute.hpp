@@ -17,7 +17,8 @@
 
 #include <string>
 #include "framework/json.hpp"
-#include "misc/hacks.hpp"
+#include "framework/json_reader.hpp"
+#include "framework/json_writer.hpp"
 
 
 //=========================================================================
@@ -26,22 +27,18 @@
 
 
 // This is used to make wrapping Controller classes in Cython easier
-// by handling the parsing of std::string input into JSON objects.
+// by handling the parsing of std::string input. The qobj is read by a
+// streaming reader and the result is written by a streaming writer
+// without building either as JSON.
 namespace AER { 
 template <class controller_t>
 std::string controller_execute(const std::string &qobj_str) {
   controller_t controller;
-  auto qobj_js = json_t::parse(qobj_str);
-
-  // Fix for MacOS and OpenMP library double initialization crash.
-  // Issue: https://github.com/Qiskit/qiskit-aer/issues/1
-  if (JSON::check_key("config", qobj_js)) {
-    std::string path;
-    JSON::get_value(path, "library_dir", qobj_js["config"]);
-    Hacks::maybe_load_openmp(path);
-  }
-
-  return controller.execute(qobj_js).dump(-1);
+  JSON::Reader reader(qobj_str);
+  std::string result;
+  JSON::Writer writer(result);
+  controller.execute(reader, writer);
+  return result;
 }
 } // end namespace AER
 #endif
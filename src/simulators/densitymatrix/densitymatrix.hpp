@@ -84,6 +84,19 @@ public:
   // The matrix is input as vector of the matrix diagonal.
   void apply_diagonal_superop_matrix(const reg_t &qubits, const cvector_t<double> &mat);
 
+  // Apply a N-qubit monomial unitary matrix (a permutation matrix with
+  // phases) to the state vector. The matrix is input as the row and the
+  // value of the non-zero entry of each column.
+  void apply_monomial_unitary_matrix(const reg_t &qubits, const reg_t &rows,
+                                     const cvector_t<double> &entries);
+
+  // Apply a unitary matrix on the target qubits controlled on all control
+  // qubits in the |1> state to the state vector.
+  // The matrix is input as vector of the column-major vectorized matrix.
+  void apply_controlled_unitary_matrix(const reg_t &control_qubits,
+                                       const reg_t &target_qubits,
+                                       const cvector_t<double> &mat);
+
   //-----------------------------------------------------------------------
   // Apply Specialized Gates
   //-----------------------------------------------------------------------
@@ -109,6 +122,29 @@ public:
   // Apply a 3-qubit toffoli gate
   void apply_toffoli(const uint_t qctrl0, const uint_t qctrl1, const uint_t qtrgt);
 
+  // Apply the Pauli rotation exp(-i theta/2 P) for the N-qubit Pauli label P,
+  // where the last character of the label acts on qubits[0].
+  // The rotation of the rows and columns is applied together in a single pass
+  // over quadruples of entries flipped by the X and Y qubits.
+  void apply_pauli_rotation(const reg_t &qubits, const std::string &pauli,
+                            const double theta);
+
+  //-----------------------------------------------------------------------
+  // Reset and measurement collapse
+  //-----------------------------------------------------------------------
+
+  // Reset the qubits to the |0> state. The diagonal blocks of the qubits are
+  // summed into the |0><0| block, which traces them out, and all other
+  // entries on the qubits are zeroed in a single pass.
+  void apply_reset(const reg_t &qubits);
+
+  // Collapse the qubits to the Z-basis measurement outcome meas_state with
+  // probability meas_prob and set them to final_state. The |m><m| block is
+  // renormalized into the |f><f| block and all other entries on the qubits
+  // are zeroed in a single pass.
+  void apply_measure_collapse(const reg_t &qubits, const uint_t meas_state,
+                              const uint_t final_state, const double meas_prob);
+
   //-----------------------------------------------------------------------
   // Z-measurement outcome probabilities
   //-----------------------------------------------------------------------
@@ -123,6 +159,12 @@ protected:
   // For the QubitVector apply matrix function
   virtual reg_t superop_qubits(const reg_t &qubits) const;
 
+  // Replace the blocks on the qubits by scale times the sum of the diagonal
+  // blocks |i><i| for first <= i < last in the |final_state><final_state|
+  // block and zero all other blocks
+  void collapse_blocks(const reg_t &qubits, const uint_t first, const uint_t last,
+                       const uint_t final_state, const double scale);
+
   // Construct a vectorized superoperator from a vectorized matrix
   // This is equivalent to vec(tensor(conj(A), A))
   cvector_t<double> vmat2vsuperop(const cvector_t<double> &vmat) const;
@@ -244,6 +286,50 @@ void DensityMatrix<data_t>::apply_diagonal_unitary_matrix(const reg_t &qubits,
   apply_diagonal_superop_matrix(qubits, AER::Utils::tensor_product(AER::Utils::conjugate(diag), diag));
 }
 
+template <typename data_t>
+void DensityMatrix<data_t>::apply_monomial_unitary_matrix(const reg_t &qubits,
+                                                          const reg_t &rows,
+                                                          const cvector_t<double> &entries) {
+  const size_t dim = rows.size();
+  if (qubits.size() > apply_unitary_threshold_) {
+    // Apply as two N-qubit monomial matrices
+    const auto nq = num_qubits();
+    reg_t conj_qubits;
+    for (const auto q: qubits) {
+      conj_qubits.push_back(q + nq);
+    }
+    BaseVector::apply_monomial_matrix(qubits, rows, entries);
+    BaseVector::apply_monomial_matrix(conj_qubits, rows, AER::Utils::conjugate(entries));
+  } else {
+    // Apply as a single 2N-qubit monomial matrix conj(U) \otimes U
+    reg_t superop_rows(dim * dim);
+    cvector_t<double> superop_entries(dim * dim);
+    for (size_t j = 0; j < dim; j++) {
+      for (size_t l = 0; l < dim; l++) {
+        superop_rows[l + dim * j] = rows[l] + dim * rows[j];
+        superop_entries[l + dim * j] = std::conj(entries[j]) * entries[l];
+      }
+    }
+    BaseVector::apply_monomial_matrix(superop_qubits(qubits), superop_rows, superop_entries);
+  }
+}
+
+template <typename data_t>
+void DensityMatrix<data_t>::apply_controlled_unitary_matrix(const reg_t &control_qubits,
+                                                            const reg_t &target_qubits,
+                                                            const cvector_t<double> &mat) {
+  // Apply id \otimes U and conj(U) \otimes id, which each only update the
+  // entries with the control qubits of the rows or the columns in |1>
+  const auto nq = num_qubits();
+  reg_t conj_controls, conj_targets;
+  for (const auto q: control_qubits)
+    conj_controls.push_back(q + nq);
+  for (const auto q: target_qubits)
+    conj_targets.push_back(q + nq);
+  BaseVector::apply_controlled_matrix(control_qubits, target_qubits, mat);
+  BaseVector::apply_controlled_matrix(conj_controls, conj_targets, AER::Utils::conjugate(mat));
+}
+
 //-----------------------------------------------------------------------
 // Apply Specialized Gates
 //-----------------------------------------------------------------------
@@ -336,6 +422,133 @@ void DensityMatrix<data_t>::apply_toffoli(const uint_t qctrl0,
   BaseVector::apply_permutation_matrix(qubits, pairs);
 }
 
+template <typename data_t>
+AER_TARGET_CLONES
+void DensityMatrix<data_t>::apply_pauli_rotation(const reg_t &qubits,
+                                                 const std::string &pauli,
+                                                 const double theta) {
+  // The vectorized matrix is updated by U = exp(-i theta/2 P) on the row
+  // qubits and conj(U) on the column qubits
+  uint_t x_mask, z_mask, num_y;
+  BaseVector::pauli_masks(qubits, pauli, x_mask, z_mask, num_y);
+  const size_t nq = num_qubits();
+  const uint_t x_cols = x_mask << nq;
+  const uint_t z_cols = z_mask << nq;
+  const data_t cos_t = std::cos(0.5 * theta);
+  const data_t sin_t = std::sin(0.5 * theta);
+  auto &data = BaseVector::data_;
+
+  // Diagonal rotation: entries are multiplied by exp(-i theta/2 (s_row - s_col))
+  if (x_mask == 0) {
+    const std::complex<data_t> phases[2] = {std::complex<data_t>(std::cos(theta), -std::sin(theta)),
+                                            std::complex<data_t>(std::cos(theta), std::sin(theta))};
+    const int_t END = BaseVector::data_size_;
+#pragma omp parallel for if (BaseVector::num_qubits_ > BaseVector::omp_threshold_ && BaseVector::omp_threads_ > 1) num_threads(BaseVector::omp_threads_)
+    for (int_t k = 0; k < END; k++) {
+      const uint_t s_row = parity(k & z_mask);
+      if (s_row != parity(k & z_cols))
+        data[k] *= phases[s_row];
+    }
+    return;
+  }
+
+  // U = cos I + a P on the rows and conj(U) = cos I + conj(a) P on the
+  // columns, where a = -i sin(theta/2) i^num_y
+  const std::complex<double> ipow[4] = {{1., 0.}, {0., 1.}, {-1., 0.}, {0., -1.}};
+  const std::complex<data_t> a_row(std::sin(0.5 * theta) * ipow[(num_y + 3) & 3]);
+  const std::complex<data_t> a_col = std::conj(a_row);
+  const data_t cos2 = cos_t * cos_t;
+  const data_t sin2 = sin_t * sin_t;
+
+  // Quadruples {k, k ^ x_mask, k ^ x_cols, k ^ x_mask ^ x_cols} where the
+  // highest bit of the x_mask is zero in the rows and columns of k
+  uint_t pivot = 0;
+  while (x_mask >> (pivot + 1))
+    pivot++;
+  const uint_t low_mask = MASKS[pivot];
+  const uint_t mid_mask = MASKS[nq - 1];
+  const int_t END = BaseVector::data_size_ >> 2;
+#pragma omp parallel for if (BaseVector::num_qubits_ > BaseVector::omp_threshold_ && BaseVector::omp_threads_ > 1) num_threads(BaseVector::omp_threads_)
+  for (int_t k = 0; k < END; k++) {
+    // Insert zeros at the pivot of the row and column qubits
+    const uint_t row = k & mid_mask;
+    const uint_t col = k >> (nq - 1);
+    const uint_t k0 = ((((col >> pivot) << (pivot + 1)) | (col & low_mask)) << nq)
+                      | ((row >> pivot) << (pivot + 1)) | (row & low_mask);
+    const uint_t inds[4] = {k0, k0 ^ x_mask, k0 ^ x_cols, k0 ^ x_mask ^ x_cols};
+    std::complex<data_t> cache[4];
+    uint_t s_row[4], s_col[4];
+    for (size_t i = 0; i < 4; i++) {
+      cache[i] = data[inds[i]];
+      s_row[i] = parity(inds[i] & z_mask);
+      s_col[i] = parity(inds[i] & z_cols);
+    }
+    // The row and column partners of entry i are entries i ^ 1 and i ^ 2
+    for (size_t i = 0; i < 4; i++) {
+      data[inds[i]] = cos2 * cache[i]
+                      + cos_t * ((s_row[i ^ 1] ? -a_row : a_row) * cache[i ^ 1]
+                                 + (s_col[i ^ 2] ? -a_col : a_col) * cache[i ^ 2])
+                      + ((s_row[i ^ 1] ^ s_col[i ^ 2]) ? -sin2 : sin2) * cache[i ^ 3];
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+// Reset and measurement collapse
+//-----------------------------------------------------------------------
+
+template <typename data_t>
+void DensityMatrix<data_t>::apply_reset(const reg_t &qubits) {
+  collapse_blocks(qubits, 0, BITS[qubits.size()], 0, 1.);
+}
+
+template <typename data_t>
+void DensityMatrix<data_t>::apply_measure_collapse(const reg_t &qubits,
+                                                   const uint_t meas_state,
+                                                   const uint_t final_state,
+                                                   const double meas_prob) {
+  collapse_blocks(qubits, meas_state, meas_state + 1, final_state, 1. / meas_prob);
+}
+
+template <typename data_t>
+AER_TARGET_CLONES
+void DensityMatrix<data_t>::collapse_blocks(const reg_t &qubits,
+                                            const uint_t first,
+                                            const uint_t last,
+                                            const uint_t final_state,
+                                            const double scale) {
+  const size_t N = qubits.size();
+  const uint_t DIM = BITS[N];
+  const size_t nq = num_qubits();
+  auto qubits_sorted = superop_qubits(qubits);
+  std::sort(qubits_sorted.begin(), qubits_sorted.end());
+
+  // Offsets of the rows and the columns of a block from its first entry
+  std::vector<uint_t> rows(DIM, 0), cols(DIM, 0);
+  for (size_t i = 0; i < N; i++) {
+    const auto n = BITS[i];
+    for (size_t j = 0; j < n; j++) {
+      rows[n + j] = rows[j] | BITS[qubits[i]];
+      cols[n + j] = cols[j] | BITS[qubits[i] + nq];
+    }
+  }
+
+  auto data = BaseVector::data_;
+  const data_t _scale = scale;
+  const int_t END = BaseVector::data_size_ >> (2 * N);
+#pragma omp parallel for if (BaseVector::num_qubits_ > BaseVector::omp_threshold_ && BaseVector::omp_threads_ > 1) num_threads(BaseVector::omp_threads_)
+  for (int_t k = 0; k < END; k++) {
+    const auto i0 = BaseVector::index0(qubits_sorted, k);
+    std::complex<data_t> sum = 0.;
+    for (uint_t i = first; i < last; i++)
+      sum += data[i0 + rows[i] + cols[i]];
+    for (uint_t j = 0; j < DIM; j++)
+      for (uint_t i = 0; i < DIM; i++)
+        data[i0 + rows[i] + cols[j]] = 0.;
+    data[i0 + rows[final_state] + cols[final_state]] = _scale * sum;
+  }
+}
+
 //-----------------------------------------------------------------------
 // Z-measurement outcome probabilities
 //-----------------------------------------------------------------------
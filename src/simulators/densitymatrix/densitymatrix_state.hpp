@@ -75,7 +75,8 @@ public:
       Operations::OpType::roerror,
       Operations::OpType::matrix,
       Operations::OpType::kraus,
-      Operations::OpType::superop
+      Operations::OpType::superop,
+      Operations::OpType::pauli_rotation
     });
   }
 
@@ -163,6 +164,9 @@ protected:
   // Apply a matrix to given qubits (identity on all other qubits)
   void apply_matrix(const reg_t &qubits, const cmatrix_t & mat);
 
+  // Apply a matrix op with the kernel for its matrix structure
+  void apply_matrix(const Operations::Op &op);
+
   // Apply a vectorized matrix to given qubits (identity on all other qubits)
   void apply_matrix(const reg_t &qubits, const cvector_t & vmat);
 
@@ -412,7 +416,7 @@ void State<densmat_t>::apply_ops(const std::vector<Operations::Op> &ops,
         apply_snapshot(op, data);
         break;
       case Operations::OpType::matrix:
-        apply_matrix(op.qubits, op.mats[0]);
+        apply_matrix(op);
         break;
       case Operations::OpType::superop:
         BaseState::qreg_.apply_superop_matrix(op.qubits, Utils::vectorize_matrix(op.mats[0]));
@@ -420,6 +424,10 @@ void State<densmat_t>::apply_ops(const std::vector<Operations::Op> &ops,
       case Operations::OpType::kraus:
         apply_kraus(op.qubits, op.mats);
         break;
+      case Operations::OpType::pauli_rotation:
+        BaseState::qreg_.apply_pauli_rotation(op.qubits, op.string_params[0],
+                                              std::real(op.params[0]));
+        break;
       default:
         throw std::invalid_argument("DensityMatrix::State::invalid instruction \'" +
                                     op.name + "\'.");
@@ -443,7 +451,8 @@ void State<densmat_t>::apply_snapshot(const Operations::Op &op,
                                 op.name + "\'.");
   switch (it -> second) {
     case Snapshots::densitymatrix:
-      BaseState::snapshot_state(op, data, "density_matrix");
+      data.add_singleshot_snapshot("density_matrix", op.string_params[0],
+                                   BaseState::qreg_.json_array());
       break;
     case Snapshots::cmemory:
       BaseState::snapshot_creg_memory(op, data);
@@ -568,6 +577,25 @@ void State<densmat_t>::apply_gate(const Operations::Op &op) {
 }
 
 
+template <class densmat_t>
+void State<densmat_t>::apply_matrix(const Operations::Op &op) {
+  switch (op.mat_structure) {
+    case Operations::MatrixStructure::diagonal:
+      BaseState::qreg_.apply_diagonal_unitary_matrix(op.qubits, op.mat_entries);
+      break;
+    case Operations::MatrixStructure::monomial:
+      BaseState::qreg_.apply_monomial_unitary_matrix(op.qubits, op.mat_rows, op.mat_entries);
+      break;
+    case Operations::MatrixStructure::controlled: {
+      reg_t controls, targets;
+      Operations::matrix_control_qubits(op, controls, targets);
+      BaseState::qreg_.apply_controlled_unitary_matrix(controls, targets, op.mat_entries);
+    } break;
+    default:
+      apply_matrix(op.qubits, op.mats[0]);
+  }
+}
+
 template <class densmat_t>
 void State<densmat_t>::apply_matrix(const reg_t &qubits, const cmatrix_t &mat) {
   if (mat.GetRows() == 1) {
@@ -641,11 +669,7 @@ std::vector<reg_t> State<densmat_t>::sample_measure(const reg_t &qubits,
 
 template <class densmat_t>
 void State<densmat_t>::apply_reset(const reg_t &qubits) {
-  // TODO: This can be more efficient by adding reset
-  // to base class rather than doing a matrix multiplication
-  // where all but 1 row is zeros.
-  const auto reset_op = Utils::SMatrix::reset(1ULL << qubits.size());
-  BaseState::qreg_.apply_superop_matrix(qubits, Utils::vectorize_matrix(reset_op));
+  BaseState::qreg_.apply_reset(qubits);
 }
 
 template <class densmat_t>
@@ -663,43 +687,9 @@ void State<densmat_t>::measure_reset_update(const reg_t &qubits,
                                              const uint_t final_state,
                                              const uint_t meas_state,
                                              const double meas_prob) {
-  // Update a state vector based on an outcome pair [m, p] from
+  // Update a density matrix based on an outcome pair [m, p] from
   // sample_measure_with_prob function, and a desired post-measurement final_state
-  // Single-qubit case
-  if (qubits.size() == 1) {
-    // Diagonal matrix for projecting and renormalizing to measurement outcome
-    cvector_t mdiag(2, 0.);
-    mdiag[meas_state] = 1. / std::sqrt(meas_prob);
-    BaseState::qreg_.apply_diagonal_unitary_matrix(qubits, mdiag);
-
-    // If it doesn't agree with the reset state update
-    if (final_state != meas_state) {
-      BaseState::qreg_.apply_x(qubits[0]);
-    }
-  }
-  // Multi qubit case
-  else {
-    // Diagonal matrix for projecting and renormalizing to measurement outcome
-    const size_t dim = 1ULL << qubits.size();
-    cvector_t mdiag(dim, 0.);
-    mdiag[meas_state] = 1. / std::sqrt(meas_prob);
-    BaseState::qreg_.apply_diagonal_unitary_matrix(qubits, mdiag);
-
-    // If it doesn't agree with the reset state update
-    // TODO This function could be optimized as a permutation update
-    if (final_state != meas_state) {
-      // build vectorized permutation matrix
-      cvector_t perm(dim * dim, 0.);
-      perm[final_state * dim + meas_state] = 1.;
-      perm[meas_state * dim + final_state] = 1.;
-      for (size_t j=0; j < dim; j++) {
-        if (j != final_state && j != meas_state)
-          perm[j * dim + j] = 1.;
-      }
-      // apply permutation to swap state
-      BaseState::qreg_.apply_unitary_matrix(qubits, perm);
-    }
-  }
+  BaseState::qreg_.apply_measure_collapse(qubits, meas_state, final_state, meas_prob);
 }
 
 
@@ -17,6 +17,7 @@
 
 #include "chlib/core.hpp"
 #include "chlib/chstabilizer.hpp"
+#include "chlib/chstabilizer_array.hpp"
 #include "gates.hpp"
 
 #include "framework/json.hpp"
@@ -28,6 +29,7 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <complex>
 #include <vector>
@@ -38,8 +40,6 @@
 
 namespace CHSimulator {
 
-using chstabilizer_t = StabilizerState;
-
 const double T_ANGLE = M_PI/4.;
 const double TDG_ANGLE = -1.*M_PI/4.;
 
@@ -47,6 +47,7 @@ const U1Sample t_sample(T_ANGLE);
 const U1Sample tdg_sample(TDG_ANGLE);
 
 const uint_t ZERO = 0ULL;
+const uint_t TOFF_BRANCH_MAX = 7ULL;
 
 thread_local std::unordered_map<double, U1Sample> Z_ROTATIONS;
 
@@ -55,8 +56,9 @@ class Runner
 private:
   uint_t n_qubits_;
   uint_t num_states_;
-  std::vector<chstabilizer_t> states_;
-  std::vector<complex_t> coefficients_;
+  //Terms of the decomposition and their coefficients, stored as one
+  //array per field of the CH-form
+  StabilizerStateArray states_;
   uint_t num_threads_;
   uint_t omp_threshold_;
 
@@ -64,6 +66,9 @@ private:
   complex_t old_ampsum_;
   uint_t x_string_;
   uint_t last_proposal_;
+  //Metropolis Paulis U_C^{-1}X(x)U_C of each term
+  PauliArray current_paulis_;
+  PauliArray proposed_paulis_;
 
   void init_metropolis(AER::RngEngine &rng);
   void metropolis_step(AER::RngEngine &rng);
@@ -94,31 +99,30 @@ public:
   //Creates num_states_ copies of the 'base state' in the runner
   //This will be either the |0>^n state, or a stabilizer state
   //produced by applying the first m Clifford gates of the
-  //circuit. 
+  //circuit.
   void initialize_decomposition(uint_t n_states);
-  //Check if the coefficient omega is 0
-  bool check_eps(uint_t rank);
-
-  //Methods for applying gates
-  void apply_cx(uint_t control, uint_t target, uint_t rank);
-  void apply_cz(uint_t control, uint_t target, uint_t rank);
-  void apply_swap(uint_t qubit_1, uint_t qubit_2, uint_t rank);
-  void apply_h(uint_t qubit, uint_t rank);
-  void apply_s(uint_t qubit, uint_t rank);
-  void apply_sdag(uint_t qubit, uint_t rank);
-  void apply_x(uint_t qubit, uint_t rank);
-  void apply_y(uint_t qubit, uint_t rank);
-  void apply_z(uint_t qubit, uint_t rank);
-  //Methods for non-clifford gates, including parameters for the Sampling
-  void apply_t(uint_t qubit, double r, int rank);
-  void apply_tdag(uint_t qubit, double r, int rank);
-  void apply_u1(uint_t qubit, complex_t lambda, double r, int rank);
-  void apply_ccx(uint_t control_1, uint_t control_2, uint_t target, uint_t branch, int rank);
-  void apply_ccz(uint_t control_1, uint_t control_2, uint_t target, uint_t branch, int rank);
+
+  //Methods for applying gates. Each gate is applied to every term
+  //of the decomposition with a nonzero coefficient omega.
+  void apply_cx(uint_t control, uint_t target);
+  void apply_cz(uint_t control, uint_t target);
+  void apply_swap(uint_t qubit_1, uint_t qubit_2);
+  void apply_h(uint_t qubit);
+  void apply_s(uint_t qubit);
+  void apply_sdag(uint_t qubit);
+  void apply_x(uint_t qubit);
+  void apply_y(uint_t qubit);
+  void apply_z(uint_t qubit);
+  //Methods for non-clifford gates. A Clifford branch is sampled for each term,
+  //in the order of the terms, and the branches are applied as masked sweeps.
+  void apply_t(uint_t qubit, AER::RngEngine &rng);
+  void apply_tdag(uint_t qubit, AER::RngEngine &rng);
+  void apply_u1(uint_t qubit, complex_t lambda, AER::RngEngine &rng);
+  void apply_ccx(uint_t control_1, uint_t control_2, uint_t target, AER::RngEngine &rng);
+  void apply_ccz(uint_t control_1, uint_t control_2, uint_t target, AER::RngEngine &rng);
   //Measure a Pauli projector on each term in the decomposition and update their coefficients
   // omega.
   void apply_pauli_projector(const std::vector<pauli_t> &generators);
-  void apply_pauli_projector(const std::vector<pauli_t> &generators, uint_t rank);
   //Routine for Norm Estimation, thin wrapper for the CHSimulator method that uses AER::RngEngine
   //to set up the estimation routine.
   double norm_estimation(uint_t n_samples, AER::RngEngine &rng);
@@ -134,6 +138,13 @@ public:
   complex_t amplitude(uint_t x_measure);
   void state_vector(std::vector<complex_t> &svector, AER::RngEngine &rng);
 
+private:
+  //Sample a branch of the U1 rotation for each nonzero term, multiply the
+  //coefficients by the branch weights and apply the Clifford branches
+  void apply_u1_sample(uint_t qubit, const U1Sample &sample, AER::RngEngine &rng);
+  //Sample a Clifford branch of the CCX or CCZ gate for each nonzero term and
+  //return the gates of the branches, see TOFFOLI_BRANCHES
+  std::vector<unsigned char> sample_toffoli_branches(AER::RngEngine &rng);
 };
 
 //=========================================================================
@@ -147,39 +158,29 @@ Runner::Runner(uint_t num_qubits)
 
 void Runner::initialize(uint_t num_qubits)
 {
-  states_.clear();
-  coefficients_.clear();
   n_qubits_ = num_qubits;
   num_states_ = 1;
   num_threads_ = 1;
-  states_ = std::vector<chstabilizer_t>(1, chstabilizer_t(num_qubits));
-  coefficients_.push_back(complex_t(1.,0.));
+  states_.Initialize(num_qubits);
 }
 
 void Runner::initialize_decomposition(uint_t n_states)
 {
-  num_states_ = n_states;
-  states_.reserve(num_states_);
-  coefficients_.reserve(num_states_);
-  if(states_.size() > 1 || coefficients_.size() > 1)
+  if(states_.size() > 1)
   {
-    throw std::runtime_error(std::string("CHSimulator::Runner was initialized without") + 
+    throw std::runtime_error(std::string("CHSimulator::Runner was initialized without") +
                              std::string("being properly cleared since the last ") +
                              std::string("experiment."));
   }
-  chstabilizer_t base_sate(states_[0]);
-  complex_t coeff(coefficients_[0]);
-  for(uint_t i=1; i<num_states_; i++)
-  {
-    states_.push_back(base_sate);
-    coefficients_.push_back(coeff);
-  }
+  num_states_ = n_states;
+  states_.Replicate(num_states_);
 }
 
 void Runner::initialize_omp(uint_t n_threads, uint_t threshold_rank)
 {
   num_threads_ = (n_threads == 0 ? 1: n_threads);
   omp_threshold_ = threshold_rank;
+  states_.initialize_omp(num_threads_, omp_threshold_);
 }
 
 uint_t Runner::get_num_states() const
@@ -203,205 +204,191 @@ bool Runner::check_omp_threshold()
 
 void Runner::apply_pauli_projector(const std::vector<pauli_t> &generators)
 {
-  const int_t END = num_states_;
-  #pragma omp parallel for if(num_states_ > omp_threshold_ && num_threads_ > 1) num_threads(num_threads_)
-  for(int_t i=0; i<END; i++)
-  {
-    apply_pauli_projector(generators, i);
-  }
-}
-
-void Runner::apply_pauli_projector(const std::vector<pauli_t> &generators, uint_t rank)
-{
-  states_[rank].MeasurePauliProjector(generators);
+  states_.MeasurePauliProjector(generators);
 }
 
-bool Runner::check_eps(uint_t rank)
+void Runner::apply_cx(uint_t control, uint_t target)
 {
-  return (states_[rank].Omega().eps == 1);
+  states_.CX(control, target);
 }
 
-void Runner::apply_cx(uint_t control, uint_t target, uint_t rank)
+void Runner::apply_cz(uint_t control, uint_t target)
 {
-  states_[rank].CX(control, target);
+  states_.CZ(control, target);
 }
 
-void Runner::apply_cz(uint_t control, uint_t target, uint_t rank)
+void Runner::apply_swap(uint_t qubit_1, uint_t qubit_2)
 {
-  states_[rank].CZ(control, target);
+  states_.CX(qubit_1, qubit_2);
+  states_.CX(qubit_2, qubit_1);
+  states_.CX(qubit_1, qubit_2);
 }
 
-void Runner::apply_swap(uint_t qubit_1, uint_t qubit_2, uint_t rank)
+void Runner::apply_h(uint_t qubit)
 {
-  states_[rank].CX(qubit_1, qubit_2);
-  states_[rank].CX(qubit_2, qubit_1);
-  states_[rank].CX(qubit_1, qubit_2);
+  states_.H(qubit);
 }
 
-
-void Runner::apply_h(uint_t qubit, uint_t rank)
+void Runner::apply_s(uint_t qubit)
 {
-  states_[rank].H(qubit);
+  states_.S(qubit);
 }
 
-void Runner::apply_s(uint_t qubit, uint_t rank)
+void Runner::apply_sdag(uint_t qubit)
 {
-  states_[rank].S(qubit);
+  states_.Sdag(qubit);
 }
 
-void Runner::apply_sdag(uint_t qubit, uint_t rank)
+void Runner::apply_x(uint_t qubit)
 {
-  states_[rank].Sdag(qubit);
+  states_.X(qubit);
 }
 
-void Runner::apply_x(uint_t qubit, uint_t rank)
+void Runner::apply_y(uint_t qubit)
 {
-  states_[rank].X(qubit);
+  states_.Y(qubit);
 }
 
-void Runner::apply_y(uint_t qubit, uint_t rank)
+void Runner::apply_z(uint_t qubit)
 {
-  states_[rank].Y(qubit);
+  states_.Z(qubit);
 }
 
-void Runner::apply_z(uint_t qubit, uint_t rank)
+void Runner::apply_t(uint_t qubit, AER::RngEngine &rng)
 {
-  states_[rank].Z(qubit);
+  apply_u1_sample(qubit, t_sample, rng);
 }
 
-void Runner::apply_t(uint_t qubit, double r, int rank)
-{
-  sample_branch_t branch = t_sample.sample(r);
-  coefficients_[rank] *= branch.first;
-  if (branch.second == Gates::s)
-  {
-    states_[rank].S(qubit);
-  }
-}
-void Runner::apply_tdag(uint_t qubit, double r, int rank)
+void Runner::apply_tdag(uint_t qubit, AER::RngEngine &rng)
 {
-  sample_branch_t branch = tdg_sample.sample(r);
-  coefficients_[rank] *= branch.first;
-  if (branch.second == Gates::sdg)
-  {
-    states_[rank].Sdag(qubit);
-  }
+  apply_u1_sample(qubit, tdg_sample, rng);
 }
 
-void Runner::apply_u1(uint_t qubit, complex_t param, double r, int rank)
+void Runner::apply_u1(uint_t qubit, complex_t param, AER::RngEngine &rng)
 {
   double lambda = std::real(param);
   auto it = Z_ROTATIONS.find(lambda); //Look for cached z_rotations
-  sample_branch_t branch;
   if (it == Z_ROTATIONS.end())
   {
-    U1Sample rotation(lambda);
-    Z_ROTATIONS.insert({lambda, rotation});
-    branch = rotation.sample(r);
+    it = Z_ROTATIONS.insert({lambda, U1Sample(lambda)}).first;
   }
-  else
-  {
-    branch = it->second.sample(r);
-  }
-  coefficients_[rank] *= branch.first;
-  switch(branch.second)
+  apply_u1_sample(qubit, it->second, rng);
+}
+
+void Runner::apply_u1_sample(uint_t qubit, const U1Sample &sample, AER::RngEngine &rng)
+{
+  std::vector<unsigned char> s_mask(num_states_, 0);
+  std::vector<unsigned char> sdg_mask(num_states_, 0);
+  std::vector<unsigned char> z_mask(num_states_, 0);
+  bool has_s = false, has_sdg = false, has_z = false;
+  for(uint_t i=0; i<num_states_; i++)
   {
-    case Gates::s:
-      states_[rank].S(qubit);
-      break;
-    case Gates::sdg:
-      states_[rank].Sdag(qubit);
-      break;
-    case Gates::z:
-      states_[rank].Z(qubit);
-      break;
-    default:
-      break;
+    if(states_.IsZero(i))
+    {
+      continue;
+    }
+    sample_branch_t branch = sample.sample(rng.rand());
+    states_.Coefficient(i) *= branch.first;
+    switch(branch.second)
+    {
+      case Gates::s:
+        s_mask[i] = has_s = true;
+        break;
+      case Gates::sdg:
+        sdg_mask[i] = has_sdg = true;
+        break;
+      case Gates::z:
+        z_mask[i] = has_z = true;
+        break;
+      default:
+        break;
+    }
   }
-}
+  if(has_s)
+    states_.S(qubit, s_mask.data());
+  if(has_sdg)
+    states_.Sdag(qubit, sdg_mask.data());
+  if(has_z)
+    states_.Z(qubit, z_mask.data());
+}
+
+// The Clifford branches of the CCX and CCZ gates are products of a subset of
+// the gates below, applied in this order:
+//   branch 1: CZ(c1,c2)
+//   branch 2: CX(c1,t)
+//   branch 3: CX(c2,t)
+//   branch 4: CZ(c1,c2) CX(c1,t) Z(c1)
+//   branch 5: CZ(c1,c2) CX(c2,t) Z(c2)
+//   branch 6: CX(c1,t) CX(c2,t) X(t)
+//   branch 7: CZ(c1,c2) CX(c1,t) CX(c2,t) Z(c1) Z(c2) X(t), with a phase -1
+// and for CCZ the CX(c,t) and X(t) gates are replaced by CZ(c,t) and Z(t).
+// The branch of each term selects its subset of gates, and each gate is one
+// masked sweep over the terms.
+enum ToffoliGate {TOFF_CZ12=1, TOFF_CX1=2, TOFF_CX2=4, TOFF_Z1=8, TOFF_Z2=16, TOFF_XT=32};
+const unsigned char TOFFOLI_BRANCHES[8] = {
+  0,
+  TOFF_CZ12,
+  TOFF_CX1,
+  TOFF_CX2,
+  TOFF_CZ12 | TOFF_CX1 | TOFF_Z1,
+  TOFF_CZ12 | TOFF_CX2 | TOFF_Z2,
+  TOFF_CX1 | TOFF_CX2 | TOFF_XT,
+  TOFF_CZ12 | TOFF_CX1 | TOFF_CX2 | TOFF_Z1 | TOFF_Z2 | TOFF_XT
+};
 
-void Runner::apply_ccx(uint_t control_1, uint_t control_2, uint_t target, uint_t branch, int rank)
+std::vector<unsigned char> Runner::sample_toffoli_branches(AER::RngEngine &rng)
 {
-  switch(branch) //Decomposition of the CCX gate into Cliffords
+  std::vector<unsigned char> gates(num_states_, 0);
+  for(uint_t i=0; i<num_states_; i++)
   {
-    case 1:
-      states_[rank].CZ(control_1, control_2);
-      break;
-    case 2:
-      states_[rank].CX(control_1, target);
-      break;
-    case 3:
-      states_[rank].CX(control_2, target);
-      break;
-    case 4:
-      states_[rank].CZ(control_1, control_2);
-      states_[rank].CX(control_1, target);
-      states_[rank].Z(control_1);
-      break;
-    case 5:
-      states_[rank].CZ(control_1, control_2);
-      states_[rank].CX(control_2, target);
-      states_[rank].Z(control_2);
-      break;
-    case 6:
-      states_[rank].CX(control_1, target);
-      states_[rank].CX(control_2, target);
-      states_[rank].X(target);
-      break;
-    case 7:
-      states_[rank].CZ(control_1, control_2);
-      states_[rank].CX(control_1, target);
-      states_[rank].CX(control_2, target);
-      states_[rank].Z(control_1);
-      states_[rank].Z(control_2);
-      states_[rank].X(target);
-      coefficients_[rank] *= -1; //Additional phase
-      break;
-    default: //Identity
-      break;
+    if(states_.IsZero(i))
+    {
+      continue;
+    }
+    uint_t branch = rng.rand_int(ZERO, TOFF_BRANCH_MAX);
+    gates[i] = TOFFOLI_BRANCHES[branch];
+    if(branch == 7)
+    {
+      states_.Coefficient(i) *= -1; //Additional phase
+    }
   }
+  return gates;
 }
 
-void Runner::apply_ccz(uint_t control_1, uint_t control_2, uint_t target, uint_t branch, int rank)
+void Runner::apply_ccx(uint_t control_1, uint_t control_2, uint_t target, AER::RngEngine &rng)
 {
-  switch(branch) //Decomposition of the CCZ gate into Cliffords
+  const std::vector<unsigned char> gates = sample_toffoli_branches(rng);
+  std::vector<unsigned char> mask(num_states_);
+  auto select = [&](unsigned char gate)
   {
-    case 1:
-      states_[rank].CZ(control_1, control_2);
-      break;
-    case 2:
-      states_[rank].CZ(control_1, target);
-      break;
-    case 3:
-      states_[rank].CZ(control_2, target);
-      break;
-    case 4:
-      states_[rank].CZ(control_1, control_2);
-      states_[rank].CZ(control_1, target);
-      states_[rank].Z(control_1);
-      break;
-    case 5:
-      states_[rank].CZ(control_1, control_2);
-      states_[rank].CZ(control_2, target);
-      states_[rank].Z(control_2);
-      break;
-    case 6:
-      states_[rank].CZ(control_1, target);
-      states_[rank].CZ(control_2, target);
-      states_[rank].Z(target);
-      break;
-    case 7:
-      states_[rank].CZ(control_1, control_2);
-      states_[rank].CZ(control_1, target);
-      states_[rank].CZ(control_2, target);
-      states_[rank].Z(control_1);
-      states_[rank].Z(control_2);
-      states_[rank].Z(target);
-      coefficients_[rank] *= -1; //Additional phase
-      break;
-    default: //Identity
-      break;
-  }
+    for(uint_t i=0; i<num_states_; i++)
+      mask[i] = !!(gates[i] & gate);
+    return mask.data();
+  };
+  states_.CZ(control_1, control_2, select(TOFF_CZ12));
+  states_.CX(control_1, target, select(TOFF_CX1));
+  states_.CX(control_2, target, select(TOFF_CX2));
+  states_.Z(control_1, select(TOFF_Z1));
+  states_.Z(control_2, select(TOFF_Z2));
+  states_.X(target, select(TOFF_XT));
+}
+
+void Runner::apply_ccz(uint_t control_1, uint_t control_2, uint_t target, AER::RngEngine &rng)
+{
+  const std::vector<unsigned char> gates = sample_toffoli_branches(rng);
+  std::vector<unsigned char> mask(num_states_);
+  auto select = [&](unsigned char gate)
+  {
+    for(uint_t i=0; i<num_states_; i++)
+      mask[i] = !!(gates[i] & gate);
+    return mask.data();
+  };
+  states_.CZ(control_1, control_2, select(TOFF_CZ12));
+  states_.CZ(control_1, target, select(TOFF_CX1));
+  states_.CZ(control_2, target, select(TOFF_CX2));
+  states_.Z(control_1, select(TOFF_Z1));
+  states_.Z(control_2, select(TOFF_Z2));
+  states_.Z(target, select(TOFF_XT));
 }
 
 //-------------------------------------------------------------------------
@@ -442,7 +429,8 @@ double Runner::norm_estimation(uint_t n_samples, AER::RngEngine &rng)
     }
   }
   } // end omp parallel
-  return ParallelNormEstimate(states_, coefficients_, adiag_1, adiag_2, a, num_threads_);
+  states_.PrepareAmplitudes();
+  return states_.NormEstimate(adiag_1, adiag_2, a);
 }
 
 double Runner::norm_estimation(uint_t n_samples, std::vector<pauli_t> generators, AER::RngEngine &rng)
@@ -480,20 +468,9 @@ void Runner::init_metropolis(AER::RngEngine &rng)
   uint_t max = (1ULL<<n_qubits_) - 1;
   x_string_ = rng.rand_int(ZERO, max);
   last_proposal_=0;
-  double local_real=0., local_imag=0.;
-  const int_t END = num_states_;
-  #pragma omp parallel for if(num_states_ > omp_threshold_ && num_threads_ > 1) num_threads(num_threads_) reduction(+:local_real) reduction(+:local_imag)
-  for (int_t i=0; i<END; i++)
-  {
-    scalar_t amp = states_[i].Amplitude(x_string_);
-    if(amp.eps == 1)
-    {
-      complex_t local = (amp.to_complex() * coefficients_[i]);
-      local_real += local.real();
-      local_imag += local.imag();
-    }
-  }
-  old_ampsum_ = complex_t(local_real, local_imag);
+  states_.PrepareAmplitudes();
+  states_.PauliX(x_string_, current_paulis_);
+  old_ampsum_ = states_.Amplitude(current_paulis_);
 }
 
 void Runner::metropolis_step(AER::RngEngine &rng)
@@ -502,40 +479,10 @@ void Runner::metropolis_step(AER::RngEngine &rng)
   if(accept_)
   {
     x_string_ ^= (one << last_proposal_);
+    current_paulis_.swap(proposed_paulis_);
   }
-  double real_part = 0.,imag_part =0.;
-  if (accept_ == 0)
-  {
-    const int_t END = num_states_;
-    #pragma omp parallel for if(num_states_ > omp_threshold_ && num_threads_ > 1) num_threads(num_threads_) reduction(+:real_part) reduction(+:imag_part)
-    for (int_t i=0; i<END; i++)
-    {
-      scalar_t amp = states_[i].ProposeFlip(proposal);
-      if(amp.eps == 1)
-      {
-        complex_t local = (amp.to_complex() * coefficients_[i]);
-        real_part += local.real();
-        imag_part += local.imag();
-      }
-    }
-  }
-  else
-  {
-    const int_t END = num_states_;
-    #pragma omp parallel for if(num_states_ > omp_threshold_ && num_threads_ > 1) num_threads(num_threads_) reduction(+:real_part) reduction(+:imag_part)
-    for (int_t i=0; i<END; i++)
-    {
-      states_[i].AcceptFlip();
-      scalar_t amp = states_[i].ProposeFlip(proposal);
-      if(amp.eps == 1)
-      {
-        complex_t local = (amp.to_complex() * coefficients_[i]);
-        real_part += local.real();
-        imag_part += local.imag();
-      }
-    }
-  }
-  complex_t ampsum(real_part, imag_part);
+  states_.FlipPauliX(proposal, current_paulis_, proposed_paulis_);
+  complex_t ampsum = states_.Amplitude(proposed_paulis_);
   double p_threshold = std::norm(ampsum)/std::norm(old_ampsum_);
   #ifdef  __FAST_MATH__ //isnan doesn't behave well under fastmath, so use absolute tolerance check instead
   if(std::isinf(p_threshold) || std::abs(std::norm(old_ampsum_)-0.) < 1e-8)
@@ -566,7 +513,7 @@ void Runner::metropolis_step(AER::RngEngine &rng)
 uint_t Runner::stabilizer_sampler(AER::RngEngine &rng)
 {
   uint_t max = (1ULL << n_qubits_) -1;
-  return states_[0].Sample(rng.rand_int(ZERO, max));
+  return states_.Sample(0, rng.rand_int(ZERO, max));
 }
 
 std::vector<uint_t> Runner::stabilizer_sampler(uint_t n_shots, AER::RngEngine &rng)
@@ -586,38 +533,63 @@ std::vector<uint_t> Runner::stabilizer_sampler(uint_t n_shots, AER::RngEngine &r
 
 complex_t Runner::amplitude(uint_t x_measure)
 {
-  double real_part=0., imag_part=0.;
-  //Splitting the reduction guarantees support on more OMP versions.
-  const int_t END = num_states_;
-  #pragma omp parallel for if(num_states_ > omp_threshold_ && num_threads_ > 1) num_threads(num_threads_) reduction(+:real_part) reduction(+:imag_part)
-  for(int_t i=0; i<END; i++)
-  {
-    complex_t amplitude = states_[i].Amplitude(x_measure).to_complex();
-    amplitude *= coefficients_[i];
-    real_part += amplitude.real();
-    imag_part += amplitude.imag();
-  }
-  return complex_t(real_part, imag_part);
+  states_.PrepareAmplitudes();
+  PauliArray paulis;
+  states_.PauliX(x_measure, paulis);
+  return states_.Amplitude(paulis);
 }
 
 void Runner::state_vector(std::vector<complex_t> &svector, AER::RngEngine &rng)
 {
-  uint_t ceil = 1ULL << n_qubits_;
-  if (!svector.empty())
-  {
-    svector.clear();
-  }
-  svector.reserve(ceil);
-  // double norm = 1;
+  const uint_t ceil = 1ULL << n_qubits_;
+  svector.assign(ceil, complex_t(0., 0.));
   double norm = 1;
   if(num_states_ > 1)
   {
     norm = norm_estimation(40, rng);
   }
-  for(uint_t i=0; i<ceil; i++)
+  const double scale = 1./std::sqrt(norm);
+  // Basis states are split into blocks of 2^block_bits consecutive indices.
+  // Blocks are distributed over threads and each block is enumerated in
+  // Gray-code order, so every amplitude after the first in a block is a
+  // single-bit update of the previous Pauli U_C^{-1}X(x)U_C of each term.
+  const uint_t block_bits = std::min<uint_t>(n_qubits_, 8);
+  const uint_t block_size = 1ULL << block_bits;
+  const int_t NBLOCKS = ceil >> block_bits;
+  // The sweeps over the terms of each amplitude are serial when the blocks
+  // are distributed over threads
+  const bool parallel_blocks = (NBLOCKS > 1 && num_threads_ > 1);
+  states_.PrepareAmplitudes();
+  if (parallel_blocks)
+    states_.initialize_omp(1, omp_threshold_);
+  #pragma omp parallel if(parallel_blocks) num_threads(num_threads_)
   {
-    svector.push_back(amplitude(i)/std::sqrt(norm));
-  }
+    PauliArray paulis(num_states_);
+    PauliArray flipped(num_states_);
+    #pragma omp for
+    for(int_t block=0; block<NBLOCKS; block++)
+    {
+      uint_t x = block * block_size;
+      states_.PauliX(x, paulis);
+      for(uint_t k=0; k<block_size; k++)
+      {
+        if(k > 0)
+        {
+          // the k-th Gray code differs from the previous one in the lowest set bit of k
+          unsigned pos = 0;
+          while(!((k >> pos) & 1ULL))
+          {
+            pos++;
+          }
+          x ^= (1ULL << pos);
+          states_.FlipPauliX(pos, paulis, flipped);
+          paulis.swap(flipped);
+        }
+        svector[x] = states_.Amplitude(paulis) * scale;
+      }
+    }
+  } // end omp parallel
+  states_.initialize_omp(num_threads_, omp_threshold_);
 }
 
 //=========================================================================
@@ -651,11 +623,11 @@ json_t Runner::serialize_state(uint_t rank) const
   std::vector<uint_t> F;
   std::vector<uint_t> G;
   gamma.reserve(n_qubits_);
-  M = states_[rank].MMatrix();
-  F = states_[rank].FMatrix();
-  G = states_[rank].GMatrix();
-  uint_t gamma1 = states_[rank].Gamma1();
-  uint_t gamma2 = states_[rank].Gamma2();
+  M = states_.MMatrix(rank);
+  F = states_.FMatrix(rank);
+  G = states_.GMatrix(rank);
+  uint_t gamma1 = states_.Gamma1(rank);
+  uint_t gamma2 = states_.Gamma2(rank);
   for(uint_t i=0; i<n_qubits_; i++)
   {
     gamma.push_back(((gamma1 >> i) & 1ULL) + 2*((gamma2 >> i) & 1ULL));
@@ -664,8 +636,8 @@ json_t Runner::serialize_state(uint_t rank) const
   js["M"] = M;
   js["F"] = F;
   js["G"] = G;
-  js["internal_cofficient"] = states_[rank].Omega().to_complex();
-  js["coefficient"] = coefficients_[rank];
+  js["internal_cofficient"] = states_.Omega(rank).to_complex();
+  js["coefficient"] = states_.Coefficient(rank);
   return js;
 }
 
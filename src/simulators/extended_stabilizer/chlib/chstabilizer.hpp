@@ -86,6 +86,16 @@ public:
 
   // measurements
   scalar_t Amplitude(uint_fast64_t x); // computes the  amplitude <x|phi>
+
+  // Read-only amplitude evaluation, safe to call from several threads
+  // once PrepareAmplitudes() has been called on the state.
+  // For a basis state x the Pauli R=U_C^{-1}X(x)U_C is updated in O(1)
+  // when x changes by a single bit, so amplitudes can be enumerated in
+  // Gray-code order at O(n) cost each.
+  void PrepareAmplitudes(); // computes F-transposed and M-transposed
+  pauli_t PauliX(uint_fast64_t x) const; // returns U_C^{-1}X(x)U_C
+  void FlipPauliX(unsigned pos, pauli_t& R) const; // R gets U_C^{-1}X_{pos}U_C * R
+  scalar_t PauliAmplitude(const pauli_t& R) const; // amplitude <x|phi> for R=U_C^{-1}X(x)U_C
   uint_fast64_t Sample(); // returns a sample from the distribution |<x|phi>|^2
   uint_fast64_t Sample(uint_fast64_t v_mask);
   void MeasurePauli(const pauli_t P); // applies a gate (I+P)/2 
@@ -119,6 +129,7 @@ public:
                         int n_threads);
   #endif
 
+
 private:
 
   unsigned n; 
@@ -410,6 +421,12 @@ void StabilizerState::CZ(unsigned q, unsigned r)
 pauli_t StabilizerState::GetPauliX(uint_fast64_t x)
 {
   // make sure that M-transposed and F-transposed have been already computed
+  PrepareAmplitudes();
+  return PauliX(x);
+}
+
+void StabilizerState::PrepareAmplitudes()
+{
   if (!isReadyMT)
   {
     TransposeM();
@@ -418,8 +435,11 @@ pauli_t StabilizerState::GetPauliX(uint_fast64_t x)
   {
     TransposeF();
   }
-  pauli_t R;
+}
 
+pauli_t StabilizerState::PauliX(uint_fast64_t x) const
+{
+  pauli_t R;
   for (unsigned pos=0; pos<n; pos++)
   {
     if (x & (one<<pos))
@@ -432,119 +452,63 @@ pauli_t StabilizerState::GetPauliX(uint_fast64_t x)
       R*=P1;
     }
   }
- return R;
+  return R;
 }
 
-scalar_t StabilizerState::Amplitude(uint_fast64_t x)
+void StabilizerState::FlipPauliX(unsigned pos, pauli_t& R) const
 {
-  // compute transposed matrices if needed
-  if (!isReadyMT)
-  {
-    TransposeM();
-  }
-  if (!isReadyFT)
-  {
-    TransposeF();
-  }
-  // compute Pauli U_C^{-1} X(x) U_C
-  P=GetPauliX(x);
+  // same update as ProposeFlip, with the result written back to R
+  pauli_t P1;
+  P1.e=1*((gamma1>>pos) & one);
+  P1.e+=2*((gamma2>>pos) & one);
+  P1.X=FT[pos];
+  P1.Z=MT[pos];
+  P1*=R;
+  R=P1;
+}
 
+scalar_t StabilizerState::PauliAmplitude(const pauli_t& R) const
+{
   if (!omega.eps) return omega; // the state is zero
 
-  // now the amplitude = complex conjugate of <s|U_H P |0^n>
-  // Z-part of P is absorbed into 0^n
+  // now the amplitude = complex conjugate of <s|U_H R |0^n>
+  // Z-part of R is absorbed into 0^n
 
   scalar_t amp;
-  amp.e=2*P.e;
-  int p = (int) hamming_weight(v);
-  amp.p= -1 * p;// each Hadamard gate contributes 1/sqrt(2)
-  bool isNonZero=true;
-
-
-  for (unsigned q=0; q<n; q++)
-  {
-    uint_fast64_t pos=(one<<q);
-    if (v & pos)
-    {
-      amp.e += 4*( (s & pos) && (P.X & pos) ); // minus sign that comes from <1|H|1>
-    }
-    else
-    {
-      isNonZero=( ((P.X & pos)==(s & pos)) );
-    }
-    if (!isNonZero) break;
-  }
-
-
-  amp.e%=8;
-  if (isNonZero)
-  {
-    amp.conjugate();
-  }
-  else
+  amp.e=2*R.e;
+  amp.p=-1*(hamming_weight(v));// each Hadamard gate contributes 1/sqrt(2)
+  // minus sign that comes from <1|H|1>
+  amp.e+=4*hamming_parity(v & s & R.X);
+  // outside the H-layer R.X must agree with s
+  if (((R.X ^ s) & ~v) != zer)
   {
     amp.eps=0;
     return amp;
   }
 
+  amp.e%=8;
+  amp.conjugate();
+
   // multiply amp by omega
   amp.p+=omega.p;
   amp.e=(amp.e + omega.e) % 8;
   return amp;
 }
 
+scalar_t StabilizerState::Amplitude(uint_fast64_t x)
+{
+  // compute Pauli U_C^{-1} X(x) U_C
+  P=GetPauliX(x);
+  return PauliAmplitude(P);
+}
+
 scalar_t StabilizerState::ProposeFlip(unsigned flip_pos)
 {
   // Q gets Pauli operator U_C^{-1} X_{flip_pos} U_C
-  Q.e=1*((gamma1>>flip_pos) & one);
-  Q.e+=2*((gamma2>>flip_pos) & one);
-  Q.X=FT[flip_pos];
-  Q.Z=MT[flip_pos];
-  Q*=P;
-
-  if (!omega.eps) return omega; // the state is zero
-
-  // the rest is the same as Amplitude() except that P becomes Q
-
-  // now the amplitude = complex conjugate of <s|U_H Q |0^n>
-  // Z-part of Q is absorbed into 0^n
-
+  Q=P;
+  FlipPauliX(flip_pos, Q);
   // the rest is the same as Amplitude() except that P is replaced by Q
-
-  scalar_t amp;
-  amp.e=2*Q.e;
-  amp.p=-1*(hamming_weight(v));// each Hadamard gate contributes 1/sqrt(2)
-  bool isNonZero=true;
-
-  for (unsigned q=0; q<n; q++)
-  {
-    uint_fast64_t pos=(one<<q);
-    if (v & pos)
-    {
-      amp.e+=4*( (s & pos) && (Q.X & pos) ); // minus sign that comes from <1|H|1>
-    }
-    else
-    {
-      isNonZero=( ((Q.X & pos)==(s & pos)) );
-    }
-    if (!isNonZero) break;
-  }
-
-  amp.e%=8;
-  if (isNonZero)
-  {
-    amp.conjugate();
-  }
-  else
-  {
-    amp.eps=0;
-    return amp;
-  }
-
-  // multiply amp by omega
-  amp.p+=omega.p;
-  amp.e=(amp.e + omega.e) % 8;
-  return amp;
+  return PauliAmplitude(Q);
 }
 
 uint_fast64_t StabilizerState::Sample()
@@ -0,0 +1,1100 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef CH_STABILIZER_ARRAY_HPP
+#define CH_STABILIZER_ARRAY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core.hpp"
+
+namespace CHSimulator
+{
+
+// Pauli operators i^e X(x) Z(z) for every term of a decomposition,
+// stored as one array per field.
+struct PauliArray
+{
+  std::vector<uint_fast64_t> X;
+  std::vector<uint_fast64_t> Z;
+  std::vector<unsigned> e;
+
+  PauliArray() = default;
+  PauliArray(uint_fast64_t size): X(size, zer), Z(size, zer), e(size, 0) {};
+
+  void swap(PauliArray& rhs)
+  {
+    X.swap(rhs.X);
+    Z.swap(rhs.Z);
+    e.swap(rhs.e);
+  }
+};
+
+// Decomposition sum_i c_i |phi_i> of a state into CH-form stabilizer states,
+// with the CH-data (F,G,M,gamma,v,s,omega) of the terms stored as one array
+// per field (e.g. F[q*size + i] is the q-th column of F for term i).
+// Gates are applied as sweeps over all terms, and each sweep reads and
+// writes the same field of consecutive terms. The per-term updates are the
+// ones of StabilizerState, see Section IIIA of arXiv:1808.00128.
+class StabilizerStateArray
+{
+public:
+  StabilizerStateArray(): n_(0), size_(0), omp_threads_(1), omp_threshold_(0) {};
+
+  uint_fast64_t size() const
+  {
+    return size_;
+  }
+
+  unsigned NQubits() const
+  {
+    return n_;
+  }
+
+  // Set the threads of the sweeps over the terms. With a single thread the
+  // sweeps are serial and can be called from inside a parallel region.
+  void initialize_omp(uint_fast64_t n_threads, uint_fast64_t threshold_size);
+
+  // Set a single term |00...0> with coefficient 1
+  void Initialize(unsigned n_qubits);
+  // Replace the terms by n_terms copies of the first term
+  void Replicate(uint_fast64_t n_terms);
+
+  // CH-data of term i
+  bool IsZero(uint_fast64_t i) const
+  {
+    return eps_[i] == 0;
+  }
+  scalar_t Omega(uint_fast64_t i) const;
+  uint_fast64_t Gamma1(uint_fast64_t i) const
+  {
+    return gamma1_[i];
+  }
+  uint_fast64_t Gamma2(uint_fast64_t i) const
+  {
+    return gamma2_[i];
+  }
+  std::vector<uint_fast64_t> FMatrix(uint_fast64_t i) const;
+  std::vector<uint_fast64_t> GMatrix(uint_fast64_t i) const;
+  std::vector<uint_fast64_t> MMatrix(uint_fast64_t i) const;
+  complex_t& Coefficient(uint_fast64_t i)
+  {
+    return coefficients_[i];
+  }
+  const complex_t& Coefficient(uint_fast64_t i) const
+  {
+    return coefficients_[i];
+  }
+
+  // Clifford gates applied to every term with a nonzero omega.
+  // If mask is not null only the terms with a nonzero mask entry are updated.
+  void CX(unsigned q, unsigned r, const unsigned char* mask = nullptr); // q=control, r=target
+  void CZ(unsigned q, unsigned r, const unsigned char* mask = nullptr);
+  void H(unsigned q, const unsigned char* mask = nullptr);
+  void S(unsigned q, const unsigned char* mask = nullptr);
+  void Sdag(unsigned q, const unsigned char* mask = nullptr);
+  void Z(unsigned q, const unsigned char* mask = nullptr);
+  void X(unsigned q, const unsigned char* mask = nullptr);
+  void Y(unsigned q, const unsigned char* mask = nullptr);
+
+  // Applies the gates (I+P)/2 for the generators P to every term
+  void MeasurePauliProjector(const std::vector<pauli_t>& generators);
+
+  // Returns a sample from the distribution |<x|phi_i>|^2 of term i, where
+  // v_mask is a uniform random binary string
+  uint_fast64_t Sample(uint_fast64_t i, uint_fast64_t v_mask) const;
+
+  // Computes the transposed F and M matrices of the terms changed since the
+  // last call. The methods below are read-only and need this to be called
+  // after the last gate, after which they are safe to call from several threads.
+  void PrepareAmplitudes();
+
+  // R gets U_C^{-1}X(x)U_C for every term
+  void PauliX(uint_fast64_t x, PauliArray& R) const;
+  // Q gets U_C^{-1}X_{pos}U_C * R for every term
+  void FlipPauliX(unsigned pos, const PauliArray& R, PauliArray& Q) const;
+  // Returns sum_i c_i <x|phi_i> where R holds U_C^{-1}X(x)U_C for every term
+  complex_t Amplitude(const PauliArray& R) const;
+
+  // Norm estimate of the decomposition from the samples of the random
+  // quadratic forms A, as NormEstimate for a vector of StabilizerState
+  double NormEstimate(const std::vector<uint_fast64_t>& Samples_d1,
+                      const std::vector<uint_fast64_t>& Samples_d2,
+                      const std::vector< std::vector<uint_fast64_t> >& Samples) const;
+
+private:
+  // True if the sweeps over the terms are split over threads
+  bool parallel() const
+  {
+    return size_ > omp_threshold_ && omp_threads_ > 1;
+  }
+
+  // Calls func(i) for every term i with a nonzero omega and mask entry
+  template <typename Lambda>
+  void Sweep(Lambda func, const unsigned char* mask = nullptr);
+
+  // Entries of the columns of F,G,M and of the rows of F and M of term i
+  uint_fast64_t& F(unsigned q, uint_fast64_t i) {return F_[q*size_ + i];}
+  uint_fast64_t& G(unsigned q, uint_fast64_t i) {return G_[q*size_ + i];}
+  uint_fast64_t& M(unsigned q, uint_fast64_t i) {return M_[q*size_ + i];}
+  uint_fast64_t& FT(unsigned q, uint_fast64_t i) {return FT_[q*size_ + i];}
+  uint_fast64_t& MT(unsigned q, uint_fast64_t i) {return MT_[q*size_ + i];}
+  uint_fast64_t G(unsigned q, uint_fast64_t i) const {return G_[q*size_ + i];}
+  uint_fast64_t FT(unsigned q, uint_fast64_t i) const {return FT_[q*size_ + i];}
+  uint_fast64_t MT(unsigned q, uint_fast64_t i) const {return MT_[q*size_ + i];}
+
+  // Updates of term i
+  void TermCX(uint_fast64_t i, unsigned q, unsigned r);
+  void TermCZ(uint_fast64_t i, unsigned q, unsigned r);
+  void TermH(uint_fast64_t i, unsigned q);
+  void TermS(uint_fast64_t i, unsigned q);
+  void TermSdag(uint_fast64_t i, unsigned q);
+  void TermZ(uint_fast64_t i, unsigned q);
+  void TermX(uint_fast64_t i, unsigned q);
+  void TermMeasurePauli(uint_fast64_t i, const pauli_t& PP);
+  // multiplies the C-layer of term i on the right by a C-type gate
+  void TermRightCX(uint_fast64_t i, unsigned q, unsigned r);
+  void TermRightCZ(uint_fast64_t i, unsigned q, unsigned r);
+  void TermRightS(uint_fast64_t i, unsigned q);
+  // replace the initial state |s> of term i by (|t> + i^b |u>)*sqrt(1/2)
+  void TermUpdateSvector(uint_fast64_t i, uint_fast64_t t, uint_fast64_t u, unsigned b);
+  void TermTransposeF(uint_fast64_t i);
+  void TermTransposeM(uint_fast64_t i);
+  // <phi_i|A> for a random quadratic form A, needs the transposed F and M
+  scalar_t TermInnerProduct(uint_fast64_t i, uint_fast64_t A_diag1, uint_fast64_t A_diag2,
+                            const std::vector<uint_fast64_t>& A) const;
+
+  template <typename T>
+  static void ReplicateField(std::vector<T>& field, unsigned rows,
+                             uint_fast64_t size, uint_fast64_t n_terms);
+
+  unsigned n_;
+  uint_fast64_t size_;
+  uint_fast64_t omp_threads_;
+  uint_fast64_t omp_threshold_;
+
+  // columns of F, G and M, F[q*size_ + i] = q-th column of F for term i
+  std::vector<uint_fast64_t> F_;
+  std::vector<uint_fast64_t> G_;
+  std::vector<uint_fast64_t> M_;
+  // rows of F and M, FT[q*size_ + i] = q-th row of F for term i
+  std::vector<uint_fast64_t> FT_;
+  std::vector<uint_fast64_t> MT_;
+  // true if the rows of F and M of the term are up to date
+  std::vector<unsigned char> readyFT_;
+  std::vector<unsigned char> readyMT_;
+  std::vector<uint_fast64_t> gamma1_;
+  std::vector<uint_fast64_t> gamma2_;
+  std::vector<uint_fast64_t> v_;
+  std::vector<uint_fast64_t> s_;
+  // omega = eps * 2^{p/2} * exp(i (pi/4)*e)
+  std::vector<int> eps_;
+  std::vector<int> p_;
+  std::vector<int> e_;
+  // magnitude 2^{(p - |v|)/2} shared by all amplitudes of the term,
+  // computed by PrepareAmplitudes
+  std::vector<double> mag_;
+  std::vector<complex_t> coefficients_;
+};
+
+//-------------------------------//
+// Implementation                //
+//-------------------------------//
+
+void StabilizerStateArray::initialize_omp(uint_fast64_t n_threads, uint_fast64_t threshold_size)
+{
+  omp_threads_ = (n_threads == 0 ? 1 : n_threads);
+  omp_threshold_ = threshold_size;
+}
+
+void StabilizerStateArray::Initialize(unsigned n_qubits)
+{
+  if(n_qubits>63)
+  {
+    throw std::invalid_argument("The CH simulator only supports up to 63 qubits.\n");
+  }
+  n_ = n_qubits;
+  size_ = 1;
+  // G and F are identity matrices, M is zero matrix
+  F_.assign(n_, zer);
+  G_.assign(n_, zer);
+  M_.assign(n_, zer);
+  for (unsigned q=0; q<n_; q++)
+  {
+    G_[q] = (one<<q);
+    F_[q] = (one<<q);
+  }
+  FT_.assign(n_, zer);
+  MT_.assign(n_, zer);
+  readyFT_.assign(1, 0);
+  readyMT_.assign(1, 0);
+  gamma1_.assign(1, zer);
+  gamma2_.assign(1, zer);
+  v_.assign(1, zer);
+  s_.assign(1, zer);
+  eps_.assign(1, 1);
+  p_.assign(1, 0);
+  e_.assign(1, 0);
+  mag_.assign(1, 1.);
+  coefficients_.assign(1, complex_t(1., 0.));
+}
+
+template <typename T>
+void StabilizerStateArray::ReplicateField(std::vector<T>& field, unsigned rows,
+                                          uint_fast64_t size, uint_fast64_t n_terms)
+{
+  std::vector<T> replicated(rows*n_terms);
+  for (unsigned q=0; q<rows; q++)
+  {
+    std::fill(replicated.begin() + q*n_terms, replicated.begin() + (q+1)*n_terms,
+              field[q*size]);
+  }
+  field.swap(replicated);
+}
+
+void StabilizerStateArray::Replicate(uint_fast64_t n_terms)
+{
+  ReplicateField(F_, n_, size_, n_terms);
+  ReplicateField(G_, n_, size_, n_terms);
+  ReplicateField(M_, n_, size_, n_terms);
+  ReplicateField(FT_, n_, size_, n_terms);
+  ReplicateField(MT_, n_, size_, n_terms);
+  ReplicateField(readyFT_, 1, size_, n_terms);
+  ReplicateField(readyMT_, 1, size_, n_terms);
+  ReplicateField(gamma1_, 1, size_, n_terms);
+  ReplicateField(gamma2_, 1, size_, n_terms);
+  ReplicateField(v_, 1, size_, n_terms);
+  ReplicateField(s_, 1, size_, n_terms);
+  ReplicateField(eps_, 1, size_, n_terms);
+  ReplicateField(p_, 1, size_, n_terms);
+  ReplicateField(e_, 1, size_, n_terms);
+  ReplicateField(mag_, 1, size_, n_terms);
+  ReplicateField(coefficients_, 1, size_, n_terms);
+  size_ = n_terms;
+}
+
+scalar_t StabilizerStateArray::Omega(uint_fast64_t i) const
+{
+  scalar_t omega;
+  omega.eps = eps_[i];
+  omega.p = p_[i];
+  omega.e = e_[i];
+  return omega;
+}
+
+std::vector<uint_fast64_t> StabilizerStateArray::FMatrix(uint_fast64_t i) const
+{
+  std::vector<uint_fast64_t> columns(n_);
+  for (unsigned q=0; q<n_; q++)
+  {
+    columns[q] = F_[q*size_ + i];
+  }
+  return columns;
+}
+
+std::vector<uint_fast64_t> StabilizerStateArray::GMatrix(uint_fast64_t i) const
+{
+  std::vector<uint_fast64_t> columns(n_);
+  for (unsigned q=0; q<n_; q++)
+  {
+    columns[q] = G_[q*size_ + i];
+  }
+  return columns;
+}
+
+std::vector<uint_fast64_t> StabilizerStateArray::MMatrix(uint_fast64_t i) const
+{
+  std::vector<uint_fast64_t> columns(n_);
+  for (unsigned q=0; q<n_; q++)
+  {
+    columns[q] = M_[q*size_ + i];
+  }
+  return columns;
+}
+
+template <typename Lambda>
+void StabilizerStateArray::Sweep(Lambda func, const unsigned char* mask)
+{
+  const int_t END = size_;
+  if (parallel())
+  {
+    #pragma omp parallel for num_threads(omp_threads_)
+    for (int_t i=0; i<END; i++)
+      if (eps_[i] && (!mask || mask[i]))
+        func(i);
+  }
+  else
+  {
+    for (int_t i=0; i<END; i++)
+      if (eps_[i] && (!mask || mask[i]))
+        func(i);
+  }
+}
+
+//-------------------------------------------------------------------------
+// Gates
+//-------------------------------------------------------------------------
+
+void StabilizerStateArray::CX(unsigned q, unsigned r, const unsigned char* mask)
+{
+  Sweep([&](uint_fast64_t i) {TermCX(i, q, r);}, mask);
+}
+
+void StabilizerStateArray::CZ(unsigned q, unsigned r, const unsigned char* mask)
+{
+  Sweep([&](uint_fast64_t i) {TermCZ(i, q, r);}, mask);
+}
+
+void StabilizerStateArray::H(unsigned q, const unsigned char* mask)
+{
+  Sweep([&](uint_fast64_t i) {TermH(i, q);}, mask);
+}
+
+void StabilizerStateArray::S(unsigned q, const unsigned char* mask)
+{
+  Sweep([&](uint_fast64_t i) {TermS(i, q);}, mask);
+}
+
+void StabilizerStateArray::Sdag(unsigned q, const unsigned char* mask)
+{
+  Sweep([&](uint_fast64_t i) {TermSdag(i, q);}, mask);
+}
+
+void StabilizerStateArray::Z(unsigned q, const unsigned char* mask)
+{
+  Sweep([&](uint_fast64_t i) {TermZ(i, q);}, mask);
+}
+
+void StabilizerStateArray::X(unsigned q, const unsigned char* mask)
+{
+  Sweep([&](uint_fast64_t i) {TermX(i, q);}, mask);
+}
+
+void StabilizerStateArray::Y(unsigned q, const unsigned char* mask)
+{
+  Sweep([&](uint_fast64_t i)
+  {
+    TermZ(i, q);
+    TermX(i, q);
+    //Add a global phase of -i
+    e_[i] = (e_[i] + 2) % 8;
+  }, mask);
+}
+
+void StabilizerStateArray::MeasurePauliProjector(const std::vector<pauli_t>& generators)
+{
+  Sweep([&](uint_fast64_t i)
+  {
+    for (const auto& generator : generators)
+    {
+      TermMeasurePauli(i, generator);
+      if (eps_[i] == 0)
+      {
+        break;
+      }
+    }
+  });
+}
+
+void StabilizerStateArray::TermS(uint_fast64_t i, unsigned q)
+{
+  readyMT_[i] = 0; // we are going to change M
+  uint_fast64_t C = (one<<q);
+  for (unsigned p=0; p<n_; p++)
+  {
+    M(p, i) ^= ((G(p, i)>>q) & one)*C;
+  }
+  // update phase vector:  gamma[q] gets gamma[q] - 1
+  gamma1_[i] ^= C;
+  gamma2_[i] ^= ((gamma1_[i] >> q) & one)*C;
+}
+
+void StabilizerStateArray::TermSdag(uint_fast64_t i, unsigned q)
+{
+  readyMT_[i] = 0; // we are going to change M
+  uint_fast64_t C = (one<<q);
+  for (unsigned p=0; p<n_; p++)
+  {
+    M(p, i) ^= ((G(p, i)>>q) & one)*C;
+  }
+  // update phase vector:  gamma[q] gets gamma[q] + 1
+  gamma2_[i] ^= ((gamma1_[i] >> q) & one)*C;
+  gamma1_[i] ^= C;
+}
+
+void StabilizerStateArray::TermZ(uint_fast64_t i, unsigned q)
+{
+  // update phase vector:  gamma[q] gets gamma[q] + 2
+  gamma2_[i] ^= (one<<q);
+}
+
+void StabilizerStateArray::TermX(uint_fast64_t i, unsigned q)
+{
+  //Commute the Pauli through UC
+  if (!readyMT_[i])
+  {
+    TermTransposeM(i);
+  }
+  if (!readyFT_[i])
+  {
+    TermTransposeF(i);
+  }
+  uint_fast64_t x_string = FT(q, i);
+  uint_fast64_t z_string = MT(q, i);
+  uint_fast64_t& s = s_[i];
+  const uint_fast64_t v = v_[i];
+  //Initial phase correction
+  int phase = 2*((gamma1_[i] >> q) & one) + 4*((gamma2_[i] >> q) & one);
+  //Commute the z_string through the hadamard layer
+  // Each z that hits a hadamard becomes a Pauli X
+  s ^= (z_string & v);
+  //Remaining Z gates add a global phase from their action on the s string
+  phase += 4*(hamming_parity((z_string & ~(v)) & s));
+  //Commute the x_string through the hadamard layer
+  // Any remaining X gates update s
+  s ^= (x_string & ~(v));
+  //New z gates add a global phase from their action on the s string
+  phase += 4*(hamming_parity((x_string & v) & s));
+  //Update the global phase
+  e_[i] = (e_[i] + phase) % 8;
+}
+
+void StabilizerStateArray::TermCX(uint_fast64_t i, unsigned q, unsigned r)
+{
+  readyMT_[i] = 0; // we are going to change M and F
+  readyFT_[i] = 0;
+  uint_fast64_t C = (one<<q);
+  uint_fast64_t T = (one<<r);
+  bool b = false;
+  for (unsigned p=0; p<n_; p++)
+  {
+    b = (b != ((M(p, i) & C) && (F(p, i) & T)));
+    G(p, i) ^= ((G(p, i)>>q) & one)*T;
+    F(p, i) ^= ((F(p, i)>>r) & one)*C;
+    M(p, i) ^= ((M(p, i)>>r) & one)*C;
+  }
+  // update phase vector as
+  // gamma[q] gets gamma[q] + gamma[r] + 2*b (mod 4)
+  uint_fast64_t& gamma1 = gamma1_[i];
+  uint_fast64_t& gamma2 = gamma2_[i];
+  if (b) gamma2 ^= C;
+  b = ((gamma1 & C) && (gamma1 & T));
+  gamma1 ^= ((gamma1 >> r) & one)*C;
+  gamma2 ^= ((gamma2 >> r) & one)*C;
+  if (b) gamma2 ^= C;
+}
+
+void StabilizerStateArray::TermCZ(uint_fast64_t i, unsigned q, unsigned r)
+{
+  readyMT_[i] = 0; // we are going to change M
+  uint_fast64_t C = (one<<q);
+  uint_fast64_t T = (one<<r);
+  for (unsigned p=0; p<n_; p++)
+  {
+    M(p, i) ^= ((G(p, i)>>r) & one)*C;
+    M(p, i) ^= ((G(p, i)>>q) & one)*T;
+  }
+}
+
+void StabilizerStateArray::TermRightCX(uint_fast64_t i, unsigned q, unsigned r)
+{
+  G(q, i) ^= G(r, i);
+  F(r, i) ^= F(q, i);
+  M(q, i) ^= M(r, i);
+}
+
+void StabilizerStateArray::TermRightCZ(uint_fast64_t i, unsigned q, unsigned r)
+{
+  readyMT_[i] = 0; // we are going to change M
+  M(q, i) ^= F(r, i);
+  M(r, i) ^= F(q, i);
+  gamma2_[i] ^= (F(q, i) & F(r, i));
+}
+
+void StabilizerStateArray::TermRightS(uint_fast64_t i, unsigned q)
+{
+  readyMT_[i] = 0; // we are going to change M
+  M(q, i) ^= F(q, i);
+  // update phase vector: gamma[p] gets gamma[p] - F_{p,q} (mod 4)   for all p
+  gamma2_[i] ^= F(q, i) ^ (gamma1_[i] & F(q, i));
+  gamma1_[i] ^= F(q, i);
+}
+
+void StabilizerStateArray::TermUpdateSvector(uint_fast64_t i, uint_fast64_t t,
+                                             uint_fast64_t u, unsigned b)
+{
+  uint_fast64_t& s = s_[i];
+  uint_fast64_t& v = v_[i];
+  int& e = e_[i];
+  // take care of the trivial case: t=u
+  if (t==u)  // multiply omega by (1+i^b)/sqrt(2)
+  {
+    s = t;
+    switch(b)
+    {
+      case 0 :
+        p_[i] += 1;
+        return;
+      case 1 :
+        e = (e + 1) % 8;
+        return;
+      case 2 :
+        eps_[i] = 0;
+        return;
+      case 3 :
+        e = (e + 7) % 8;
+        return;
+      default :
+        // we should not get here
+        throw std::logic_error("Invalid phase factor found b:" + std::to_string(b) + ".\n");
+    }
+  }
+
+  // now t and u are distinct
+  readyFT_[i] = 0; // below we are going to change F and M
+  readyMT_[i] = 0;
+  // naming of variables roughly follows Section IIIA
+  uint_fast64_t ut = u^t;
+  uint_fast64_t nu0 = (~v) & ut;
+  uint_fast64_t nu1 = v & ut;
+  //
+  b %= 4;
+  unsigned q = 0;
+  uint_fast64_t qpos = zer;
+  if (nu0)
+  {
+    // the subset nu0 is non-empty
+    // find the first element of nu0
+    while (!(nu0 & (one<<q))) q++;
+    qpos = (one<<q);
+
+    // if nu0 has size >1 then multiply U_C on the right by the first half of the circuit VC
+    nu0 ^= qpos; // set q-th bit to zero
+    if (nu0)
+      for (unsigned q1=q+1; q1<n_; q1++)
+        if (nu0 & (one<<q1))
+          TermRightCX(i, q, q1);
+
+    // if nu1 has size >0 then apply the second half of the circuit VC
+    if (nu1)
+      for (unsigned q1=0; q1<n_; q1++)
+        if (nu1 & (one<<q1))
+          TermRightCZ(i, q, q1);
+  }
+  else
+  {
+    // if we got here when nu0 is empty
+    // find the first element of nu1
+    while (!(nu1 & (one<<q))) q++;
+    qpos = (one<<q);
+
+    // if nu1 has size >1 then apply the circuit VC
+    nu1 ^= qpos;
+    if (nu1)
+      for (unsigned q1=q+1; q1<n_; q1++)
+        if (nu1 & (one<<q1))
+          TermRightCX(i, q1, q);
+  }
+
+  // update the initial state
+  // if t_q=1 then switch t_q and u_q
+  if (t & qpos)
+  {
+    s = u;
+    e = (e + 2*b) % 8;
+    b = (4-b) % 4;
+  }
+  else
+    s = t;
+
+  // change the order of H and S gates, as in StabilizerState::UpdateSvector
+  // H^{a} S^{b} |+> = eta^{e1} S^{e2} H^{e3} |e4>
+  bool a = ((v & qpos) > 0);
+  unsigned e1 = a*(b % 2)*(3*b - 2);
+  unsigned e2 = b % 2;
+  bool e3 = ((!a) != (a && ((b % 2) > 0)));
+  bool e4 = (((!a) && (b >= 2)) != (a && ((b == 1) || (b == 2))));
+
+  // update CH-form
+  // set q-th bit of s to e4
+  s &= ~qpos;
+  s ^= e4*qpos;
+
+  // set q-th bit of v to e3
+  v &= ~qpos;
+  v ^= e3*qpos;
+
+  // update the scalar factor omega
+  e = (e + e1) % 8;
+
+  // multiply the C-layer on the right by S^{e2} on the q-th qubit
+  if (e2) TermRightS(i, q);
+}
+
+void StabilizerStateArray::TermH(uint_fast64_t i, unsigned q)
+{
+  readyMT_[i] = 0; // we are going to change M and F
+  readyFT_[i] = 0;
+  // extract the q-th row of F,G,M
+  uint_fast64_t rowF = zer;
+  uint_fast64_t rowG = zer;
+  uint_fast64_t rowM = zer;
+  for (unsigned j=0; j<n_; j++)
+  {
+    uint_fast64_t pos = (one<<j);
+    rowF ^= pos*((F(j, i)>>q) & one);
+    rowG ^= pos*((G(j, i)>>q) & one);
+    rowM ^= pos*((M(j, i)>>q) & one);
+  }
+  const uint_fast64_t s = s_[i];
+  const uint_fast64_t v = v_[i];
+
+  // after commuting H through the C and H laters it maps |s> to a state
+  // sqrt(0.5)*[  (-1)^alpha |t> + i^{gamma[p]} (-1)^beta |u>  ]
+  uint_fast64_t t = s ^ (rowG & v);
+  uint_fast64_t u = s ^ (rowF & (~v)) ^ (rowM & v);
+
+  unsigned alpha = hamming_weight(rowG & (~v) & s);
+  unsigned beta = hamming_weight((rowM & (~v) & s) ^ (rowF & v & (rowM ^ s)));
+
+  if (alpha % 2) e_[i] = (e_[i] + 4) % 8;
+  // get the phase gamma[q]
+  unsigned phase = ((gamma1_[i] >> q) & one) + 2*((gamma2_[i] >> q) & one);
+  unsigned b = (phase + 2*alpha + 2*beta) % 4;
+
+  // now the initial state is sqrt(0.5)*(|t> + i^b |u>)
+
+  // take care of the trivial case
+  if (t==u)
+  {
+    s_[i] = t;
+    if(!((b==1) || (b==3))) // otherwise the state is not normalized
+    {
+      throw std::logic_error("State is not properly normalised, b should be 1 or 3.\n");
+    }
+    if (b==1)
+      e_[i] = (e_[i] + 1) % 8;
+    else
+      e_[i] = (e_[i] + 7) % 8;
+  }
+  else
+    TermUpdateSvector(i, t, u, b);
+}
+
+void StabilizerStateArray::TermMeasurePauli(uint_fast64_t i, const pauli_t& PP)
+{
+  // compute Pauli R = U_C^{-1} P U_C
+  pauli_t R;
+  R.e = PP.e;
+
+  for (unsigned j=0; j<n_; j++)
+    if ((PP.X>>j) & one)
+    {
+      // multiply R by U_C^{-1} X_j U_C
+      // extract the j-th rows of F and M
+      uint_fast64_t rowF = zer;
+      uint_fast64_t rowM = zer;
+      for (unsigned k=0; k<n_; k++)
+      {
+        rowF ^= (one<<k)*((F(k, i)>>j) & one);
+        rowM ^= (one<<k)*((M(k, i)>>j) & one);
+      }
+      R.e += 2*hamming_weight(R.Z & rowF); // extra sign from Pauli commutation
+      R.Z ^= rowM;
+      R.X ^= rowF;
+      R.e += ((gamma1_[i]>>j) & one) + 2*((gamma2_[i]>>j) & one);
+    }
+  for (unsigned q=0; q<n_; q++)
+    R.Z ^= (one<<q)*(hamming_weight(PP.Z & G(q, i)) % 2);
+
+  // now R=U_C^{-1} PP U_C
+  // next conjugate R by U_H
+  const uint_fast64_t v = v_[i];
+  uint_fast64_t tempX = ((~v) & R.X) ^ (v & R.Z);
+  uint_fast64_t tempZ = ((~v) & R.Z) ^ (v & R.X);
+  // the sign flips each time a Hadamard hits Y on some qubit
+  R.e = (R.e + 2*hamming_weight(v & R.X & R.Z)) % 4;
+  R.X = tempX;
+  R.Z = tempZ;
+
+  // now the initial state |s> becomes 0.5*(|s> + R |s>) = 0.5*(|s> + i^b |s ^ R.X>)
+  const uint_fast64_t s = s_[i];
+  unsigned b = (R.e + 2*hamming_weight(R.Z & s)) % 4;
+  TermUpdateSvector(i, s, s ^ R.X, b);
+  // account for the extra factor sqrt(1/2)
+  p_[i] -= 1;
+
+  readyMT_[i] = 0; // we have changed change M and F
+  readyFT_[i] = 0;
+}
+
+void StabilizerStateArray::TermTransposeF(uint_fast64_t i)
+{
+  for (unsigned p=0; p<n_; p++) // look at p-th row of F
+  {
+    uint_fast64_t row = zer;
+    uint_fast64_t mask = (one<<p);
+    for (unsigned q=0; q<n_; q++) // look at q-th column of F
+      if (F(q, i) & mask) row ^= (one<<q);
+    FT(p, i) = row;
+  }
+  readyFT_[i] = 1;
+}
+
+void StabilizerStateArray::TermTransposeM(uint_fast64_t i)
+{
+  for (unsigned p=0; p<n_; p++) // look at p-th row of M
+  {
+    uint_fast64_t row = zer;
+    uint_fast64_t mask = (one<<p);
+    for (unsigned q=0; q<n_; q++) // look at q-th column of M
+      if (M(q, i) & mask) row ^= (one<<q);
+    MT(p, i) = row;
+  }
+  readyMT_[i] = 1;
+}
+
+//-------------------------------------------------------------------------
+// Sampling and amplitudes
+//-------------------------------------------------------------------------
+
+uint_fast64_t StabilizerStateArray::Sample(uint_fast64_t i, uint_fast64_t v_mask) const
+{
+  //v_mask is a uniform random binary string we use to sample the bits
+  //of v in a single step.
+  uint_fast64_t x = zer;
+  uint_fast64_t masked_v = v_[i] & v_mask;
+  for (unsigned q=0; q<n_; q++)
+  {
+    bool w = !!(s_[i] & (one<<q));
+    w ^= !!(masked_v & (one<<q));
+    if (w) x ^= G(q, i);
+  }
+  return x;
+}
+
+void StabilizerStateArray::PrepareAmplitudes()
+{
+  auto term = [&](int_t i)
+  {
+    if (!readyMT_[i])
+    {
+      TermTransposeM(i);
+    }
+    if (!readyFT_[i])
+    {
+      TermTransposeF(i);
+    }
+    int p = p_[i] - (int) hamming_weight(v_[i]);
+    mag_[i] = std::pow(2, p/(double)2);
+  };
+  const int_t END = size_;
+  if (parallel())
+  {
+    #pragma omp parallel for num_threads(omp_threads_)
+    for (int_t i=0; i<END; i++)
+      term(i);
+  }
+  else
+  {
+    for (int_t i=0; i<END; i++)
+      term(i);
+  }
+}
+
+void StabilizerStateArray::PauliX(uint_fast64_t x, PauliArray& R) const
+{
+  R.X.assign(size_, zer);
+  R.Z.assign(size_, zer);
+  R.e.assign(size_, 0);
+  for (unsigned pos=0; pos<n_; pos++)
+  {
+    if (!(x & (one<<pos)))
+    {
+      continue;
+    }
+    const uint_fast64_t* FT = FT_.data() + pos*size_;
+    const uint_fast64_t* MT = MT_.data() + pos*size_;
+    auto term = [&](int_t i)
+    {
+      // R gets R * U_C^{-1} X_{pos} U_C
+      unsigned e1 = ((gamma1_[i]>>pos) & one) + 2*((gamma2_[i]>>pos) & one);
+      unsigned overlap = hamming_weight(R.Z[i] & FT[i]);
+      R.X[i] ^= FT[i];
+      R.Z[i] ^= MT[i];
+      R.e[i] = (R.e[i] + e1 + 2*overlap) % 4;
+    };
+    const int_t END = size_;
+    if (parallel())
+    {
+      #pragma omp parallel for num_threads(omp_threads_)
+      for (int_t i=0; i<END; i++)
+        term(i);
+    }
+    else
+    {
+      for (int_t i=0; i<END; i++)
+        term(i);
+    }
+  }
+}
+
+void StabilizerStateArray::FlipPauliX(unsigned pos, const PauliArray& R, PauliArray& Q) const
+{
+  Q.X.resize(size_);
+  Q.Z.resize(size_);
+  Q.e.resize(size_);
+  const uint_fast64_t* FT = FT_.data() + pos*size_;
+  const uint_fast64_t* MT = MT_.data() + pos*size_;
+  auto term = [&](int_t i)
+  {
+    unsigned e1 = ((gamma1_[i]>>pos) & one) + 2*((gamma2_[i]>>pos) & one);
+    unsigned overlap = hamming_weight(MT[i] & R.X[i]);
+    Q.X[i] = FT[i] ^ R.X[i];
+    Q.Z[i] = MT[i] ^ R.Z[i];
+    Q.e[i] = (e1 + R.e[i] + 2*overlap) % 4;
+  };
+  const int_t END = size_;
+  if (parallel())
+  {
+    #pragma omp parallel for num_threads(omp_threads_)
+    for (int_t i=0; i<END; i++)
+      term(i);
+  }
+  else
+  {
+    for (int_t i=0; i<END; i++)
+      term(i);
+  }
+}
+
+complex_t StabilizerStateArray::Amplitude(const PauliArray& R) const
+{
+  // Same evaluation as StabilizerState::PauliAmplitude for every term,
+  // accumulated with the term coefficients.
+  auto term = [&](int_t i, double &real_part, double &imag_part)
+  {
+    if (!eps_[i] || ((R.X[i] ^ s_[i]) & ~v_[i]) != zer)
+    {
+      return;
+    }
+    int e = (2*R.e[i] + 4*hamming_parity(v_[i] & s_[i] & R.X[i])) % 8;
+    e = ((8 - e) % 8 + e_[i]) % 8;
+    complex_t amp(mag_[i]*RE_PHASE[e], mag_[i]*IM_PHASE[e]);
+    amp *= coefficients_[i];
+    real_part += amp.real();
+    imag_part += amp.imag();
+  };
+  double real_part = 0., imag_part = 0.;
+  const int_t END = size_;
+  if (parallel())
+  {
+    #pragma omp parallel for num_threads(omp_threads_) reduction(+:real_part) reduction(+:imag_part)
+    for (int_t i=0; i<END; i++)
+      term(i, real_part, imag_part);
+  }
+  else
+  {
+    for (int_t i=0; i<END; i++)
+      term(i, real_part, imag_part);
+  }
+  return complex_t(real_part, imag_part);
+}
+
+//-------------------------------------------------------------------------
+// Norm estimation
+//-------------------------------------------------------------------------
+
+scalar_t StabilizerStateArray::TermInnerProduct(uint_fast64_t i,
+                                                uint_fast64_t A_diag1,
+                                                uint_fast64_t A_diag2,
+                                                const std::vector<uint_fast64_t>& A) const
+{
+  const unsigned n = n_;
+  const uint_fast64_t v = v_[i];
+  const uint_fast64_t s = s_[i];
+  uint_fast64_t K_diag1 = zer, K_diag2 = zer, J_diag1 = gamma1_[i], J_diag2 = gamma2_[i];
+  std::vector<uint_fast64_t> J(n, zer);
+  std::vector<uint_fast64_t> K(n, zer);
+  std::vector<uint_fast64_t> placeholder(n, zer);
+  //Setup the J matrix
+  for (size_t k=0; k<n; k++)
+  {
+    for (size_t j=k; j<n; j++)
+    {
+      if (hamming_parity(MT(k, i) & FT(j, i)))
+      {
+        J[k] |= (one << j);
+        J[j] |= (one << k);
+      }
+    }
+  }
+  //Calculate the matrix J =  A+J
+  J_diag2 = (A_diag2 ^ J_diag2 ^ (A_diag1&J_diag1));
+  J_diag1 = (A_diag1 ^ J_diag1);
+  for (size_t k=0; k<n; k++)
+  {
+    J[k] ^= A[k];
+  }
+  //placeholder = J*G)
+  for (size_t k=0; k<n; k++)
+  {
+    //Grab column k of J, it's symmetric
+    uint_fast64_t col_k = J[k];
+    for (size_t j=0; j<n; j++)
+    {
+      if (hamming_parity(col_k & G(j, i)))
+      {
+        placeholder[j] |= (one<<k);
+      }
+    }
+  }
+  //K = GT*placeholder
+  for (size_t k=0; k<n; k++)
+  {
+    uint_fast64_t col_k = G(k, i);
+    uint_fast64_t shift = (one << k);
+    for (size_t j=k; j<n; j++)
+    {
+      if(hamming_parity(col_k & placeholder[j]))
+      {
+        K[j] |= shift;
+        K[k] |= (one << j);
+      }
+    }
+    for (size_t r=0; r<n; r++)
+    {
+      if ((col_k >> r) & one)
+      {
+        uint_fast64_t one_bit = (J_diag1 >> r) & one;
+        if ((K_diag1 >> k) & one_bit)
+        {
+          K_diag2 ^= shift;
+        }
+        K_diag1 ^= one_bit*shift;
+        K_diag2 ^= ((J_diag2 >> r)&one) * shift;
+      }
+      for (size_t l=r+1; l<n; l++)
+      {
+        if ((J[l] >> r) & (col_k >> r) & (col_k >> l) & one)
+        {
+          K_diag2 ^= shift;
+        }
+      }
+    }
+  }
+  unsigned col = 0;
+  QuadraticForm q(hamming_weight(v));
+  //We need to setup a quadratic form to evaluate the Exponential Sum
+  for (size_t k=0; k<n; k++)
+  {
+    if ((v>>k) & one)
+    {
+      uint_fast64_t shift = (one << col);
+      //D = Diag(K(1,1)) + 2*[s + s*K](1)
+      q.D1 ^= ((K_diag1 >> k) & one) * shift;
+      q.D2 ^= ((((K_diag2 >> k) ^ (s >> k)) & one)
+               ^ hamming_parity(K[k] & s)) * shift;
+      unsigned row = 0;
+      for (size_t j=0; j<n; j++)
+      {
+        if((v>>j) & one)
+        {
+          q.J[col] |= (((K[k] >> j) & one) << row);
+          row++;
+        }
+      }
+      col++;
+    }
+  }
+  // Q = 4* (s.v) + sKs
+  q.Q = hamming_parity(s&v)*4;
+  for (size_t k=0; k<n; k++)
+  {
+    if ((s>>k) & one)
+    {
+      q.Q = (q.Q + 4*((K_diag2 >> k) & one) + 2*((K_diag1 >> k) & one))%8;
+      for (size_t j=k+1; j<n; j++)
+      {
+        if ((s>>j) & (K[j] >> k) & one)
+        {
+          q.Q ^= 4;
+        }
+      }
+    }
+  }
+  scalar_t amp = q.ExponentialSum();
+  // Reweight by 2^{-(n+|v|)}/2
+  amp.p -= (n+hamming_weight(v));
+  // We need to further multiply by omega*
+  scalar_t psi_amp(Omega(i));
+  psi_amp.conjugate();
+  amp *= psi_amp;
+  return amp;
+}
+
+double StabilizerStateArray::NormEstimate(const std::vector<uint_fast64_t>& Samples_d1,
+                                          const std::vector<uint_fast64_t>& Samples_d2,
+                                          const std::vector< std::vector<uint_fast64_t> >& Samples) const
+{
+  // Norm estimate for a state |psi> = \sum_{i} c_{i}|phi_{i}>
+  double xi = 0;
+  const uint_fast64_t L = Samples_d1.size();
+  for (uint_fast64_t l=0; l<L; l++)
+  {
+    auto term = [&](int_t i, double &re_eta, double &im_eta)
+    {
+      if (!eps_[i])
+      {
+        return;
+      }
+      scalar_t amp = TermInnerProduct(i, Samples_d1[l], Samples_d2[l], Samples[l]);
+      if (amp.eps != 0)
+      {
+        if (amp.e % 2)
+        {
+          amp.p--;
+        }
+        double mag = std::pow(2, amp.p/(double) 2);
+        complex_t phase(RE_PHASE[amp.e], IM_PHASE[amp.e]);
+        phase *= std::conj(coefficients_[i]);
+        re_eta += (mag * std::real(phase));
+        im_eta += (mag * std::imag(phase));
+      }
+    };
+    double re_eta = 0., im_eta = 0.;
+    const int_t END = size_;
+    if (parallel())
+    {
+      #pragma omp parallel for num_threads(omp_threads_) reduction(+:re_eta) reduction(+:im_eta)
+      for (int_t i=0; i<END; i++)
+        term(i, re_eta, im_eta);
+    }
+    else
+    {
+      for (int_t i=0; i<END; i++)
+        term(i, re_eta, im_eta);
+    }
+    xi += (std::pow(re_eta, 2) + std::pow(im_eta, 2));
+  }
+  return std::pow(2., n_)*(xi/L);
+}
+
+} // Close namespace CHSimulator
+#endif
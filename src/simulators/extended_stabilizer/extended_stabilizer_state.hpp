@@ -34,9 +34,6 @@ using chpauli_t = CHSimulator::pauli_t;
 using chstate_t = CHSimulator::Runner;
 using Gates = CHSimulator::Gates;
 
-uint_t zero = 0ULL;
-uint_t toff_branch_max = 7ULL;
-
 enum class Snapshots {
   state, 
   statevector,
@@ -92,15 +89,21 @@ public:
 
   virtual void set_config(const json_t &config) override;
 
+  // Compute the required stabilizer rank of the circuit
+  uint_t compute_chi(const std::vector<Operations::Op> &ops) const;
+
+  // Number of Metropolis steps before sampling from the output distribution
+  uint_t mixing_time() const {return metropolis_mixing_steps_;}
+
   virtual std::vector<reg_t> sample_measure(const reg_t& qubits,
                                             uint_t shots,
                                             RngEngine &rng) override;
 
 protected:
 
-  //Alongside the sample measure optimisaiton, we can parallelise
-  //circuit applicaiton over the states. This reduces the threading overhead
-  //as we only have to fork once per circuit.
+  //Alongside the sample measure optimisaiton, the circuit only contains
+  //gates and barriers, so it is applied without checking for conditionals.
+  //Each gate is a sweep over the states of the decomposition.
   void apply_ops_parallel(const std::vector<Operations::Op> &ops,
                                   RngEngine &rng);
 
@@ -110,12 +113,9 @@ protected:
   void apply_stabilizer_circuit(const std::vector<Operations::Op> &ops,
                                       OutputData &data,
                                       RngEngine &rng);
-  // Applies a sypported Gate operation to the state class.
+  // Applies a sypported Gate operation to every state of the decomposition.
   // If the input is not in allowed_gates an exeption will be raised.
-  // TODO: Investigate OMP synchronisation over stattes to remove these different versions
-  // One option would be tasks, but the memory overhead isn't clear
   void apply_gate(const Operations::Op &op, RngEngine &rng);
-  void apply_gate(const Operations::Op &op, RngEngine &rng, uint_t rank);
 
   // Measure qubits and return a list of outcomes [q0, q1, ...]
   // If a state subclass supports this function then "measure" 
@@ -164,8 +164,6 @@ protected:
 
   double probabilities_snapshot_samples_ = 3000.;
 
-  // Compute the required stabilizer rank of the circuit
-  uint_t compute_chi(const std::vector<Operations::Op> &ops) const;
   // Add the given operation to the extent
   void compute_extent(const Operations::Op &op, double &xi) const;
 
@@ -422,31 +420,22 @@ std::vector<reg_t> State::sample_measure(const reg_t& qubits,
 // Implemenation: Protected Methods
 //-------------------------------------------------------------------------
 
-//Method with slighty optimized parallelisation for the case of a sample_measure circuit
+//Method for the case of a sample_measure circuit, which has no conditionals
 void State::apply_ops_parallel(const std::vector<Operations::Op> &ops, RngEngine &rng)
 {
-  const int_t NUM_STATES = BaseState::qreg_.get_num_states();
-  #pragma omp parallel for if(BaseState::qreg_.check_omp_threshold() && BaseState::threads_>1) num_threads(BaseState::threads_)
-  for(int_t i=0; i < NUM_STATES; i++)
+  for(const auto op: ops)
   {
-    if(!BaseState::qreg_.check_eps(i))
-    {
-      continue;
-    }
-    for(const auto op: ops)
+    switch (op.type)
     {
-      switch (op.type)
-      {
-        case Operations::OpType::gate:
-          apply_gate(op, rng, i);
-          break;
-        case Operations::OpType::barrier:
-          break;
-        default:
-          throw std::invalid_argument("CH::State::apply_ops_parallel does not support operations of the type \'" + 
-                                       op.name + "\'.");
-          break;
-      }
+      case Operations::OpType::gate:
+        apply_gate(op, rng);
+        break;
+      case Operations::OpType::barrier:
+        break;
+      default:
+        throw std::invalid_argument("CH::State::apply_ops_parallel does not support operations of the type \'" + 
+                                     op.name + "\'.");
+        break;
     }
   }
 }
@@ -461,7 +450,7 @@ void State::apply_stabilizer_circuit(const std::vector<Operations::Op> &ops,
       case Operations::OpType::gate:
         if(BaseState::creg_.check_conditional(op))
         {
-          apply_gate(op, rng, 0);
+          apply_gate(op, rng);
         }
         break;
       case Operations::OpType::reset:
@@ -526,7 +515,6 @@ void State::apply_measure(const reg_t &qubits, const reg_t &cmemory, const reg_t
 void State::apply_reset(const reg_t &qubits, AER::RngEngine &rng)
 {
   uint_t measure_string;
-  const int_t NUM_STATES = BaseState::qreg_.get_num_states();
   if(BaseState::qreg_.get_num_states() == 1)
   {
     measure_string = BaseState::qreg_.stabilizer_sampler(rng);
@@ -548,33 +536,16 @@ void State::apply_reset(const reg_t &qubits, AER::RngEngine &rng)
     }
   }
   BaseState::qreg_.apply_pauli_projector(paulis);
-  #pragma omp parallel for if(BaseState::threads_ > 1 && BaseState::qreg_.check_omp_threshold()) num_threads(BaseState::threads_)
-  for(int_t i=0; i< NUM_STATES; i++)
+  for (auto qubit: qubits)
   {
-    for (auto qubit: qubits)
+    if ((measure_string>>qubit) & 1ULL)
     {
-      if ((measure_string>>qubit) & 1ULL)
-      {
-        BaseState::qreg_.apply_x(qubit, i);
-      }
+      BaseState::qreg_.apply_x(qubit);
     }
   }
 }
 
 void State::apply_gate(const Operations::Op &op, RngEngine &rng)
-{
-  const int_t NUM_STATES = BaseState::qreg_.get_num_states();
-  #pragma omp parallel for if (BaseState::threads_ > 1 && BaseState::qreg_.check_omp_threshold()) num_threads(BaseState::threads_)
-  for(int_t i=0; i < NUM_STATES; i++)
-  {
-    if(BaseState::qreg_.check_eps(i))
-    {
-      apply_gate(op, rng, i);
-    }
-  }
-}
-
-void State::apply_gate(const Operations::Op &op, RngEngine &rng, uint_t rank)
 {
   auto it = gateset_.find(op.name);
   if (it == gateset_.end())
@@ -585,46 +556,46 @@ void State::apply_gate(const Operations::Op &op, RngEngine &rng, uint_t rank)
   switch(it->second)
   {
     case Gates::x:
-      BaseState::qreg_.apply_x(op.qubits[0], rank);
+      BaseState::qreg_.apply_x(op.qubits[0]);
       break;
     case Gates::y:
-      BaseState::qreg_.apply_y(op.qubits[0], rank);
+      BaseState::qreg_.apply_y(op.qubits[0]);
       break;
     case Gates::z:
-      BaseState::qreg_.apply_z(op.qubits[0], rank);
+      BaseState::qreg_.apply_z(op.qubits[0]);
       break;
     case Gates::s:
-      BaseState::qreg_.apply_s(op.qubits[0], rank);
+      BaseState::qreg_.apply_s(op.qubits[0]);
       break;
     case Gates::sdg:
-      BaseState::qreg_.apply_sdag(op.qubits[0], rank);
+      BaseState::qreg_.apply_sdag(op.qubits[0]);
       break;
     case Gates::h:
-      BaseState::qreg_.apply_h(op.qubits[0], rank);
+      BaseState::qreg_.apply_h(op.qubits[0]);
       break;
     case Gates::cx:
-      BaseState::qreg_.apply_cx(op.qubits[0], op.qubits[1], rank);
+      BaseState::qreg_.apply_cx(op.qubits[0], op.qubits[1]);
       break;
     case Gates::cz:
-      BaseState::qreg_.apply_cz(op.qubits[0], op.qubits[1], rank);
+      BaseState::qreg_.apply_cz(op.qubits[0], op.qubits[1]);
       break;
     case Gates::swap:
-      BaseState::qreg_.apply_swap(op.qubits[0], op.qubits[1], rank);
+      BaseState::qreg_.apply_swap(op.qubits[0], op.qubits[1]);
       break;
     case Gates::t:
-      BaseState::qreg_.apply_t(op.qubits[0], rng.rand(), rank);
+      BaseState::qreg_.apply_t(op.qubits[0], rng);
       break;
     case Gates::tdg:
-      BaseState::qreg_.apply_tdag(op.qubits[0], rng.rand(), rank);
+      BaseState::qreg_.apply_tdag(op.qubits[0], rng);
       break;
     case Gates::ccx:
-      BaseState::qreg_.apply_ccx(op.qubits[0], op.qubits[1], op.qubits[2], rng.rand_int(zero, toff_branch_max), rank);
+      BaseState::qreg_.apply_ccx(op.qubits[0], op.qubits[1], op.qubits[2], rng);
       break;
     case Gates::ccz:
-      BaseState::qreg_.apply_ccz(op.qubits[0], op.qubits[1], op.qubits[2], rng.rand_int(zero, toff_branch_max), rank);
+      BaseState::qreg_.apply_ccz(op.qubits[0], op.qubits[1], op.qubits[2], rng);
       break;
     case Gates::u1:
-      BaseState::qreg_.apply_u1(op.qubits[0], op.params[0], rng.rand(), rank);
+      BaseState::qreg_.apply_u1(op.qubits[0], op.params[0], rng);
       break;
     default: //u0 or Identity
       break;
@@ -87,7 +87,8 @@ public:
       Operations::OpType::bfunc,
       Operations::OpType::roerror,
       Operations::OpType::matrix,
-      Operations::OpType::kraus
+      Operations::OpType::kraus,
+      Operations::OpType::pauli_rotation
     });
   }
 
@@ -445,6 +446,11 @@ void State::apply_ops(const std::vector<Operations::Op> &ops,
         case Operations::OpType::kraus:
           apply_kraus(op.qubits, op.mats, rng);
           break;
+        case Operations::OpType::pauli_rotation:
+          qreg_.apply_pauli_rotation(op.qubits, op.string_params[0],
+                                     std::real(op.params[0]),
+                                     (op.params.size() > 1) ? op.params[1] : 1.);
+          break;
         default:
           throw std::invalid_argument("MatrixProductState::State::invalid instruction \'" +
                                       op.name + "\'.");
@@ -511,9 +517,7 @@ void State::snapshot_state(const Operations::Op &op,
 void State::snapshot_probabilities(const Operations::Op &op,
 				   OutputData &data,
 				   bool variance) {
-  MatrixProductState::MPS_Tensor full_tensor = qreg_.state_vec(0, qreg_.num_qubits()-1);
-  rvector_t prob_vector;
-  qreg_.probabilities_vector(prob_vector);
+  rvector_t prob_vector = qreg_.probabilities(op.qubits);
   data.add_singleshot_snapshot("probabilities", op.string_params[0], prob_vector);
 }
 
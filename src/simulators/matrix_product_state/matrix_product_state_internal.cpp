@@ -6,6 +6,7 @@
  */
 
 
+#include <algorithm>
 #include <bitset>
 #include <math.h>
 
@@ -128,6 +129,8 @@ cmatrix_t reshape_matrix(cmatrix_t input_matrix) {
 void MPS::initialize(uint_t num_qubits)
 {
   num_qubits_ = num_qubits;
+  q_reg_.clear();
+  lambda_reg_.clear();
   complex_t alpha = 1.0f;
   complex_t beta = 0.0f;
   for(uint_t i = 0; i < num_qubits_-1; i++) {
@@ -330,12 +333,83 @@ void MPS::apply_diagonal_matrix(const AER::reg_t &qubits, const cvector_t &vmat)
   cmatrix_t diag_mat(dim, dim);
   for (uint_t i=0; i<dim; i++) {
     for (uint_t j=0; j<dim; j++){
-      diag_mat(i, i) = ( i==j ? vmat[i] : 0.0);
+      diag_mat(i, j) = ( i==j ? vmat[i] : 0.0);
     }
   }
   apply_matrix(qubits, diag_mat);
 }
 
+void MPS::apply_pauli_rotation(const reg_t &qubits, const string &pauli,
+                               double theta, complex_t phase)
+{
+  if (pauli.size() != qubits.size())
+    throw std::invalid_argument("Pauli label doesn't match the number of qubits");
+
+  // Non-identity qubits in ascending order with their Pauli matrices
+  vector<std::pair<uint_t, cmatrix_t>> support;
+  const uint_t N = qubits.size();
+  for (uint_t i = 0; i < N; i++) {
+    switch (pauli[N - 1 - i]) {
+    case 'I':
+      break;
+    case 'X':
+      support.emplace_back(qubits[i], AER::Utils::Matrix::X);
+      break;
+    case 'Y':
+      support.emplace_back(qubits[i], AER::Utils::Matrix::Y);
+      break;
+    case 'Z':
+      support.emplace_back(qubits[i], AER::Utils::Matrix::Z);
+      break;
+    default:
+      throw std::invalid_argument("invalid Pauli label \"" + pauli + "\"");
+    }
+  }
+  std::sort(support.begin(), support.end(),
+            [](const std::pair<uint_t, cmatrix_t> &a, const std::pair<uint_t, cmatrix_t> &b) {
+              return a.first < b.first;
+            });
+
+  // phase * (cos(theta/2) I - i sin(theta/2) P)
+  const complex_t cos_t = phase * std::cos(0.5 * theta);
+  const complex_t sin_t = phase * complex_t(0., -std::sin(0.5 * theta));
+  if (support.empty()) {
+    q_reg_[qubits.empty() ? 0 : qubits[0]].apply_matrix(AER::Utils::Matrix::I * (cos_t + sin_t));
+    return;
+  }
+  if (support.size() == 1) {
+    q_reg_[support[0].first].apply_matrix(AER::Utils::Matrix::I * cos_t + support[0].second * sin_t);
+    return;
+  }
+
+  // Basis changes B with B P B^dagger = Z for all but the last qubit
+  const uint_t last = support.size() - 1;
+  vector<cmatrix_t> basis(last);
+  for (uint_t i = 0; i < last; i++) {
+    const cmatrix_t &P = support[i].second;
+    if (P(0, 1) == 0.)
+      basis[i] = AER::Utils::Matrix::I;
+    else if (P(0, 1) == 1.)
+      basis[i] = AER::Utils::Matrix::H;
+    else
+      basis[i] = AER::Utils::Matrix::H * AER::Utils::Matrix::SDG;
+    q_reg_[support[i].first].apply_matrix(basis[i]);
+  }
+  for (uint_t i = 0; i + 2 < support.size(); i++)
+    apply_cnot(support[i].first, support[i + 1].first);
+
+  // Rotation on the parity qubit and the last qubit, where the first qubit
+  // of the gate indexes the rows of the matrix in the high bit
+  const cmatrix_t ZP = AER::Utils::tensor_product(AER::Utils::Matrix::Z, support[last].second);
+  const cmatrix_t rot = AER::Utils::Matrix::identity(4) * cos_t + ZP * sin_t;
+  apply_2_qubit_gate(support[last - 1].first, support[last].first, su4, rot);
+
+  for (uint_t i = support.size() - 2; i > 0; i--)
+    apply_cnot(support[i - 1].first, support[i].first);
+  for (uint_t i = 0; i < last; i++)
+    q_reg_[support[i].first].apply_matrix(AER::Utils::dagger(basis[i]));
+}
+
 void MPS::change_position(uint_t src, uint_t dst)
 {
 	if(src == dst)
@@ -493,6 +567,111 @@ void MPS::probabilities_vector(rvector_t& probvector) const
   }
 }
 
+rvector_t MPS::probabilities(const reg_t &qubits) const
+{
+  const uint_t num_measured = qubits.size();
+  const uint_t length = 1ULL << num_measured;
+  if (num_measured == 0)
+    return rvector_t(1, 1.0);
+
+  // position[q] is the bit of the outcome index that qubit q is stored in
+  reg_t position(num_qubits_, num_qubits_);
+  for (uint_t j = 0; j < num_measured; j++)
+    position[qubits[j]] = j;
+
+  // If all qubits are measured there is nothing to trace out,
+  // so only the bits of the full probability vector are permuted
+  if (num_measured == num_qubits_) {
+    rvector_t probvector;
+    probabilities_vector(probvector);
+    rvector_t result(length, 0.);
+    for (uint_t i = 0; i < length; i++) {
+      uint_t index = 0;
+      for (uint_t q = 0; q < num_qubits_; q++)
+        if ((i >> q) & 1ULL)
+          index |= 1ULL << position[q];
+      result[index] = probvector[i];
+    }
+    return result;
+  }
+
+  const uint_t first = *std::min_element(qubits.begin(), qubits.end());
+  const uint_t last = *std::max_element(qubits.begin(), qubits.end());
+
+  // The state is the product of the matrices A_i[s] = Gamma_i[s] * Lambda_i
+  // over all sites, with no Lambda on the last site.
+  auto site_matrices = [&](uint_t i) {
+    vector<cmatrix_t> mats(2);
+    for (uint_t s = 0; s < 2; s++)
+      mats[s] = (i < num_qubits_-1)
+                  ? mul_matrix_by_lambda(q_reg_[i].get_data(s), lambda_reg_[i])
+                  : q_reg_[i].get_data(s);
+    return mats;
+  };
+
+  // Left transfer matrix of the traced-out sites 0..first-1:
+  // E = sum_s A[s]^dagger E A[s]
+  cmatrix_t left(1, 1);
+  left(0, 0) = 1.;
+  for (uint_t i = 0; i < first; i++) {
+    vector<cmatrix_t> mats = site_matrices(i);
+    left = AER::Utils::dagger(mats[0]) * left * mats[0]
+         + AER::Utils::dagger(mats[1]) * left * mats[1];
+  }
+
+  // Right transfer matrix of the traced-out sites last+1..n-1:
+  // R = sum_s A[s] R A[s]^dagger
+  cmatrix_t right(1, 1);
+  right(0, 0) = 1.;
+  for (uint_t i = num_qubits_-1; i > last; i--) {
+    vector<cmatrix_t> mats = site_matrices(i);
+    right = mats[0] * right * AER::Utils::dagger(mats[0])
+          + mats[1] * right * AER::Utils::dagger(mats[1]);
+  }
+
+  // Contract the sites between the first and last measured qubit, keeping
+  // one left environment for every partial outcome of the measured qubits
+  vector<cmatrix_t> envs(1, left);
+  reg_t outcomes(1, 0);
+  for (uint_t i = first; i <= last; i++) {
+    vector<cmatrix_t> mats = site_matrices(i);
+    vector<cmatrix_t> mats_dagger = {AER::Utils::dagger(mats[0]),
+                                     AER::Utils::dagger(mats[1])};
+    const int_t size = envs.size();
+    if (position[i] == num_qubits_) {
+      #pragma omp parallel for if (omp_threads_ > 1 && size > 1) num_threads(omp_threads_)
+      for (int_t b = 0; b < size; b++)
+        envs[b] = mats_dagger[0] * envs[b] * mats[0]
+                + mats_dagger[1] * envs[b] * mats[1];
+    } else {
+      vector<cmatrix_t> new_envs(2 * size);
+      reg_t new_outcomes(2 * size);
+      #pragma omp parallel for if (omp_threads_ > 1 && size > 1) num_threads(omp_threads_)
+      for (int_t b = 0; b < size; b++) {
+        for (uint_t s = 0; s < 2; s++) {
+          new_envs[2 * b + s] = mats_dagger[s] * envs[b] * mats[s];
+          new_outcomes[2 * b + s] = outcomes[b] | (s << position[i]);
+        }
+      }
+      envs.swap(new_envs);
+      outcomes.swap(new_outcomes);
+    }
+  }
+
+  // The probability of each outcome is Tr(E R)
+  rvector_t result(length, 0.);
+  const int_t size = envs.size();
+  #pragma omp parallel for if (omp_threads_ > 1 && size > 1) num_threads(omp_threads_)
+  for (int_t b = 0; b < size; b++) {
+    complex_t trace = 0.;
+    for (uint_t r = 0; r < right.GetRows(); r++)
+      for (uint_t c = 0; c < right.GetColumns(); c++)
+        trace += envs[b](c, r) * right(r, c);
+    result[outcomes[b]] = std::real(trace);
+  }
+  return result;
+}
+
 reg_t MPS::apply_measure(const reg_t &qubits, 
 			 RngEngine &rng) {
   reg_t qubits_to_update;
@@ -110,6 +110,19 @@ public:
 
   void apply_diagonal_matrix(const AER::reg_t &qubits, const cvector_t &vmat); 
 
+  //----------------------------------------------------------------
+  // function name: apply_pauli_rotation
+  // Description: Apply phase * exp(-i theta/2 P) for a Pauli label P whose
+  //   last character acts on qubits[0]. Rotations on 1 or 2 qubits are
+  //   applied as a single gate. Otherwise all but the last non-identity
+  //   qubit are rotated to the Z basis and their parity is collected by a CX
+  //   chain in qubit order, so that the rotation is a single 2-qubit gate.
+  // Parameters: the qubits, the Pauli label, the angle and global phase.
+  // Returns: none.
+  //----------------------------------------------------------------
+  void apply_pauli_rotation(const reg_t &qubits, const string &pauli,
+                            double theta, complex_t phase = 1.);
+
   //----------------------------------------------------------------
   // function name: change_position
   // Description: Move qubit from src to dst in the MPS. Used only
@@ -178,12 +191,19 @@ public:
     cout << "enable_gate_opt not supported yet" <<endl;
   }
 
-  rvector_t probabilities(const AER::reg_t &qubits) const
-  {
-    rvector_t probvector;
-    probabilities_vector(probvector);
-    return probvector;
-  }
+  //----------------------------------------------------------------
+  // function name: probabilities
+  // Description: Computes the marginal probabilities of measuring a subset
+  //   of the qubits in the computational basis, without building the
+  //   statevector. The traced-out sites to the left and right of the
+  //   subset are folded into transfer matrices, and only the sites
+  //   between the first and last measured qubit are contracted for
+  //   every partial outcome.
+  // Parameters: qubits - the measured qubits, in any order. Bit j of the
+  //   index into the result corresponds to qubits[j].
+  // Returns: rvector_t of size 2^qubits.size().
+  //----------------------------------------------------------------
+  rvector_t probabilities(const AER::reg_t &qubits) const;
 
   //  void store_measure(const AER::reg_t outcome, const AER::reg_t &cmemory, const AER::reg_t &cregister) const{
   //           cout << " store_measure not supported yet" <<endl;}
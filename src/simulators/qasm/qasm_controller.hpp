@@ -16,11 +16,16 @@
 #define _aer_qasm_controller_hpp_
 
 #include "base/controller.hpp"
+#include "framework/bounded_queue.hpp"
 #include "transpile/basic_opts.hpp"
 #include "transpile/fusion.hpp"
+#include "transpile/superop_fusion.hpp"
+#include "transpile/clifford_fusion.hpp"
 #include "transpile/delay_measure.hpp"
+#include "transpile/relabel_qubits.hpp"
 #include "simulators/extended_stabilizer/extended_stabilizer_state.hpp"
 #include "simulators/statevector/statevector_state.hpp"
+#include "simulators/statevector/realvector.hpp"
 #include "simulators/stabilizer/stabilizer_state.hpp"
 #include "simulators/matrix_product_state/matrix_product_state.hpp"
 #include "simulators/densitymatrix/densitymatrix_state.hpp"
@@ -40,6 +45,32 @@ namespace Simulator {
  *   optimizations passes for an ideal circuit [Default: 0].
  * - "optimize_noise_threshold" (int): Qubit threshold for running circuit
  *   optimizations passes for a noisy circuit [Default: 12].
+ * - "shot_branching_enable" (bool): Execute the shots of a circuit without
+ *   quantum noise that cannot use measure sampling by branching the
+ *   statevector at each mid-circuit measure, reset and initialize. The shots
+ *   are distributed over the outcomes and each branch is simulated once,
+ *   depth-first with the fewest shots first. Circuits returning memory,
+ *   register or single-shot snapshot data for each shot are not branched,
+ *   since this data would be grouped by branch [Default: True].
+ * - "noise_sampling_threads" (int): Number of threads sampling and
+ *   optimizing the noisy instances of a circuit with quantum noise ahead of
+ *   the shot threads simulating them. Set to 0 to sample each shot in its
+ *   shot thread, or to -1 to use one sampler thread when the shots are
+ *   executed with parallel state updates [Default: -1].
+ * - "superop_fusion_enable" (bool): Replace groups of adjacent gates and
+ *   Kraus or superop instructions on a few qubits, such as a gate and its
+ *   sampled noise, by a single superop instruction for the density matrix
+ *   method (see Transpile::SuperopFusion) [Default: True].
+ * - "clifford_fusion_enable" (bool): Replace groups of adjacent Clifford
+ *   gates on a few qubits by a single clifford instruction carrying their
+ *   tableau for the stabilizer method (see Transpile::CliffordFusion)
+ *   [Default: True].
+ * - "dry_run_calibration" (json): Calibration of the runtime estimate of the
+ *   "dry_run" mode. Keys are the simulation method names for the seconds
+ *   per unit of the cost model of the method, and "operation", "shot" and
+ *   "noise" for the seconds per executed operation, per shot and per
+ *   operation of a shot with sampled noise (eg. {"statevector": 1e-9}).
+ *   The defaults are measured on a single core of a recent x86-64 CPU.
  * 
  * From Statevector::State class
  *
@@ -55,6 +86,10 @@ namespace Simulator {
  *      measure sampling [Default: 10]
  * - "statevector_hpc_gate_opt" (bool): Enable large qubit gate optimizations.
  *      [Default: False]
+ * - "statevector_real_enable" (bool): Simulate circuits without quantum
+ *      noise whose gates, matrices, snapshots and initial statevector are
+ *      real with a statevector of real amplitudes, which halves the memory
+ *      and the work of each gate (see QV::RealVector) [Default: True].
  *
  * From ExtendedStabilizer::State class
  * - "extended_stabilizer_approximation_error" (double): Set the error in the 
@@ -205,29 +240,82 @@ protected:
                        OutputData &data,
                        RngEngine &rng) const;
 
-  // Execute a n-shots of a circuit without noise.
-  // If possible this is done using measure sampling to only simulate
-  // a single shot up to the first measurement, then sampling measure
-  // outcomes for each shot.
+  // Execute a n-shots of an optimized circuit without noise.
+  // If check is {true, pos} this is done using measure sampling to only
+  // simulate a single shot up to the first measurement at position pos,
+  // then sampling measure outcomes for each shot.
   template <class State_t, class Initstate_t>
-  void run_circuit_without_noise(const Circuit &circ,
+  void run_circuit_without_noise(const Circuit &opt_circ,
+                                 const std::pair<bool, size_t> &check,
                                  uint_t shots,
                                  State_t &state,
                                  const Initstate_t &initial_state,
-                                 const Method method,
                                  OutputData &data,
                                  RngEngine &rng) const;
 
+  // Execute n-shots of an optimized circuit without quantum noise by
+  // branching the state at each random operation before position pos.
+  // The final measurements from pos are sampled for each branch.
+  template <class State_t, class Initstate_t>
+  void run_circuit_with_branching(const Circuit &opt_circ,
+                                  size_t pos,
+                                  uint_t shots,
+                                  State_t &state,
+                                  const Initstate_t &initial_state,
+                                  OutputData &data,
+                                  RngEngine &rng) const;
+
+  // Execute the blocks of operations from position k for a branch of
+  // n-shots. Blocks are either a single random operation or snapshot, or
+  // a sequence of deterministic operations. Branches are run depth-first
+  // with the fewest shots first, so at most log2(shots) copies of the
+  // state are saved at any time.
+  template <class State_t>
+  void apply_branches(const std::vector<std::vector<Operations::Op>> &blocks,
+                      size_t k,
+                      const std::vector<Operations::Op> &meas_ops,
+                      uint_t shots,
+                      State_t &state,
+                      OutputData &data,
+                      RngEngine &rng) const;
+
+  // A noisy instance of a circuit sampled for a shot, and the rng of the
+  // shot after sampling it
+  struct NoisyShot {
+    Circuit circ;
+    RngEngine rng;
+  };
+  using NoisyShotQueue = BoundedQueue<NoisyShot>;
+
   // Execute n-shots of a circuit with noise by sampling a new noisy
-  // instance of the circuit for each shot.
+  // instance of the circuit for each shot. The shots are distributed over
+  // parallel_shots_ threads in contiguous ranges. Each shot uses its own
+  // rng seeded from rng_seed and the shot number, so the results do not
+  // depend on the number of threads. With noise sampler threads, the noisy
+  // instances of each shot thread are sampled and optimized into a bounded
+  // queue while the shot thread simulates earlier shots.
   template <class State_t, class Initstate_t>
-  void run_circuit_with_noise(const Circuit &circ,
+  OutputData run_circuit_with_noise(const Circuit &circ,
+                                    const Noise::NoiseModel& noise,
+                                    const json_t &config,
+                                    uint_t shots,
+                                    uint_t rng_seed,
+                                    const Initstate_t &initial_state) const;
+
+  // Sample and optimize the noisy instance of a circuit for a shot. The
+  // state is used for its supported operations, and metadata of the
+  // optimization is added to data.
+  template <class State_t>
+  NoisyShot sample_noisy_shot(const Circuit &circ,
                               const Noise::NoiseModel& noise,
-                              uint_t shots,
+                              uint_t shot,
+                              uint_t rng_seed,
                               State_t &state,
-                              const Initstate_t &initial_state,
-                              OutputData &data,
-                              RngEngine &rng) const;
+                              OutputData &data) const;
+
+  // Return the number of noise sampler threads for n-shots of a circuit
+  // with quantum noise
+  int noise_sampling_threads(uint_t shots) const;
 
   //----------------------------------------------------------------
   // Measure sampling optimization
@@ -248,6 +336,48 @@ protected:
   std::pair<bool, size_t>
   check_measure_sampling_opt(const Circuit &circ, const Method method) const;
 
+  // Check if shot branching is valid for the input circuit
+  // if so return a pair {true, pos} where pos is the position of the
+  // final measurement operations in the input circuit
+  std::pair<bool, size_t>
+  check_shot_branching_opt(const Circuit &circ, const Method method) const;
+
+  // Check if the statevector of the input circuit stays real, so that it
+  // can be simulated with a real-amplitude statevector
+  bool check_real_statevector(const Circuit &circ,
+                              const Noise::NoiseModel &noise) const;
+
+  //-----------------------------------------------------------------------
+  // Resource estimation
+  //-----------------------------------------------------------------------
+
+  // Return the simulation method, memory, runtime and the optimizations
+  // that would be used to execute the circuit
+  virtual json_t estimate_circuit(const Circuit &circ,
+                                  const Noise::NoiseModel &noise,
+                                  const json_t &config) const override;
+
+  // Return the cost of applying the operations [first, last) in units of the
+  // cost model of the simulation method: amplitude updates for the
+  // statevector and density matrix methods, tableau row updates for the
+  // stabilizer method and stabilizer state updates for the extended
+  // stabilizer method. For the matrix product state method the cost is the
+  // size of the tensor contractions for upper bounds of the bond dimensions,
+  // which are updated in bonds. The number of tensor entries is added to
+  // mps_entries and its maximum is tracked in mps_peak.
+  double estimate_ops_cost(std::vector<Operations::Op>::const_iterator first,
+                           std::vector<Operations::Op>::const_iterator last,
+                           uint_t num_qubits,
+                           Method method,
+                           double chi,
+                           double mixing_time,
+                           std::vector<double> &bonds,
+                           double &mps_entries,
+                           double &mps_peak) const;
+
+  // Return the name of a simulation method
+  static std::string method_name(Method method);
+
   //-----------------------------------------------------------------------
   // Config
   //-----------------------------------------------------------------------
@@ -271,8 +401,40 @@ protected:
 
   // Controller-level parameter for CH method
   bool extended_stabilizer_measure_sampling_ = false;
+
+  // Branch the shots at mid-circuit measurements of ideal circuits
+  bool shot_branching_enable_ = true;
+
+  // The memory or register value of each shot is returned
+  bool singleshot_measure_ = false;
+
+  // Use a real-amplitude statevector for real circuits
+  bool statevector_real_enable_ = true;
+
+  // Threads sampling noisy circuit instances ahead of the shot threads,
+  // or -1 for automatic
+  int noise_sampling_threads_ = -1;
+
+  // Noisy circuit instances queued ahead of each shot thread
+  static constexpr size_t noise_sampling_queue_size_ = 4;
+
+  // Seconds per unit of the cost model of each simulation method, and per
+  // operation, shot and noisy operation for the fixed costs
+  static const stringmap_t<double> default_dry_run_calibration_;
+  stringmap_t<double> dry_run_calibration_ = default_dry_run_calibration_;
 };
 
+const stringmap_t<double> QasmController::default_dry_run_calibration_({
+  {"statevector", 1.6e-9},
+  {"density_matrix", 6e-10},
+  {"stabilizer", 1e-8},
+  {"extended_stabilizer", 1e-8},
+  {"matrix_product_state", 1e-8},
+  {"operation", 5e-7},
+  {"shot", 5e-6},
+  {"noise", 5e-6}
+});
+
 //=========================================================================
 // Implementations
 //=========================================================================
@@ -281,9 +443,14 @@ protected:
 // Constructor
 //-------------------------------------------------------------------------
 QasmController::QasmController() {
+  // Circuits are prepared once before their shots are distributed
+  run_circuit_parallel_shots_ = true;
   add_circuit_optimization(Transpile::ReduceBarrier());
   add_circuit_optimization(Transpile::DelayMeasure());
   add_circuit_optimization(Transpile::Fusion());
+  add_circuit_optimization(Transpile::SuperopFusion());
+  add_circuit_optimization(Transpile::CliffordFusion());
+  add_circuit_optimization(Transpile::RelabelQubits());
 }
 
 //-------------------------------------------------------------------------
@@ -340,6 +507,25 @@ void QasmController::set_config(const json_t &config) {
   JSON::get_value(extended_stabilizer_measure_sampling_,
                   "extended_stabilizer_measure_sampling", config);
 
+  // Check for shot branching
+  JSON::get_value(shot_branching_enable_, "shot_branching_enable", config);
+  bool memory = false, creg = false;
+  JSON::get_value(memory, "memory", config);
+  JSON::get_value(creg, "register", config);
+  singleshot_measure_ = memory || creg;
+
+  // Check for real-amplitude statevector simulation
+  JSON::get_value(statevector_real_enable_, "statevector_real_enable", config);
+
+  // Check for noise sampler threads
+  JSON::get_value(noise_sampling_threads_, "noise_sampling_threads", config);
+
+  // Load cost model calibration for the dry run mode
+  if (JSON::check_key("dry_run_calibration", config)) {
+    for (const auto &item : config["dry_run_calibration"].items())
+      dry_run_calibration_[item.key()] = item.value().get<double>();
+  }
+
   // DEPRECATED: Add custom initial state
   if (JSON::get_value(initial_statevector_, "initial_statevector", config)) {
     // Raise error if method is set to stabilizer or ch
@@ -367,6 +553,11 @@ void QasmController::clear_config() {
   Base::Controller::clear_config();
   simulation_method_ = Method::automatic;
   initial_statevector_ = cvector_t();
+  shot_branching_enable_ = true;
+  singleshot_measure_ = false;
+  statevector_real_enable_ = true;
+  noise_sampling_threads_ = -1;
+  dry_run_calibration_ = default_dry_run_calibration_;
 }
 
 //-------------------------------------------------------------------------
@@ -381,6 +572,32 @@ OutputData QasmController::run_circuit(const Circuit &circ,
   // Validate circuit for simulation method
   switch (simulation_method(circ, noise, true)) {
     case Method::statevector:
+      if (check_real_statevector(circ, noise)) {
+        // Real-amplitude Statevector simulation
+        OutputData data;
+        if (simulation_precision_ == Precision::double_precision) {
+          data = run_circuit_helper<Statevector::State<QV::RealVector<double>>>(
+                                                      circ,
+                                                      noise,
+                                                      config,
+                                                      shots,
+                                                      rng_seed,
+                                                      initial_statevector_,
+                                                      Method::statevector);
+        } else {
+          data = run_circuit_helper<Statevector::State<QV::RealVector<float>>>(
+                                                      circ,
+                                                      noise,
+                                                      config,
+                                                      shots,
+                                                      rng_seed,
+                                                      initial_statevector_,
+                                                      Method::statevector);
+        }
+        data.add_additional_data("metadata",
+                                 json_t::object({{"statevector_real", true}}));
+        return data;
+      }
       if (simulation_precision_ == Precision::double_precision) {
         // Double-precision Statevector simulation
         return run_circuit_helper<Statevector::State<QV::QubitVector<double>>>(
@@ -510,7 +727,15 @@ QasmController::simulation_method(const Circuit &circ,
       // default to the Statevector method. Otherwise we attempt to use
       // the extended stabilizer simulator.
       bool enough_memory = true;
-      if (simulation_precision_ == Precision::single_precision) {
+      if (check_real_statevector(circ, noise_model)) {
+        if (simulation_precision_ == Precision::single_precision) {
+          Statevector::State<QV::RealVector<float>> sv_state;
+          enough_memory = validate_memory_requirements(sv_state, circ, false);
+        } else {
+          Statevector::State<QV::RealVector<double>> sv_state;
+          enough_memory = validate_memory_requirements(sv_state, circ, false);
+        }
+      } else if (simulation_precision_ == Precision::single_precision) {
         Statevector::State<QV::QubitVector<float>> sv_state;
         enough_memory = validate_memory_requirements(sv_state, circ, false);
       } else {
@@ -551,7 +776,15 @@ size_t QasmController::required_memory_mb(const Circuit& circ,
                                           const Noise::NoiseModel& noise) const {
   switch (simulation_method(circ, noise, false)) {
     case Method::statevector: {
-      if (simulation_precision_ == Precision::single_precision) {
+      if (check_real_statevector(circ, noise)) {
+        if (simulation_precision_ == Precision::single_precision) {
+          Statevector::State<QV::RealVector<float>> state;
+          return state.required_memory_mb(circ.num_qubits, circ.ops);
+        } else {
+          Statevector::State<QV::RealVector<double>> state;
+          return state.required_memory_mb(circ.num_qubits, circ.ops);
+        }
+      } else if (simulation_precision_ == Precision::single_precision) {
         Statevector::State<QV::QubitVector<float>> state;
         return state.required_memory_mb(circ.num_qubits, circ.ops);
       } else {
@@ -591,7 +824,8 @@ void QasmController::set_parallelization_circuit(const Circuit& circ,
     case Method::statevector:
     case Method::matrix_product_state: {
       if ((noise_model.is_ideal() || !noise_model.has_quantum_errors()) &&
-          check_measure_sampling_opt(circ, Method::statevector).first) {
+          (check_measure_sampling_opt(circ, Method::statevector).first ||
+           check_shot_branching_opt(circ, method).first)) {
         parallel_shots_ = 1;
         parallel_state_update_ = max_parallel_threads_;
         return;
@@ -630,14 +864,6 @@ OutputData QasmController::run_circuit_helper(const Circuit &circ,
   // Check memory requirements, raise exception if they're exceeded
   validate_memory_requirements(state, circ, true);
 
-  // Set state config
-  state.set_config(config);
-  state.set_parallalization(parallel_state_update_);
-
-  // Rng engine
-  RngEngine rng;
-  rng.set_seed(rng_seed);
-
   // Output data container
   OutputData data;
   data.set_config(config);
@@ -648,26 +874,79 @@ OutputData QasmController::run_circuit_helper(const Circuit &circ,
   data.add_additional_data("metadata",
                             json_t::object({{"measure_sampling", false}}));
 
-  // Choose execution method based on noise and method
-  if (noise.is_ideal()) {
-    run_circuit_without_noise(circ, shots, state, initial_state, method, data, rng);
-  }
-  else if (method == Method::density_matrix && noise.has_quantum_errors()) {
-    // We can sample the noise model using superoperator method
-    // and then execute the resulting circuit containing superoperators
-    Noise::NoiseModel noise_cpy = noise;
-    noise_cpy.activate_superop_method();
-    Circuit noise_circ = noise_cpy.sample_noise(circ, rng);
-    run_circuit_without_noise(noise_circ, shots, state, initial_state, method, data, rng);
-  }
-  else if (noise.has_quantum_errors() == false) {
-    // We can insert the readout errors from the noise model and then
-    // execute the resulting circuit
-    Circuit noise_circ = noise.sample_noise(circ, rng);
-    run_circuit_without_noise(noise_circ, shots, state, initial_state, method, data, rng);
+  // Gradient snapshots need the operations of each shot to be recorded
+  const bool gradient_tape = circ.opset().snapshots.count("expectation_value_pauli_gradient") > 0;
+
+  // Execute the shots of a thread on its own state, rng and output data
+  const auto run_shots = [&](uint_t thread_seed, auto &&func) {
+    State_t thread_state;
+    thread_state.set_config(config);
+    thread_state.set_parallalization(state_update_threads());
+    thread_state.set_gradient_tape(gradient_tape);
+    RngEngine rng;
+    rng.set_seed(thread_seed);
+    OutputData thread_data;
+    thread_data.set_config(config);
+    func(thread_state, thread_data, rng);
+    return thread_data;
+  };
+
+  // Noise that is sampled once for all shots is inserted into the circuit,
+  // which is then optimized and checked for measure sampling once before
+  // the shots are distributed over threads. All threads share it read-only.
+  if (noise.is_ideal() || !noise.has_quantum_errors() ||
+      method == Method::density_matrix) {
+    Circuit opt_circ;
+    RngEngine rng;
+    rng.set_seed(rng_seed);
+    if (noise.is_ideal()) {
+      opt_circ = circ;
+    }
+    else if (noise.has_quantum_errors()) {
+      // We can sample the noise model using superoperator method
+      // and then execute the resulting circuit containing superoperators
+      Noise::NoiseModel noise_cpy = noise;
+      noise_cpy.activate_superop_method();
+      opt_circ = noise_cpy.sample_noise(circ, rng);
+    } else {
+      // We can insert the readout errors from the noise model and then
+      // execute the resulting circuit
+      opt_circ = noise.sample_noise(circ, rng);
+    }
+    // Optimize circuit for state type
+    if (opt_circ.num_qubits > circuit_opt_ideal_threshold_) {
+      Noise::NoiseModel dummy;
+      optimize_circuit(opt_circ, dummy, state, data);
+    }
+    // Check if measure sampler and optimization are valid
+    const auto check = check_measure_sampling_opt(opt_circ, method);
+    // Otherwise check if the shots can be branched at random operations
+    const auto branch = (check.first || shots < 2)
+                        ? std::make_pair(false, size_t(0))
+                        : check_shot_branching_opt(opt_circ, method);
+
+    auto tmp_data = run_parallel_shots(shots, rng_seed,
+      [&](uint_t thread_shots, uint_t thread_seed) {
+        return run_shots(thread_seed,
+          [&](State_t &thread_state, OutputData &thread_data, RngEngine &thread_rng) {
+            if (branch.first)
+              run_circuit_with_branching(opt_circ, branch.second, thread_shots,
+                                         thread_state, initial_state,
+                                         thread_data, thread_rng);
+            else
+              run_circuit_without_noise(opt_circ, check, thread_shots, thread_state,
+                                        initial_state, thread_data, thread_rng);
+          });
+      });
+    if (branch.first)
+      data.add_additional_data("metadata",
+                               json_t::object({{"shot_branching", true}}));
+    data.combine(tmp_data);
   } else {
     // Run sampling a noisy instance of the circuit for each shot
-    run_circuit_with_noise(circ, noise, shots, state, initial_state, data, rng);
+    auto tmp_data = run_circuit_with_noise<State_t>(circ, noise, config, shots,
+                                                    rng_seed, initial_state);
+    data.combine(tmp_data);
   }
   return data;
 }
@@ -686,42 +965,177 @@ void QasmController::run_single_shot(const Circuit &circ,
 
 
 template <class State_t, class Initstate_t>
-void QasmController::run_circuit_with_noise(const Circuit &circ,
-                                            const Noise::NoiseModel& noise,
-                                            uint_t shots,
-                                            State_t &state,
-                                            const Initstate_t &initial_state,
-                                            OutputData &data,
-                                            RngEngine &rng) const {
-  // Sample a new noise circuit and optimize for each shot
-  while(shots-- > 0) {
-    Circuit noise_circ = noise.sample_noise(circ, rng);
-    noise_circ.shots = 1;
-    if (noise_circ.num_qubits > circuit_opt_noise_threshold_) {
-      Noise::NoiseModel dummy;
-      optimize_circuit(noise_circ, dummy, state, data);
+OutputData QasmController::run_circuit_with_noise(const Circuit &circ,
+                                                  const Noise::NoiseModel& noise,
+                                                  const json_t &config,
+                                                  uint_t shots,
+                                                  uint_t rng_seed,
+                                                  const Initstate_t &initial_state) const {
+  // Contiguous shot ranges of the shot threads
+  const int shot_threads = std::max<int>(1, std::min<uint_t>(parallel_shots_, shots));
+  std::vector<uint_t> first_shots(shot_threads + 1, 0);
+  for (int i = 0; i < shot_threads; i++)
+    first_shots[i + 1] = first_shots[i] + shots / shot_threads +
+                         (uint_t(i) < shots % shot_threads);
+
+  int samplers = std::min(noise_sampling_threads(shots), shot_threads);
+  std::vector<std::unique_ptr<NoisyShotQueue>> queues;
+  std::vector<OutputData> par_data(shot_threads + samplers);
+  std::vector<std::string> error_msgs(shot_threads + samplers);
+  std::vector<std::string> bindings(shot_threads);
+  const bool gradient_tape = circ.opset().snapshots.count("expectation_value_pauli_gradient") > 0;
+
+  // Simulate the noisy instances of the shots of shot thread i in order,
+  // taken from its queue or sampled in the thread if it has none
+  const auto run_shot_thread = [&](int i, NoisyShotQueue *queue) {
+    const auto cpus = Topology::worker_cpus(binding_domains_, i, shot_threads);
+    Topology::ThreadBinding binding(cpus, parallel_state_update_);
+    if (binding.bound())
+      bindings[i] = Topology::format_cpulist(cpus);
+    try {
+      State_t state;
+      state.set_config(config);
+      state.set_parallalization(state_update_threads());
+      state.set_gradient_tape(gradient_tape);
+      OutputData &data = par_data[i];
+      data.set_config(config);
+      NoisyShot noisy_shot;
+      for (uint_t shot = first_shots[i]; shot < first_shots[i + 1]; shot++) {
+        if (queue == nullptr)
+          noisy_shot = sample_noisy_shot(circ, noise, shot, rng_seed, state, data);
+        else if (!queue->pop(noisy_shot))
+          break; // its sampler failed
+        run_single_shot(noisy_shot.circ, state, initial_state, data, noisy_shot.rng);
+      }
+    } catch (std::runtime_error &error) {
+      error_msgs[i] = error.what();
     }
-    run_single_shot(noise_circ, state, initial_state, data, rng);
-  }     
+    // Stop the sampler if this thread failed
+    if (queue != nullptr)
+      queue->close();
+  };
+
+  // Sampler j fills the queues of shot threads j, j + samplers, ... taking
+  // one shot of each in turn
+  const auto run_sampler = [&](int j) {
+    try {
+      State_t state;
+      state.set_config(config);
+      OutputData &data = par_data[shot_threads + j];
+      data.set_config(config);
+      bool open = true;
+      for (uint_t k = 0; open; k++) {
+        open = false;
+        for (int i = j; i < shot_threads; i += samplers) {
+          const uint_t shot = first_shots[i] + k;
+          if (shot < first_shots[i + 1])
+            open |= queues[i]->push(sample_noisy_shot(circ, noise, shot, rng_seed,
+                                                      state, data));
+        }
+      }
+    } catch (std::runtime_error &error) {
+      error_msgs[shot_threads + j] = error.what();
+    }
+    // Release shot threads waiting for shots that will not be sampled
+    for (int i = j; i < shot_threads; i += samplers)
+      queues[i]->close();
+  };
+
+  if (samplers > 0) {
+    for (int i = 0; i < shot_threads; i++)
+      queues.emplace_back(new NoisyShotQueue(noise_sampling_queue_size_));
+    // The role of a thread is given by its number, so if the team is
+    // smaller than requested the shots are sampled in the shot threads
+    bool complete_team = true;
+    #pragma omp parallel num_threads(shot_threads + samplers)
+    {
+    #ifdef _OPENMP
+      const int thread = omp_get_thread_num();
+      const int team = omp_get_num_threads();
+    #else
+      const int thread = 0;
+      const int team = 1;
+    #endif
+      if (team < shot_threads + samplers) {
+        if (thread == 0)
+          complete_team = false;
+      }
+      else if (thread < shot_threads)
+        run_shot_thread(thread, queues[thread].get());
+      else
+        run_sampler(thread - shot_threads);
+    }
+    if (!complete_team)
+      samplers = 0;
+  }
+  if (samplers == 0) {
+    #pragma omp parallel for if (shot_threads > 1) num_threads(shot_threads)
+    for (int i = 0; i < shot_threads; i++)
+      run_shot_thread(i, nullptr);
+  }
+
+  for (const auto &error_msg : error_msgs)
+    if (!error_msg.empty())
+      throw std::runtime_error(error_msg);
+
+  // Accumulate results in shot order
+  OutputData data;
+  for (auto &datum : par_data)
+    data.combine(datum);
+  if (!bindings.front().empty()) {
+    json_t metadata;
+    metadata["thread_binding"] = bindings;
+    data.add_additional_data("metadata", metadata);
+  }
+  if (samplers > 0)
+    data.add_additional_data("metadata",
+                             json_t::object({{"noise_sampling_threads", samplers}}));
+  return data;
+}
+
+
+template <class State_t>
+QasmController::NoisyShot
+QasmController::sample_noisy_shot(const Circuit &circ,
+                                  const Noise::NoiseModel& noise,
+                                  uint_t shot,
+                                  uint_t rng_seed,
+                                  State_t &state,
+                                  OutputData &data) const {
+  RngEngine rng(RngEngine::derive_seed(rng_seed, shot));
+  Circuit noise_circ = noise.sample_noise(circ, rng);
+  noise_circ.shots = 1;
+  if (noise_circ.num_qubits > circuit_opt_noise_threshold_) {
+    Noise::NoiseModel dummy;
+    optimize_circuit(noise_circ, dummy, state, data);
+  }
+  return NoisyShot{std::move(noise_circ), rng};
+}
+
+
+int QasmController::noise_sampling_threads(uint_t shots) const {
+#ifdef _OPENMP
+  if (shots < 2)
+    return 0;
+  if (noise_sampling_threads_ >= 0)
+    return noise_sampling_threads_;
+  // Shot threads that are alone on their cores already overlap sampling
+  // with the simulation of other shot threads
+  return (parallel_state_update_ > 1) ? 1 : 0;
+#else
+  return 0;
+#endif
 }
 
 
 template <class State_t, class Initstate_t>
-void QasmController::run_circuit_without_noise(const Circuit &circ,
+void QasmController::run_circuit_without_noise(const Circuit &opt_circ,
+                                               const std::pair<bool, size_t> &check,
                                                uint_t shots,
                                                State_t &state,
                                                const Initstate_t &initial_state,
-                                               const Method method,
                                                OutputData &data,
                                                RngEngine &rng) const {
-  // Optimize circuit for state type
-  Circuit opt_circ = circ;
-  if (opt_circ.num_qubits > circuit_opt_ideal_threshold_) {
-    Noise::NoiseModel dummy;
-    optimize_circuit(opt_circ, dummy, state, data);
-  }
-  // Check if measure sampler and optimization are valid
-  auto check = check_measure_sampling_opt(opt_circ, method);
   if (check.first == false) {
     // Perform standard execution if we cannot apply the
     // measurement sampling optimization
@@ -747,6 +1161,100 @@ void QasmController::run_circuit_without_noise(const Circuit &circ,
 }
 
 
+template <class State_t, class Initstate_t>
+void QasmController::run_circuit_with_branching(const Circuit &opt_circ,
+                                                size_t pos,
+                                                uint_t shots,
+                                                State_t &state,
+                                                const Initstate_t &initial_state,
+                                                OutputData &data,
+                                                RngEngine &rng) const {
+  // Split the operations before the final measurements into blocks
+  std::vector<std::vector<Operations::Op>> blocks;
+  bool deterministic = false;
+  for (size_t j = 0; j < pos; ++j) {
+    const auto &op = opt_circ.ops[j];
+    const bool random = (op.type == Operations::OpType::measure ||
+                         op.type == Operations::OpType::reset ||
+                         op.type == Operations::OpType::initialize ||
+                         op.type == Operations::OpType::snapshot);
+    if (random || !deterministic)
+      blocks.emplace_back();
+    blocks.back().push_back(op);
+    deterministic = !random;
+  }
+  const std::vector<Operations::Op> meas_ops(opt_circ.ops.begin() + pos,
+                                             opt_circ.ops.end());
+
+  // A branch of n shots saves at most log2(n) copies of the state, so the
+  // shots are run in chunks whose copies fit in the memory limit
+  const size_t state_mb = state.required_memory_mb(opt_circ.num_qubits,
+                                                   opt_circ.ops);
+  uint_t chunk = shots;
+  if (state_mb > 0) {
+    const size_t max_states = max_memory_mb_ / (state_mb * parallel_shots_);
+    if (max_states < 2)
+      chunk = 1;
+    else if (max_states <= 64)
+      chunk = std::min<uint_t>(shots, 1ULL << (max_states - 1));
+  }
+  while (shots > 0) {
+    const uint_t chunk_shots = std::min(shots, chunk);
+    shots -= chunk_shots;
+    initialize_state(opt_circ, state, initial_state);
+    apply_branches(blocks, 0, meas_ops, chunk_shots, state, data, rng);
+  }
+}
+
+
+template <class State_t>
+void QasmController::apply_branches(const std::vector<std::vector<Operations::Op>> &blocks,
+                                    size_t k,
+                                    const std::vector<Operations::Op> &meas_ops,
+                                    uint_t shots,
+                                    State_t &state,
+                                    OutputData &data,
+                                    RngEngine &rng) const {
+  for (; k < blocks.size(); ++k) {
+    const auto &block = blocks[k];
+    const auto &op = block.front();
+    // Averaged snapshots are recorded once with the weight of the shots
+    // of the branch
+    if (op.type == Operations::OpType::snapshot) {
+      data.set_average_snapshot_weight(shots);
+      state.apply_ops(block, data, rng);
+      data.set_average_snapshot_weight(1);
+      continue;
+    }
+    const auto probs = state.branch_probabilities(op);
+    if (probs.empty()) {
+      state.apply_ops(block, data, rng);
+      continue;
+    }
+    // Distribute the shots over the outcomes
+    const auto counts = rng.rand_multinomial(shots, probs);
+    std::vector<uint_t> outcomes;
+    for (uint_t j = 0; j < counts.size(); ++j) {
+      if (counts[j] > 0)
+        outcomes.push_back(j);
+    }
+    std::stable_sort(outcomes.begin(), outcomes.end(),
+                     [&counts](uint_t a, uint_t b) {return counts[a] < counts[b];});
+    // Run the smaller branches on saved copies of the state and continue
+    // with the largest branch on the state itself
+    for (size_t j = 0; j + 1 < outcomes.size(); ++j) {
+      state.push_branch();
+      state.apply_branch(op, outcomes[j], probs[outcomes[j]]);
+      apply_branches(blocks, k + 1, meas_ops, counts[outcomes[j]], state, data, rng);
+      state.pop_branch();
+    }
+    shots = counts[outcomes.back()];
+    state.apply_branch(op, outcomes.back(), probs[outcomes.back()]);
+  }
+  measure_sampler(meas_ops, shots, state, data, rng);
+}
+
+
 //-------------------------------------------------------------------------
 // Measure sampling optimization
 //-------------------------------------------------------------------------
@@ -794,6 +1302,154 @@ QasmController::check_measure_sampling_opt(const Circuit &circ,
 }
 
 
+std::pair<bool, size_t>
+QasmController::check_shot_branching_opt(const Circuit &circ,
+                                         const Method method) const {
+  // The shots of a branch are recorded together, so circuits returning
+  // the memory or register value of each shot are not branched
+  if (!shot_branching_enable_ || singleshot_measure_ ||
+      method != Method::statevector)
+    return std::make_pair(false, 0);
+  // Find the final measurements that are sampled for each branch
+  size_t pos = circ.ops.size();
+  while (pos > 0) {
+    const auto &op = circ.ops[pos - 1];
+    if ((op.type != Operations::OpType::measure &&
+         op.type != Operations::OpType::roerror) || op.conditional)
+      break;
+    --pos;
+  }
+  // Readout errors and noise before the final measurements are sampled
+  // for each shot and cannot be branched. Neither can snapshots returning
+  // a value for each shot.
+  const stringset_t singleshot_snapshots({
+    "statevector", "memory", "register",
+    "expectation_value_pauli_single_shot",
+    "expectation_value_matrix_single_shot"
+  });
+  for (size_t j = 0; j < pos; ++j) {
+    const auto &op = circ.ops[j];
+    if (op.type == Operations::OpType::roerror ||
+        op.type == Operations::OpType::kraus ||
+        op.type == Operations::OpType::superop ||
+        (op.type == Operations::OpType::snapshot &&
+         singleshot_snapshots.count(op.name)))
+      return std::make_pair(false, 0);
+  }
+  return std::make_pair(true, pos);
+}
+
+//-------------------------------------------------------------------------
+// Real-amplitude statevector
+//-------------------------------------------------------------------------
+
+bool QasmController::check_real_statevector(const Circuit &circ,
+                                            const Noise::NoiseModel &noise) const {
+  // Sampled quantum errors are not known to be real before the shots are run
+  if (!statevector_real_enable_ || noise.has_quantum_errors())
+    return false;
+  if (!Utils::is_real(initial_statevector_, validation_threshold_))
+    return false;
+
+  // Gates whose matrices are always real
+  static const stringset_t real_gates({
+    "id", "x", "z", "h", "cx", "cz", "swap", "mcswap", "ccx", "mcx", "mcz",
+    "relabel"
+  });
+  const auto is_real_mats = [&](const std::vector<cmatrix_t> &mats) {
+    for (const auto &mat : mats) {
+      if (!Utils::is_real(mat, validation_threshold_))
+        return false;
+    }
+    return true;
+  };
+
+  for (const auto &op : circ.ops) {
+    switch (op.type) {
+      case Operations::OpType::barrier:
+      case Operations::OpType::measure:
+      case Operations::OpType::reset:
+      case Operations::OpType::bfunc:
+      case Operations::OpType::roerror:
+        break;
+      case Operations::OpType::initialize:
+        if (!Utils::is_real(op.params, validation_threshold_))
+          return false;
+        break;
+      case Operations::OpType::matrix:
+      case Operations::OpType::multiplexer:
+      case Operations::OpType::kraus:
+        if (!is_real_mats(op.mats) ||
+            !Utils::is_real(op.mat_entries, validation_threshold_))
+          return false;
+        break;
+      case Operations::OpType::pauli_rotation: {
+        // phase * (cos(theta/2) I - i sin(theta/2) P) where the Pauli
+        // matrix P is i^num_y times a real matrix
+        const auto num_y = std::count(op.string_params[0].begin(),
+                                      op.string_params[0].end(), 'Y');
+        const complex_t phase = (op.params.size() > 1) ? op.params[1] : 1.;
+        const double theta = std::real(op.params[0]);
+        const cvector_t coeffs({
+          phase * std::cos(0.5 * theta),
+          phase * std::sin(0.5 * theta) * std::pow(complex_t(0., 1.), num_y + 3)
+        });
+        if (!Utils::is_real(coeffs, validation_threshold_))
+          return false;
+        break;
+      }
+      case Operations::OpType::gate: {
+        if (real_gates.count(op.name))
+          break;
+        cvector_t mat;
+        if (op.name == "u1" || op.name == "cu1" || op.name == "mcu1")
+          mat = Utils::VMatrix::u1(op.params[0]);
+        else if (op.name == "u2" || op.name == "mcu2")
+          mat = Utils::VMatrix::u2(op.params[0], op.params[1]);
+        else if (op.name == "u3" || op.name == "mcu3")
+          mat = Utils::VMatrix::u3(op.params[0], op.params[1], op.params[2]);
+        else
+          return false;
+        if (!Utils::is_real(mat, validation_threshold_))
+          return false;
+        break;
+      }
+      case Operations::OpType::snapshot: {
+        if (op.name == "statevector" || op.name == "memory" ||
+            op.name == "register" || op.name == "probabilities" ||
+            op.name == "probabilities_with_variance")
+          break;
+        // Pauli expectation values apply the Pauli gates to the state
+        if (op.name == "expectation_value_pauli" ||
+            op.name == "expectation_value_pauli_with_variance" ||
+            op.name == "expectation_value_pauli_single_shot") {
+          for (const auto &param : op.params_expval_pauli) {
+            if (param.second.find('Y') != std::string::npos)
+              return false;
+          }
+          break;
+        }
+        if (op.name == "expectation_value_matrix" ||
+            op.name == "expectation_value_matrix_with_variance" ||
+            op.name == "expectation_value_matrix_single_shot") {
+          for (const auto &param : op.params_expval_matrix) {
+            for (const auto &pair : param.second) {
+              if (!Utils::is_real(pair.second, validation_threshold_))
+                return false;
+            }
+          }
+          break;
+        }
+        return false;
+      }
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+
 template <class State_t>
 void QasmController::measure_sampler(const std::vector<Operations::Op> &meas_roerror_ops,
                                      uint_t shots,
@@ -847,15 +1503,11 @@ void QasmController::measure_sampler(const std::vector<Operations::Op> &meas_roe
     }
   }
   
-  // Process samples
-  // Convert opts to circuit so we can get the needed creg sizes
-  // NB: this function could probably be moved somewhere else like Utils or Ops
-  Circuit meas_circ(meas_roerror_ops);
-  ClassicalRegister creg;
-  while (!all_samples.empty()) {
-    auto sample = all_samples.back();
-    creg.initialize(meas_circ.num_memory, meas_circ.num_registers);
-
+  // Return the classical register of a sample. The measurements are stored
+  // on top of the current classical register which holds the outcomes of
+  // any earlier measurements of a branch
+  const auto sample_creg = [&](const reg_t &sample) {
+    ClassicalRegister creg = state.creg();
     // process memory bit measurements
     for (const auto &pair : memory_map) {
       creg.store_measure(reg_t({sample[pair.second]}), reg_t({pair.first}), reg_t());
@@ -864,6 +1516,38 @@ void QasmController::measure_sampler(const std::vector<Operations::Op> &meas_roe
     for (const auto &pair : register_map) {
       creg.store_measure(reg_t({sample[pair.second]}), reg_t(), reg_t({pair.first}));
     }
+    return creg;
+  };
+
+  // If only counts are returned factored read out errors are applied to the
+  // histogram of samples by distributing the shots of each sample over
+  // the outcomes of the errors. Dense errors are sampled for each shot
+  // below, which keeps the random numbers of seeded simulations.
+  const bool factored = std::any_of(roerror_ops.begin(), roerror_ops.end(),
+    [](const Operations::Op &op) {return !op.roerror_factors.empty();});
+  if (factored && !data.singleshot_measure_enabled()) {
+    std::map<reg_t, uint_t> hist;
+    for (const auto &sample : all_samples)
+      ++hist[sample];
+    for (const auto &pair : hist) {
+      std::vector<std::pair<ClassicalRegister, uint_t>> cregs({{sample_creg(pair.first), pair.second}});
+      for (const Operations::Op& roerror: roerror_ops) {
+        std::vector<std::pair<ClassicalRegister, uint_t>> noisy_cregs;
+        for (const auto &creg : cregs) {
+          auto outcomes = creg.first.apply_roerror(roerror, creg.second, rng);
+          noisy_cregs.insert(noisy_cregs.end(), outcomes.begin(), outcomes.end());
+        }
+        cregs = std::move(noisy_cregs);
+      }
+      for (const auto &creg : cregs)
+        data.add_memory_count(creg.first.memory_hex(), creg.second);
+    }
+    return;
+  }
+
+  // Process samples
+  while (!all_samples.empty()) {
+    auto creg = sample_creg(all_samples.back());
 
     // process read out errors for memory and registers
     for (const Operations::Op& roerror: roerror_ops) {
@@ -881,6 +1565,206 @@ void QasmController::measure_sampler(const std::vector<Operations::Op> &meas_roe
   }
 }
 
+//-------------------------------------------------------------------------
+// Resource estimation
+//-------------------------------------------------------------------------
+
+json_t QasmController::estimate_circuit(const Circuit &circ,
+                                        const Noise::NoiseModel &noise,
+                                        const json_t &config) const {
+  const Method method = simulation_method(circ, noise, true);
+  const uint_t num_qubits = circ.num_qubits;
+
+  // Circuits are executed once and sampled if measure sampling applies,
+  // which requires noise that can be inserted into a single circuit
+  const bool sampled_noise = noise.is_ideal() || !noise.has_quantum_errors() ||
+                             method == Method::density_matrix;
+  const auto check = check_measure_sampling_opt(circ, method);
+  const bool sampling = sampled_noise && check.first;
+
+  // Circuit optimizations are applied above a qubit threshold
+  Transpile::Fusion fusion;
+  fusion.set_config(config);
+  const uint_t opt_threshold = sampled_noise ? circuit_opt_ideal_threshold_
+                                             : circuit_opt_noise_threshold_;
+  const bool fusion_applied = num_qubits > opt_threshold &&
+                              fusion.is_active(num_qubits);
+
+  // Stabilizer rank of the extended stabilizer method
+  double chi = 1.;
+  double mixing_time = 0.;
+  if (method == Method::extended_stabilizer) {
+    ExtendedStabilizer::State state;
+    state.set_config(config);
+    chi = state.compute_chi(circ.ops);
+    mixing_time = state.mixing_time();
+  }
+
+  // Cost of the circuit, and of each shot if measurements are sampled
+  std::vector<double> bonds(num_qubits > 0 ? num_qubits - 1 : 0, 1.);
+  double mps_entries = 2. * num_qubits;
+  double mps_peak = mps_entries;
+  const auto meas_pos = circ.ops.begin() + (sampling ? check.second : circ.ops.size());
+  double cost = estimate_ops_cost(circ.ops.begin(), meas_pos, num_qubits, method,
+                                  chi, mixing_time, bonds, mps_entries, mps_peak);
+  double shot_cost = estimate_ops_cost(meas_pos, circ.ops.end(), num_qubits, method,
+                                       chi, mixing_time, bonds, mps_entries, mps_peak);
+  if (!sampling) {
+    // Each shot also initializes the state
+    double init_cost = 0.;
+    if (method == Method::statevector)
+      init_cost = std::pow(2., num_qubits);
+    else if (method == Method::density_matrix)
+      init_cost = std::pow(4., num_qubits);
+    cost = circ.shots * (init_cost + cost + shot_cost);
+  } else if (method == Method::statevector || method == Method::density_matrix) {
+    // Sampling from the probabilities of a single pass over the state
+    cost += std::pow(2., num_qubits) + circ.shots * num_qubits;
+  } else {
+    cost += circ.shots * shot_cost;
+  }
+
+  // Shots that are not sampled are distributed over parallel shot threads,
+  // the statevector and density matrix methods update large states in parallel
+  double threads = sampling ? 1. : std::max(1, parallel_shots_);
+  if (method == Method::statevector || method == Method::density_matrix) {
+    int omp_qubit_threshold = 14;
+    JSON::get_value(omp_qubit_threshold, "statevector_parallel_threshold", config);
+    if (num_qubits > static_cast<uint_t>(omp_qubit_threshold))
+      threads *= std::max(1, parallel_state_update_);
+  }
+
+  // Fixed costs of executed operations and shots, and of sampling the noise
+  // of each operation for every shot
+  const double num_shots = sampling ? 1. : circ.shots;
+  const double num_ops = sampling ? check.second : circ.shots * circ.ops.size();
+  const double num_noise_ops = sampled_noise ? 0. : circ.shots * circ.ops.size();
+
+  // Memory of a state for each shot that is executed in parallel, the
+  // matrix product state size follows from the bond dimensions
+  const std::string name = method_name(method);
+  const double state_mb = (method == Method::matrix_product_state)
+                          ? 16. * mps_peak / (1ULL << 20)
+                          : required_memory_mb(circ, noise);
+  const double memory_mb = state_mb * (sampling ? 1 : std::max(1, parallel_shots_));
+
+  const auto calibration = [this](const std::string &key) {
+    const auto it = dry_run_calibration_.find(key);
+    return (it != dry_run_calibration_.end()) ? it->second : default_dry_run_calibration_.at(key);
+  };
+  const double seconds = cost * calibration(name) +
+                         num_ops * calibration("operation") +
+                         num_shots * calibration("shot") +
+                         num_noise_ops * calibration("noise");
+
+  json_t estimate;
+  estimate["method"] = name;
+  estimate["estimated_memory_mb"] = static_cast<size_t>(std::ceil(memory_mb));
+  estimate["estimated_time"] = seconds / threads;
+  estimate["measure_sampling"] = sampling;
+  estimate["fusion"] = fusion_applied;
+  return estimate;
+}
+
+double QasmController::estimate_ops_cost(std::vector<Operations::Op>::const_iterator first,
+                                         std::vector<Operations::Op>::const_iterator last,
+                                         uint_t num_qubits,
+                                         Method method,
+                                         double chi,
+                                         double mixing_time,
+                                         std::vector<double> &bonds,
+                                         double &mps_entries,
+                                         double &mps_peak) const {
+  const double dim = std::pow(2., num_qubits);
+  double cost = 0.;
+  for (auto op = first; op != last; ++op) {
+    bool update = false;
+    switch (op->type) {
+      case Operations::OpType::barrier:
+      case Operations::OpType::bfunc:
+      case Operations::OpType::roerror:
+        continue;
+      case Operations::OpType::gate:
+      case Operations::OpType::matrix:
+      case Operations::OpType::multiplexer:
+      case Operations::OpType::kraus:
+      case Operations::OpType::superop:
+        update = true;
+        break;
+      default:
+        break;
+    }
+    // Kraus operators are applied one at a time to find the outcome
+    const double num_mats = (op->type == Operations::OpType::kraus) ? op->mats.size() : 1.;
+    const double op_dim = std::pow(2., op->qubits.size());
+    switch (method) {
+      case Method::statevector:
+        cost += update ? num_mats * dim * op_dim : 4. * dim;
+        break;
+      case Method::density_matrix:
+        cost += update ? dim * dim * op_dim * op_dim : 2. * dim * dim;
+        break;
+      case Method::stabilizer:
+        cost += update ? 2. * num_qubits : 5. * num_qubits;
+        break;
+      case Method::extended_stabilizer:
+        cost += update ? chi * num_qubits : chi * mixing_time;
+        break;
+      case Method::matrix_product_state: {
+        if (op->qubits.empty() || bonds.empty())
+          break;
+        const auto minmax = std::minmax_element(op->qubits.begin(), op->qubits.end());
+        const uint_t lo = *minmax.first;
+        const uint_t hi = *minmax.second;
+        if (!update) {
+          // Measurements and snapshots contract the tensors of the qubits
+          for (const auto &bond : bonds)
+            cost += op->qubits.size() * 4. * bond * bond;
+        } else if (lo == hi) {
+          const double left = (lo > 0) ? bonds[lo - 1] : 1.;
+          const double right = (lo < bonds.size()) ? bonds[lo] : 1.;
+          cost += 4. * left * right;
+        } else {
+          // Gates on distant qubits are applied with swaps along the chain,
+          // each step decomposes two neighbouring tensors and may double the
+          // bond dimension up to the dimension of the smaller side
+          for (uint_t i = lo; i < hi; i++) {
+            cost += 8. * bonds[i] * bonds[i] * bonds[i];
+            const double bond = std::min(2. * bonds[i],
+                                         std::pow(2., std::min(i + 1, num_qubits - i - 1)));
+            const double left = (i > 0) ? bonds[i - 1] : 1.;
+            const double right = (i + 1 < bonds.size()) ? bonds[i + 1] : 1.;
+            mps_entries += 2. * (bond - bonds[i]) * (left + right);
+            bonds[i] = bond;
+          }
+          mps_peak = std::max(mps_peak, mps_entries);
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return cost;
+}
+
+std::string QasmController::method_name(Method method) {
+  switch (method) {
+    case Method::statevector:
+      return "statevector";
+    case Method::density_matrix:
+      return "density_matrix";
+    case Method::stabilizer:
+      return "stabilizer";
+    case Method::extended_stabilizer:
+      return "extended_stabilizer";
+    case Method::matrix_product_state:
+      return "matrix_product_state";
+    default:
+      return "automatic";
+  }
+}
+
 //-------------------------------------------------------------------------
 } // end namespace Simulator
 //-------------------------------------------------------------------------
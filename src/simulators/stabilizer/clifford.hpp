@@ -15,6 +15,7 @@
 #ifndef _clifford_hpp_
 #define _clifford_hpp_
 
+#include "framework/isa.hpp"
 #include "pauli.hpp"
 
 
@@ -93,6 +94,12 @@ public:
   // Apply Pauli::Pauli Z gate
   void append_z(const uint64_t qubit);
 
+  // Apply a Clifford gate on the qubits given by the table of the images of
+  // all Paulis on its qubits from Operations::clifford_images. Each row is
+  // updated once from the table.
+  void append_clifford(const std::vector<uint64_t> &qubits,
+                       const std::vector<uint64_t> &images);
+
   //-----------------------------------------------------------------------
   // Measurement
   //-----------------------------------------------------------------------
@@ -259,6 +266,28 @@ void Clifford::append_z(const uint64_t qubit) {
     phases_[i] ^= table_[i].X[qubit];
 }
 
+void Clifford::append_clifford(const std::vector<uint64_t> &qubits,
+                               const std::vector<uint64_t> &images) {
+  const uint64_t N = qubits.size();
+  const uint64_t MASK = (1ULL << N) - 1;
+
+  #pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int64_t i = 0; i < static_cast<int64_t>(2 * num_qubits_); i++) {
+    auto &X = table_[i].X;
+    auto &Z = table_[i].Z;
+    uint64_t k = 0;
+    for (uint64_t j = 0; j < N; j++)
+      k |= (uint64_t(X[qubits[j]]) << j) | (uint64_t(Z[qubits[j]]) << (N + j));
+    if (k == 0)
+      continue;
+    phases_[i] ^= (images[k] >> (2 * N)) & 1;
+    const uint64_t x = images[k] & MASK, z = (images[k] >> N) & MASK;
+    for (uint64_t j = 0; j < N; j++) {
+      X.setValue((x >> j) & 1, qubits[j]);
+      Z.setValue((z >> j) & 1, qubits[j]);
+    }
+  }
+}
 
 //------------------------------------------------------------------------------
 // Utility
@@ -285,6 +314,7 @@ std::pair<bool, uint64_t> Clifford::x_anticommuting(const uint64_t qubit) const
 // Measurement
 //------------------------------------------------------------------------------
 
+AER_TARGET_CLONES
 bool Clifford::measure_and_update(const uint64_t qubit, const uint64_t randint) {
   // Clifford state measurements only have three probabilities:
   // (p0, p1) = (0.5, 0.5), (1, 0), or (0, 1)
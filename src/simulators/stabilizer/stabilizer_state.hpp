@@ -65,7 +65,8 @@ public:
       Operations::OpType::snapshot,
       Operations::OpType::barrier,
       Operations::OpType::bfunc,
-      Operations::OpType::roerror
+      Operations::OpType::roerror,
+      Operations::OpType::clifford
     });
   }
 
@@ -117,6 +118,9 @@ protected:
   // If the input is not in allowed_gates an exeption will be raised.
   void apply_gate(const Operations::Op &op);
 
+  // Applies a Clifford gate given by its tableau to the state class.
+  void apply_clifford(const Operations::Op &op);
+
   // Measure qubits and return a list of outcomes [q0, q1, ...]
   // If a state subclass supports this function it then "measure"
   // should be contained in the set returned by the 'allowed_ops'
@@ -290,6 +294,9 @@ void State::apply_ops(const std::vector<Operations::Op> &ops,
         case Operations::OpType::gate:
           apply_gate(op);
           break;
+        case Operations::OpType::clifford:
+          apply_clifford(op);
+          break;
         case Operations::OpType::snapshot:
           apply_snapshot(op, data);
           break;
@@ -349,6 +356,10 @@ void State::apply_gate(const Operations::Op &op) {
   }
 }
 
+void State::apply_clifford(const Operations::Op &op) {
+  BaseState::qreg_.append_clifford(op.qubits, op.clifford_images);
+}
+
 //=========================================================================
 // Implementation: Reset and Measurement Sampling
 //=========================================================================
@@ -28,7 +28,9 @@
 #include <sstream>
 #include <stdexcept>
 
+#include "framework/isa.hpp"
 #include "framework/json.hpp"
+#include "framework/json_writer.hpp"
 
 namespace QV {
 
@@ -95,6 +97,25 @@ const std::array<uint_t, 64> MASKS {{
   1152921504606846975ULL, 2305843009213693951ULL, 4611686018427387903ULL, 9223372036854775807ULL
 }};
 
+// Return the parity of the number of set bits of k
+inline uint_t parity(uint_t k) {
+#ifdef __GNUC__
+  return __builtin_parityll(k);
+#else
+  uint_t ret = 0;
+  for (; k; k &= k - 1)
+    ret ^= 1;
+  return ret;
+#endif
+}
+
+
+// Vector representations of matrix operators for expectation values
+// dense:     column-major vectorized N-qubit matrix (length 4^N)
+// diagonal:  matrix diagonal (length 2^N)
+// projector: vector |phi> of the rank-1 projector |phi><phi| (length 2^N)
+enum class MatrixForm {dense, diagonal, projector};
+
 
 //============================================================================
 // QubitVector class
@@ -160,6 +181,10 @@ public:
   // Return JSON serialization of QubitVector;
   json_t json() const;
 
+  // Return a copy of the vector that is serialized as json() by a
+  // JSON::Writer without building the JSON document
+  JSON::ComplexArray json_array() const;
+
   // Set all entries in the vector to 0.
   void zero();
 
@@ -208,6 +233,12 @@ public:
   // (using apply_reset)
   void initialize_component(const reg_t &qubits, const cvector_t<double> &state);
 
+  // As above but first projects the specified qubits onto the basis state
+  // meas_state with probability meas_prob. This applies a reset from a
+  // sampled measurement outcome and the initialization in a single pass.
+  void initialize_component(const reg_t &qubits, const cvector_t<double> &state,
+                            const uint_t meas_state, const double meas_prob);
+
   //-----------------------------------------------------------------------
   // Check point operations
   //-----------------------------------------------------------------------
@@ -221,6 +252,37 @@ public:
   // Compute the inner product of current state with checkpoint state
   std::complex<double> inner_product() const;
 
+  //-----------------------------------------------------------------------
+  // Operations with a second state
+  //-----------------------------------------------------------------------
+
+  // Swap the current and checkpoint data with another state of the same
+  // number of qubits
+  void swap(QubitVector &qv);
+
+  // Add coeff * P|qv> to the current state for the N-qubit Pauli label P,
+  // where the last character of the label acts on qubits[0]
+  void add_pauli(const QubitVector &qv, const reg_t &qubits,
+                 const std::string &pauli, const std::complex<double> coeff);
+
+  // Compute the inner product <bra|P|this> for the N-qubit Pauli label P
+  // on the qubits, restricted to the subspace where all control qubits are
+  // in the |1> state. With an empty label this is the inner product with
+  // the projector onto that subspace.
+  std::complex<double> inner_product(const QubitVector &bra,
+                                     const reg_t &qubits,
+                                     const std::string &pauli,
+                                     const reg_t &controls = {}) const;
+
+  // Compute the inner products <bra|(|i><j|)|this> for the single-qubit
+  // operators |i><j| on the qubit, restricted to the subspace where all
+  // control qubits are in the |1> state. They are returned in column-major
+  // order [00, 10, 01, 11], so that <bra|M|this> is the sum of the
+  // products with the vectorized matrix M.
+  cvector_t<double> inner_products(const QubitVector &bra,
+                                   const uint_t qubit,
+                                   const reg_t &controls = {}) const;
+
   //-----------------------------------------------------------------------
   // Initialization
   //-----------------------------------------------------------------------
@@ -253,6 +315,12 @@ public:
   // The matrix is input as vector of the column-major vectorized N-qubit matrix.
   void apply_multiplexer(const reg_t &control_qubits, const reg_t &target_qubits, const cvector_t<double> &mat);
 
+  // Apply a multiplexer given as a list of 2^control_count column-major vectorized
+  // target_count-qubit matrices, where the value of the control qubits selects the matrix.
+  // If target_count=1 or 2 this implements an optimized multiplexer.
+  void apply_multiplexer(const reg_t &control_qubits, const reg_t &target_qubits,
+                         const std::vector<cvector_t<double>> &mats);
+
   // Apply a 1-qubit diagonal matrix to the state vector.
   // The matrix is input as vector of the matrix diagonal.
   void apply_diagonal_matrix(const uint_t qubit, const cvector_t<double> &mat);
@@ -265,6 +333,19 @@ public:
   void apply_permutation_matrix(const reg_t &qubits,
                                 const std::vector<std::pair<uint_t, uint_t>> &pairs);
 
+  // Apply a N-qubit monomial matrix (a permutation matrix with phases).
+  // The matrix is input as the row and the value of the non-zero entry of
+  // each column. Only the amplitudes not fixed by the matrix are updated.
+  void apply_monomial_matrix(const reg_t &qubits, const reg_t &rows,
+                             const cvector_t<double> &entries);
+
+  // Apply a matrix on the target qubits to the subspace where all control
+  // qubits are in the |1> state.
+  // The matrix is input as vector of the column-major vectorized matrix.
+  void apply_controlled_matrix(const reg_t &control_qubits,
+                               const reg_t &target_qubits,
+                               const cvector_t<double> &mat);
+
   //-----------------------------------------------------------------------
   // Apply Specialized Gates
   //-----------------------------------------------------------------------
@@ -300,6 +381,20 @@ public:
   // If N=3 this implements an optimized Fredkin gate
   void apply_mcswap(const reg_t &qubits);
 
+  // Apply a sequence of SWAP gates on the qubit pairs
+  // (qubits[0], qubits[1]), (qubits[2], qubits[3]), ...
+  // Each block of SWAPs acting on at most 6 distinct qubits is applied
+  // in a single pass over the state vector.
+  void apply_swaps(const reg_t &qubits);
+
+  // Apply the Pauli rotation phase * exp(-i theta/2 P) for the N-qubit Pauli
+  // label P, where the last character of the label acts on qubits[0].
+  // Amplitudes are updated in pairs flipped by the X and Y qubits in a single
+  // pass, with the sign given by the parity of the Z and Y qubits.
+  void apply_pauli_rotation(const reg_t &qubits, const std::string &pauli,
+                            const double theta,
+                            const std::complex<double> phase = 1.);
+
   //-----------------------------------------------------------------------
   // Z-measurement outcome probabilities
   //-----------------------------------------------------------------------
@@ -354,6 +449,44 @@ public:
   // The matrix is input as vector of the matrix diagonal.
   double norm_diagonal(const reg_t &qubits, const cvector_t<double> &mat) const;
 
+  //-----------------------------------------------------------------------
+  // Expectation values
+  //-----------------------------------------------------------------------
+
+  // These functions return the expectation value <psi|A|psi> of a matrix
+  // A computed directly from the vector in a single read-only pass.
+  // Unlike applying A to a checkpointed copy of the vector they do not
+  // modify the current vector or require any additional vector memory.
+
+  // Return the expectation value of the N-qubit matrix mat.
+  // The matrix is input as vector of the column-major vectorized N-qubit matrix.
+  std::complex<double> expval_matrix(const reg_t &qubits,
+                                     const cvector_t<double> &mat) const;
+
+  // Return the expectation value of the N-qubit diagonal matrix mat.
+  // The matrix is input as vector of the matrix diagonal.
+  std::complex<double> expval_diagonal_matrix(const reg_t &qubits,
+                                              const cvector_t<double> &mat) const;
+
+  // Return the expectation value of the N-qubit projector |phi><phi|.
+  // The projector is input as the length 2^N vector |phi>.
+  double expval_projector(const reg_t &qubits,
+                          const cvector_t<double> &phi) const;
+
+  // Return the expectation value of the operator product M_K ... M_1 where
+  // each M_j acts on the qubits regs[j]. The matrices need not act on
+  // disjoint qubits: a tensor product M_1 x ... x M_K over disjoint qubits
+  // is the special case where all the matrices commute.
+  // Each M_j is input as a vector in the format specified by forms[j]
+  // (see the MatrixForm enum class).
+  // Each thread holds blocks of amplitudes for the union of the qubits, so
+  // the union should only span a few qubits: for a large union the vector
+  // is split into few blocks, which limits the parallelism and the block
+  // buffers approach the size of the vector.
+  std::complex<double> expval_matrix(const std::vector<reg_t> &regs,
+                                     const std::vector<cvector_t<double>> &mats,
+                                     const std::vector<MatrixForm> &forms) const;
+
   //-----------------------------------------------------------------------
   // JSON configuration settings
   //-----------------------------------------------------------------------
@@ -362,7 +495,7 @@ public:
   void set_json_chop_threshold(double threshold);
 
   // Set the threshold for chopping values to 0 in JSON
-  double get_json_chop_threshold() {return json_chop_threshold_;}
+  double get_json_chop_threshold() const {return json_chop_threshold_;}
 
   //-----------------------------------------------------------------------
   // OpenMP configuration settings
@@ -420,6 +553,15 @@ protected:
   void check_dimension(const QubitVector &qv) const;
   void check_checkpoint() const;
 
+  //-----------------------------------------------------------------------
+  // Pauli masks
+  //-----------------------------------------------------------------------
+  // Return the bit-masks of the X and Z components of a Pauli label on the
+  // qubits and the number of Y, so that
+  // P|k> = i^num_y (-1)^popcount(k & z_mask) |k ^ x_mask>
+  void pauli_masks(const reg_t &qubits, const std::string &pauli,
+                   uint_t &x_mask, uint_t &z_mask, uint_t &num_y) const;
+
   //-----------------------------------------------------------------------
   // Statevector update with Lambda function
   //-----------------------------------------------------------------------
@@ -566,6 +708,11 @@ json_t QubitVector<data_t>::json() const {
   return js;
 }
 
+template <typename data_t>
+JSON::ComplexArray QubitVector<data_t>::json_array() const {
+  return JSON::ComplexArray(data_, data_size_, json_chop_threshold_);
+}
+
 //------------------------------------------------------------------------------
 // Error Handling
 //------------------------------------------------------------------------------
@@ -603,10 +750,10 @@ void QubitVector<data_t>::check_vector(const cvector_t<data_t> &vec, uint_t nqub
 
 template <typename data_t>
 void QubitVector<data_t>::check_dimension(const QubitVector &qv) const {
-  if (data_size_ != qv.size_) {
+  if (data_size_ != qv.data_size_) {
     std::string error = "QubitVector: vectors are different shape " +
                          std::to_string(data_size_) + " != " +
-                         std::to_string(qv.num_states_);
+                         std::to_string(qv.data_size_);
     throw std::runtime_error(error);
   }
 }
@@ -618,6 +765,43 @@ void QubitVector<data_t>::check_checkpoint() const {
   }
 }
 
+//------------------------------------------------------------------------------
+// Pauli masks
+//------------------------------------------------------------------------------
+
+template <typename data_t>
+void QubitVector<data_t>::pauli_masks(const reg_t &qubits, const std::string &pauli,
+                                      uint_t &x_mask, uint_t &z_mask, uint_t &num_y) const {
+  const size_t N = qubits.size();
+  if (pauli.size() != N) {
+    throw std::invalid_argument("QubitVector: Pauli label \"" + pauli +
+                                "\" doesn't match the number of qubits.");
+  }
+  x_mask = 0;
+  z_mask = 0;
+  num_y = 0;
+  for (size_t i = 0; i < N; i++) {
+    const uint_t bit = BITS[qubits[i]];
+    switch (pauli[N - 1 - i]) {
+      case 'I':
+        break;
+      case 'X':
+        x_mask |= bit;
+        break;
+      case 'Y':
+        x_mask |= bit;
+        z_mask |= bit;
+        num_y++;
+        break;
+      case 'Z':
+        z_mask |= bit;
+        break;
+      default:
+        throw std::invalid_argument("QubitVector: invalid Pauli label \"" + pauli + "\".");
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 // Constructors & Destructor
 //------------------------------------------------------------------------------
@@ -735,20 +919,63 @@ indexes_t QubitVector<data_t>::indexes(const reg_t& qubits,
 //------------------------------------------------------------------------------
 template <typename data_t>
 void QubitVector<data_t>::initialize_component(const reg_t &qubits, const cvector_t<double> &state0) {
+  initialize_component(qubits, state0, 0, 1.);
+}
 
+template <typename data_t>
+void QubitVector<data_t>::initialize_component(const reg_t &qubits,
+                                               const cvector_t<double> &state0,
+                                               const uint_t meas_state,
+                                               const double meas_prob) {
+
+  // Renormalize the new state by the probability of the projected component
   cvector_t<data_t> state = convert(state0);
+  const data_t renorm = 1. / std::sqrt(meas_prob);
+  for (auto &v : state)
+    v *= renorm;
 
   // Lambda function for initializing component
+  // Each component is set to psi[k] * state[i], where psi[k] is the
+  // meas_state component of the non-initialized vector
   const size_t N = qubits.size();
-  auto lambda = [&](const indexes_t &inds, const cvector_t<data_t> &_state)->void {
-    const uint_t DIM = 1ULL << N;
-    std::complex<data_t> cache = data_[inds[0]];  // the k-th component of non-initialized vector
-    for (size_t i = 0; i < DIM; i++) {
-      data_[inds[i]] = cache * _state[i];  // set component to psi[k] * state[i]
-    }    // (where psi is is the post-reset state of the non-initialized qubits)
-   };
-  // Use the lambda function
-  apply_lambda(lambda, qubits, state);
+  switch (N) {
+    case 1: {
+      auto lambda = [&](const areg_t<2> &inds, const cvector_t<data_t> &_state)->void {
+        const auto cache = data_[inds[meas_state]];
+        data_[inds[0]] = cache * _state[0];
+        data_[inds[1]] = cache * _state[1];
+      };
+      apply_lambda(lambda, areg_t<1>({{qubits[0]}}), state);
+      return;
+    }
+    case 2: {
+      auto lambda = [&](const areg_t<4> &inds, const cvector_t<data_t> &_state)->void {
+        const auto cache = data_[inds[meas_state]];
+        for (size_t i = 0; i < 4; i++)
+          data_[inds[i]] = cache * _state[i];
+      };
+      apply_lambda(lambda, areg_t<2>({{qubits[0], qubits[1]}}), state);
+      return;
+    }
+    case 3: {
+      auto lambda = [&](const areg_t<8> &inds, const cvector_t<data_t> &_state)->void {
+        const auto cache = data_[inds[meas_state]];
+        for (size_t i = 0; i < 8; i++)
+          data_[inds[i]] = cache * _state[i];
+      };
+      apply_lambda(lambda, areg_t<3>({{qubits[0], qubits[1], qubits[2]}}), state);
+      return;
+    }
+    default: {
+      const uint_t DIM = BITS[N];
+      auto lambda = [&](const indexes_t &inds, const cvector_t<data_t> &_state)->void {
+        const auto cache = data_[inds[meas_state]];
+        for (size_t i = 0; i < DIM; i++)
+          data_[inds[i]] = cache * _state[i];
+      };
+      apply_lambda(lambda, qubits, state);
+    }
+  } // end switch
 }
 
 //------------------------------------------------------------------------------
@@ -854,6 +1081,94 @@ std::complex<double> QubitVector<data_t>::inner_product() const {
   return apply_reduction_lambda(lambda);
 }
 
+//------------------------------------------------------------------------------
+// Operations with a second state
+//------------------------------------------------------------------------------
+
+template <typename data_t>
+void QubitVector<data_t>::swap(QubitVector &qv) {
+  check_dimension(qv);
+  std::swap(data_, qv.data_);
+  std::swap(checkpoint_, qv.checkpoint_);
+}
+
+template <typename data_t>
+void QubitVector<data_t>::add_pauli(const QubitVector &qv,
+                                    const reg_t &qubits,
+                                    const std::string &pauli,
+                                    const std::complex<double> coeff) {
+  check_dimension(qv);
+  uint_t x_mask, z_mask, num_y;
+  pauli_masks(qubits, pauli, x_mask, z_mask, num_y);
+  const std::complex<double> ipow[4] = {{1., 0.}, {0., 1.}, {-1., 0.}, {0., -1.}};
+  const std::complex<data_t> phase(coeff * ipow[num_y & 3]);
+  // P|k> = i^num_y (-1)^parity(k & z_mask) |k ^ x_mask>
+  auto lambda = [&](const int_t k)->void {
+    data_[k ^ x_mask] += (parity(k & z_mask) ? -phase : phase) * qv.data_[k];
+  };
+  apply_lambda(lambda);
+}
+
+template <typename data_t>
+std::complex<double> QubitVector<data_t>::inner_product(const QubitVector &bra,
+                                                        const reg_t &qubits,
+                                                        const std::string &pauli,
+                                                        const reg_t &controls) const {
+  check_dimension(bra);
+  uint_t x_mask, z_mask, num_y;
+  pauli_masks(qubits, pauli, x_mask, z_mask, num_y);
+  uint_t ctrl_mask = 0;
+  for (const auto &qubit : controls)
+    ctrl_mask |= BITS[qubit];
+  auto lambda = [&](const int_t k, double &val_re, double &val_im)->void {
+    if ((k & ctrl_mask) != ctrl_mask)
+      return;
+    const std::complex<double> z = data_[k] * std::conj(bra.data_[k ^ x_mask]);
+    if (parity(k & z_mask)) {
+      val_re -= std::real(z);
+      val_im -= std::imag(z);
+    } else {
+      val_re += std::real(z);
+      val_im += std::imag(z);
+    }
+  };
+  const std::complex<double> ipow[4] = {{1., 0.}, {0., 1.}, {-1., 0.}, {0., -1.}};
+  return ipow[num_y & 3] * apply_reduction_lambda(lambda);
+}
+
+template <typename data_t>
+cvector_t<double> QubitVector<data_t>::inner_products(const QubitVector &bra,
+                                                      const uint_t qubit,
+                                                      const reg_t &controls) const {
+  check_dimension(bra);
+  uint_t ctrl_mask = 0;
+  for (const auto &ctrl : controls)
+    ctrl_mask |= BITS[ctrl];
+  const uint_t low_mask = MASKS[qubit];
+  double re00 = 0., im00 = 0., re10 = 0., im10 = 0.;
+  double re01 = 0., im01 = 0., re11 = 0., im11 = 0.;
+  const int_t END = data_size_ >> 1;
+#pragma omp parallel for reduction(+:re00, im00, re10, im10, re01, im01, re11, im11) \
+                         if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; k++) {
+    const uint_t k0 = ((k >> qubit) << (qubit + 1)) | (k & low_mask);
+    if ((k0 & ctrl_mask) != ctrl_mask)
+      continue;
+    const uint_t k1 = k0 | BITS[qubit];
+    const std::complex<double> bra0 = std::conj(bra.data_[k0]);
+    const std::complex<double> bra1 = std::conj(bra.data_[k1]);
+    const std::complex<double> ket0 = data_[k0];
+    const std::complex<double> ket1 = data_[k1];
+    const std::complex<double> z00 = bra0 * ket0, z10 = bra1 * ket0;
+    const std::complex<double> z01 = bra0 * ket1, z11 = bra1 * ket1;
+    re00 += std::real(z00); im00 += std::imag(z00);
+    re10 += std::real(z10); im10 += std::imag(z10);
+    re01 += std::real(z01); im01 += std::imag(z01);
+    re11 += std::real(z11); im11 += std::imag(z11);
+  }
+  return cvector_t<double>({{re00, im00}, {re10, im10}, {re01, im01}, {re11, im11}});
+}
+
 //------------------------------------------------------------------------------
 // Initialization
 //------------------------------------------------------------------------------
@@ -932,6 +1247,7 @@ void QubitVector<data_t>::set_json_chop_threshold(double threshold) {
 
 template <typename data_t>
 template<typename Lambda>
+AER_TARGET_CLONES
 void QubitVector<data_t>::apply_lambda(Lambda&& func) {
   const int_t END = data_size_;
 #pragma omp parallel if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
@@ -945,6 +1261,7 @@ void QubitVector<data_t>::apply_lambda(Lambda&& func) {
 
 template <typename data_t>
 template<typename Lambda, typename list_t>
+AER_TARGET_CLONES
 void QubitVector<data_t>::apply_lambda(Lambda&& func, const list_t &qubits) {
 
   // Error checking
@@ -970,6 +1287,7 @@ void QubitVector<data_t>::apply_lambda(Lambda&& func, const list_t &qubits) {
 
 template <typename data_t>
 template<typename Lambda, typename list_t, typename param_t>
+AER_TARGET_CLONES
 void QubitVector<data_t>::apply_lambda(Lambda&& func,
                                        const list_t &qubits,
                                        const param_t &params) {
@@ -1002,6 +1320,7 @@ void QubitVector<data_t>::apply_lambda(Lambda&& func,
 
 template <typename data_t>
 template<typename Lambda>
+AER_TARGET_CLONES
 std::complex<double> QubitVector<data_t>::apply_reduction_lambda(Lambda &&func) const {
   // Reduction variables
   double val_re = 0.;
@@ -1021,6 +1340,7 @@ std::complex<double> QubitVector<data_t>::apply_reduction_lambda(Lambda &&func)
 
 template <typename data_t>
 template<typename Lambda, typename list_t>
+AER_TARGET_CLONES
 std::complex<double>
 QubitVector<data_t>::apply_reduction_lambda(Lambda&& func,
                                             const list_t &qubits) const {
@@ -1054,6 +1374,7 @@ QubitVector<data_t>::apply_reduction_lambda(Lambda&& func,
 
 template <typename data_t>
 template<typename Lambda, typename list_t, typename param_t>
+AER_TARGET_CLONES
 std::complex<double>
 QubitVector<data_t>::apply_reduction_lambda(Lambda&& func,
                                             const list_t &qubits,
@@ -1211,6 +1532,80 @@ void QubitVector<data_t>::apply_multiplexer(const reg_t &control_qubits,
   apply_lambda(lambda, qubits, convert(mat));
 }
 
+template <typename data_t>
+void QubitVector<data_t>::apply_multiplexer(const reg_t &control_qubits,
+                                            const reg_t &target_qubits,
+                                            const std::vector<cvector_t<double>> &mats) {
+
+  const size_t control_count = control_qubits.size();
+  const size_t target_count  = target_qubits.size();
+  const uint_t DIM = BITS[target_count];
+  const uint_t SIZE = DIM * DIM;
+
+  // Pack the component matrices into a single vector
+  cvector_t<double> packed;
+  packed.reserve(mats.size() * SIZE);
+  for (const auto &mat : mats)
+    packed.insert(packed.end(), mat.begin(), mat.end());
+
+  // Offset of the matrix selected by the control qubits of an index
+  auto offset = [&](const uint_t k)->uint_t {
+    uint_t b = 0;
+    for (size_t j = 0; j < control_count; j++)
+      if (k & BITS[control_qubits[j]])
+        b |= BITS[j];
+    return b * SIZE;
+  };
+
+  // The lambda functions only loop over the target qubits and
+  // select the matrix component from the control qubits of the index
+  switch (target_count) {
+    case 1: {
+      auto lambda = [&](const areg_t<2> &inds, const cvector_t<data_t> &_mat)->void {
+        const auto m = _mat.data() + offset(inds[0]);
+        const auto cache = data_[inds[0]];
+        data_[inds[0]] = m[0] * cache + m[2] * data_[inds[1]];
+        data_[inds[1]] = m[1] * cache + m[3] * data_[inds[1]];
+      };
+      apply_lambda(lambda, areg_t<1>({{target_qubits[0]}}), convert(packed));
+      return;
+    }
+    case 2: {
+      auto lambda = [&](const areg_t<4> &inds, const cvector_t<data_t> &_mat)->void {
+        const auto m = _mat.data() + offset(inds[0]);
+        std::array<std::complex<data_t>, 4> cache;
+        for (size_t i = 0; i < 4; i++) {
+          const auto ii = inds[i];
+          cache[i] = data_[ii];
+          data_[ii] = 0.;
+        }
+        // update state vector
+        for (size_t i = 0; i < 4; i++)
+          for (size_t j = 0; j < 4; j++)
+            data_[inds[i]] += m[i + 4 * j] * cache[j];
+      };
+      apply_lambda(lambda, areg_t<2>({{target_qubits[0], target_qubits[1]}}), convert(packed));
+      return;
+    }
+    default: {
+      auto lambda = [&](const indexes_t &inds, const cvector_t<data_t> &_mat)->void {
+        const auto m = _mat.data() + offset(inds[0]);
+        auto cache = std::make_unique<std::complex<data_t>[]>(DIM);
+        for (size_t i = 0; i < DIM; i++) {
+          const auto ii = inds[i];
+          cache[i] = data_[ii];
+          data_[ii] = 0.;
+        }
+        // update state vector
+        for (size_t i = 0; i < DIM; i++)
+          for (size_t j = 0; j < DIM; j++)
+            data_[inds[i]] += m[i + DIM * j] * cache[j];
+      };
+      apply_lambda(lambda, target_qubits, convert(packed));
+    }
+  } // end switch
+}
+
 template <typename data_t>
 void QubitVector<data_t>::apply_diagonal_matrix(const reg_t &qubits,
                                                 const cvector_t<double> &diag) {
@@ -1326,6 +1721,135 @@ void QubitVector<data_t>::apply_permutation_matrix(const reg_t& qubits,
   } // end switch
 }
 
+template <typename data_t>
+void QubitVector<data_t>::apply_monomial_matrix(const reg_t &qubits,
+                                                const reg_t &rows,
+                                                const cvector_t<double> &entries) {
+  const size_t N = qubits.size();
+
+  // Error checking
+  #ifdef DEBUG
+  check_vector(entries, N);
+  #endif
+
+  // Source and destination columns and phases of the amplitudes that are
+  // not fixed by the matrix
+  reg_t cols, dests;
+  std::vector<std::complex<data_t>> phases;
+  for (size_t j = 0; j < rows.size(); j++) {
+    if (rows[j] != j || entries[j] != 1.) {
+      cols.push_back(j);
+      dests.push_back(rows[j]);
+      phases.push_back(std::complex<data_t>(entries[j]));
+    }
+  }
+  const size_t M = cols.size();
+  if (M == 0)
+    return;
+  const uint_t *src = cols.data();
+  const uint_t *dst = dests.data();
+  const std::complex<data_t> *vals = phases.data();
+  std::complex<data_t> *data = data_;
+  auto permute = [=](const auto &inds, std::complex<data_t> *cache)->void {
+    for (size_t i = 0; i < M; i++)
+      cache[i] = data[inds[src[i]]];
+    for (size_t i = 0; i < M; i++)
+      data[inds[dst[i]]] = vals[i] * cache[i];
+  };
+
+  switch (N) {
+    case 1: {
+      auto lambda = [&](const areg_t<2> &inds)->void {
+        std::array<std::complex<data_t>, 2> cache;
+        permute(inds, cache.data());
+      };
+      apply_lambda(lambda, areg_t<1>({{qubits[0]}}));
+      return;
+    }
+    case 2: {
+      auto lambda = [&](const areg_t<4> &inds)->void {
+        std::array<std::complex<data_t>, 4> cache;
+        permute(inds, cache.data());
+      };
+      apply_lambda(lambda, areg_t<2>({{qubits[0], qubits[1]}}));
+      return;
+    }
+    case 3: {
+      auto lambda = [&](const areg_t<8> &inds)->void {
+        std::array<std::complex<data_t>, 8> cache;
+        permute(inds, cache.data());
+      };
+      apply_lambda(lambda, areg_t<3>({{qubits[0], qubits[1], qubits[2]}}));
+      return;
+    }
+    case 4: {
+      auto lambda = [&](const areg_t<16> &inds)->void {
+        std::array<std::complex<data_t>, 16> cache;
+        permute(inds, cache.data());
+      };
+      apply_lambda(lambda, areg_t<4>({{qubits[0], qubits[1], qubits[2], qubits[3]}}));
+      return;
+    }
+    default: {
+      auto lambda = [&](const indexes_t &inds)->void {
+        auto cache = std::make_unique<std::complex<data_t>[]>(M);
+        permute(inds, cache.get());
+      };
+      apply_lambda(lambda, qubits);
+    }
+  } // end switch
+}
+
+template <typename data_t>
+AER_TARGET_CLONES
+void QubitVector<data_t>::apply_controlled_matrix(const reg_t &control_qubits,
+                                                  const reg_t &target_qubits,
+                                                  const cvector_t<double> &mat) {
+  // A single target qubit is a multi-controlled single-qubit gate
+  if (target_qubits.size() == 1) {
+    reg_t qubits = control_qubits;
+    qubits.push_back(target_qubits[0]);
+    apply_mcu(qubits, mat);
+    return;
+  }
+
+  reg_t qubits_sorted = control_qubits;
+  qubits_sorted.insert(qubits_sorted.end(), target_qubits.begin(), target_qubits.end());
+  std::sort(qubits_sorted.begin(), qubits_sorted.end());
+  uint_t ctrl_mask = 0;
+  for (const auto &qubit : control_qubits)
+    ctrl_mask |= BITS[qubit];
+
+  // Offsets of the target basis states from the index with the target
+  // qubits in the |0> state
+  const uint_t DIM = BITS[target_qubits.size()];
+  std::vector<uint_t> offsets(DIM, 0);
+  for (size_t i = 0; i < target_qubits.size(); i++) {
+    const auto n = BITS[i];
+    for (size_t j = 0; j < n; j++)
+      offsets[n + j] = offsets[j] | BITS[target_qubits[i]];
+  }
+
+  const auto _mat = convert(mat);
+  const int_t END = data_size_ >> qubits_sorted.size();
+#pragma omp parallel if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  {
+    std::vector<std::complex<data_t>> cache(DIM);
+#pragma omp for
+    for (int_t k = 0; k < END; k++) {
+      const uint_t base = index0(qubits_sorted, k) | ctrl_mask;
+      for (size_t i = 0; i < DIM; i++)
+        cache[i] = data_[base | offsets[i]];
+      for (size_t i = 0; i < DIM; i++) {
+        std::complex<data_t> val = 0.;
+        for (size_t j = 0; j < DIM; j++)
+          val += _mat[i + DIM * j] * cache[j];
+        data_[base | offsets[i]] = val;
+      }
+    }
+  } // end omp parallel
+}
+
 
 /*******************************************************************************
  *
@@ -1465,6 +1989,87 @@ void QubitVector<data_t>::apply_mcswap(const reg_t &qubits) {
   } // end switch
 }
 
+template <typename data_t>
+void QubitVector<data_t>::apply_swaps(const reg_t &qubits) {
+  const size_t num_swaps = qubits.size() / 2;
+  size_t start = 0;
+  while (start < num_swaps) {
+    // Collect the largest block of SWAPs acting on at most 6 qubits
+    reg_t block;
+    size_t end = start;
+    for (; end < num_swaps; end++) {
+      reg_t next = block;
+      for (size_t j = 0; j < 2; j++) {
+        const uint_t qubit = qubits[2 * end + j];
+        if (std::find(next.begin(), next.end(), qubit) == next.end())
+          next.push_back(qubit);
+      }
+      if (next.size() > 6 && end > start)
+        break;
+      block = next;
+    }
+
+    // Convert the SWAPs into a sequence of index swaps of the block
+    const uint_t DIM = BITS[block.size()];
+    std::vector<std::pair<uint_t, uint_t>> pairs;
+    for (size_t i = start; i < end; i++) {
+      const uint_t bit0 = BITS[std::distance(block.begin(),
+                              std::find(block.begin(), block.end(), qubits[2 * i]))];
+      const uint_t bit1 = BITS[std::distance(block.begin(),
+                              std::find(block.begin(), block.end(), qubits[2 * i + 1]))];
+      for (uint_t k = 0; k < DIM; k++) {
+        if ((k & bit0) && !(k & bit1))
+          pairs.emplace_back(k, k ^ bit0 ^ bit1);
+      }
+    }
+    apply_permutation_matrix(block, pairs);
+    start = end;
+  }
+}
+
+template <typename data_t>
+AER_TARGET_CLONES
+void QubitVector<data_t>::apply_pauli_rotation(const reg_t &qubits,
+                                               const std::string &pauli,
+                                               const double theta,
+                                               const std::complex<double> phase) {
+  uint_t x_mask, z_mask, num_y;
+  pauli_masks(qubits, pauli, x_mask, z_mask, num_y);
+
+  // Coefficients of phase * (cos(theta/2) I - i sin(theta/2) P)
+  const std::complex<double> ipow[4] = {{1., 0.}, {0., 1.}, {-1., 0.}, {0., -1.}};
+  const std::complex<data_t> cos_t(phase * std::cos(0.5 * theta));
+  const std::complex<data_t> sin_t(phase * std::sin(0.5 * theta) * ipow[(num_y + 3) & 3]);
+
+  // Diagonal rotation: each amplitude is multiplied by exp(-/+ i theta/2)
+  if (x_mask == 0) {
+    const std::complex<data_t> phases[2] = {cos_t + sin_t, cos_t - sin_t};
+    const int_t END = data_size_;
+#pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+    for (int_t k = 0; k < END; k++) {
+      data_[k] *= phases[parity(k & z_mask)];
+    }
+    return;
+  }
+
+  // Pair amplitudes k0 and k1 = k0 ^ x_mask where the highest bit of the
+  // x_mask is zero in k0
+  uint_t pivot = 0;
+  while (x_mask >> (pivot + 1))
+    pivot++;
+  const uint_t low_mask = MASKS[pivot];
+  const int_t END = data_size_ >> 1;
+#pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; k++) {
+    const uint_t k0 = ((k >> pivot) << (pivot + 1)) | (k & low_mask);
+    const uint_t k1 = k0 ^ x_mask;
+    const std::complex<data_t> cache0 = data_[k0];
+    const std::complex<data_t> cache1 = data_[k1];
+    data_[k0] = cos_t * cache0 + (parity(k1 & z_mask) ? -sin_t : sin_t) * cache1;
+    data_[k1] = cos_t * cache1 + (parity(k0 & z_mask) ? -sin_t : sin_t) * cache0;
+  }
+}
+
 template <typename data_t>
 void QubitVector<data_t>::apply_mcphase(const reg_t &qubits, const std::complex<double> phase) {
   const size_t N = qubits.size();
@@ -1992,6 +2597,377 @@ double QubitVector<data_t>::norm_diagonal(const uint_t qubit, const cvector_t<do
 }
 
 
+/*******************************************************************************
+ *
+ * EXPECTATION VALUES
+ *
+ ******************************************************************************/
+
+template <typename data_t>
+std::complex<double> QubitVector<data_t>::expval_matrix(const reg_t &qubits,
+                                                        const cvector_t<double> &mat) const {
+
+  const uint_t N = qubits.size();
+
+  // Error checking
+  #ifdef DEBUG
+  check_vector(mat, 2 * N);
+  #endif
+
+  // Static array optimized lambda functions
+  switch (N) {
+    case 1: {
+      // Check if input matrix is diagonal, and if so use diagonal function.
+      if (mat[1] == 0.0 && mat[2] == 0.0) {
+        const cvector_t<double> diag = {{mat[0], mat[3]}};
+        return expval_diagonal_matrix(qubits, diag);
+      }
+      // Lambda function for 1-qubit matrix expectation value
+      auto lambda = [&](const areg_t<2> &inds, const cvector_t<data_t> &_mat,
+                        double &val_re, double &val_im)->void {
+        const auto v0 = data_[inds[0]];
+        const auto v1 = data_[inds[1]];
+        const auto z = std::conj(v0) * (_mat[0] * v0 + _mat[2] * v1)
+                     + std::conj(v1) * (_mat[1] * v0 + _mat[3] * v1);
+        val_re += std::real(z);
+        val_im += std::imag(z);
+      };
+      return apply_reduction_lambda(lambda, areg_t<1>({{qubits[0]}}), convert(mat));
+    }
+    case 2: {
+      // Lambda function for 2-qubit matrix expectation value
+      auto lambda = [&](const areg_t<4> &inds, const cvector_t<data_t> &_mat,
+                        double &val_re, double &val_im)->void {
+        std::array<std::complex<data_t>, 4> cache;
+        for (size_t i = 0; i < 4; i++)
+          cache[i] = data_[inds[i]];
+        for (size_t i = 0; i < 4; i++) {
+          std::complex<data_t> vi = 0;
+          for (size_t j = 0; j < 4; j++)
+            vi += _mat[i + 4 * j] * cache[j];
+          const auto z = std::conj(cache[i]) * vi;
+          val_re += std::real(z);
+          val_im += std::imag(z);
+        }
+      };
+      areg_t<2> qubits_arr = {{qubits[0], qubits[1]}};
+      return apply_reduction_lambda(lambda, qubits_arr, convert(mat));
+    }
+    case 3: {
+      // Lambda function for 3-qubit matrix expectation value
+      auto lambda = [&](const areg_t<8> &inds, const cvector_t<data_t> &_mat,
+                        double &val_re, double &val_im)->void {
+        std::array<std::complex<data_t>, 8> cache;
+        for (size_t i = 0; i < 8; i++)
+          cache[i] = data_[inds[i]];
+        for (size_t i = 0; i < 8; i++) {
+          std::complex<data_t> vi = 0;
+          for (size_t j = 0; j < 8; j++)
+            vi += _mat[i + 8 * j] * cache[j];
+          const auto z = std::conj(cache[i]) * vi;
+          val_re += std::real(z);
+          val_im += std::imag(z);
+        }
+      };
+      areg_t<3> qubits_arr = {{qubits[0], qubits[1], qubits[2]}};
+      return apply_reduction_lambda(lambda, qubits_arr, convert(mat));
+    }
+    case 4: {
+      // Lambda function for 4-qubit matrix expectation value
+      auto lambda = [&](const areg_t<16> &inds, const cvector_t<data_t> &_mat,
+                        double &val_re, double &val_im)->void {
+        std::array<std::complex<data_t>, 16> cache;
+        for (size_t i = 0; i < 16; i++)
+          cache[i] = data_[inds[i]];
+        for (size_t i = 0; i < 16; i++) {
+          std::complex<data_t> vi = 0;
+          for (size_t j = 0; j < 16; j++)
+            vi += _mat[i + 16 * j] * cache[j];
+          const auto z = std::conj(cache[i]) * vi;
+          val_re += std::real(z);
+          val_im += std::imag(z);
+        }
+      };
+      areg_t<4> qubits_arr = {{qubits[0], qubits[1], qubits[2], qubits[3]}};
+      return apply_reduction_lambda(lambda, qubits_arr, convert(mat));
+    }
+    default: {
+      // Lambda function for N-qubit matrix expectation value
+      const uint_t DIM = BITS[N];
+      auto lambda = [&](const indexes_t &inds, const cvector_t<data_t> &_mat,
+                        double &val_re, double &val_im)->void {
+        for (size_t i = 0; i < DIM; i++) {
+          std::complex<data_t> vi = 0;
+          for (size_t j = 0; j < DIM; j++)
+            vi += _mat[i + DIM * j] * data_[inds[j]];
+          const auto z = std::conj(data_[inds[i]]) * vi;
+          val_re += std::real(z);
+          val_im += std::imag(z);
+        }
+      };
+      // Use the lambda function
+      return apply_reduction_lambda(lambda, qubits, convert(mat));
+    }
+  } // end switch
+}
+
+template <typename data_t>
+std::complex<double>
+QubitVector<data_t>::expval_diagonal_matrix(const reg_t &qubits,
+                                            const cvector_t<double> &mat) const {
+
+  const uint_t N = qubits.size();
+
+  // Error checking
+  #ifdef DEBUG
+  check_vector(mat, N);
+  #endif
+
+  // Static array optimized lambda functions
+  switch (N) {
+    case 1: {
+      // Lambda function for 1-qubit diagonal expectation value
+      auto lambda = [&](const areg_t<2> &inds, const cvector_t<data_t> &_mat,
+                        double &val_re, double &val_im)->void {
+        const auto z = _mat[0] * std::norm(data_[inds[0]])
+                     + _mat[1] * std::norm(data_[inds[1]]);
+        val_re += std::real(z);
+        val_im += std::imag(z);
+      };
+      return apply_reduction_lambda(lambda, areg_t<1>({{qubits[0]}}), convert(mat));
+    }
+    case 2: {
+      // Lambda function for 2-qubit diagonal expectation value
+      auto lambda = [&](const areg_t<4> &inds, const cvector_t<data_t> &_mat,
+                        double &val_re, double &val_im)->void {
+        for (size_t i = 0; i < 4; i++) {
+          const auto z = _mat[i] * std::norm(data_[inds[i]]);
+          val_re += std::real(z);
+          val_im += std::imag(z);
+        }
+      };
+      areg_t<2> qubits_arr = {{qubits[0], qubits[1]}};
+      return apply_reduction_lambda(lambda, qubits_arr, convert(mat));
+    }
+    case 3: {
+      // Lambda function for 3-qubit diagonal expectation value
+      auto lambda = [&](const areg_t<8> &inds, const cvector_t<data_t> &_mat,
+                        double &val_re, double &val_im)->void {
+        for (size_t i = 0; i < 8; i++) {
+          const auto z = _mat[i] * std::norm(data_[inds[i]]);
+          val_re += std::real(z);
+          val_im += std::imag(z);
+        }
+      };
+      areg_t<3> qubits_arr = {{qubits[0], qubits[1], qubits[2]}};
+      return apply_reduction_lambda(lambda, qubits_arr, convert(mat));
+    }
+    default: {
+      // Lambda function for N-qubit diagonal expectation value
+      const uint_t DIM = BITS[N];
+      auto lambda = [&](const indexes_t &inds, const cvector_t<data_t> &_mat,
+                        double &val_re, double &val_im)->void {
+        for (size_t i = 0; i < DIM; i++) {
+          const auto z = _mat[i] * std::norm(data_[inds[i]]);
+          val_re += std::real(z);
+          val_im += std::imag(z);
+        }
+      };
+      // Use the lambda function
+      return apply_reduction_lambda(lambda, qubits, convert(mat));
+    }
+  } // end switch
+}
+
+template <typename data_t>
+double QubitVector<data_t>::expval_projector(const reg_t &qubits,
+                                             const cvector_t<double> &phi) const {
+
+  const uint_t N = qubits.size();
+
+  // Error checking
+  #ifdef DEBUG
+  check_vector(phi, N);
+  #endif
+
+  // <psi|phi><phi|psi> is the sum over the blocks of the remaining qubits
+  // of |<phi|psi_k>|^2 so we only need the overlap with each block.
+  switch (N) {
+    case 1: {
+      // Lambda function for 1-qubit projector expectation value
+      auto lambda = [&](const areg_t<2> &inds, const cvector_t<data_t> &_phi,
+                        double &val_re, double &val_im)->void {
+        (void)val_im; // unused
+        const auto amp = std::conj(_phi[0]) * data_[inds[0]]
+                       + std::conj(_phi[1]) * data_[inds[1]];
+        val_re += std::norm(amp);
+      };
+      return std::real(apply_reduction_lambda(lambda, areg_t<1>({{qubits[0]}}), convert(phi)));
+    }
+    case 2: {
+      // Lambda function for 2-qubit projector expectation value
+      auto lambda = [&](const areg_t<4> &inds, const cvector_t<data_t> &_phi,
+                        double &val_re, double &val_im)->void {
+        (void)val_im; // unused
+        std::complex<data_t> amp = 0;
+        for (size_t i = 0; i < 4; i++)
+          amp += std::conj(_phi[i]) * data_[inds[i]];
+        val_re += std::norm(amp);
+      };
+      areg_t<2> qubits_arr = {{qubits[0], qubits[1]}};
+      return std::real(apply_reduction_lambda(lambda, qubits_arr, convert(phi)));
+    }
+    default: {
+      // Lambda function for N-qubit projector expectation value
+      const uint_t DIM = BITS[N];
+      auto lambda = [&](const indexes_t &inds, const cvector_t<data_t> &_phi,
+                        double &val_re, double &val_im)->void {
+        (void)val_im; // unused
+        std::complex<data_t> amp = 0;
+        for (size_t i = 0; i < DIM; i++)
+          amp += std::conj(_phi[i]) * data_[inds[i]];
+        val_re += std::norm(amp);
+      };
+      // Use the lambda function
+      return std::real(apply_reduction_lambda(lambda, qubits, convert(phi)));
+    }
+  } // end switch
+}
+
+template <typename data_t>
+std::complex<double>
+QubitVector<data_t>::expval_matrix(const std::vector<reg_t> &regs,
+                                   const std::vector<cvector_t<double>> &mats,
+                                   const std::vector<MatrixForm> &forms) const {
+
+  // Single matrix case uses the optimized kernels
+  if (regs.size() == 1) {
+    switch (forms[0]) {
+      case MatrixForm::dense:
+        return expval_matrix(regs[0], mats[0]);
+      case MatrixForm::diagonal:
+        return expval_diagonal_matrix(regs[0], mats[0]);
+      case MatrixForm::projector:
+        return expval_projector(regs[0], mats[0]);
+    }
+  }
+
+  // Get the union of the qubits of all matrices, and the position of each
+  // matrix's qubits within that union.
+  reg_t qubits;
+  std::vector<reg_t> positions;
+  for (const auto &reg : regs) {
+    reg_t pos;
+    for (const auto qubit : reg) {
+      const auto it = std::find(qubits.begin(), qubits.end(), qubit);
+      pos.push_back(std::distance(qubits.begin(), it));
+      if (it == qubits.end())
+        qubits.push_back(qubit);
+    }
+    positions.push_back(pos);
+  }
+  auto qubits_sorted = qubits;
+  std::sort(qubits_sorted.begin(), qubits_sorted.end());
+
+  // Error checking
+  #ifdef DEBUG
+  for (const auto &qubit : qubits)
+    check_qubit(qubit);
+  #endif
+
+  // Each block of amplitudes for the union of qubits is loaded once and
+  // every matrix is then applied in turn to a local copy of the block.
+  // For each matrix we precompute the local block offsets of its
+  // sub-indexes, and the base local indexes of its sub-blocks.
+  const uint_t N = qubits.size();
+  const uint_t DIM = BITS[N];
+  const size_t NUM_MATS = regs.size();
+  std::vector<reg_t> offsets(NUM_MATS);
+  std::vector<reg_t> bases(NUM_MATS);
+  std::vector<cvector_t<data_t>> _mats(NUM_MATS);
+  uint_t max_subdim = 1;
+  for (size_t m = 0; m < NUM_MATS; m++) {
+    const auto &pos = positions[m];
+    const uint_t SUBDIM = BITS[pos.size()];
+    uint_t mask = 0;
+    offsets[m].assign(SUBDIM, 0);
+    for (size_t i = 0; i < pos.size(); i++) {
+      mask |= BITS[pos[i]];
+      for (size_t j = 0; j < BITS[i]; j++)
+        offsets[m][BITS[i] + j] = offsets[m][j] | BITS[pos[i]];
+    }
+    for (uint_t i = 0; i < DIM; i++) {
+      if ((i & mask) == 0)
+        bases[m].push_back(i);
+    }
+    _mats[m] = convert(mats[m]);
+    max_subdim = std::max(max_subdim, SUBDIM);
+  }
+
+  const int_t END = data_size_ >> N;
+  double val_re = 0.;
+  double val_im = 0.;
+#pragma omp parallel reduction(+:val_re, val_im) if (num_qubits_ > omp_threshold_ && omp_threads_ > 1)         \
+                                               num_threads(omp_threads_)
+  {
+    // Thread local block buffers
+    std::vector<std::complex<data_t>> cache(DIM);
+    std::vector<std::complex<data_t>> vec(DIM);
+    std::vector<std::complex<data_t>> tmp(max_subdim);
+#pragma omp for
+    for (int_t k = 0; k < END; k++) {
+      const auto inds = indexes(qubits, qubits_sorted, k);
+      for (size_t i = 0; i < DIM; i++) {
+        cache[i] = data_[inds[i]];
+        vec[i] = cache[i];
+      }
+      // Apply each matrix to the local block
+      for (size_t m = 0; m < NUM_MATS; m++) {
+        const auto &_mat = _mats[m];
+        const auto &offs = offsets[m];
+        const uint_t SUBDIM = offs.size();
+        switch (forms[m]) {
+          case MatrixForm::dense:
+            for (const auto base : bases[m]) {
+              for (size_t i = 0; i < SUBDIM; i++)
+                tmp[i] = vec[base | offs[i]];
+              for (size_t i = 0; i < SUBDIM; i++) {
+                std::complex<data_t> vi = 0;
+                for (size_t j = 0; j < SUBDIM; j++)
+                  vi += _mat[i + SUBDIM * j] * tmp[j];
+                vec[base | offs[i]] = vi;
+              }
+            }
+            break;
+          case MatrixForm::diagonal:
+            for (const auto base : bases[m]) {
+              for (size_t i = 0; i < SUBDIM; i++)
+                vec[base | offs[i]] *= _mat[i];
+            }
+            break;
+          case MatrixForm::projector:
+            for (const auto base : bases[m]) {
+              std::complex<data_t> amp = 0;
+              for (size_t i = 0; i < SUBDIM; i++)
+                amp += std::conj(_mat[i]) * vec[base | offs[i]];
+              for (size_t i = 0; i < SUBDIM; i++)
+                vec[base | offs[i]] = _mat[i] * amp;
+            }
+            break;
+        }
+      }
+      // Contract with the original block
+      for (size_t i = 0; i < DIM; i++) {
+        const auto z = std::conj(cache[i]) * vec[i];
+        val_re += std::real(z);
+        val_im += std::imag(z);
+      }
+    }
+  } // end omp parallel
+  return std::complex<double>(val_re, val_im);
+}
+
+
 /*******************************************************************************
  *
  * Probabilities
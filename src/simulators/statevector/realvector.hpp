@@ -0,0 +1,1648 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+
+
+#ifndef _qv_real_vector_hpp_
+#define _qv_real_vector_hpp_
+
+#include "simulators/statevector/qubitvector.hpp"
+
+namespace QV {
+
+template <typename T> using rvector_t = std::vector<T>;
+
+//============================================================================
+// RealVector class
+//============================================================================
+
+// Template class for a qubit vector with real amplitudes.
+// It implements the interface of the QubitVector class for circuits whose
+// gates, matrices and initial state keep every amplitude real, storing
+// 2^n data_t values instead of 2^n complex values. This halves the memory
+// and bandwidth of the vector, and matrices are applied with real
+// arithmetic.
+// Complex inputs such as matrices and phases are converted to their real
+// parts, so a RealVector must only be used for circuits that have been
+// checked to be real. Operations that can never be real, such as the Y
+// gate, raise an exception.
+
+template <typename data_t = double>
+class RealVector {
+
+public:
+
+  //-----------------------------------------------------------------------
+  // Constructors and Destructor
+  //-----------------------------------------------------------------------
+
+  RealVector();
+  explicit RealVector(size_t num_qubits);
+  virtual ~RealVector();
+  RealVector(const RealVector& obj) = delete;
+  RealVector &operator=(const RealVector& obj) = delete;
+
+  //-----------------------------------------------------------------------
+  // Data access
+  //-----------------------------------------------------------------------
+
+  // Element access
+  data_t &operator[](uint_t element);
+  data_t operator[](uint_t element) const;
+
+  // Returns a reference to the underlying data_t data class
+  data_t* &data() {return data_;}
+
+  // Returns a copy of the underlying data_t data class
+  data_t* data() const {return data_;}
+
+  //-----------------------------------------------------------------------
+  // Utility functions
+  //-----------------------------------------------------------------------
+
+  // Set the size of the vector in terms of qubit number
+  void set_num_qubits(size_t num_qubits);
+
+  // Returns the number of qubits for the current vector
+  virtual uint_t num_qubits() const {return num_qubits_;}
+
+  // Returns the size of the underlying n-qubit vector
+  uint_t size() const {return data_size_;}
+
+  // Returns required memory
+  size_t required_memory_mb(uint_t num_qubits) const;
+
+  // Returns a copy of the underlying data_t data as a real vector
+  rvector_t<data_t> vector() const;
+
+  // Return JSON serialization of RealVector as a complex vector
+  json_t json() const;
+
+  // Return a complex copy of the vector that is serialized as json() by a
+  // JSON::Writer without building the JSON document
+  JSON::ComplexArray json_array() const;
+
+  // Set all entries in the vector to 0.
+  void zero();
+
+  // Convert a complex vector to a real vector of the data type of this
+  // vector by taking the real parts
+  rvector_t<data_t> convert(const cvector_t<double>& v) const;
+
+  // Return the integer representation of a number of bits set to zero
+  // inserted into an arbitrary bit string (see QubitVector::index0)
+  template<typename list_t>
+  uint_t index0(const list_t &qubits_sorted, const uint_t k) const;
+
+  // Return the 2^N indexes of the N qubits for the M-N other qubits in
+  // state k (see QubitVector::indexes)
+  indexes_t indexes(const reg_t &qubits, const reg_t &qubits_sorted, const uint_t k) const;
+
+  // As above but returns a fixed sized array of of 2^N in ints
+  template<size_t N>
+  areg_t<1ULL << N> indexes(const areg_t<N> &qs, const areg_t<N> &qubits_sorted, const uint_t k) const;
+
+  // State initialization of a component
+  // Initialize the specified qubits to a desired statevector
+  // (leaving the other qubits in their current state)
+  // assuming the qubits being initialized have already been reset to the zero state
+  void initialize_component(const reg_t &qubits, const cvector_t<double> &state);
+
+  // As above but first projects the specified qubits onto the basis state
+  // meas_state with probability meas_prob.
+  void initialize_component(const reg_t &qubits, const cvector_t<double> &state,
+                            const uint_t meas_state, const double meas_prob);
+
+  //-----------------------------------------------------------------------
+  // Check point operations
+  //-----------------------------------------------------------------------
+
+  // Create a checkpoint of the current state
+  void checkpoint();
+
+  // Revert to the checkpoint
+  void revert(bool keep);
+
+  // Compute the inner product of current state with checkpoint state
+  std::complex<double> inner_product() const;
+
+  //-----------------------------------------------------------------------
+  // Operations with a second state
+  //-----------------------------------------------------------------------
+
+  // Swap the current and checkpoint data with another state of the same
+  // number of qubits
+  void swap(RealVector &qv);
+
+  // Add coeff * P|qv> to the current state for the N-qubit Pauli label P,
+  // where the last character of the label acts on qubits[0]
+  void add_pauli(const RealVector &qv, const reg_t &qubits,
+                 const std::string &pauli, const std::complex<double> coeff);
+
+  // Compute the inner product <bra|P|this> for the N-qubit Pauli label P
+  // on the qubits, restricted to the subspace where all control qubits are
+  // in the |1> state.
+  std::complex<double> inner_product(const RealVector &bra,
+                                     const reg_t &qubits,
+                                     const std::string &pauli,
+                                     const reg_t &controls = {}) const;
+
+  // Compute the inner products <bra|(|i><j|)|this> for the single-qubit
+  // operators |i><j| on the qubit in column-major order [00, 10, 01, 11],
+  // restricted to the subspace where all control qubits are in the |1> state.
+  cvector_t<double> inner_products(const RealVector &bra,
+                                   const uint_t qubit,
+                                   const reg_t &controls = {}) const;
+
+  //-----------------------------------------------------------------------
+  // Initialization
+  //-----------------------------------------------------------------------
+
+  // Initializes the current vector so that all qubits are in the |0> state.
+  void initialize();
+
+  // Initializes the vector to the real parts of a custom initial state.
+  // If the length of the data vector does not match the number of qubits
+  // an exception is raised.
+  void initialize_from_vector(const cvector_t<double> &data);
+
+  // Initializes the vector to a custom initial state.
+  // If num_states does not match the number of qubits an exception is raised.
+  void initialize_from_data(const data_t* data, const size_t num_states);
+
+  //-----------------------------------------------------------------------
+  // Apply Matrices
+  //-----------------------------------------------------------------------
+
+  // Apply a N-qubit matrix to the state vector.
+  // The matrix is input as vector of the column-major vectorized N-qubit matrix.
+  void apply_matrix(const reg_t &qubits, const cvector_t<double> &mat);
+
+  // Apply a stacked set of 2^control_count target_count--qubit matrix to the state vector.
+  // The matrix is input as vector of the column-major vectorized N-qubit matrix.
+  void apply_multiplexer(const reg_t &control_qubits, const reg_t &target_qubits,
+                         const cvector_t<double> &mat);
+
+  // Apply a multiplexer given as a list of 2^control_count column-major vectorized
+  // target_count-qubit matrices, where the value of the control qubits selects the matrix.
+  void apply_multiplexer(const reg_t &control_qubits, const reg_t &target_qubits,
+                         const std::vector<cvector_t<double>> &mats);
+
+  // Apply a N-qubit diagonal matrix to the state vector.
+  // The matrix is input as vector of the matrix diagonal.
+  void apply_diagonal_matrix(const reg_t &qubits, const cvector_t<double> &mat);
+
+  // Apply a N-qubit monomial matrix (a permutation matrix with signs).
+  // The matrix is input as the row and the value of the non-zero entry of
+  // each column.
+  void apply_monomial_matrix(const reg_t &qubits, const reg_t &rows,
+                             const cvector_t<double> &entries);
+
+  // Apply a matrix on the target qubits to the subspace where all control
+  // qubits are in the |1> state.
+  // The matrix is input as vector of the column-major vectorized matrix.
+  void apply_controlled_matrix(const reg_t &control_qubits,
+                               const reg_t &target_qubits,
+                               const cvector_t<double> &mat);
+
+  //-----------------------------------------------------------------------
+  // Apply Specialized Gates
+  //-----------------------------------------------------------------------
+
+  // Apply a general N-qubit multi-controlled X-gate
+  void apply_mcx(const reg_t &qubits);
+
+  // The multi-controlled Y-gate is not real and raises an exception
+  void apply_mcy(const reg_t &qubits);
+
+  // Apply a general multi-controlled single-qubit phase gate
+  // with diagonal [1, ..., 1, phase] for a real phase
+  void apply_mcphase(const reg_t &qubits, const std::complex<double> phase);
+
+  // Apply a general multi-controlled single-qubit real gate
+  void apply_mcu(const reg_t &qubits, const cvector_t<double> &mat);
+
+  // Apply a general multi-controlled SWAP gate
+  void apply_mcswap(const reg_t &qubits);
+
+  // Apply a sequence of SWAP gates on the qubit pairs
+  // (qubits[0], qubits[1]), (qubits[2], qubits[3]), ...
+  void apply_swaps(const reg_t &qubits);
+
+  // Apply the Pauli rotation phase * exp(-i theta/2 P) for the N-qubit Pauli
+  // label P, where the last character of the label acts on qubits[0].
+  // The rotation must be real, which requires an odd number of Y in the
+  // label unless the phase or the angle cancel the imaginary unit.
+  void apply_pauli_rotation(const reg_t &qubits, const std::string &pauli,
+                            const double theta,
+                            const std::complex<double> phase = 1.);
+
+  //-----------------------------------------------------------------------
+  // Z-measurement outcome probabilities
+  //-----------------------------------------------------------------------
+
+  // Return the Z-basis measurement outcome probability P(outcome) for
+  // outcome in [0, 2^num_qubits - 1]
+  virtual double probability(const uint_t outcome) const;
+
+  // Return the probabilities for all measurement outcomes in the current vector
+  virtual std::vector<double> probabilities() const;
+
+  // Return the Z-basis measurement outcome probabilities [P(0), ..., P(2^N-1)]
+  // for measurement of N-qubits.
+  virtual std::vector<double> probabilities(const reg_t &qubits) const;
+
+  // Return M sampled outcomes for Z-basis measurement of all qubits
+  // The input is a length M list of random reals between [0, 1) used for
+  // generating samples.
+  virtual reg_t sample_measure(const std::vector<double> &rnds) const;
+
+  //-----------------------------------------------------------------------
+  // Norms
+  //-----------------------------------------------------------------------
+
+  // Returns the norm of the current vector
+  double norm() const;
+
+  // Return the norm for of the vector obtained after apply the N-qubit
+  // matrix mat to the vector.
+  // The matrix is input as vector of the column-major vectorized N-qubit matrix.
+  double norm(const reg_t &qubits, const cvector_t<double> &mat) const;
+
+  //-----------------------------------------------------------------------
+  // Expectation values
+  //-----------------------------------------------------------------------
+
+  // Return the expectation value of the operator product M_K ... M_1 where
+  // each M_j acts on the qubits regs[j] and is input as a vector in the
+  // format specified by forms[j] (see the MatrixForm enum class).
+  std::complex<double> expval_matrix(const std::vector<reg_t> &regs,
+                                     const std::vector<cvector_t<double>> &mats,
+                                     const std::vector<MatrixForm> &forms) const;
+
+  //-----------------------------------------------------------------------
+  // JSON configuration settings
+  //-----------------------------------------------------------------------
+
+  // Set the threshold for chopping values to 0 in JSON
+  void set_json_chop_threshold(double threshold);
+
+  // Set the threshold for chopping values to 0 in JSON
+  double get_json_chop_threshold() const {return json_chop_threshold_;}
+
+  //-----------------------------------------------------------------------
+  // OpenMP configuration settings
+  //-----------------------------------------------------------------------
+
+  // Set the maximum number of OpenMP thread for operations.
+  void set_omp_threads(int n);
+
+  // Get the maximum number of OpenMP thread for operations.
+  uint_t get_omp_threads() {return omp_threads_;}
+
+  // Set the qubit threshold for activating OpenMP.
+  // If self.qubits() > threshold OpenMP will be activated.
+  void set_omp_threshold(int n);
+
+  // Get the qubit threshold for activating OpenMP.
+  uint_t get_omp_threshold() {return omp_threshold_;}
+
+  //-----------------------------------------------------------------------
+  // Optimization configuration settings
+  //-----------------------------------------------------------------------
+
+  // Set the sample_measure index size
+  void set_sample_measure_index_size(int n) {sample_measure_index_size_ = n;}
+
+  // Get the sample_measure index size
+  int get_sample_measure_index_size() {return sample_measure_index_size_;}
+
+protected:
+
+  //-----------------------------------------------------------------------
+  // Protected data members
+  //-----------------------------------------------------------------------
+  size_t num_qubits_;
+  size_t data_size_;
+  data_t* data_;
+  data_t* checkpoint_;
+
+  //-----------------------------------------------------------------------
+  // Config settings
+  //-----------------------------------------------------------------------
+  uint_t omp_threads_ = 1;     // Disable multithreading by default
+  uint_t omp_threshold_ = 14;  // Qubit threshold for multithreading when enabled
+  int sample_measure_index_size_ = 10; // Sample measure indexing qubit size
+  double json_chop_threshold_ = 0;  // Threshold for choping small values
+                                    // in JSON serialization
+
+  //-----------------------------------------------------------------------
+  // Error Messages
+  //-----------------------------------------------------------------------
+
+  void check_qubit(const uint_t qubit) const;
+  void check_dimension(const RealVector &qv) const;
+  void check_checkpoint() const;
+  void check_real(const cvector_t<double> &vec) const;
+
+  //-----------------------------------------------------------------------
+  // Pauli masks
+  //-----------------------------------------------------------------------
+  // Return the bit-masks of the X and Z components of a Pauli label on the
+  // qubits and the number of Y, so that
+  // P|k> = i^num_y (-1)^popcount(k & z_mask) |k ^ x_mask>
+  void pauli_masks(const reg_t &qubits, const std::string &pauli,
+                   uint_t &x_mask, uint_t &z_mask, uint_t &num_y) const;
+
+  //-----------------------------------------------------------------------
+  // State update with Lambda function
+  //-----------------------------------------------------------------------
+  // Apply a lambda function to all blocks of the vector for the given
+  // qubits. The lambda function signature should be:
+  //
+  // (Static): [&](const areg_t<1ULL<<N> &inds)->void
+  // (Dynamic): [&](const indexes_t &inds)->void
+  //
+  // where `inds` are the 2 ** N indexes for each N-qubit block returned by
+  // the `indexes` function.
+  template <typename Lambda, typename list_t>
+  void apply_lambda(Lambda&& func, const list_t &qubits);
+
+  // Apply a dense real matrix to the state vector
+  void apply_real_matrix(const reg_t &qubits, const rvector_t<data_t> &mat);
+};
+
+/*******************************************************************************
+ *
+ * Implementations
+ *
+ ******************************************************************************/
+
+//------------------------------------------------------------------------------
+// JSON Serialization
+//------------------------------------------------------------------------------
+
+template <typename data_t>
+inline void to_json(json_t &js, const RealVector<data_t> &qv) {
+  js = qv.json();
+}
+
+template <typename data_t>
+json_t RealVector<data_t>::json() const {
+  const int_t END = data_size_;
+  const json_t ZERO = std::complex<data_t>(0.0, 0.0);
+  json_t js = json_t(data_size_, ZERO);
+
+  #pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t j=0; j < END; j++) {
+    if (std::abs(data_[j]) > json_chop_threshold_)
+      js[j][0] = data_[j];
+  }
+  return js;
+}
+
+template <typename data_t>
+JSON::ComplexArray RealVector<data_t>::json_array() const {
+  cvector_t<data_t> vec(data_size_);
+  const int_t END = data_size_;
+  #pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t j=0; j < END; j++)
+    vec[j] = data_[j];
+  return JSON::ComplexArray(vec.data(), data_size_, json_chop_threshold_);
+}
+
+//------------------------------------------------------------------------------
+// Error Handling
+//------------------------------------------------------------------------------
+
+template <typename data_t>
+void RealVector<data_t>::check_qubit(const uint_t qubit) const {
+  if (qubit + 1 > num_qubits_) {
+    std::string error = "RealVector: qubit index " + std::to_string(qubit) +
+                        " > " + std::to_string(num_qubits_);
+    throw std::runtime_error(error);
+  }
+}
+
+template <typename data_t>
+void RealVector<data_t>::check_dimension(const RealVector &qv) const {
+  if (data_size_ != qv.data_size_) {
+    std::string error = "RealVector: vectors are different shape " +
+                         std::to_string(data_size_) + " != " +
+                         std::to_string(qv.data_size_);
+    throw std::runtime_error(error);
+  }
+}
+
+template <typename data_t>
+void RealVector<data_t>::check_checkpoint() const {
+  if (!checkpoint_) {
+    throw std::runtime_error("RealVector: checkpoint must exist for inner_product() or revert()");
+  }
+}
+
+template <typename data_t>
+void RealVector<data_t>::check_real(const cvector_t<double> &vec) const {
+  for (const auto &val : vec) {
+    if (std::abs(std::imag(val)) > 1e-10)
+      throw std::runtime_error("RealVector: input vector is not real");
+  }
+}
+
+//------------------------------------------------------------------------------
+// Pauli masks
+//------------------------------------------------------------------------------
+
+template <typename data_t>
+void RealVector<data_t>::pauli_masks(const reg_t &qubits, const std::string &pauli,
+                                     uint_t &x_mask, uint_t &z_mask, uint_t &num_y) const {
+  const size_t N = qubits.size();
+  if (pauli.size() != N) {
+    throw std::invalid_argument("RealVector: Pauli label \"" + pauli +
+                                "\" doesn't match the number of qubits.");
+  }
+  x_mask = 0;
+  z_mask = 0;
+  num_y = 0;
+  for (size_t i = 0; i < N; i++) {
+    const uint_t bit = BITS[qubits[i]];
+    switch (pauli[N - 1 - i]) {
+      case 'I':
+        break;
+      case 'X':
+        x_mask |= bit;
+        break;
+      case 'Y':
+        x_mask |= bit;
+        z_mask |= bit;
+        num_y++;
+        break;
+      case 'Z':
+        z_mask |= bit;
+        break;
+      default:
+        throw std::invalid_argument("RealVector: invalid Pauli label \"" + pauli + "\".");
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Constructors & Destructor
+//------------------------------------------------------------------------------
+
+template <typename data_t>
+RealVector<data_t>::RealVector(size_t num_qubits) : num_qubits_(0), data_(nullptr), checkpoint_(0){
+  set_num_qubits(num_qubits);
+}
+
+template <typename data_t>
+RealVector<data_t>::RealVector() : RealVector(0) {}
+
+template <typename data_t>
+RealVector<data_t>::~RealVector() {
+  if (data_)
+    free(data_);
+
+  if (checkpoint_)
+    free(checkpoint_);
+}
+
+//------------------------------------------------------------------------------
+// Element access operators
+//------------------------------------------------------------------------------
+
+template <typename data_t>
+data_t &RealVector<data_t>::operator[](uint_t element) {
+  // Error checking
+  #ifdef DEBUG
+  if (element > data_size_) {
+    std::string error = "RealVector: vector index " + std::to_string(element) +
+                        " > " + std::to_string(data_size_);
+    throw std::runtime_error(error);
+  }
+  #endif
+  return data_[element];
+}
+
+template <typename data_t>
+data_t RealVector<data_t>::operator[](uint_t element) const {
+  // Error checking
+  #ifdef DEBUG
+  if (element > data_size_) {
+    std::string error = "RealVector: vector index " + std::to_string(element) +
+                        " > " + std::to_string(data_size_);
+    throw std::runtime_error(error);
+  }
+  #endif
+  return data_[element];
+}
+
+template <typename data_t>
+rvector_t<data_t> RealVector<data_t>::vector() const {
+  return rvector_t<data_t>(data_, data_ + data_size_);
+}
+
+//------------------------------------------------------------------------------
+// Indexing
+//------------------------------------------------------------------------------
+
+template <typename data_t>
+template <typename list_t>
+uint_t RealVector<data_t>::index0(const list_t &qubits_sorted, const uint_t k) const {
+  uint_t lowbits, retval = k;
+  for (size_t j = 0; j < qubits_sorted.size(); j++) {
+    lowbits = retval & MASKS[qubits_sorted[j]];
+    retval >>= qubits_sorted[j];
+    retval <<= qubits_sorted[j] + 1;
+    retval |= lowbits;
+  }
+  return retval;
+}
+
+template <typename data_t>
+template <size_t N>
+areg_t<1ULL << N> RealVector<data_t>::indexes(const areg_t<N> &qs,
+                                              const areg_t<N> &qubits_sorted,
+                                              const uint_t k) const {
+  areg_t<1ULL << N> ret;
+  ret[0] = index0(qubits_sorted, k);
+  for (size_t i = 0; i < N; i++) {
+    const auto n = BITS[i];
+    const auto bit = BITS[qs[i]];
+    for (size_t j = 0; j < n; j++)
+      ret[n + j] = ret[j] | bit;
+  }
+  return ret;
+}
+
+template <typename data_t>
+indexes_t RealVector<data_t>::indexes(const reg_t& qubits,
+                                      const reg_t& qubits_sorted,
+                                      const uint_t k) const {
+  const auto N = qubits_sorted.size();
+  indexes_t ret(new uint_t[BITS[N]]);
+  ret[0] = index0(qubits_sorted, k);
+  for (size_t i = 0; i < N; i++) {
+    const auto n = BITS[i];
+    const auto bit = BITS[qubits[i]];
+    for (size_t j = 0; j < n; j++)
+      ret[n + j] = ret[j] | bit;
+  }
+  return ret;
+}
+
+//------------------------------------------------------------------------------
+// State initialize component
+//------------------------------------------------------------------------------
+
+template <typename data_t>
+void RealVector<data_t>::initialize_component(const reg_t &qubits, const cvector_t<double> &state0) {
+  initialize_component(qubits, state0, 0, 1.);
+}
+
+template <typename data_t>
+void RealVector<data_t>::initialize_component(const reg_t &qubits,
+                                              const cvector_t<double> &state0,
+                                              const uint_t meas_state,
+                                              const double meas_prob) {
+  // Renormalize the new state by the probability of the projected component
+  rvector_t<data_t> state = convert(state0);
+  const data_t renorm = 1. / std::sqrt(meas_prob);
+  for (auto &v : state)
+    v *= renorm;
+
+  // Each component is set to psi[k] * state[i], where psi[k] is the
+  // meas_state component of the non-initialized vector
+  const uint_t DIM = BITS[qubits.size()];
+  auto lambda = [&](const indexes_t &inds)->void {
+    const auto cache = data_[inds[meas_state]];
+    for (size_t i = 0; i < DIM; i++)
+      data_[inds[i]] = cache * state[i];
+  };
+  apply_lambda(lambda, qubits);
+}
+
+//------------------------------------------------------------------------------
+// Utility
+//------------------------------------------------------------------------------
+
+template <typename data_t>
+void RealVector<data_t>::zero() {
+  const int_t END = data_size_;    // end for k loop
+
+#pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; ++k) {
+    data_[k] = 0.0;
+  }
+}
+
+template <typename data_t>
+rvector_t<data_t> RealVector<data_t>::convert(const cvector_t<double>& v) const {
+  #ifdef DEBUG
+  check_real(v);
+  #endif
+  rvector_t<data_t> ret(v.size());
+  for (size_t i = 0; i < v.size(); ++i)
+    ret[i] = std::real(v[i]);
+  return ret;
+}
+
+template <typename data_t>
+void RealVector<data_t>::set_num_qubits(size_t num_qubits) {
+
+  size_t prev_num_qubits = num_qubits_;
+  num_qubits_ = num_qubits;
+  data_size_ = BITS[num_qubits];
+
+  if (checkpoint_) {
+    free(checkpoint_);
+    checkpoint_ = nullptr;
+  }
+
+  // Free any currently assigned memory
+  if (data_) {
+    if (prev_num_qubits != num_qubits_) {
+      free(data_);
+      data_ = nullptr;
+    }
+  }
+
+  // Allocate memory for new vector
+  if (data_ == nullptr)
+    data_ = reinterpret_cast<data_t*>(malloc(sizeof(data_t) * data_size_));
+}
+
+template <typename data_t>
+size_t RealVector<data_t>::required_memory_mb(uint_t num_qubits) const {
+
+  size_t unit = std::log2(sizeof(data_t));
+  size_t shift_mb = std::max<int_t>(0, num_qubits + unit - 20);
+  size_t mem_mb = 1ULL << shift_mb;
+  return mem_mb;
+}
+
+template <typename data_t>
+void RealVector<data_t>::checkpoint() {
+  if (!checkpoint_)
+    checkpoint_ = reinterpret_cast<data_t*>(malloc(sizeof(data_t) * data_size_));
+
+  const int_t END = data_size_;    // end for k loop
+  #pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; ++k)
+    checkpoint_[k] = data_[k];
+}
+
+template <typename data_t>
+void RealVector<data_t>::revert(bool keep) {
+
+  #ifdef DEBUG
+  check_checkpoint();
+  #endif
+
+  const int_t END = data_size_;    // end for k loop
+#pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; ++k)
+    data_[k] = checkpoint_[k];
+
+  if (!keep) {
+    free(checkpoint_);
+    checkpoint_ = nullptr;
+  }
+}
+
+template <typename data_t>
+std::complex<double> RealVector<data_t>::inner_product() const {
+
+  #ifdef DEBUG
+  check_checkpoint();
+  #endif
+  double val = 0.;
+  const int_t END = data_size_;
+#pragma omp parallel for reduction(+:val) if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; ++k)
+    val += data_[k] * checkpoint_[k];
+  return val;
+}
+
+//------------------------------------------------------------------------------
+// Operations with a second state
+//------------------------------------------------------------------------------
+
+template <typename data_t>
+void RealVector<data_t>::swap(RealVector &qv) {
+  check_dimension(qv);
+  std::swap(data_, qv.data_);
+  std::swap(checkpoint_, qv.checkpoint_);
+}
+
+template <typename data_t>
+void RealVector<data_t>::add_pauli(const RealVector &qv,
+                                   const reg_t &qubits,
+                                   const std::string &pauli,
+                                   const std::complex<double> coeff) {
+  check_dimension(qv);
+  uint_t x_mask, z_mask, num_y;
+  pauli_masks(qubits, pauli, x_mask, z_mask, num_y);
+  const std::complex<double> ipow[4] = {{1., 0.}, {0., 1.}, {-1., 0.}, {0., -1.}};
+  const data_t phase = std::real(coeff * ipow[num_y & 3]);
+  // P|k> = i^num_y (-1)^parity(k & z_mask) |k ^ x_mask>
+  const int_t END = data_size_;
+#pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; ++k)
+    data_[k ^ x_mask] += (parity(k & z_mask) ? -phase : phase) * qv.data_[k];
+}
+
+template <typename data_t>
+std::complex<double> RealVector<data_t>::inner_product(const RealVector &bra,
+                                                       const reg_t &qubits,
+                                                       const std::string &pauli,
+                                                       const reg_t &controls) const {
+  check_dimension(bra);
+  uint_t x_mask, z_mask, num_y;
+  pauli_masks(qubits, pauli, x_mask, z_mask, num_y);
+  uint_t ctrl_mask = 0;
+  for (const auto &qubit : controls)
+    ctrl_mask |= BITS[qubit];
+  double val = 0.;
+  const int_t END = data_size_;
+#pragma omp parallel for reduction(+:val) if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; ++k) {
+    if ((k & ctrl_mask) != ctrl_mask)
+      continue;
+    const double z = data_[k] * bra.data_[k ^ x_mask];
+    val += parity(k & z_mask) ? -z : z;
+  }
+  const std::complex<double> ipow[4] = {{1., 0.}, {0., 1.}, {-1., 0.}, {0., -1.}};
+  return ipow[num_y & 3] * val;
+}
+
+template <typename data_t>
+cvector_t<double> RealVector<data_t>::inner_products(const RealVector &bra,
+                                                     const uint_t qubit,
+                                                     const reg_t &controls) const {
+  check_dimension(bra);
+  uint_t ctrl_mask = 0;
+  for (const auto &ctrl : controls)
+    ctrl_mask |= BITS[ctrl];
+  const uint_t low_mask = MASKS[qubit];
+  double z00 = 0., z10 = 0., z01 = 0., z11 = 0.;
+  const int_t END = data_size_ >> 1;
+#pragma omp parallel for reduction(+:z00, z10, z01, z11) \
+                         if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; k++) {
+    const uint_t k0 = ((k >> qubit) << (qubit + 1)) | (k & low_mask);
+    if ((k0 & ctrl_mask) != ctrl_mask)
+      continue;
+    const uint_t k1 = k0 | BITS[qubit];
+    z00 += bra.data_[k0] * data_[k0];
+    z10 += bra.data_[k1] * data_[k0];
+    z01 += bra.data_[k0] * data_[k1];
+    z11 += bra.data_[k1] * data_[k1];
+  }
+  return cvector_t<double>({z00, z10, z01, z11});
+}
+
+//------------------------------------------------------------------------------
+// Initialization
+//------------------------------------------------------------------------------
+
+template <typename data_t>
+void RealVector<data_t>::initialize() {
+  zero();
+  data_[0] = 1.;
+}
+
+template <typename data_t>
+void RealVector<data_t>::initialize_from_vector(const cvector_t<double> &statevec) {
+  if (data_size_ != statevec.size()) {
+    std::string error = "RealVector::initialize input vector is incorrect length (" +
+                        std::to_string(data_size_) + "!=" +
+                        std::to_string(statevec.size()) + ")";
+    throw std::runtime_error(error);
+  }
+
+  const int_t END = data_size_;    // end for k loop
+
+#pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; ++k)
+    data_[k] = std::real(statevec[k]);
+}
+
+template <typename data_t>
+void RealVector<data_t>::initialize_from_data(const data_t* statevec, const size_t num_states) {
+  if (data_size_ != num_states) {
+    std::string error = "RealVector::initialize input vector is incorrect length (" +
+                        std::to_string(data_size_) + "!=" + std::to_string(num_states) + ")";
+    throw std::runtime_error(error);
+  }
+
+  const int_t END = data_size_;    // end for k loop
+
+#pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; ++k)
+    data_[k] = statevec[k];
+}
+
+
+/*******************************************************************************
+ *
+ * CONFIG SETTINGS
+ *
+ ******************************************************************************/
+
+template <typename data_t>
+void RealVector<data_t>::set_omp_threads(int n) {
+  if (n > 0)
+    omp_threads_ = n;
+}
+
+template <typename data_t>
+void RealVector<data_t>::set_omp_threshold(int n) {
+  if (n > 0)
+    omp_threshold_ = n;
+}
+
+template <typename data_t>
+void RealVector<data_t>::set_json_chop_threshold(double threshold) {
+  json_chop_threshold_ = threshold;
+}
+
+/*******************************************************************************
+ *
+ * LAMBDA FUNCTION TEMPLATES
+ *
+ ******************************************************************************/
+
+template <typename data_t>
+template<typename Lambda, typename list_t>
+AER_TARGET_CLONES
+void RealVector<data_t>::apply_lambda(Lambda&& func, const list_t &qubits) {
+
+  // Error checking
+  #ifdef DEBUG
+  for (const auto &qubit : qubits)
+    check_qubit(qubit);
+  #endif
+
+  const auto NUM_QUBITS = qubits.size();
+  const int_t END = data_size_ >> NUM_QUBITS;
+  auto qubits_sorted = qubits;
+  std::sort(qubits_sorted.begin(), qubits_sorted.end());
+#pragma omp parallel if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  {
+#pragma omp for
+    for (int_t k = 0; k < END; k++) {
+      const auto inds = indexes(qubits, qubits_sorted, k);
+      std::forward<Lambda>(func)(inds);
+    }
+  }
+}
+
+/*******************************************************************************
+ *
+ * MATRIX MULTIPLICATION
+ *
+ ******************************************************************************/
+
+template <typename data_t>
+void RealVector<data_t>::apply_matrix(const reg_t &qubits,
+                                      const cvector_t<double> &mat) {
+  apply_real_matrix(qubits, convert(mat));
+}
+
+template <typename data_t>
+void RealVector<data_t>::apply_real_matrix(const reg_t &qubits,
+                                           const rvector_t<data_t> &mat) {
+  const size_t N = qubits.size();
+  switch (N) {
+    case 1: {
+      auto lambda = [&](const areg_t<2> &inds)->void {
+        const data_t cache0 = data_[inds[0]];
+        const data_t cache1 = data_[inds[1]];
+        data_[inds[0]] = mat[0] * cache0 + mat[2] * cache1;
+        data_[inds[1]] = mat[1] * cache0 + mat[3] * cache1;
+      };
+      apply_lambda(lambda, areg_t<1>({{qubits[0]}}));
+      return;
+    }
+    case 2: {
+      auto lambda = [&](const areg_t<4> &inds)->void {
+        std::array<data_t, 4> cache;
+        for (size_t i = 0; i < 4; i++)
+          cache[i] = data_[inds[i]];
+        for (size_t i = 0; i < 4; i++) {
+          data_t val = 0.;
+          for (size_t j = 0; j < 4; j++)
+            val += mat[i + 4 * j] * cache[j];
+          data_[inds[i]] = val;
+        }
+      };
+      apply_lambda(lambda, areg_t<2>({{qubits[0], qubits[1]}}));
+      return;
+    }
+    case 3: {
+      auto lambda = [&](const areg_t<8> &inds)->void {
+        std::array<data_t, 8> cache;
+        for (size_t i = 0; i < 8; i++)
+          cache[i] = data_[inds[i]];
+        for (size_t i = 0; i < 8; i++) {
+          data_t val = 0.;
+          for (size_t j = 0; j < 8; j++)
+            val += mat[i + 8 * j] * cache[j];
+          data_[inds[i]] = val;
+        }
+      };
+      apply_lambda(lambda, areg_t<3>({{qubits[0], qubits[1], qubits[2]}}));
+      return;
+    }
+    default: {
+      const uint_t DIM = BITS[N];
+      auto lambda = [&](const indexes_t &inds)->void {
+        auto cache = std::make_unique<data_t[]>(DIM);
+        for (size_t i = 0; i < DIM; i++)
+          cache[i] = data_[inds[i]];
+        for (size_t i = 0; i < DIM; i++) {
+          data_t val = 0.;
+          for (size_t j = 0; j < DIM; j++)
+            val += mat[i + DIM * j] * cache[j];
+          data_[inds[i]] = val;
+        }
+      };
+      apply_lambda(lambda, qubits);
+    }
+  } // end switch
+}
+
+template <typename data_t>
+void RealVector<data_t>::apply_multiplexer(const reg_t &control_qubits,
+                                           const reg_t &target_qubits,
+                                           const cvector_t<double> &mat) {
+  // Split the stacked matrix into the matrices selected by the controls
+  const uint_t DIM = BITS[target_qubits.size() + control_qubits.size()];
+  const uint_t columns = BITS[target_qubits.size()];
+  const uint_t blocks = BITS[control_qubits.size()];
+  std::vector<cvector_t<double>> mats(blocks, cvector_t<double>(columns * columns));
+  for (uint_t b = 0; b < blocks; b++)
+    for (uint_t i = 0; i < columns; i++)
+      for (uint_t j = 0; j < columns; j++)
+        mats[b][i + columns * j] = mat[i + b * columns + DIM * j];
+  apply_multiplexer(control_qubits, target_qubits, mats);
+}
+
+template <typename data_t>
+void RealVector<data_t>::apply_multiplexer(const reg_t &control_qubits,
+                                           const reg_t &target_qubits,
+                                           const std::vector<cvector_t<double>> &mats) {
+  const size_t control_count = control_qubits.size();
+  const uint_t DIM = BITS[target_qubits.size()];
+  const uint_t SIZE = DIM * DIM;
+
+  // Pack the component matrices into a single vector
+  rvector_t<data_t> packed;
+  packed.reserve(mats.size() * SIZE);
+  for (const auto &mat : mats) {
+    const auto _mat = convert(mat);
+    packed.insert(packed.end(), _mat.begin(), _mat.end());
+  }
+
+  // The lambda function only loops over the target qubits and selects the
+  // matrix component from the control qubits of the index
+  auto lambda = [&](const indexes_t &inds)->void {
+    uint_t b = 0;
+    for (size_t j = 0; j < control_count; j++)
+      if (inds[0] & BITS[control_qubits[j]])
+        b |= BITS[j];
+    const auto m = packed.data() + b * SIZE;
+    auto cache = std::make_unique<data_t[]>(DIM);
+    for (size_t i = 0; i < DIM; i++)
+      cache[i] = data_[inds[i]];
+    for (size_t i = 0; i < DIM; i++) {
+      data_t val = 0.;
+      for (size_t j = 0; j < DIM; j++)
+        val += m[i + DIM * j] * cache[j];
+      data_[inds[i]] = val;
+    }
+  };
+  apply_lambda(lambda, target_qubits);
+}
+
+template <typename data_t>
+void RealVector<data_t>::apply_diagonal_matrix(const reg_t &qubits,
+                                               const cvector_t<double> &diag) {
+  const size_t N = qubits.size();
+  const auto _diag = convert(diag);
+  if (N == 1) {
+    auto lambda = [&](const areg_t<2> &inds)->void {
+      data_[inds[0]] *= _diag[0];
+      data_[inds[1]] *= _diag[1];
+    };
+    apply_lambda(lambda, areg_t<1>({{qubits[0]}}));
+    return;
+  }
+  const uint_t DIM = BITS[N];
+  auto lambda = [&](const indexes_t &inds)->void {
+    for (size_t i = 0; i < DIM; i++) {
+      if (diag[i] != 1.)
+        data_[inds[i]] *= _diag[i];
+    }
+  };
+  apply_lambda(lambda, qubits);
+}
+
+template <typename data_t>
+void RealVector<data_t>::apply_monomial_matrix(const reg_t &qubits,
+                                               const reg_t &rows,
+                                               const cvector_t<double> &entries) {
+  // Source and destination columns and signs of the amplitudes that are
+  // not fixed by the matrix
+  const auto _entries = convert(entries);
+  reg_t cols, dests;
+  rvector_t<data_t> signs;
+  for (size_t j = 0; j < rows.size(); j++) {
+    if (rows[j] != j || entries[j] != 1.) {
+      cols.push_back(j);
+      dests.push_back(rows[j]);
+      signs.push_back(_entries[j]);
+    }
+  }
+  const size_t M = cols.size();
+  if (M == 0)
+    return;
+  auto lambda = [&](const indexes_t &inds)->void {
+    auto cache = std::make_unique<data_t[]>(M);
+    for (size_t i = 0; i < M; i++)
+      cache[i] = data_[inds[cols[i]]];
+    for (size_t i = 0; i < M; i++)
+      data_[inds[dests[i]]] = signs[i] * cache[i];
+  };
+  apply_lambda(lambda, qubits);
+}
+
+template <typename data_t>
+void RealVector<data_t>::apply_controlled_matrix(const reg_t &control_qubits,
+                                                 const reg_t &target_qubits,
+                                                 const cvector_t<double> &mat) {
+  // A single target qubit is a multi-controlled single-qubit gate
+  if (target_qubits.size() == 1) {
+    reg_t qubits = control_qubits;
+    qubits.push_back(target_qubits[0]);
+    apply_mcu(qubits, mat);
+    return;
+  }
+
+  reg_t qubits_sorted = control_qubits;
+  qubits_sorted.insert(qubits_sorted.end(), target_qubits.begin(), target_qubits.end());
+  std::sort(qubits_sorted.begin(), qubits_sorted.end());
+  uint_t ctrl_mask = 0;
+  for (const auto &qubit : control_qubits)
+    ctrl_mask |= BITS[qubit];
+
+  // Offsets of the target basis states from the index with the target
+  // qubits in the |0> state
+  const uint_t DIM = BITS[target_qubits.size()];
+  std::vector<uint_t> offsets(DIM, 0);
+  for (size_t i = 0; i < target_qubits.size(); i++) {
+    const auto n = BITS[i];
+    for (size_t j = 0; j < n; j++)
+      offsets[n + j] = offsets[j] | BITS[target_qubits[i]];
+  }
+
+  const auto _mat = convert(mat);
+  const int_t END = data_size_ >> qubits_sorted.size();
+#pragma omp parallel if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  {
+    std::vector<data_t> cache(DIM);
+#pragma omp for
+    for (int_t k = 0; k < END; k++) {
+      const uint_t base = index0(qubits_sorted, k) | ctrl_mask;
+      for (size_t i = 0; i < DIM; i++)
+        cache[i] = data_[base | offsets[i]];
+      for (size_t i = 0; i < DIM; i++) {
+        data_t val = 0.;
+        for (size_t j = 0; j < DIM; j++)
+          val += _mat[i + DIM * j] * cache[j];
+        data_[base | offsets[i]] = val;
+      }
+    }
+  } // end omp parallel
+}
+
+/*******************************************************************************
+ *
+ * APPLY OPTIMIZED GATES
+ *
+ ******************************************************************************/
+
+//------------------------------------------------------------------------------
+// Multi-controlled gates
+//------------------------------------------------------------------------------
+
+template <typename data_t>
+void RealVector<data_t>::apply_mcx(const reg_t &qubits) {
+  // Calculate the permutation positions for the last qubit.
+  const size_t N = qubits.size();
+  const size_t pos0 = MASKS[N - 1];
+  const size_t pos1 = MASKS[N];
+
+  switch (N) {
+    case 1: {
+      // Lambda function for X gate
+      auto lambda = [&](const areg_t<2> &inds)->void {
+        std::swap(data_[inds[pos0]], data_[inds[pos1]]);
+      };
+      apply_lambda(lambda, areg_t<1>({{qubits[0]}}));
+      return;
+    }
+    case 2: {
+      // Lambda function for CX gate
+      auto lambda = [&](const areg_t<4> &inds)->void {
+        std::swap(data_[inds[pos0]], data_[inds[pos1]]);
+      };
+      apply_lambda(lambda, areg_t<2>({{qubits[0], qubits[1]}}));
+      return;
+    }
+    case 3: {
+      // Lambda function for Toffli gate
+      auto lambda = [&](const areg_t<8> &inds)->void {
+        std::swap(data_[inds[pos0]], data_[inds[pos1]]);
+      };
+      apply_lambda(lambda, areg_t<3>({{qubits[0], qubits[1], qubits[2]}}));
+      return;
+    }
+    default: {
+      // Lambda function for general multi-controlled X gate
+      auto lambda = [&](const indexes_t &inds)->void {
+        std::swap(data_[inds[pos0]], data_[inds[pos1]]);
+      };
+      apply_lambda(lambda, qubits);
+    }
+  } // end switch
+}
+
+template <typename data_t>
+void RealVector<data_t>::apply_mcy(const reg_t &qubits) {
+  (void)qubits; // unused
+  throw std::runtime_error("RealVector: Y gate is not real");
+}
+
+template <typename data_t>
+void RealVector<data_t>::apply_mcphase(const reg_t &qubits, const std::complex<double> phase) {
+  #ifdef DEBUG
+  check_real({phase});
+  #endif
+  const data_t _phase = std::real(phase);
+  const size_t N = qubits.size();
+  switch (N) {
+    case 1: {
+      // Lambda function for Z gate
+      auto lambda = [&](const areg_t<2> &inds)->void {
+        data_[inds[1]] *= _phase;
+      };
+      apply_lambda(lambda, areg_t<1>({{qubits[0]}}));
+      return;
+    }
+    case 2: {
+      // Lambda function for CZ gate
+      auto lambda = [&](const areg_t<4> &inds)->void {
+        data_[inds[3]] *= _phase;
+      };
+      apply_lambda(lambda, areg_t<2>({{qubits[0], qubits[1]}}));
+      return;
+    }
+    default: {
+      // Lambda function for general multi-controlled Z gate
+      auto lambda = [&](const indexes_t &inds)->void {
+         data_[inds[MASKS[N]]] *= _phase;
+      };
+      apply_lambda(lambda, qubits);
+    }
+  } // end switch
+}
+
+template <typename data_t>
+void RealVector<data_t>::apply_mcu(const reg_t &qubits,
+                                   const cvector_t<double> &mat) {
+  const auto _mat = convert(mat);
+  // Check if matrix is actually a phase gate
+  if (mat[1] == 0.0 && mat[2] == 0.0 && mat[0] == 1.0) {
+    apply_mcphase(qubits, _mat[3]);
+    return;
+  }
+
+  // Calculate the permutation positions for the last qubit.
+  const size_t N = qubits.size();
+  const size_t pos0 = MASKS[N - 1];
+  const size_t pos1 = MASKS[N];
+  switch (N) {
+    case 1: {
+      apply_real_matrix(qubits, _mat);
+      return;
+    }
+    case 2: {
+      // Lambda function for CU gate
+      auto lambda = [&](const areg_t<4> &inds)->void {
+        const auto cache = data_[inds[pos0]];
+        data_[inds[pos0]] = _mat[0] * cache + _mat[2] * data_[inds[pos1]];
+        data_[inds[pos1]] = _mat[1] * cache + _mat[3] * data_[inds[pos1]];
+      };
+      apply_lambda(lambda, areg_t<2>({{qubits[0], qubits[1]}}));
+      return;
+    }
+    default: {
+      // Lambda function for general multi-controlled U gate
+      auto lambda = [&](const indexes_t &inds)->void {
+        const auto cache = data_[inds[pos0]];
+        data_[inds[pos0]] = _mat[0] * cache + _mat[2] * data_[inds[pos1]];
+        data_[inds[pos1]] = _mat[1] * cache + _mat[3] * data_[inds[pos1]];
+      };
+      apply_lambda(lambda, qubits);
+    }
+  } // end switch
+}
+
+template <typename data_t>
+void RealVector<data_t>::apply_mcswap(const reg_t &qubits) {
+  // Calculate the swap positions for the last two qubits.
+  // If N = 2 this is just a regular SWAP gate rather than a controlled-SWAP gate.
+  const size_t N = qubits.size();
+  const size_t pos0 = MASKS[N - 1];
+  const size_t pos1 = pos0 + BITS[N - 2];
+
+  switch (N) {
+    case 2: {
+      // Lambda function for SWAP gate
+      auto lambda = [&](const areg_t<4> &inds)->void {
+        std::swap(data_[inds[pos0]], data_[inds[pos1]]);
+      };
+      apply_lambda(lambda, areg_t<2>({{qubits[0], qubits[1]}}));
+      return;
+    }
+    default: {
+      // Lambda function for general multi-controlled SWAP gate
+      auto lambda = [&](const indexes_t &inds)->void {
+        std::swap(data_[inds[pos0]], data_[inds[pos1]]);
+      };
+      apply_lambda(lambda, qubits);
+    }
+  } // end switch
+}
+
+template <typename data_t>
+void RealVector<data_t>::apply_swaps(const reg_t &qubits) {
+  for (size_t i = 0; i + 1 < qubits.size(); i += 2)
+    apply_mcswap({qubits[i], qubits[i + 1]});
+}
+
+template <typename data_t>
+AER_TARGET_CLONES
+void RealVector<data_t>::apply_pauli_rotation(const reg_t &qubits,
+                                              const std::string &pauli,
+                                              const double theta,
+                                              const std::complex<double> phase) {
+  uint_t x_mask, z_mask, num_y;
+  pauli_masks(qubits, pauli, x_mask, z_mask, num_y);
+
+  // Coefficients of phase * (cos(theta/2) I - i sin(theta/2) P)
+  const std::complex<double> ipow[4] = {{1., 0.}, {0., 1.}, {-1., 0.}, {0., -1.}};
+  const auto coeffs = convert({phase * std::cos(0.5 * theta),
+                               phase * std::sin(0.5 * theta) * ipow[(num_y + 3) & 3]});
+  const data_t cos_t = coeffs[0];
+  const data_t sin_t = coeffs[1];
+
+  // Diagonal rotation: each amplitude is multiplied by cos_t +/- sin_t
+  if (x_mask == 0) {
+    const data_t phases[2] = {cos_t + sin_t, cos_t - sin_t};
+    const int_t END = data_size_;
+#pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+    for (int_t k = 0; k < END; k++) {
+      data_[k] *= phases[parity(k & z_mask)];
+    }
+    return;
+  }
+
+  // Pair amplitudes k0 and k1 = k0 ^ x_mask where the highest bit of the
+  // x_mask is zero in k0
+  uint_t pivot = 0;
+  while (x_mask >> (pivot + 1))
+    pivot++;
+  const uint_t low_mask = MASKS[pivot];
+  const int_t END = data_size_ >> 1;
+#pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; k++) {
+    const uint_t k0 = ((k >> pivot) << (pivot + 1)) | (k & low_mask);
+    const uint_t k1 = k0 ^ x_mask;
+    const data_t cache0 = data_[k0];
+    const data_t cache1 = data_[k1];
+    data_[k0] = cos_t * cache0 + (parity(k1 & z_mask) ? -sin_t : sin_t) * cache1;
+    data_[k1] = cos_t * cache1 + (parity(k0 & z_mask) ? -sin_t : sin_t) * cache0;
+  }
+}
+
+/*******************************************************************************
+ *
+ * NORMS
+ *
+ ******************************************************************************/
+
+template <typename data_t>
+double RealVector<data_t>::norm() const {
+  double val = 0.;
+  const int_t END = data_size_;
+#pragma omp parallel for reduction(+:val) if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; ++k)
+    val += data_[k] * data_[k];
+  return val;
+}
+
+template <typename data_t>
+double RealVector<data_t>::norm(const reg_t &qubits, const cvector_t<double> &mat) const {
+  const auto _mat = convert(mat);
+  const uint_t DIM = BITS[qubits.size()];
+  auto qubits_sorted = qubits;
+  std::sort(qubits_sorted.begin(), qubits_sorted.end());
+  double val = 0.;
+  const int_t END = data_size_ >> qubits.size();
+#pragma omp parallel for reduction(+:val) if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t k = 0; k < END; k++) {
+    const auto inds = indexes(qubits, qubits_sorted, k);
+    for (size_t i = 0; i < DIM; i++) {
+      data_t vi = 0;
+      for (size_t j = 0; j < DIM; j++)
+        vi += _mat[i + DIM * j] * data_[inds[j]];
+      val += vi * vi;
+    }
+  }
+  return val;
+}
+
+/*******************************************************************************
+ *
+ * EXPECTATION VALUES
+ *
+ ******************************************************************************/
+
+template <typename data_t>
+std::complex<double> RealVector<data_t>::expval_matrix(const std::vector<reg_t> &regs,
+                                                       const std::vector<cvector_t<double>> &mats,
+                                                       const std::vector<MatrixForm> &forms) const {
+  // Get the union of the qubits of all matrices, and the position of each
+  // matrix's qubits within that union.
+  reg_t qubits;
+  std::vector<reg_t> positions;
+  for (const auto &reg : regs) {
+    reg_t pos;
+    for (const auto qubit : reg) {
+      const auto it = std::find(qubits.begin(), qubits.end(), qubit);
+      pos.push_back(std::distance(qubits.begin(), it));
+      if (it == qubits.end())
+        qubits.push_back(qubit);
+    }
+    positions.push_back(pos);
+  }
+  auto qubits_sorted = qubits;
+  std::sort(qubits_sorted.begin(), qubits_sorted.end());
+
+  // Each block of amplitudes for the union of qubits is loaded once and
+  // every matrix is then applied in turn to a local copy of the block
+  // (see QubitVector::expval_matrix).
+  const uint_t N = qubits.size();
+  const uint_t DIM = BITS[N];
+  const size_t NUM_MATS = regs.size();
+  std::vector<reg_t> offsets(NUM_MATS);
+  std::vector<reg_t> bases(NUM_MATS);
+  std::vector<rvector_t<data_t>> _mats(NUM_MATS);
+  uint_t max_subdim = 1;
+  for (size_t m = 0; m < NUM_MATS; m++) {
+    const auto &pos = positions[m];
+    const uint_t SUBDIM = BITS[pos.size()];
+    uint_t mask = 0;
+    offsets[m].assign(SUBDIM, 0);
+    for (size_t i = 0; i < pos.size(); i++) {
+      mask |= BITS[pos[i]];
+      for (size_t j = 0; j < BITS[i]; j++)
+        offsets[m][BITS[i] + j] = offsets[m][j] | BITS[pos[i]];
+    }
+    for (uint_t i = 0; i < DIM; i++) {
+      if ((i & mask) == 0)
+        bases[m].push_back(i);
+    }
+    _mats[m] = convert(mats[m]);
+    max_subdim = std::max(max_subdim, SUBDIM);
+  }
+
+  const int_t END = data_size_ >> N;
+  double val = 0.;
+#pragma omp parallel reduction(+:val) if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  {
+    // Thread local block buffers
+    std::vector<data_t> cache(DIM);
+    std::vector<data_t> vec(DIM);
+    std::vector<data_t> tmp(max_subdim);
+#pragma omp for
+    for (int_t k = 0; k < END; k++) {
+      const auto inds = indexes(qubits, qubits_sorted, k);
+      for (size_t i = 0; i < DIM; i++) {
+        cache[i] = data_[inds[i]];
+        vec[i] = cache[i];
+      }
+      // Apply each matrix to the local block
+      for (size_t m = 0; m < NUM_MATS; m++) {
+        const auto &_mat = _mats[m];
+        const auto &offs = offsets[m];
+        const uint_t SUBDIM = offs.size();
+        switch (forms[m]) {
+          case MatrixForm::dense:
+            for (const auto base : bases[m]) {
+              for (size_t i = 0; i < SUBDIM; i++)
+                tmp[i] = vec[base | offs[i]];
+              for (size_t i = 0; i < SUBDIM; i++) {
+                data_t vi = 0;
+                for (size_t j = 0; j < SUBDIM; j++)
+                  vi += _mat[i + SUBDIM * j] * tmp[j];
+                vec[base | offs[i]] = vi;
+              }
+            }
+            break;
+          case MatrixForm::diagonal:
+            for (const auto base : bases[m]) {
+              for (size_t i = 0; i < SUBDIM; i++)
+                vec[base | offs[i]] *= _mat[i];
+            }
+            break;
+          case MatrixForm::projector:
+            for (const auto base : bases[m]) {
+              data_t amp = 0;
+              for (size_t i = 0; i < SUBDIM; i++)
+                amp += _mat[i] * vec[base | offs[i]];
+              for (size_t i = 0; i < SUBDIM; i++)
+                vec[base | offs[i]] = _mat[i] * amp;
+            }
+            break;
+        }
+      }
+      // Contract with the original block
+      for (size_t i = 0; i < DIM; i++)
+        val += cache[i] * vec[i];
+    }
+  } // end omp parallel
+  return val;
+}
+
+/*******************************************************************************
+ *
+ * Probabilities
+ *
+ ******************************************************************************/
+
+template <typename data_t>
+double RealVector<data_t>::probability(const uint_t outcome) const {
+  return data_[outcome] * data_[outcome];
+}
+
+template <typename data_t>
+std::vector<double> RealVector<data_t>::probabilities() const {
+  const int_t END = 1LL << num_qubits();
+  std::vector<double> probs(END, 0.);
+#pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t j=0; j < END; j++) {
+    probs[j] = probability(j);
+  }
+  return probs;
+}
+
+template <typename data_t>
+std::vector<double> RealVector<data_t>::probabilities(const reg_t &qubits) const {
+
+  const size_t N = qubits.size();
+  const int_t DIM = BITS[N];
+  const int_t END = BITS[num_qubits() - N];
+
+  // Error checking
+  #ifdef DEBUG
+  for (const auto &qubit : qubits)
+    check_qubit(qubit);
+  #endif
+
+  auto qubits_sorted = qubits;
+  std::sort(qubits_sorted.begin(), qubits_sorted.end());
+  if ((N == num_qubits_) && (qubits == qubits_sorted))
+    return probabilities();
+
+  std::vector<double> probs(DIM, 0.);
+  #pragma omp parallel if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  {
+    std::vector<double> probs_private(DIM, 0.);
+    #pragma omp for
+      for (int_t k = 0; k < END; k++) {
+        auto idx = indexes(qubits, qubits_sorted, k);
+        for (int_t m = 0; m < DIM; ++m) {
+          probs_private[m] += probability(idx[m]);
+        }
+      }
+    #pragma omp critical
+    for (int_t m = 0; m < DIM; ++m) {
+      probs[m] += probs_private[m];
+    }
+  }
+
+  return probs;
+}
+
+//------------------------------------------------------------------------------
+// Sample measure outcomes
+//------------------------------------------------------------------------------
+template <typename data_t>
+reg_t RealVector<data_t>::sample_measure(const std::vector<double> &rnds) const {
+
+  const int_t END = 1LL << num_qubits();
+  const int_t SHOTS = rnds.size();
+  reg_t samples;
+  samples.assign(SHOTS, 0);
+
+  const int INDEX_SIZE = sample_measure_index_size_;
+  const int_t INDEX_END = BITS[INDEX_SIZE];
+  // Qubit number is below index size, loop over shots
+  if (END < INDEX_END) {
+    #pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+    for (int_t i = 0; i < SHOTS; ++i) {
+      double rnd = rnds[i];
+      double p = .0;
+      int_t sample;
+      for (sample = 0; sample < END - 1; ++sample) {
+        p += probability(sample);
+        if (rnd < p)
+          break;
+      }
+      samples[i] = sample;
+    }
+    return samples;
+  }
+
+  // Qubit number is above index size, loop over index blocks
+  std::vector<double> idxs(INDEX_END, 0.0);
+  uint_t loop = (END >> INDEX_SIZE);
+  #pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t i = 0; i < INDEX_END; ++i) {
+    uint_t base = loop * i;
+    double total = .0;
+    for (uint_t j = 0; j < loop; ++j)
+      total += probability(base | j);
+    idxs[i] = total;
+  }
+
+  #pragma omp parallel for if (num_qubits_ > omp_threshold_ && omp_threads_ > 1) num_threads(omp_threads_)
+  for (int_t i = 0; i < SHOTS; ++i) {
+    double rnd = rnds[i];
+    double p = .0;
+    int_t sample = 0;
+    for (uint_t j = 0; j < idxs.size(); ++j) {
+      if (rnd < (p + idxs[j])) {
+        break;
+      }
+      p += idxs[j];
+      sample += loop;
+    }
+
+    for (; sample < END - 1; ++sample) {
+      p += probability(sample);
+      if (rnd < p){
+        break;
+      }
+    }
+    samples[i] = sample;
+  }
+  return samples;
+}
+
+//------------------------------------------------------------------------------
+} // end namespace QV
+//------------------------------------------------------------------------------
+
+// ostream overload for templated realvector
+template <typename data_t>
+inline std::ostream &operator<<(std::ostream &out, const QV::RealVector<data_t>&qv) {
+
+  out << "[";
+  size_t last = qv.size() - 1;
+  for (size_t i = 0; i < qv.size(); ++i) {
+    out << qv[i];
+    if (i != last)
+      out << ", ";
+  }
+  out << "]";
+  return out;
+}
+
+//------------------------------------------------------------------------------
+#endif // end module
@@ -164,7 +164,7 @@ OutputData StatevectorController::run_circuit(const Circuit &circ,
 
   // Set config
   state.set_config(config);
-  state.set_parallalization(parallel_state_update_);
+  state.set_parallalization(state_update_threads());
   
   // Rng engine
   RngEngine rng;
@@ -184,7 +184,7 @@ OutputData StatevectorController::run_circuit(const Circuit &circ,
   state.add_creg_to_data(data);
   
   // Add final state to the data
-  data.add_additional_data("statevector", state.qreg());
+  data.add_additional_data("statevector", state.qreg().json_array());
 
   return data;
 }
@@ -32,7 +32,8 @@ namespace Statevector {
 enum class Gates {
   id, h, s, sdg, t, tdg, // single qubit
   // multi-qubit controlled (including single-qubit non-controlled)
-  mcx, mcy, mcz, mcu1, mcu2, mcu3, mcswap
+  mcx, mcy, mcz, mcu1, mcu2, mcu3, mcswap,
+  relabel // sequence of SWAPs inserted by qubit relabelling
 };
 
 // Allowed snapshots enum class
@@ -40,7 +41,8 @@ enum class Snapshots {
   statevector, cmemory, cregister,
   probs, probs_var,
   expval_pauli, expval_pauli_var, expval_pauli_shot,
-  expval_matrix, expval_matrix_var, expval_matrix_shot
+  expval_matrix, expval_matrix_var, expval_matrix_shot,
+  expval_pauli_grad
 };
 
 // Enum class for different types of expectation values
@@ -78,7 +80,8 @@ public:
       Operations::OpType::roerror,
       Operations::OpType::matrix,
       Operations::OpType::multiplexer,
-      Operations::OpType::kraus
+      Operations::OpType::kraus,
+      Operations::OpType::pauli_rotation
     });
   }
 
@@ -89,6 +92,11 @@ public:
             "mcx", "mcz", "mcy", "mcz", "mcu1", "mcu2", "mcu3", "mcswap"};
   }
 
+  // Return the set of gate names inserted by circuit optimizations
+  virtual stringset_t internal_gates() const override {
+    return {"relabel"};
+  }
+
   // Return the set of qobj snapshot types supported by the State
   virtual stringset_t allowed_snapshots() const override {
     return {"statevector", "memory", "register",
@@ -98,7 +106,8 @@ public:
             "expectation_value_matrix_single_shot",
             "expectation_value_matrix",
             "expectation_value_matrix_with_variance",
-            "expectation_value_pauli_single_shot"
+            "expectation_value_pauli_single_shot",
+            "expectation_value_pauli_gradient"
             };
   }
 
@@ -132,6 +141,23 @@ public:
                                             uint_t shots,
                                             RngEngine &rng) override;
 
+  // Return the outcome probabilities of a measure, or of a reset or
+  // initialize on qubits that are not known to be in the |0> state.
+  // The vector is empty for other operations and failed conditionals.
+  virtual rvector_t branch_probabilities(const Operations::Op &op) override;
+
+  // Apply a measure, reset or initialize with a fixed measurement outcome
+  virtual void apply_branch(const Operations::Op &op,
+                            uint_t outcome,
+                            double prob) override;
+
+  // Save and restore copies of the statevector and classical register
+  virtual void push_branch() override;
+  virtual void pop_branch() override;
+
+  // Enable recording the unitary operations of a shot for gradient snapshots
+  virtual void set_gradient_tape(bool enable) override {record_tape_ = enable;}
+
   //-----------------------------------------------------------------------
   // Additional methods
   //-----------------------------------------------------------------------
@@ -164,14 +190,23 @@ protected:
   // Reset the specified qubits to the |0> state by simulating
   // a measurement, applying a conditional x-gate if the outcome is 1, and
   // then discarding the outcome.
+  // If the qubits are known to be in the |0> state this does nothing.
   void apply_reset(const reg_t &qubits, RngEngine &rng);
 
   // Initialize the specified qubits to a given state |psi>
   // by applying a reset to the these qubits and then
   // computing the tensor product with the new state |psi>
   // /psi> is given in params
+  // If the qubits are known to be in the |0> state the reset is skipped,
+  // otherwise it is applied in the same pass as the initialization.
   void apply_initialize(const reg_t &qubits, const cvector_t &params, RngEngine &rng);
 
+  // Return true if all qubits are known to be in the |0> state
+  bool is_clean(const reg_t &qubits) const;
+
+  // Mark qubits as known (or not known) to be in the |0> state
+  void set_clean(const reg_t &qubits, bool clean);
+
   // Apply a supported snapshot instruction
   // If the input is not in allowed_snapshots an exeption will be raised.
   virtual void apply_snapshot(const Operations::Op &op, OutputData &data);
@@ -183,6 +218,7 @@ protected:
   void apply_matrix(const reg_t &qubits, const cvector_t & vmat); 
 
   // Apply a vector of control matrices to given qubits (identity on all other qubits)
+  // The matrix is selected by the value of the control qubits without stacking
   void apply_multiplexer(const reg_t &control_qubits, const reg_t &target_qubits, const std::vector<cmatrix_t> &mmat);
 
   // Apply stacked (flat) version of multiplexer matrix to target qubits (using control qubits to select matrix instance)
@@ -245,6 +281,18 @@ protected:
                               OutputData &data,
                               SnapshotDataType type);
 
+  // Snapshot the gradient of the expectation value of a Pauli operator
+  // with respect to the parameters of the u1, u2, u3, cu1, mcu1, mcu2,
+  // mcu3 and pauli_rotation instructions applied before the snapshot,
+  // in circuit order. The gradient is computed by a backward sweep over
+  // the recorded operations applying their inverses to the state and to
+  // a co-state initialized to the Pauli operator applied to the state.
+  void snapshot_pauli_gradient(const Operations::Op &op,
+                               OutputData &data);
+
+  // Apply the inverse of a recorded unitary operation
+  void apply_adjoint(const Operations::Op &op);
+
   //-----------------------------------------------------------------------
   // Single-qubit gate helpers
   //-----------------------------------------------------------------------
@@ -277,6 +325,36 @@ protected:
   // Threshold for chopping small values to zero in JSON
   double json_chop_threshold_ = 1e-10;
 
+  // Maximum number of qubits of a matrix expectation value component that
+  // is evaluated in a single read-only pass over blocks of its qubits.
+  // Larger components apply their matrices to a checkpointed copy.
+  uint_t expval_matrix_block_qubits_ = 6;
+
+  // Qubits that are known to be in the |0> state
+  // These are all qubits after initializing to the all |0> state and
+  // reset qubits, until another operation is applied to them
+  std::vector<bool> clean_qubits_;
+
+  // Unitary operations applied since the state was initialized, for
+  // gradient snapshots. These point into the operation lists passed to
+  // apply_ops, which are kept until the end of the shot.
+  std::vector<const Operations::Op*> tape_;
+
+  // Record the tape. Disabled by the controller for circuits without
+  // gradient snapshots.
+  bool record_tape_ = true;
+
+  // False once a non-unitary operation has been applied
+  bool tape_valid_ = true;
+
+  // Copies of the state saved by push_branch
+  struct Branch {
+    decltype(std::declval<const statevec_t&>().vector()) qreg;
+    ClassicalRegister creg;
+    std::vector<bool> clean_qubits;
+  };
+  std::vector<Branch> branches_;
+
   // Table of allowed gate names to gate enum class members
   const static stringmap_t<Gates> gateset_;
 
@@ -320,7 +398,9 @@ const stringmap_t<Gates> State<statevec_t>::gateset_({
   {"mcz", Gates::mcz},   // Multi-controlled-Z gate
   {"mcu1", Gates::mcu1}, // Multi-controlled-u1
   {"mcu2", Gates::mcu2}, // Multi-controlled-u2
-  {"mcu3", Gates::mcu3}  // Multi-controlled-u3
+  {"mcu3", Gates::mcu3}, // Multi-controlled-u3
+  // Qubit relabelling
+  {"relabel", Gates::relabel} // Sequence of SWAP gates
 
 });
 
@@ -336,6 +416,7 @@ const stringmap_t<Snapshots> State<statevec_t>::snapshotset_({
   {"expectation_value_matrix_with_variance", Snapshots::expval_matrix_var},
   {"expectation_value_pauli_single_shot", Snapshots::expval_pauli_shot},
   {"expectation_value_matrix_single_shot", Snapshots::expval_matrix_shot},
+  {"expectation_value_pauli_gradient", Snapshots::expval_pauli_grad},
   {"memory", Snapshots::cmemory},
   {"register", Snapshots::cregister}
 });
@@ -354,6 +435,9 @@ void State<statevec_t>::initialize_qreg(uint_t num_qubits) {
   initialize_omp();
   BaseState::qreg_.set_num_qubits(num_qubits);
   BaseState::qreg_.initialize();
+  clean_qubits_.assign(num_qubits, true);
+  tape_.clear();
+  tape_valid_ = true;
 }
 
 template <class statevec_t>
@@ -366,6 +450,9 @@ void State<statevec_t>::initialize_qreg(uint_t num_qubits,
   initialize_omp();
   BaseState::qreg_.set_num_qubits(num_qubits);
   BaseState::qreg_.initialize_from_data(state.data(), 1ULL << num_qubits);
+  clean_qubits_.assign(num_qubits, false);
+  tape_.clear();
+  tape_valid_ = true;
 }
 
 template <class statevec_t>
@@ -377,6 +464,9 @@ void State<statevec_t>::initialize_qreg(uint_t num_qubits,
   initialize_omp();
   BaseState::qreg_.set_num_qubits(num_qubits);
   BaseState::qreg_.initialize_from_vector(state);
+  clean_qubits_.assign(num_qubits, false);
+  tape_.clear();
+  tape_valid_ = true;
 }
 
 template <class statevec_t>
@@ -435,12 +525,16 @@ void State<statevec_t>::apply_ops(const std::vector<Operations::Op> &ops,
           break;
         case Operations::OpType::reset:
           apply_reset(op.qubits, rng);
+          tape_valid_ = false;
           break;
         case Operations::OpType::initialize:
           apply_initialize(op.qubits, op.params, rng);
+          tape_valid_ = false;
           break;
         case Operations::OpType::measure:
           apply_measure(op.qubits, op.memory, op.registers, rng);
+          set_clean(op.qubits, false);
+          tape_valid_ = false;
           break;
         case Operations::OpType::bfunc:
           BaseState::creg_.apply_bfunc(op);
@@ -450,18 +544,37 @@ void State<statevec_t>::apply_ops(const std::vector<Operations::Op> &ops,
           break;
         case Operations::OpType::gate:
           apply_gate(op);
+          set_clean(op.qubits, false);
+          if (record_tape_)
+            tape_.push_back(&op);
           break;
         case Operations::OpType::snapshot:
           apply_snapshot(op, data);
           break;
         case Operations::OpType::matrix:
           apply_matrix(op);
+          set_clean(op.qubits, false);
+          if (record_tape_)
+            tape_.push_back(&op);
           break;
         case Operations::OpType::multiplexer:
           apply_multiplexer(op.regs[0], op.regs[1], op.mats); // control qubits ([0]) & target qubits([1])
+          set_clean(op.qubits, false);
+          if (record_tape_)
+            tape_.push_back(&op);
           break;
         case Operations::OpType::kraus:
           apply_kraus(op.qubits, op.mats, rng);
+          set_clean(op.qubits, false);
+          tape_valid_ = false;
+          break;
+        case Operations::OpType::pauli_rotation:
+          BaseState::qreg_.apply_pauli_rotation(op.qubits, op.string_params[0],
+                                                std::real(op.params[0]),
+                                                (op.params.size() > 1) ? op.params[1] : 1.);
+          set_clean(op.qubits, false);
+          if (record_tape_)
+            tape_.push_back(&op);
           break;
         default:
           throw std::invalid_argument("QubitVector::State::invalid instruction \'" +
@@ -487,7 +600,8 @@ void State<statevec_t>::apply_snapshot(const Operations::Op &op,
                                 op.name + "\'.");
   switch (it -> second) {
     case Snapshots::statevector:
-      BaseState::snapshot_state(op, data, "statevector");
+      data.add_singleshot_snapshot("statevector", op.string_params[0],
+                                   BaseState::qreg_.json_array());
       break;
     case Snapshots::cmemory:
       BaseState::snapshot_creg_memory(op, data);
@@ -521,6 +635,9 @@ void State<statevec_t>::apply_snapshot(const Operations::Op &op,
     case Snapshots::expval_matrix_shot: {
       snapshot_matrix_expval(op, data, SnapshotDataType::single_shot);
     }  break;
+    case Snapshots::expval_pauli_grad: {
+      snapshot_pauli_gradient(op, data);
+    }  break;
     default:
       // We shouldn't get here unless there is a bug in the snapshotset
       throw std::invalid_argument("QubitVector::State::invalid snapshot instruction \'" +
@@ -621,35 +738,64 @@ void State<statevec_t>::snapshot_matrix_expval(const Operations::Op &op,
     throw std::invalid_argument("Invalid matrix snapshot (components are empty).");
   }
 
-  // Cache the current quantum state
-  BaseState::qreg_.checkpoint();
-  bool first = true; // flag for first pass so we don't unnecessarily revert from checkpoint
-
   // Compute expval components
+  // Components on a few qubits are evaluated directly from the current
+  // state so we don't need to checkpoint and revert the state. The
+  // others are deferred to the checkpointed passes below.
   complex_t expval(0., 0.);
+  std::vector<const Operations::Op::matrix_component_t*> deferred;
   for (const auto &param : op.params_expval_matrix) {
-    complex_t coeff = param.first;
-    // Revert the quantum state to cached checkpoint
-    if (first)
-      first = false;
-    else
-      BaseState::qreg_.revert(true);
-
-    // Apply each matrix component
+    std::set<uint_t> qubits;
+    for (const auto &pair: param.second)
+      qubits.insert(pair.first.begin(), pair.first.end());
+    if (qubits.size() > expval_matrix_block_qubits_) {
+      deferred.push_back(&param);
+      continue;
+    }
+    const complex_t coeff = param.first;
+    std::vector<reg_t> regs;
+    std::vector<cvector_t> vmats;
+    std::vector<QV::MatrixForm> forms;
     for (const auto &pair: param.second) {
-      const reg_t &qubits = pair.first;
       const cmatrix_t &mat = pair.second;
-      cvector_t vmat = (mat.GetColumns() == 1)
-        ? Utils::vectorize_matrix(Utils::projector(Utils::vectorize_matrix(mat))) // projector case
-        : Utils::vectorize_matrix(mat); // diagonal or square matrix case
-      if (vmat.size() == 1ULL << qubits.size()) {
-        BaseState::qreg_.apply_diagonal_matrix(qubits, vmat);
-      } else {
-        BaseState::qreg_.apply_matrix(qubits, vmat);
-      }
+      regs.push_back(pair.first);
+      vmats.push_back(Utils::vectorize_matrix(mat));
+      if (mat.GetColumns() == 1)
+        forms.push_back(QV::MatrixForm::projector); // projector case
+      else if (mat.GetRows() == 1)
+        forms.push_back(QV::MatrixForm::diagonal); // diagonal matrix case
+      else
+        forms.push_back(QV::MatrixForm::dense); // square matrix case
+    }
+    expval += coeff * BaseState::qreg_.expval_matrix(regs, vmats, forms);
+  }
 
+  // Components on many qubits apply each matrix to the state, which is
+  // reverted to a cached checkpoint between components
+  if (!deferred.empty()) {
+    BaseState::qreg_.checkpoint();
+    bool first = true; // flag for first pass so we don't unnecessarily revert from checkpoint
+    for (const auto param : deferred) {
+      if (first)
+        first = false;
+      else
+        BaseState::qreg_.revert(true);
+      for (const auto &pair: param->second) {
+        const reg_t &qubits = pair.first;
+        const cmatrix_t &mat = pair.second;
+        cvector_t vmat = (mat.GetColumns() == 1)
+          ? Utils::vectorize_matrix(Utils::projector(Utils::vectorize_matrix(mat))) // projector case
+          : Utils::vectorize_matrix(mat); // diagonal or square matrix case
+        if (vmat.size() == 1ULL << qubits.size()) {
+          BaseState::qreg_.apply_diagonal_matrix(qubits, vmat);
+        } else {
+          BaseState::qreg_.apply_matrix(qubits, vmat);
+        }
+      }
+      expval += param->first * BaseState::qreg_.inner_product();
     }
-    expval += coeff*BaseState::qreg_.inner_product();
+    // Revert to original state
+    BaseState::qreg_.revert(false);
   }
   // add to snapshot
   Utils::chop_inplace(expval, json_chop_threshold_);
@@ -666,11 +812,102 @@ void State<statevec_t>::snapshot_matrix_expval(const Operations::Op &op,
       data.add_singleshot_snapshot("expectation_values", op.string_params[0], expval);
       break;
   }
-  // Revert to original state
-  BaseState::qreg_.revert(false);
 }
 
 
+template <class statevec_t>
+void State<statevec_t>::snapshot_pauli_gradient(const Operations::Op &op,
+                                                OutputData &data) {
+  // Check empty edge case
+  if (op.params_expval_pauli.empty()) {
+    throw std::invalid_argument("Invalid expval gradient snapshot (Pauli components are empty).");
+  }
+  if (!record_tape_) {
+    throw std::invalid_argument("Invalid expval gradient snapshot (operations are not recorded).");
+  }
+  if (!tape_valid_) {
+    throw std::invalid_argument("Invalid expval gradient snapshot (measure, reset, "
+                                "initialize or non-unitary noise before the snapshot).");
+  }
+  auto &qreg = BaseState::qreg_;
+
+  // Co-state H|psi> for the Hermitian part of the Pauli operator H
+  statevec_t costate(qreg.num_qubits());
+  costate.set_omp_threshold(qreg.get_omp_threshold());
+  costate.set_omp_threads(qreg.get_omp_threads());
+  costate.zero();
+  for (const auto &param : op.params_expval_pauli)
+    costate.add_pauli(qreg, op.qubits, param.second, std::real(param.first));
+
+  // Cache the current quantum state
+  qreg.checkpoint();
+
+  // Apply an update of the state to both the state and the co-state
+  auto apply_both = [&](auto &&func) {
+    func();
+    qreg.swap(costate);
+    func();
+    qreg.swap(costate);
+  };
+
+  // Sweep backwards over the operations. With |psi> the state and |lambda>
+  // the co-state after an operation U whose derivative is dU = A U, the
+  // derivative of the expectation value is 2 Re <lambda|A|psi>.
+  // For phase parameters A = i Proj(|1..1>) and for rotations A = -i/2 P.
+  // The gradients are collected in reverse order.
+  std::vector<double> grads;
+  for (auto it = tape_.rbegin(); it != tape_.rend(); ++it) {
+    const Operations::Op &gate = **it;
+    const auto gate_it = (gate.type == Operations::OpType::gate)
+                         ? gateset_.find(gate.name) : gateset_.end();
+    if (gate.type == Operations::OpType::pauli_rotation) {
+      grads.push_back(std::imag(qreg.inner_product(costate, gate.qubits,
+                                                   gate.string_params[0])));
+    } else if (gate_it != gateset_.end() && gate_it->second == Gates::mcu1) {
+      grads.push_back(-2. * std::imag(qreg.inner_product(costate, {}, "", gate.qubits)));
+    } else if (gate_it != gateset_.end() && (gate_it->second == Gates::mcu2 ||
+                                             gate_it->second == Gates::mcu3)) {
+      // u3(theta, phi, lambda) = u1(phi) ry(theta) u1(lambda) on the target
+      // qubit, controlled by the other qubits. The derivatives are A U with
+      // A = i |1><1| for phi, A = -i/2 u1(phi) Y u1(-phi) for theta and
+      // A = i U|1><1|U^dagger for lambda, which are all evaluated from the
+      // inner products of the co-state and state on the target qubit.
+      const bool u3 = (gate_it->second == Gates::mcu3);
+      const double theta = u3 ? std::real(gate.params[0]) : M_PI / 2.;
+      const double phi = std::real(gate.params[u3 ? 1 : 0]);
+      const double cos_t = std::cos(0.5 * theta);
+      const double sin_t = std::sin(0.5 * theta);
+      const complex_t eiphi = std::exp(complex_t(0., phi));
+      const reg_t controls(gate.qubits.begin(), gate.qubits.end() - 1);
+      const auto prods = qreg.inner_products(costate, gate.qubits.back(), controls);
+      // 2 Re sum_ij A_ij <lambda|(|i><j|)|psi> for column-major A
+      auto grad = [&prods](const cvector_t &mat) {
+        complex_t val = 0.;
+        for (size_t j = 0; j < 4; ++j)
+          val += mat[j] * prods[j];
+        return 2. * std::real(val);
+      };
+      const complex_t i1(0., 1.);
+      grads.push_back(grad({i1 * sin_t * sin_t, -i1 * sin_t * cos_t * eiphi,
+                            -i1 * sin_t * cos_t * std::conj(eiphi), i1 * cos_t * cos_t}));
+      grads.push_back(grad({0., 0., 0., i1}));
+      if (u3)
+        grads.push_back(grad({0., 0.5 * eiphi, -0.5 * std::conj(eiphi), 0.}));
+      apply_both([&]() {apply_adjoint(gate);});
+      continue;
+    }
+    apply_both([&]() {apply_adjoint(gate);});
+  }
+  std::reverse(grads.begin(), grads.end());
+
+  // Revert to original state
+  qreg.revert(false);
+
+  Utils::chop_inplace(grads, json_chop_threshold_);
+  data.add_average_snapshot("expectation_value_gradient", op.string_params[0],
+                            BaseState::creg_.memory_hex(), grads, false);
+}
+
 //=========================================================================
 // Implementation: Matrix multiplication
 //=========================================================================
@@ -718,6 +955,10 @@ void State<statevec_t>::apply_gate(const Operations::Op &op) {
       // Includes SWAP, CSWAP, etc
       BaseState::qreg_.apply_mcswap(op.qubits);
       break;
+    case Gates::relabel:
+      // SWAPs on consecutive pairs of qubits
+      BaseState::qreg_.apply_swaps(op.qubits);
+      break;
     case Gates::mcu3:
       // Includes u3, cu3, etc
       apply_gate_mcu3(op.qubits,
@@ -744,6 +985,88 @@ void State<statevec_t>::apply_gate(const Operations::Op &op) {
 }
 
 
+template <class statevec_t>
+void State<statevec_t>::apply_adjoint(const Operations::Op &op) {
+  switch (op.type) {
+    case Operations::OpType::gate: {
+      auto it = gateset_.find(op.name);
+      if (it == gateset_.end())
+        throw std::invalid_argument("QubitVectorState::invalid gate instruction \'" +
+                                    op.name + "\'.");
+      switch (it -> second) {
+        case Gates::s:
+          apply_gate_phase(op.qubits[0], complex_t(0., -1.));
+          break;
+        case Gates::sdg:
+          apply_gate_phase(op.qubits[0], complex_t(0., 1.));
+          break;
+        case Gates::t: {
+          const double isqrt2{1. / std::sqrt(2)};
+          apply_gate_phase(op.qubits[0], complex_t(isqrt2, -isqrt2));
+        } break;
+        case Gates::tdg: {
+          const double isqrt2{1. / std::sqrt(2)};
+          apply_gate_phase(op.qubits[0], complex_t(isqrt2, isqrt2));
+        } break;
+        case Gates::relabel: {
+          // Undo the SWAPs in reverse order
+          reg_t qubits;
+          qubits.reserve(op.qubits.size());
+          for (size_t j = op.qubits.size(); j >= 2; j -= 2) {
+            qubits.push_back(op.qubits[j - 2]);
+            qubits.push_back(op.qubits[j - 1]);
+          }
+          BaseState::qreg_.apply_swaps(qubits);
+        } break;
+        case Gates::mcu3:
+          apply_gate_mcu3(op.qubits,
+                          -std::real(op.params[0]),
+                          -std::real(op.params[2]),
+                          -std::real(op.params[1]));
+          break;
+        case Gates::mcu2:
+          apply_gate_mcu3(op.qubits,
+                          -M_PI / 2.,
+                          -std::real(op.params[1]),
+                          -std::real(op.params[0]));
+          break;
+        case Gates::mcu1:
+          BaseState::qreg_.apply_mcphase(op.qubits, std::exp(complex_t(0, -1) * op.params[0]));
+          break;
+        default:
+          // The other gates are self-inverse
+          apply_gate(op);
+      }
+    } break;
+    case Operations::OpType::matrix:
+      if (op.qubits.empty() == false && op.mats[0].size() > 0) {
+        if (Utils::is_diagonal(op.mats[0], .0)) {
+          BaseState::qreg_.apply_diagonal_matrix(op.qubits,
+            Utils::conjugate(Utils::matrix_diagonal(op.mats[0])));
+        } else {
+          BaseState::qreg_.apply_matrix(op.qubits,
+            Utils::vectorize_matrix(Utils::dagger(op.mats[0])));
+        }
+      }
+      break;
+    case Operations::OpType::multiplexer: {
+      std::vector<cmatrix_t> mmat;
+      mmat.reserve(op.mats.size());
+      for (const auto &mat : op.mats)
+        mmat.push_back(Utils::dagger(mat));
+      apply_multiplexer(op.regs[0], op.regs[1], mmat);
+    } break;
+    case Operations::OpType::pauli_rotation:
+      BaseState::qreg_.apply_pauli_rotation(op.qubits, op.string_params[0],
+                                            -std::real(op.params[0]),
+                                            (op.params.size() > 1) ? std::conj(op.params[1]) : 1.);
+      break;
+    default:
+      throw std::invalid_argument("QubitVector::State::invalid adjoint instruction \'" +
+                                  op.name + "\'.");
+  }
+}
+
 template <class statevec_t>
 void State<statevec_t>::apply_multiplexer(const reg_t &control_qubits, const reg_t &target_qubits, const cmatrix_t &mat) {
   if (control_qubits.empty() == false && target_qubits.empty() == false && mat.size() > 0) {
@@ -754,12 +1077,22 @@ void State<statevec_t>::apply_multiplexer(const reg_t &control_qubits, const reg
 
 template <class statevec_t>
 void State<statevec_t>::apply_matrix(const Operations::Op &op) {
-  if (op.qubits.empty() == false && op.mats[0].size() > 0) {
-    if (Utils::is_diagonal(op.mats[0], .0)) {
-      BaseState::qreg_.apply_diagonal_matrix(op.qubits, Utils::matrix_diagonal(op.mats[0]));
-    } else {
+  if (op.qubits.empty() || op.mats[0].size() == 0)
+    return;
+  switch (op.mat_structure) {
+    case Operations::MatrixStructure::diagonal:
+      BaseState::qreg_.apply_diagonal_matrix(op.qubits, op.mat_entries);
+      break;
+    case Operations::MatrixStructure::monomial:
+      BaseState::qreg_.apply_monomial_matrix(op.qubits, op.mat_rows, op.mat_entries);
+      break;
+    case Operations::MatrixStructure::controlled: {
+      reg_t controls, targets;
+      Operations::matrix_control_qubits(op, controls, targets);
+      BaseState::qreg_.apply_controlled_matrix(controls, targets, op.mat_entries);
+    } break;
+    default:
       BaseState::qreg_.apply_matrix(op.qubits, Utils::vectorize_matrix(op.mats[0]));
-    }
   }
 }
 
@@ -842,10 +1175,97 @@ std::vector<reg_t> State<statevec_t>::sample_measure(const reg_t &qubits,
 template <class statevec_t>
 void State<statevec_t>::apply_reset(const reg_t &qubits,
                                     RngEngine &rng) {
+  // Reset does nothing to qubits in the |0> state
+  if (is_clean(qubits))
+    return;
   // Simulate unobserved measurement
   const auto meas = sample_measure_with_prob(qubits, rng);
   // Apply update to reset state
   measure_reset_update(qubits, 0, meas.first, meas.second);
+  set_clean(qubits, true);
+}
+
+template <class statevec_t>
+rvector_t State<statevec_t>::branch_probabilities(const Operations::Op &op) {
+  if (!BaseState::creg_.check_conditional(op))
+    return rvector_t();
+  switch (op.type) {
+    case Operations::OpType::measure:
+      return measure_probs(op.qubits);
+    case Operations::OpType::reset:
+      if (is_clean(op.qubits))
+        return rvector_t();
+      return measure_probs(op.qubits);
+    case Operations::OpType::initialize: {
+      // Initializing all qubits in order replaces the state
+      auto sorted_qubits = op.qubits;
+      std::sort(sorted_qubits.begin(), sorted_qubits.end());
+      if (is_clean(op.qubits) ||
+          (op.qubits.size() == BaseState::qreg_.num_qubits() &&
+           op.qubits == sorted_qubits))
+        return rvector_t();
+      return measure_probs(op.qubits);
+    }
+    default:
+      return rvector_t();
+  }
+}
+
+template <class statevec_t>
+void State<statevec_t>::apply_branch(const Operations::Op &op,
+                                     uint_t outcome,
+                                     double prob) {
+  tape_valid_ = false;
+  switch (op.type) {
+    case Operations::OpType::measure:
+      measure_reset_update(op.qubits, outcome, outcome, prob);
+      BaseState::creg_.store_measure(Utils::int2reg(outcome, 2, op.qubits.size()),
+                                     op.memory, op.registers);
+      set_clean(op.qubits, false);
+      break;
+    case Operations::OpType::reset:
+      measure_reset_update(op.qubits, 0, outcome, prob);
+      set_clean(op.qubits, true);
+      break;
+    case Operations::OpType::initialize:
+      BaseState::qreg_.initialize_component(op.qubits, op.params, outcome, prob);
+      set_clean(op.qubits, false);
+      break;
+    default:
+      throw std::invalid_argument("QubitVector::State::invalid branch instruction \'" +
+                                  op.name + "\'.");
+  }
+}
+
+template <class statevec_t>
+void State<statevec_t>::push_branch() {
+  branches_.push_back({BaseState::qreg_.vector(), BaseState::creg_, clean_qubits_});
+}
+
+template <class statevec_t>
+void State<statevec_t>::pop_branch() {
+  auto &branch = branches_.back();
+  BaseState::qreg_.initialize_from_data(branch.qreg.data(), branch.qreg.size());
+  BaseState::creg_ = std::move(branch.creg);
+  clean_qubits_ = std::move(branch.clean_qubits);
+  branches_.pop_back();
+}
+
+template <class statevec_t>
+bool State<statevec_t>::is_clean(const reg_t &qubits) const {
+  for (const auto &qubit : qubits) {
+    if (qubit >= clean_qubits_.size() || !clean_qubits_[qubit])
+      return false;
+  }
+  return true;
+}
+
+template <class statevec_t>
+void State<statevec_t>::set_clean(const reg_t &qubits, bool clean) {
+  for (const auto &qubit : qubits) {
+    if (qubit < clean_qubits_.size())
+      clean_qubits_[qubit] = clean;
+  }
 }
 
 template <class statevec_t>
@@ -918,10 +1338,16 @@ void State<statevec_t>::apply_initialize(const reg_t &qubits,
       return;
       }
    }
-   // Apply reset to qubits
-   apply_reset(qubits, rng);
-   // Apply initialize_component
-   BaseState::qreg_.initialize_component(qubits, params);
+   if (is_clean(qubits)) {
+     // The qubits are in the |0> state so no reset is needed
+     BaseState::qreg_.initialize_component(qubits, params);
+   } else {
+     // Simulate an unobserved measurement and apply the reset together
+     // with initialize_component
+     const auto meas = sample_measure_with_prob(qubits, rng);
+     BaseState::qreg_.initialize_component(qubits, params, meas.first, meas.second);
+   }
+   set_clean(qubits, false);
 }
 
 //=========================================================================
@@ -930,11 +1356,36 @@ void State<statevec_t>::apply_initialize(const reg_t &qubits,
 
 template <class statevec_t>
 void State<statevec_t>::apply_multiplexer(const reg_t &control_qubits, const reg_t &target_qubits, const std::vector<cmatrix_t> &mmat) {
-	// (1) Pack vector of matrices into single (stacked) matrix ... note: matrix dims: rows = DIM[qubit.size()] columns = DIM[|target bits|]
-	cmatrix_t multiplexer_matrix = Utils::stacked_matrix(mmat);
+  if (target_qubits.empty() || mmat.empty())
+    return;
+
+  // A multiplexer of diagonal matrices is a diagonal matrix on the target
+  // and control qubits, which is applied as a table of phases
+  bool diagonal = true;
+  for (const auto &mat : mmat) {
+    if (!Utils::is_diagonal(mat, 0.)) {
+      diagonal = false;
+      break;
+    }
+  }
+  if (diagonal) {
+    cvector_t diag;
+    for (const auto &mat : mmat) {
+      const auto mat_diag = Utils::matrix_diagonal(mat);
+      diag.insert(diag.end(), mat_diag.begin(), mat_diag.end());
+    }
+    reg_t qubits = target_qubits;
+    qubits.insert(qubits.end(), control_qubits.begin(), control_qubits.end());
+    BaseState::qreg_.apply_diagonal_matrix(qubits, diag);
+    return;
+  }
 
-	// (2) Treat as single, large(r), chained/batched matrix operator
-	apply_multiplexer(control_qubits, target_qubits, multiplexer_matrix);
+  // Otherwise the control qubits select the matrix applied to the targets
+  std::vector<cvector_t> vmats;
+  vmats.reserve(mmat.size());
+  for (const auto &mat : mmat)
+    vmats.push_back(Utils::vectorize_matrix(mat));
+  BaseState::qreg_.apply_multiplexer(control_qubits, target_qubits, vmats);
 }
 
 
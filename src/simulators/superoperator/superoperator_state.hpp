@@ -465,7 +465,8 @@ void State<data_t>::apply_snapshot(const Operations::Op &op,
                                    OutputData &data) {
   // Look for snapshot type in snapshotset
   if (op.name == "superopertor" || op.name == "state") {
-    BaseState::snapshot_state(op, data, "superoperator");
+    data.add_singleshot_snapshot("superoperator", op.string_params[0],
+                                 BaseState::qreg_.json_array());
   } else {
     throw std::invalid_argument("QubitSuperoperator::State::invalid snapshot instruction \'" +
                                 op.name + "\'.");
@@ -17,6 +17,8 @@
 
 #include "base/controller.hpp"
 #include "unitary_state.hpp"
+#include "transpile/basic_opts.hpp"
+#include "transpile/fusion.hpp"
 
 namespace AER {
 namespace Simulator {
@@ -38,6 +40,19 @@ namespace Simulator {
  * - "unitary_parallel_threshold" (int): Threshold that number of qubits
  *      must be greater than to enable OpenMP parallelization at State
  *      level [Default: 6]
+ * - "unitary_gemm_min_qubit" (int): Minimum number of qubits of a dense
+ *      matrix, such as a fused gate, that is multiplied into the unitary
+ *      with complex GEMMs instead of a sweep. Fusion uses the same value
+ *      in its cost model [Default: 4]
+ *
+ * From Transpile::Fusion class
+ *
+ * - "fusion_enable" (bool): Fuse gates into matrices [Default: False]
+ * - "fusion_threshold" (int): Threshold that twice the number of qubits,
+ *      the qubits of the matrix swept by each gate, must reach to enable
+ *      fusion [Default: 16]
+ * - "fusion_max_qubit" (int): Maximum number of qubits of a fused
+ *      matrix [Default: 6]
  * 
  * From BaseController Class
  *
@@ -100,6 +115,9 @@ private:
 UnitaryController::UnitaryController() : Base::Controller() {
   // Disable qubit truncation by default
   Base::Controller::truncate_qubits_ = false;
+  // Each gate sweeps the 4^n entries of the unitary
+  add_circuit_optimization(Transpile::ReduceBarrier());
+  add_circuit_optimization(Transpile::Fusion(6, 16, 1.8, Transpile::Fusion::Sweep::gemm));
 }
 
 //-------------------------------------------------------------------------
@@ -163,7 +181,7 @@ OutputData UnitaryController::run_circuit(const Circuit &circ,
 
   // Set state config
   state.set_config(config);
-  state.set_parallalization(parallel_state_update_);
+  state.set_parallalization(state_update_threads());
 
   // Rng engine (not actually needed for unitary controller)
   RngEngine rng;
@@ -173,17 +191,22 @@ OutputData UnitaryController::run_circuit(const Circuit &circ,
   OutputData data;
   data.set_config(config);
 
+  // Optimize circuit
+  Circuit opt_circ = circ;
+  Noise::NoiseModel dummy;
+  optimize_circuit(opt_circ, dummy, state, data);
+
   // Run single shot collecting measure data or snapshots
   if (initial_unitary_.empty())
     state.initialize_qreg(circ.num_qubits);
   else
     state.initialize_qreg(circ.num_qubits, initial_unitary_);
   state.initialize_creg(circ.num_memory, circ.num_registers);
-  state.apply_ops(circ.ops, data, rng);
+  state.apply_ops(opt_circ.ops, data, rng);
   state.add_creg_to_data(data);
 
   // Add final state unitary to the data
-  data.add_additional_data("unitary", state.qreg());
+  data.add_additional_data("unitary", state.qreg().json_array());
 
   return data;
 }
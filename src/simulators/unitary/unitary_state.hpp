@@ -61,6 +61,7 @@ public:
       Operations::OpType::gate,
       Operations::OpType::barrier,
       Operations::OpType::matrix,
+      Operations::OpType::pauli_rotation,
       Operations::OpType::snapshot
     });
   }
@@ -98,8 +99,9 @@ public:
                                     const override;
 
   // Load the threshold for applying OpenMP parallelization
-  // if the controller/engine allows threads for it
-  // Config: {"omp_qubit_threshold": 7}
+  // if the controller/engine allows threads for it, and the number
+  // of qubits of dense matrices applied as GEMMs
+  // Config: {"omp_qubit_threshold": 7, "unitary_gemm_min_qubit": 4}
   virtual void set_config(const json_t &config) override;
 
   //-----------------------------------------------------------------------
@@ -130,6 +132,9 @@ protected:
   // Apply a matrix to given qubits (identity on all other qubits)
   void apply_matrix(const reg_t &qubits, const cmatrix_t & mat);
 
+  // Apply a matrix op with the kernel for its matrix structure
+  void apply_matrix(const Operations::Op &op);
+
   // Apply a matrix to given qubits (identity on all other qubits)
   void apply_matrix(const reg_t &qubits, const cvector_t & vmat);
 
@@ -159,6 +164,9 @@ protected:
   // OpenMP qubit threshold
   int omp_qubit_threshold_ = 6;
 
+  // Minimum number of qubits of a dense matrix applied as GEMMs
+  uint_t gemm_min_qubit_ = 4;
+
   // Threshold for chopping small values to zero in JSON
   double json_chop_threshold_ = 1e-10;
 
@@ -226,7 +234,12 @@ void State<data_t>::apply_ops(const std::vector<Operations::Op> &ops,
         apply_snapshot(op, data);
         break;
       case Operations::OpType::matrix:
-        apply_matrix(op.qubits, op.mats[0]);
+        apply_matrix(op);
+        break;
+      case Operations::OpType::pauli_rotation:
+        BaseState::qreg_.apply_pauli_rotation(op.qubits, op.string_params[0],
+                                              std::real(op.params[0]),
+                                              (op.params.size() > 1) ? op.params[1] : 1.);
         break;
       default:
         throw std::invalid_argument("QubitUnitary::State::invalid instruction \'" +
@@ -253,6 +266,9 @@ void State<data_t>::set_config(const json_t &config) {
   // Set OMP threshold for state update functions
   JSON::get_value(omp_qubit_threshold_, "unitary_parallel_threshold", config);
 
+  // Set number of qubits of dense matrices applied as GEMMs
+  JSON::get_value(gemm_min_qubit_, "unitary_gemm_min_qubit", config);
+
   // Set threshold for truncating snapshots
   JSON::get_value(json_chop_threshold_, "zero_threshold", config);
   BaseState::qreg_.set_json_chop_threshold(json_chop_threshold_);
@@ -375,6 +391,25 @@ void State<data_t>::apply_gate(const Operations::Op &op) {
   }
 }
 
+template <class data_t>
+void State<data_t>::apply_matrix(const Operations::Op &op) {
+  switch (op.mat_structure) {
+    case Operations::MatrixStructure::diagonal:
+      BaseState::qreg_.apply_diagonal_matrix(op.qubits, op.mat_entries);
+      break;
+    case Operations::MatrixStructure::monomial:
+      BaseState::qreg_.apply_monomial_matrix(op.qubits, op.mat_rows, op.mat_entries);
+      break;
+    case Operations::MatrixStructure::controlled: {
+      reg_t controls, targets;
+      Operations::matrix_control_qubits(op, controls, targets);
+      BaseState::qreg_.apply_controlled_matrix(controls, targets, op.mat_entries);
+    } break;
+    default:
+      apply_matrix(op.qubits, op.mats[0]);
+  }
+}
+
 template <class data_t>
 void State<data_t>::apply_matrix(const reg_t &qubits, const cmatrix_t &mat) {
   if (qubits.empty() == false && mat.size() > 0) {
@@ -387,6 +422,8 @@ void State<data_t>::apply_matrix(const reg_t &qubits, const cvector_t &vmat) {
   // Check if diagonal matrix
   if (vmat.size() == 1ULL << qubits.size()) {
     BaseState::qreg_.apply_diagonal_matrix(qubits, vmat);
+  } else if (qubits.size() >= gemm_min_qubit_) {
+    BaseState::qreg_.apply_matrix_gemm(qubits, vmat);
   } else {
     BaseState::qreg_.apply_matrix(qubits, vmat);
   }
@@ -417,7 +454,8 @@ void State<data_t>::apply_snapshot(const Operations::Op &op,
                                    OutputData &data) {
   // Look for snapshot type in snapshotset
   if (op.name == "unitary" || op.name == "state") {
-    BaseState::snapshot_state(op, data);
+    data.add_singleshot_snapshot(op.name, op.string_params[0],
+                                 BaseState::qreg_.json_array());
   } else {
     throw std::invalid_argument("Unitary::State::invalid snapshot instruction \'" +
                                 op.name + "\'.");
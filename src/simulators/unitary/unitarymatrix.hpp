@@ -69,6 +69,10 @@ public:
   // Return JSON serialization of UnitaryMatrix;
   json_t json() const;
 
+  // Return a copy of the matrix that is serialized as json() by a
+  // JSON::Writer without building the JSON document
+  JSON::ComplexArray json_array() const;
+
   // Initializes the current vector so that all qubits are in the |0> state.
   void initialize();
 
@@ -94,8 +98,40 @@ public:
   // Get the threshold for verify_identity
   double get_check_identity_threshold() {return identity_threshold_;}
 
+  //-----------------------------------------------------------------------
+  // Block matrix multiplication
+  //-----------------------------------------------------------------------
+
+  // Apply a dense N-qubit matrix to the rows of the unitary with complex
+  // GEMMs. Viewing the unitary as a 2^N x 2^(2n-N) matrix whose rows are
+  // indexed by the qubits, a batch of its columns is gathered into a
+  // contiguous buffer, multiplied by the matrix and scattered back.
+  // Above the OpenMP threshold the batches are distributed over the OpenMP
+  // threads, and each thread calls the BLAS GEMM for its own batches. The
+  // BLAS is then expected to run single-threaded in each call. OpenMP
+  // builds of OpenBLAS and MKL do this inside an active parallel region.
+  // A pthreads build of OpenBLAS has to be limited with
+  // OPENBLAS_NUM_THREADS=1, or its threads oversubscribe the cores. Below
+  // the threshold the GEMMs are called serially and may use BLAS threads.
+  void apply_matrix_gemm(const reg_t &qubits, const cvector_t<double> &mat);
+
+  // Set the number of amplitudes gathered for each GEMM
+  void set_gemm_batch_size(uint_t size) {
+    gemm_batch_size_ = std::max<uint_t>(size, 1);
+  }
+
 protected:
 
+  // C = A * B for column-major A (m x k), B (k x n) and C (m x n)
+  static void gemm(size_t m, size_t n, size_t k,
+                   const std::complex<double> *A,
+                   const std::complex<double> *B,
+                   std::complex<double> *C);
+  static void gemm(size_t m, size_t n, size_t k,
+                   const std::complex<float> *A,
+                   const std::complex<float> *B,
+                   std::complex<float> *C);
+
   //-----------------------------------------------------------------------
   // Protected data members
   //-----------------------------------------------------------------------
@@ -109,6 +145,8 @@ protected:
   double identity_threshold_ = 1e-10; // Threshold for verifying if the
                                       // internal matrix is identity up to
                                       // global phase
+
+  uint_t gemm_batch_size_ = 1ULL << 14; // Amplitudes gathered for each GEMM
 };
 
 /*******************************************************************************
@@ -169,6 +207,12 @@ json_t UnitaryMatrix<data_t>::json() const {
   return js;
 }
 
+template <class data_t>
+JSON::ComplexArray UnitaryMatrix<data_t>::json_array() const {
+  return JSON::ComplexArray(BaseVector::data_, rows_, rows_,
+                            BaseVector::json_chop_threshold_);
+}
+
 
 //------------------------------------------------------------------------------
 // Constructors & Destructor
@@ -309,6 +353,81 @@ std::pair<bool, double> UnitaryMatrix<data_t>::check_identity() const {
   return std::make_pair(true, theta);
 }
 
+//------------------------------------------------------------------------------
+// Block matrix multiplication
+//------------------------------------------------------------------------------
+
+template <class data_t>
+void UnitaryMatrix<data_t>::gemm(size_t m, size_t n, size_t k,
+                                 const std::complex<double> *A,
+                                 const std::complex<double> *B,
+                                 std::complex<double> *C) {
+  const char Trans = 'N';
+  const std::complex<double> alpha = 1., beta = 0.;
+  zgemm_(&Trans, &Trans, &m, &n, &k, &alpha, A, &m, B, &k, &beta, C, &m);
+}
+
+template <class data_t>
+void UnitaryMatrix<data_t>::gemm(size_t m, size_t n, size_t k,
+                                 const std::complex<float> *A,
+                                 const std::complex<float> *B,
+                                 std::complex<float> *C) {
+  const char Trans = 'N';
+  const std::complex<float> alpha = 1., beta = 0.;
+  cgemm_(&Trans, &Trans, &m, &n, &k, &alpha, A, &m, B, &k, &beta, C, &m);
+}
+
+template <class data_t>
+void UnitaryMatrix<data_t>::apply_matrix_gemm(const reg_t &qubits,
+                                              const cvector_t<double> &mat) {
+  const size_t N = qubits.size();
+  const uint_t DIM = BITS[N];
+  #ifdef DEBUG
+  BaseVector::check_vector(mat, 2 * N);
+  #endif
+
+  auto qubits_sorted = qubits;
+  std::sort(qubits_sorted.begin(), qubits_sorted.end());
+
+  // Offsets of the rows of the matrix from the first index of a column
+  std::vector<uint_t> offsets(DIM, 0);
+  for (size_t i = 0; i < N; i++) {
+    const auto n = BITS[i];
+    const auto bit = BITS[qubits[i]];
+    for (size_t j = 0; j < n; j++)
+      offsets[n + j] = offsets[j] | bit;
+  }
+
+  const auto _mat = BaseVector::convert(mat);
+  auto data = BaseVector::data_;
+  const int_t END = BaseVector::data_size_ >> N;
+  const int_t BATCH = std::min<int_t>(END, std::max<int_t>(1, gemm_batch_size_ >> N));
+  const int_t NBATCHES = (END + BATCH - 1) / BATCH;
+
+  #pragma omp parallel if (BaseVector::num_qubits_ > BaseVector::omp_threshold_ && BaseVector::omp_threads_ > 1) num_threads(BaseVector::omp_threads_)
+  {
+    cvector_t<data_t> cols(DIM * BATCH), result(DIM * BATCH);
+    #pragma omp for
+    for (int_t b = 0; b < NBATCHES; b++) {
+      const int_t start = b * BATCH;
+      const int_t ncols = std::min(BATCH, END - start);
+      for (int_t c = 0; c < ncols; c++) {
+        const auto i0 = BaseVector::index0(qubits_sorted, start + c);
+        auto col = cols.data() + DIM * c;
+        for (uint_t j = 0; j < DIM; j++)
+          col[j] = data[i0 + offsets[j]];
+      }
+      gemm(DIM, ncols, DIM, _mat.data(), cols.data(), result.data());
+      for (int_t c = 0; c < ncols; c++) {
+        const auto i0 = BaseVector::index0(qubits_sorted, start + c);
+        const auto col = result.data() + DIM * c;
+        for (uint_t j = 0; j < DIM; j++)
+          data[i0 + offsets[j]] = col[j];
+      }
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 } // end namespace QV
 //------------------------------------------------------------------------------
@@ -0,0 +1,173 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_transpile_clifford_fusion_hpp_
+#define _aer_transpile_clifford_fusion_hpp_
+
+#include <algorithm>
+
+#include "transpile/group_fusion.hpp"
+#include "simulators/stabilizer/stabilizer_state.hpp"
+
+namespace AER {
+namespace Transpile {
+
+using uint_t = uint_t;
+using op_t = Operations::Op;
+using optype_t = Operations::OpType;
+using oplist_t = std::vector<op_t>;
+using opset_t = Operations::OpSet;
+using reg_t = std::vector<uint_t>;
+
+class CliffordFusion : public GroupFusion {
+public:
+  CliffordFusion(uint_t max_qubit = 3, uint_t threshold = 16);
+
+  /*
+   * Clifford fusion replaces groups of adjacent Clifford gates on a few
+   * qubits by a single clifford instruction carrying their tableau, for
+   * simulators that support clifford instructions. Each gate is a sweep
+   * over the rows of the stabilizer tableau, while a clifford instruction
+   * updates each row once from a table of the images of the Paulis on its
+   * qubits. The groups are chosen by minimizing the estimated cost of the
+   * sweeps, where a clifford instruction on k qubits costs as much as
+   * 1 + k gates.
+   *
+   * Clifford fusion uses following configuration options
+   *   - clifford_fusion_enable (bool): if true, activate Clifford fusion (default: true)
+   *   - clifford_fusion_max_qubit (int): maximum number of qubits of a fused Clifford, at most 10 (default: 3)
+   *   - clifford_fusion_threshold (int): number of qubits of a circuit to activate Clifford fusion (default: 16)
+   *   - fusion_verbose (bool): if true, output generated instructions in metadata (default: false)
+   */
+  void set_config(const json_t &config) override;
+
+  void optimize_circuit(Circuit& circ,
+                        Noise::NoiseModel& noise,
+                        const opset_t &opset,
+                        OutputData &data) const override;
+
+private:
+  // Return true if the instruction can be part of a fused Clifford
+  bool can_apply_fusion(const op_t& op) const override;
+
+  // Estimated cost of the sweep of a clifford instruction on num_qubits
+  // qubits
+  double get_cost(uint_t num_qubits) const override {
+    return 1. + num_qubits;
+  }
+
+  // Estimated cost of the sweep of an instruction
+  double get_cost(const op_t& op) const override {
+    if (op.type == optype_t::clifford)
+      return get_cost(op.qubits.size());
+    // CZ and SWAP gates are applied as 3 sweeps
+    return (op.name == "cz" || op.name == "swap") ? 3. : 1.;
+  }
+
+  // Return a clifford instruction for a group of instructions
+  op_t generate_fusion(const std::vector<op_t>& fusioned_ops) const override;
+
+  bool verbose_ = false;
+  bool active_ = true;
+
+  // Gates supported by the stabilizer simulator
+  const stringset_t supported_gates_ = Stabilizer::State().allowed_gates();
+};
+
+CliffordFusion::CliffordFusion(uint_t max_qubit, uint_t threshold):
+    GroupFusion(max_qubit, threshold) {
+}
+
+void CliffordFusion::set_config(const json_t &config) {
+
+  CircuitOptimization::set_config(config);
+
+  if (JSON::check_key("fusion_verbose", config_))
+    JSON::get_value(verbose_, "fusion_verbose", config_);
+
+  if (JSON::check_key("clifford_fusion_enable", config_))
+    JSON::get_value(active_, "clifford_fusion_enable", config_);
+
+  if (JSON::check_key("clifford_fusion_max_qubit", config_))
+    JSON::get_value(max_qubit_, "clifford_fusion_max_qubit", config_);
+  max_qubit_ = std::min(max_qubit_, Operations::max_clifford_qubits);
+
+  if (JSON::check_key("clifford_fusion_threshold", config_))
+    JSON::get_value(threshold_, "clifford_fusion_threshold", config_);
+}
+
+void CliffordFusion::optimize_circuit(Circuit& circ,
+                                      Noise::NoiseModel&,
+                                      const opset_t &allowed_opset,
+                                      OutputData &data) const {
+
+  if (!active_ || circ.num_qubits < threshold_ ||
+      allowed_opset.optypes.count(optype_t::clifford) == 0)
+    return;
+
+  if (fuse_operations(circ.ops) && verbose_)
+    data.add_additional_data("metadata",
+                             json_t::object({{"clifford_fusion_verbose", circ.ops}}));
+}
+
+bool CliffordFusion::can_apply_fusion(const op_t& op) const {
+  if (op.conditional || op.qubits.size() > max_qubit_)
+    return false;
+  switch (op.type) {
+  case optype_t::gate:
+    return supported_gates_.count(op.name) > 0;
+  case optype_t::clifford:
+    return true;
+  default:
+    return false;
+  }
+}
+
+op_t CliffordFusion::generate_fusion(const std::vector<op_t>& fusioned_ops) const {
+
+  reg_t qubits;
+  for (const op_t& op: fusioned_ops)
+    for (const uint_t qubit: op.qubits)
+      if (std::find(qubits.begin(), qubits.end(), qubit) == qubits.end())
+        qubits.push_back(qubit);
+  std::sort(qubits.begin(), qubits.end());
+
+  // Apply the instructions relabelled to the positions of their qubits
+  // to an identity tableau
+  std::vector<op_t> local_ops(fusioned_ops);
+  for (op_t& op: local_ops)
+    for (uint_t& qubit: op.qubits)
+      qubit = std::distance(qubits.begin(),
+                            std::find(qubits.begin(), qubits.end(), qubit));
+
+  Stabilizer::State clifford;
+  clifford.initialize_qreg(qubits.size());
+  OutputData data;
+  RngEngine rng(0);
+  clifford.apply_ops(local_ops, data, rng);
+
+  std::vector<std::string> destabilizers, stabilizers;
+  for (uint_t j = 0; j < qubits.size(); ++j) {
+    const auto &tableau = clifford.qreg();
+    destabilizers.push_back((tableau.phases()[j] ? "-" : "") + tableau.destabilizer(j).str());
+    stabilizers.push_back((tableau.phases()[qubits.size() + j] ? "-" : "") + tableau.stabilizer(j).str());
+  }
+  return Operations::make_clifford(qubits, destabilizers, stabilizers);
+}
+
+//-------------------------------------------------------------------------
+} // end namespace Transpile
+} // end namespace AER
+//-------------------------------------------------------------------------
+#endif
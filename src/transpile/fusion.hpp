@@ -15,7 +15,11 @@
 #ifndef _aer_transpile_fusion_hpp_
 #define _aer_transpile_fusion_hpp_
 
+#include <map>
+#include <set>
+
 #include "transpile/circuitopt.hpp"
+#include "simulators/unitary/unitarymatrix.hpp"
 
 namespace AER {
 namespace Transpile {
@@ -30,7 +34,13 @@ using reg_t = std::vector<uint_t>;
 class Fusion : public CircuitOptimization {
 public:
   // constructor
-  Fusion(uint_t max_qubit = 5, uint_t threshold = 16, double cost_factor = 1.8);
+  // States swept by the gates: a vector of 2^n amplitudes, or a unitary
+  // matrix of 4^n entries to which dense matrices on enough qubits are
+  // applied as GEMMs
+  enum class Sweep {vector, gemm};
+
+  Fusion(uint_t max_qubit = 5, uint_t threshold = 16, double cost_factor = 1.8,
+         Sweep sweep = Sweep::vector);
 
   /*
    * Fusion optimization uses following configuration options
@@ -39,23 +49,71 @@ public:
    *   - fusion_max_qubit (int): maximum number of qubits for a operation (default: 5)
    *   - fusion_threshold (int): a threshold to activate fusion optimization when fusion_enable is true (default: 16)
    *   - fusion_cost_factor (double): a cost function to estimate an aggregate gate (default: 1.8)
+   *
+   * If the simulator supports the pauli_rotation instruction, a u1 gate
+   * between mirrored ladders of CX gates whose parity spans at least
+   * 3 qubits is first replaced by a single Pauli rotation, together with
+   * pairs of inverse single-qubit gates around the ladder that map Z on a
+   * qubit of the parity to another Pauli.
+   *
+   * Circuits with gradient snapshots are not fused.
+   *
+   * For GEMM sweeps the threshold is compared to twice the number of
+   * qubits, and the cost model follows sweeps of a 4^n matrix, which are
+   * limited by memory bandwidth: a dense gate of up to 2 qubits costs one
+   * sweep, each further qubit doubles the cost, and diagonal and
+   * permutation gates cost a quarter of a sweep. The cost factor is
+   * not used. Dense matrices on at least unitary_gemm_min_qubit qubits
+   * (default: 4) are multiplied into the unitary with complex GEMMs,
+   * which are limited by arithmetic rather than memory: their cost
+   * starts at two sweeps and doubles with each further qubit. Gates are
+   * then collected into blocks across the circuit rather than in runs of
+   * adjacent instructions: a block grows from the first remaining gate by
+   * taking every later gate whose earlier gates on the same qubits are
+   * already in the block, up to max_qubit qubits, and the longest prefix
+   * of the block that saves the most estimated cost is fused. Large blocks
+   * are therefore only formed where there are enough gates to fill them.
   */
   void set_config(const json_t &config) override;
 
+  // Return true if fusion is applied to circuits of the given size
+  bool is_active(uint_t num_qubits) const {
+    return active_ && num_qubits * (sweep_ == Sweep::gemm ? 2 : 1) >= threshold_;
+  }
+
   void optimize_circuit(Circuit& circ,
                         Noise::NoiseModel& noise,
                         const opset_t &opset,
                         OutputData &data) const override;
 
+  // Return true if a gate or matrix is applied by a diagonal or
+  // permutation kernel rather than a dense matrix
+  static bool is_diagonal_or_permutation(const op_t& op);
+
 private:
   bool can_ignore(const op_t& op) const;
 
+  bool rewrite_pauli_ladders(oplist_t& ops) const;
+
+  bool is_cx(const op_t& op) const;
+
+  int nearest_1q_gate(const oplist_t& ops, int from, int step, uint_t qubit) const;
+
+  bool pauli_of(const cmatrix_t& mat, char& pauli, bool& negative) const;
+
   bool can_apply_fusion(const op_t& op) const;
 
   double get_cost(const op_t& op) const;
 
   bool aggregate_operations(oplist_t& ops, const int fusion_start, const int fusion_end) const;
 
+  bool aggregate_blocks(oplist_t& ops, const int fusion_start, const int fusion_end,
+                        const uint_t num_qubits) const;
+
+  op_t generate_block_operation(const std::vector<op_t>& fusioned_ops) const;
+
+  double gemm_cost(const uint_t num_qubits) const;
+
   op_t generate_fusion_operation(const std::vector<op_t>& fusioned_ops) const;
 
   void swap_cols_and_rows(const uint_t idx1,
@@ -93,6 +151,8 @@ private:
   uint_t max_qubit_;
   uint_t threshold_;
   double cost_factor_;
+  Sweep sweep_;
+  uint_t gemm_min_qubit_ = 4;
   bool verbose_ = false;
   bool active_ = false;
 };
@@ -123,8 +183,10 @@ const std::vector<std::string> Fusion::supported_gates({
   //"ccx"   // Controlled-CX gate (Toffoli): TODO
 });
 
-Fusion::Fusion(uint_t max_qubit, uint_t threshold, double cost_factor):
-    max_qubit_(max_qubit), threshold_(threshold), cost_factor_(cost_factor) {
+Fusion::Fusion(uint_t max_qubit, uint_t threshold, double cost_factor,
+               Sweep sweep):
+    max_qubit_(max_qubit), threshold_(threshold), cost_factor_(cost_factor),
+    sweep_(sweep) {
 }
 
 void Fusion::set_config(const json_t &config) {
@@ -145,6 +207,9 @@ void Fusion::set_config(const json_t &config) {
 
   if (JSON::check_key("fusion_cost_factor", config_))
     JSON::get_value(cost_factor_, "fusion_cost_factor", config_);
+
+  if (JSON::check_key("unitary_gemm_min_qubit", config_))
+    JSON::get_value(gemm_min_qubit_, "unitary_gemm_min_qubit", config_);
 }
 
 
@@ -174,24 +239,36 @@ void Fusion::optimize_circuit(Circuit& circ,
                               const opset_t &allowed_opset,
                               OutputData &data) const {
 
-  if (circ.num_qubits < threshold_
-      || !active_)
+  if (!is_active(circ.num_qubits))
     return;
 
-  bool applied = false;
+  // Gradient snapshots refer to the parameters of the gates, which would be
+  // merged into matrices
+  for (const auto &op : circ.ops) {
+    if (op.type == optype_t::snapshot && op.name == "expectation_value_pauli_gradient")
+      return;
+  }
+
+  bool applied = allowed_opset.optypes.count(optype_t::pauli_rotation) > 0
+                 && rewrite_pauli_ladders(circ.ops);
+
+  const auto aggregate = [&](oplist_t& ops, const int start, const int end) {
+    return (sweep_ == Sweep::gemm) ? aggregate_blocks(ops, start, end, circ.num_qubits)
+                                   : aggregate_operations(ops, start, end);
+  };
 
   uint_t fusion_start = 0;
   for (uint_t op_idx = 0; op_idx < circ.ops.size(); ++op_idx) {
     if (can_ignore(circ.ops[op_idx]))
       continue;
     if (!can_apply_fusion(circ.ops[op_idx])) {
-      applied |= fusion_start != op_idx && aggregate_operations(circ.ops, fusion_start, op_idx);
+      applied |= fusion_start != op_idx && aggregate(circ.ops, fusion_start, op_idx);
       fusion_start = op_idx + 1;
     }
   }
 
   if (fusion_start < circ.ops.size()
-      && aggregate_operations(circ.ops, fusion_start, circ.ops.size()))
+      && aggregate(circ.ops, fusion_start, circ.ops.size()))
       applied = true;
 
   if (applied) {
@@ -218,6 +295,140 @@ void Fusion::optimize_circuit(Circuit& circ,
 #endif
 }
 
+bool Fusion::rewrite_pauli_ladders(oplist_t& ops) const {
+  bool applied = false;
+  const int size = ops.size();
+  for (int center = 0; center < size; ++center) {
+    const op_t& u1 = ops[center];
+    if (u1.type != optype_t::gate || u1.name != "u1" || u1.conditional)
+      continue;
+
+    // Find the largest mirrored range of CX gates around the u1 gate
+    int width = 0;
+    while (center - width - 1 >= 0 && center + width + 1 < size
+           && is_cx(ops[center - width - 1]) && is_cx(ops[center + width + 1])
+           && ops[center - width - 1].qubits == ops[center + width + 1].qubits)
+      ++width;
+    if (width == 0)
+      continue;
+
+    // The u1 gate acts on the parity of the qubits given by the linear map
+    // of the first half of the ladder
+    std::map<uint_t, std::set<uint_t>> parities;
+    auto parity = [&parities](uint_t qubit)->std::set<uint_t>& {
+      auto it = parities.find(qubit);
+      if (it == parities.end())
+        it = parities.emplace(qubit, std::set<uint_t>({qubit})).first;
+      return it->second;
+    };
+    for (int i = center - width; i < center; ++i) {
+      const std::set<uint_t> control = parity(ops[i].qubits[0]);
+      std::set<uint_t>& target = parity(ops[i].qubits[1]);
+      for (const uint_t qubit: control)
+        if (!target.erase(qubit))
+          target.insert(qubit);
+    }
+    const std::set<uint_t>& support = parity(u1.qubits[0]);
+    if (support.size() < 3)
+      continue;
+
+    // u1(lam) = exp(i lam/2) exp(-i lam/2 Z) on the parity
+    const reg_t qubits(support.begin(), support.end());
+    const double lambda = std::real(u1.params[0]);
+    double theta = lambda;
+    complex_t phase = std::exp(complex_t(0., 0.5 * lambda));
+    std::string pauli(qubits.size(), 'Z');
+
+    // Absorb pairs of gates U before and V after the ladder with VU = c I
+    // by conjugating the Pauli of the qubit with V
+    for (size_t i = 0; i < qubits.size(); ++i) {
+      char& label = pauli[qubits.size() - 1 - i];
+      int before = center - width;
+      int after = center + width;
+      while (true) {
+        before = nearest_1q_gate(ops, before, -1, qubits[i]);
+        after = nearest_1q_gate(ops, after, 1, qubits[i]);
+        if (before < 0 || after < 0)
+          break;
+        const cmatrix_t mat_v = matrix(ops[after]);
+        const cmatrix_t prod = mat_v * matrix(ops[before]);
+        if (std::abs(prod(0, 1)) > 1e-10 || std::abs(prod(1, 0)) > 1e-10
+            || std::abs(prod(0, 0) - prod(1, 1)) > 1e-10)
+          break;
+        const cmatrix_t& current = (label == 'X') ? Utils::Matrix::X
+                                   : (label == 'Y') ? Utils::Matrix::Y
+                                   : Utils::Matrix::Z;
+        bool negative;
+        if (!pauli_of(mat_v * current * Utils::dagger(mat_v), label, negative))
+          break;
+        if (negative)
+          theta = -theta;
+        phase *= prod(0, 0);
+        ops[before].name = "nop";
+        ops[after].name = "nop";
+      }
+    }
+
+    for (int i = center - width; i <= center + width; ++i)
+      ops[i].name = "nop";
+    ops[center] = Operations::make_pauli_rotation(qubits, pauli, theta, phase);
+    applied = true;
+  }
+  return applied;
+}
+
+bool Fusion::is_cx(const op_t& op) const {
+  return op.type == optype_t::gate && (op.name == "cx" || op.name == "CX")
+         && !op.conditional;
+}
+
+int Fusion::nearest_1q_gate(const oplist_t& ops, int from, int step, uint_t qubit) const {
+  for (int i = from + step; i >= 0 && i < static_cast<int>(ops.size()); i += step) {
+    const op_t& op = ops[i];
+    if (op.name == "nop")
+      continue;
+    switch (op.type) {
+    case optype_t::gate:
+    case optype_t::matrix:
+    case optype_t::multiplexer:
+    case optype_t::pauli_rotation:
+      break;
+    default:
+      return -1;
+    }
+    if (std::find(op.qubits.begin(), op.qubits.end(), qubit) == op.qubits.end())
+      continue;
+    if (op.qubits.size() != 1 || op.conditional || op.type == optype_t::multiplexer
+        || op.type == optype_t::pauli_rotation || !can_apply_fusion(op))
+      return -1;
+    return i;
+  }
+  return -1;
+}
+
+bool Fusion::pauli_of(const cmatrix_t& mat, char& pauli, bool& negative) const {
+  auto near = [](complex_t a, complex_t b) {return std::abs(a - b) < 1e-10;};
+  const complex_t i(0., 1.);
+  if (near(mat(0, 1), 0.) && near(mat(1, 0), 0.) && near(mat(0, 0), -mat(1, 1))) {
+    pauli = 'Z';
+    negative = near(mat(0, 0), -1.);
+    return negative || near(mat(0, 0), 1.);
+  }
+  if (!near(mat(0, 0), 0.) || !near(mat(1, 1), 0.))
+    return false;
+  if (near(mat(0, 1), mat(1, 0))) {
+    pauli = 'X';
+    negative = near(mat(1, 0), -1.);
+    return negative || near(mat(1, 0), 1.);
+  }
+  if (near(mat(0, 1), -mat(1, 0))) {
+    pauli = 'Y';
+    negative = near(mat(1, 0), -i);
+    return negative || near(mat(1, 0), i);
+  }
+  return false;
+}
+
 bool Fusion::can_ignore(const op_t& op) const {
   switch (op.type) {
   case optype_t::barrier:
@@ -253,8 +464,18 @@ bool Fusion::can_apply_fusion(const op_t& op) const {
 double Fusion::get_cost(const op_t& op) const {
   if (can_ignore(op))
     return .0;
-  else
-    return cost_factor_;
+  if (sweep_ == Sweep::gemm)
+    return is_diagonal_or_permutation(op) ? 0.25 : 1.;
+  return cost_factor_;
+}
+
+bool Fusion::is_diagonal_or_permutation(const op_t& op) {
+  if (op.type == optype_t::matrix)
+    return op.mat_structure == Operations::MatrixStructure::diagonal ||
+           op.mat_structure == Operations::MatrixStructure::monomial;
+  const static stringset_t gates({"id", "u0", "u1", "x", "y", "z", "s", "sdg",
+                                  "t", "tdg", "CX", "cx", "cu1", "cz", "swap"});
+  return op.type == optype_t::gate && gates.count(op.name) > 0;
 }
 
 bool Fusion::aggregate_operations(oplist_t& ops, const int fusion_start, const int fusion_end) const {
@@ -323,6 +544,112 @@ bool Fusion::aggregate_operations(oplist_t& ops, const int fusion_start, const i
   return true;
 }
 
+bool Fusion::aggregate_blocks(oplist_t& ops, const int fusion_start, const int fusion_end,
+                              const uint_t num_qubits) const {
+
+  std::vector<bool> done(fusion_end - fusion_start, false);
+  oplist_t fused_ops;
+  bool applied = false;
+
+  for (int first = fusion_start; first < fusion_end; ++first) {
+    if (done[first - fusion_start])
+      continue;
+
+    // Grow a block from the first remaining instruction. Qubits are blocked
+    // once a remaining instruction on them is left out of the block, and
+    // the block is complete once all of its qubits are blocked.
+    std::vector<int> block;
+    reg_t block_qubits;
+    std::vector<bool> blocked(num_qubits, false);
+    // Cost saved by fusing each prefix of the block
+    std::vector<double> savings;
+    double unfused_cost = 0.;
+
+    for (int i = first; i < fusion_end; ++i) {
+      if (done[i - fusion_start])
+        continue;
+      if (!block_qubits.empty() &&
+          std::all_of(block_qubits.begin(), block_qubits.end(),
+                      [&blocked](uint_t qubit) {return blocked[qubit];}))
+        break;
+      const op_t& op = ops[i];
+      reg_t qubits = block_qubits;
+      for (const uint_t qubit: op.qubits)
+        if (std::find(qubits.begin(), qubits.end(), qubit) == qubits.end())
+          qubits.push_back(qubit);
+      const bool free = std::none_of(op.qubits.begin(), op.qubits.end(),
+                                     [&blocked](uint_t qubit) {return blocked[qubit];});
+      if (!block.empty() && (!free || qubits.size() > max_qubit_ ||
+                             op.type == optype_t::barrier)) {
+        for (const uint_t qubit: op.qubits)
+          blocked[qubit] = true;
+        continue;
+      }
+      block.push_back(i);
+      block_qubits = qubits;
+      unfused_cost += get_cost(op);
+      savings.push_back(unfused_cost - gemm_cost(block_qubits.size()));
+    }
+
+    // Fuse the prefix of the block with the largest saving
+    const auto best = std::max_element(savings.rbegin(), savings.rend());
+    const size_t length = (*best > 0.) ? std::distance(best, savings.rend()) : 1;
+    std::vector<op_t> block_ops;
+    for (size_t j = 0; j < length; ++j) {
+      block_ops.push_back(ops[block[j]]);
+      done[block[j] - fusion_start] = true;
+    }
+    if (length > 1) {
+      fused_ops.push_back(generate_block_operation(block_ops));
+      applied = true;
+    } else {
+      fused_ops.push_back(block_ops[0]);
+    }
+  }
+
+  if (!applied)
+    return false;
+
+  for (int i = fusion_start; i < fusion_end; ++i) {
+    const size_t j = i - fusion_start;
+    if (j < fused_ops.size())
+      ops[i] = fused_ops[j];
+    else
+      ops[i].name = "nop";
+  }
+  return true;
+}
+
+op_t Fusion::generate_block_operation(const std::vector<op_t>& fusioned_ops) const {
+
+  reg_t sorted_qubits;
+  for (const op_t& op: fusioned_ops)
+    for (const uint_t qubit: op.qubits)
+      if (std::find(sorted_qubits.begin(), sorted_qubits.end(), qubit) == sorted_qubits.end())
+        sorted_qubits.push_back(qubit);
+  std::sort(sorted_qubits.begin(), sorted_qubits.end());
+
+  // Multiply the matrices of the instructions relabelled to the positions
+  // of their qubits into an identity matrix
+  QV::UnitaryMatrix<double> U(sorted_qubits.size());
+  U.initialize();
+  for (const op_t& op: fusioned_ops) {
+    reg_t qubits;
+    for (const uint_t qubit: op.qubits)
+      qubits.push_back(std::distance(sorted_qubits.begin(),
+                                     std::find(sorted_qubits.begin(), sorted_qubits.end(), qubit)));
+    U.apply_matrix(qubits, Utils::vectorize_matrix(matrix(op)));
+  }
+
+  return Operations::make_fusion(sorted_qubits, U.matrix(), fusioned_ops);
+}
+
+double Fusion::gemm_cost(const uint_t num_qubits) const {
+  if (num_qubits >= gemm_min_qubit_)
+    return pow(2., num_qubits - 3.);
+  return std::max(1., pow(2., num_qubits - 2.));
+}
+
 op_t Fusion::generate_fusion_operation(const std::vector<op_t>& fusioned_ops) const {
 
   std::vector<reg_t> regs;
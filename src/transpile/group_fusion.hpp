@@ -0,0 +1,166 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_transpile_group_fusion_hpp_
+#define _aer_transpile_group_fusion_hpp_
+
+#include <algorithm>
+
+#include "transpile/circuitopt.hpp"
+
+namespace AER {
+namespace Transpile {
+
+/*
+ * Base class of the passes that replace groups of adjacent instructions on
+ * at most max_qubit_ qubits by a single instruction. The groups are chosen
+ * by dynamic programming over each run of fusable instructions, minimizing
+ * the sum of the estimated costs of the instructions left in the circuit.
+ * Derived classes define which instructions can be fused, the costs, and
+ * the instruction replacing a group.
+ */
+class GroupFusion : public CircuitOptimization {
+public:
+  GroupFusion(uint_t max_qubit, uint_t threshold):
+      max_qubit_(max_qubit), threshold_(threshold) {}
+
+protected:
+  // Fuse the groups of the cheapest path of every run of fusable
+  // instructions, and remove the fused instructions. Return true if any
+  // group was fused.
+  bool fuse_operations(std::vector<Operations::Op>& ops) const;
+
+  // Return true if the instruction can be part of a group
+  virtual bool can_apply_fusion(const Operations::Op& op) const = 0;
+
+  // Return true if a group containing the instruction may be fused. A
+  // group is only fused if this is true for one of its instructions.
+  virtual bool is_fusion_target(const Operations::Op& op) const {
+    (void)op;
+    return true;
+  }
+
+  // Estimated cost of the fused instruction on num_qubits qubits
+  virtual double get_cost(uint_t num_qubits) const = 0;
+
+  // Estimated cost of an unfused instruction
+  virtual double get_cost(const Operations::Op& op) const = 0;
+
+  // Return the instruction replacing a group of instructions
+  virtual Operations::Op generate_fusion(const std::vector<Operations::Op>& fusioned_ops) const = 0;
+
+  uint_t max_qubit_;
+  uint_t threshold_;
+
+private:
+  // Fuse the instructions of a range without non-fusable instructions
+  bool aggregate_operations(std::vector<Operations::Op>& ops,
+                            const int fusion_start, const int fusion_end) const;
+};
+
+bool GroupFusion::fuse_operations(std::vector<Operations::Op>& ops) const {
+
+  bool applied = false;
+  uint_t fusion_start = 0;
+  for (uint_t op_idx = 0; op_idx < ops.size(); ++op_idx) {
+    if (!can_apply_fusion(ops[op_idx])) {
+      applied |= fusion_start != op_idx && aggregate_operations(ops, fusion_start, op_idx);
+      fusion_start = op_idx + 1;
+    }
+  }
+
+  if (fusion_start < ops.size()
+      && aggregate_operations(ops, fusion_start, ops.size()))
+      applied = true;
+
+  if (!applied)
+    return false;
+
+  size_t idx = 0;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    if (ops[i].name != "nop") {
+      if (i != idx)
+        ops[idx] = std::move(ops[i]);
+      ++idx;
+    }
+  }
+
+  if (idx != ops.size())
+    ops.erase(ops.begin() + idx, ops.end());
+
+  return true;
+}
+
+bool GroupFusion::aggregate_operations(std::vector<Operations::Op>& ops,
+                                       const int fusion_start,
+                                       const int fusion_end) const {
+
+  // costs[i]: estimated cost to execute from fusion_start-th to i-th in ops
+  std::vector<double> costs;
+  // fusion_to[i]: first instruction of the group ending at the i-th
+  std::vector<int> fusion_to;
+
+  bool applied = false;
+  for (int i = fusion_start; i < fusion_end; ++i) {
+    const double before = (i == fusion_start) ? 0. : costs[i - 1 - fusion_start];
+    fusion_to.push_back(i);
+    costs.push_back(before + get_cost(ops[i]));
+
+    // Groups from j-th to i-th containing a target within max_qubit_ qubits
+    reg_t fusion_qubits = ops[i].qubits;
+    bool target = is_fusion_target(ops[i]);
+    for (int j = i - 1; j >= fusion_start; --j) {
+      for (const uint_t qubit: ops[j].qubits)
+        if (std::find(fusion_qubits.begin(), fusion_qubits.end(), qubit) == fusion_qubits.end())
+          fusion_qubits.push_back(qubit);
+      if (fusion_qubits.size() > max_qubit_)
+        break;
+      target |= is_fusion_target(ops[j]);
+      if (!target)
+        continue;
+      const double estimated_cost = get_cost(fusion_qubits.size())
+          + (j == fusion_start ? 0. : costs[j - 1 - fusion_start]);
+      if (estimated_cost < costs[i - fusion_start]) {
+        costs[i - fusion_start] = estimated_cost;
+        fusion_to[i - fusion_start] = j;
+        applied = true;
+      }
+    }
+  }
+
+  if (!applied)
+    return false;
+
+  // Replace each group of the cheapest path by a single instruction
+  for (int i = fusion_end - 1; i >= fusion_start;) {
+    const int to = fusion_to[i - fusion_start];
+    if (to != i) {
+      std::vector<Operations::Op> fusioned_ops;
+      for (int j = to; j <= i; ++j) {
+        fusioned_ops.push_back(std::move(ops[j]));
+        ops[j].name = "nop";
+      }
+      ops[i] = generate_fusion(fusioned_ops);
+    }
+    i = to - 1;
+  }
+
+  return true;
+}
+
+//-------------------------------------------------------------------------
+} // end namespace Transpile
+} // end namespace AER
+//-------------------------------------------------------------------------
+#endif
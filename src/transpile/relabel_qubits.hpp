@@ -0,0 +1,310 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_transpile_relabel_qubits_hpp_
+#define _aer_transpile_relabel_qubits_hpp_
+
+#include <algorithm>
+
+#include "transpile/circuitopt.hpp"
+
+namespace AER {
+namespace Transpile {
+
+// Gates acting on high qubits of a state vector access memory with large
+// strides and are slower than gates acting on low qubits. This pass keeps
+// the most frequently used qubits of each window of operations in the low
+// ("local") bit positions by exchanging them with rarely used local qubits.
+// Each change of the layout is inserted as "relabel" gates (a sequence of
+// SWAPs applied in a single pass over the state) and the following
+// operations are remapped to the new layout. The original layout is
+// restored before any operation that returns the full state.
+class RelabelQubits : public CircuitOptimization {
+public:
+  // constructor
+  RelabelQubits(uint_t local_qubits = 12, uint_t window = 1000, double cost_factor = 2.0);
+
+  /*
+   * RelabelQubits uses following configuration options
+   *   - relabel_verbose (bool): if true, output generated operations in metadata (default: false)
+   *   - relabel_enable (bool): if true, activate relabel optimization (default: false)
+   *   - relabel_local_qubits (int): number of low qubit positions that gates are moved to (default: 12)
+   *   - relabel_window (int): number of operations analysed for each layout (default: 1000)
+   *   - relabel_cost_factor (double): cost of a relabel gate relative to the gain of moving
+   *     one gate to a local qubit (default: 2.0)
+  */
+  void set_config(const json_t &config) override;
+
+  void optimize_circuit(Circuit& circ,
+                        Noise::NoiseModel& noise,
+                        const Operations::OpSet &opset,
+                        OutputData &data) const override;
+
+private:
+  // check this optimization can be applied
+  bool can_apply(const Circuit& circ) const;
+
+  // check this optimization can be applied
+  bool can_apply(const Operations::Op& op) const;
+
+  // check if an operation needs the original qubit layout
+  bool requires_layout(const Operations::Op& op) const;
+
+  // Exchange pairs of physical qubits that move the most used qubits of
+  // the window [start, end) to local positions. Returns an empty list if the
+  // estimated gain does not exceed the cost of the relabel gates.
+  reg_t choose_swaps(const std::vector<Operations::Op>& ops,
+                     const size_t start, const size_t end,
+                     const reg_t& physical, const reg_t& logical) const;
+
+  // Swaps that restore the original layout
+  reg_t restore_swaps(const reg_t& logical) const;
+
+  // Append relabel gates for a sequence of swaps and update the layout
+  void add_swaps(const reg_t& swaps,
+                 reg_t& physical, reg_t& logical,
+                 std::vector<Operations::Op>& ops) const;
+
+  // remap qubits in an operation
+  void remap_qubits(Operations::Op& op, const reg_t& physical) const;
+
+  uint_t local_qubits_;
+  uint_t window_;
+  double cost_factor_;
+
+  // number of swaps in a single relabel gate
+  const uint_t max_swaps_ = 3;
+
+  // show debug info
+  bool verbose_ = false;
+
+  // disabled in config
+  bool active_ = false;
+};
+
+RelabelQubits::RelabelQubits(uint_t local_qubits, uint_t window, double cost_factor):
+    local_qubits_(local_qubits), window_(window), cost_factor_(cost_factor) {
+}
+
+void RelabelQubits::set_config(const json_t &config) {
+
+  CircuitOptimization::set_config(config);
+
+  if (JSON::check_key("relabel_verbose", config_))
+    JSON::get_value(verbose_, "relabel_verbose", config_);
+
+  if (JSON::check_key("relabel_enable", config_))
+    JSON::get_value(active_, "relabel_enable", config_);
+
+  if (JSON::check_key("relabel_local_qubits", config_))
+    JSON::get_value(local_qubits_, "relabel_local_qubits", config_);
+
+  if (JSON::check_key("relabel_window", config_))
+    JSON::get_value(window_, "relabel_window", config_);
+
+  if (JSON::check_key("relabel_cost_factor", config_))
+    JSON::get_value(cost_factor_, "relabel_cost_factor", config_);
+
+  // The initial state is given in the original layout
+  if (JSON::check_key("initial_statevector", config_))
+    active_ = false;
+}
+
+void RelabelQubits::optimize_circuit(Circuit& circ,
+                                     Noise::NoiseModel& noise,
+                                     const Operations::OpSet &allowed_opset,
+                                     OutputData &data) const {
+
+  // Relabel gates are only supported by the statevector method, and noise
+  // must already have been sampled into the circuit
+  if (!active_
+      || circ.num_qubits <= local_qubits_
+      || window_ == 0
+      || !noise.is_ideal()
+      || allowed_opset.gates.find("relabel") == allowed_opset.gates.end()
+      || !can_apply(circ))
+    return;
+
+  // physical[q] is the position of qubit q and logical[p] the qubit at position p
+  reg_t physical(circ.num_qubits);
+  for (uint_t q = 0; q < circ.num_qubits; ++q)
+    physical[q] = q;
+  reg_t logical = physical;
+
+  bool applied = false;
+  std::vector<Operations::Op> ops;
+  ops.reserve(circ.ops.size());
+
+  for (size_t start = 0; start < circ.ops.size(); start += window_) {
+    const size_t end = std::min<size_t>(start + window_, circ.ops.size());
+
+    const reg_t swaps = choose_swaps(circ.ops, start, end, physical, logical);
+    if (!swaps.empty()) {
+      add_swaps(swaps, physical, logical, ops);
+      applied = true;
+    }
+
+    for (size_t i = start; i < end; ++i) {
+      if (requires_layout(circ.ops[i]))
+        add_swaps(restore_swaps(logical), physical, logical, ops);
+      ops.push_back(circ.ops[i]);
+      remap_qubits(ops.back(), physical);
+    }
+  }
+
+  if (!applied)
+    return;
+
+  circ.ops = std::move(ops);
+
+  if (verbose_)
+    data.add_additional_data("metadata",
+                             json_t::object({{"relabel_verbose", circ.ops}}));
+}
+
+reg_t RelabelQubits::choose_swaps(const std::vector<Operations::Op>& ops,
+                                  const size_t start, const size_t end,
+                                  const reg_t& physical, const reg_t& logical) const {
+  const uint_t num_qubits = physical.size();
+
+  // Number of operations acting on each qubit in the window
+  std::vector<uint_t> counts(num_qubits, 0);
+  for (size_t i = start; i < end; ++i) {
+    const Operations::Op& op = ops[i];
+    switch (op.type) {
+      case Operations::OpType::gate:
+      case Operations::OpType::matrix:
+      case Operations::OpType::multiplexer:
+      case Operations::OpType::pauli_rotation:
+      case Operations::OpType::kraus:
+        for (const uint_t qubit: op.qubits)
+          counts[qubit]++;
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Candidates for moving in are used non-local qubits in descending order,
+  // candidates for moving out are local qubits in ascending order of use
+  const auto cmp_desc = [&counts](uint_t a, uint_t b) {return counts[a] > counts[b];};
+  const auto cmp_asc = [&counts](uint_t a, uint_t b) {return counts[a] < counts[b];};
+  reg_t incoming(logical.begin() + local_qubits_, logical.end());
+  reg_t outgoing(logical.begin(), logical.begin() + local_qubits_);
+  std::stable_sort(incoming.begin(), incoming.end(), cmp_desc);
+  std::stable_sort(outgoing.begin(), outgoing.end(), cmp_asc);
+
+  reg_t swaps;
+  uint_t gain = 0;
+  for (size_t i = 0; i < incoming.size() && i < outgoing.size(); ++i) {
+    if (counts[incoming[i]] <= counts[outgoing[i]])
+      break;
+    gain += counts[incoming[i]] - counts[outgoing[i]];
+    swaps.push_back(physical[outgoing[i]]);
+    swaps.push_back(physical[incoming[i]]);
+  }
+
+  const uint_t num_gates = (swaps.size() / 2 + max_swaps_ - 1) / max_swaps_;
+  if (gain <= cost_factor_ * num_gates)
+    swaps.clear();
+  return swaps;
+}
+
+reg_t RelabelQubits::restore_swaps(const reg_t& logical) const {
+  reg_t layout = logical;
+  reg_t swaps;
+  for (uint_t pos = 0; pos < layout.size(); ++pos) {
+    while (layout[pos] != pos) {
+      const uint_t target = layout[pos];
+      swaps.push_back(pos);
+      swaps.push_back(target);
+      std::swap(layout[pos], layout[target]);
+    }
+  }
+  return swaps;
+}
+
+void RelabelQubits::add_swaps(const reg_t& swaps,
+                              reg_t& physical, reg_t& logical,
+                              std::vector<Operations::Op>& ops) const {
+  const uint_t num_swaps = swaps.size() / 2;
+  for (uint_t i = 0; i < num_swaps; i += max_swaps_) {
+    Operations::Op op;
+    op.type = Operations::OpType::gate;
+    op.name = "relabel";
+    const uint_t last = std::min(num_swaps, i + max_swaps_);
+    op.qubits.assign(swaps.begin() + 2 * i, swaps.begin() + 2 * last);
+    ops.push_back(op);
+  }
+  for (uint_t i = 0; i < num_swaps; ++i) {
+    const uint_t pos0 = swaps[2 * i];
+    const uint_t pos1 = swaps[2 * i + 1];
+    std::swap(logical[pos0], logical[pos1]);
+    physical[logical[pos0]] = pos0;
+    physical[logical[pos1]] = pos1;
+  }
+}
+
+void RelabelQubits::remap_qubits(Operations::Op& op, const reg_t& physical) const {
+  for (uint_t& qubit: op.qubits)
+    qubit = physical[qubit];
+  for (reg_t& reg: op.regs)
+    for (uint_t& qubit: reg)
+      qubit = physical[qubit];
+  for (auto& component: op.params_expval_matrix)
+    for (auto& mat: component.second)
+      for (uint_t& qubit: mat.first)
+        qubit = physical[qubit];
+}
+
+bool RelabelQubits::can_apply(const Circuit& circ) const {
+  for (const Operations::Op& op: circ.ops)
+    if (!can_apply(op))
+      return false;
+  return true;
+}
+
+bool RelabelQubits::can_apply(const Operations::Op& op) const {
+  switch (op.type) {
+  case Operations::OpType::snapshot: {
+    const stringset_t allowed({
+      "statevector",
+      "memory",
+      "register",
+      "probabilities",
+      "probabilities_with_variance",
+      "expectation_value_pauli",
+      "expectation_value_pauli_with_variance",
+      "expectation_value_pauli_single_shot",
+      "expectation_value_matrix",
+      "expectation_value_matrix_with_variance",
+      "expectation_value_matrix_single_shot",
+      "expectation_value_pauli_gradient"
+    });
+    return allowed.find(op.name) != allowed.end();
+  }
+  default:
+    return true;
+  }
+}
+
+bool RelabelQubits::requires_layout(const Operations::Op& op) const {
+  return op.type == Operations::OpType::snapshot && op.name == "statevector";
+}
+
+//-------------------------------------------------------------------------
+} // end namespace Transpile
+} // end namespace AER
+//-------------------------------------------------------------------------
+#endif
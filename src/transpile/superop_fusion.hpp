@@ -0,0 +1,185 @@
+/**
+ * This code is part of Qiskit.
+ *
+ * (C) Copyright IBM 2018, 2019.
+ *
+ * This code is licensed under the Apache License, Version 2.0. You may
+ * obtain a copy of this license in the LICENSE.txt file in the root directory
+ * of this source tree or at http://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Any modifications or derivative works of this code must retain this
+ * copyright notice, and modified files need to carry a notice indicating
+ * that they have been altered from the originals.
+ */
+
+#ifndef _aer_transpile_superop_fusion_hpp_
+#define _aer_transpile_superop_fusion_hpp_
+
+#include <algorithm>
+#include <cmath>
+
+#include "transpile/fusion.hpp"
+#include "transpile/group_fusion.hpp"
+#include "simulators/superoperator/superoperator_state.hpp"
+
+namespace AER {
+namespace Transpile {
+
+using uint_t = uint_t;
+using op_t = Operations::Op;
+using optype_t = Operations::OpType;
+using oplist_t = std::vector<op_t>;
+using opset_t = Operations::OpSet;
+using reg_t = std::vector<uint_t>;
+
+class SuperopFusion : public GroupFusion {
+public:
+  SuperopFusion(uint_t max_qubit = 2, uint_t threshold = 5);
+
+  /*
+   * Superoperator fusion replaces groups of adjacent instructions that
+   * contain a Kraus channel or superoperator by a single superop
+   * instruction, for simulators that support superop instructions and
+   * apply every instruction as a sweep over a density matrix. Gates
+   * and matrices before and after a channel on the same qubits are
+   * absorbed into its superoperator. The groups are chosen by minimizing
+   * the estimated cost of the sweeps over the density matrix, where an
+   * n-qubit superoperator is a dense 2n-qubit matrix: sweeps of up to 2
+   * such qubits are limited by memory bandwidth and cost the same, each
+   * further qubit doubles the cost, and diagonal and permutation gates
+   * cost a quarter of a sweep.
+   *
+   * Superoperator fusion uses following configuration options
+   *   - superop_fusion_enable (bool): if true, activate superoperator fusion (default: true)
+   *   - superop_fusion_max_qubit (int): maximum number of qubits of a fused superop (default: 2)
+   *   - superop_fusion_threshold (int): number of qubits of a circuit to activate superoperator fusion (default: 5)
+   *   - fusion_verbose (bool): if true, output generated instructions in metadata (default: false)
+   */
+  void set_config(const json_t &config) override;
+
+  void optimize_circuit(Circuit& circ,
+                        Noise::NoiseModel& noise,
+                        const opset_t &opset,
+                        OutputData &data) const override;
+
+private:
+  // Return true if the instruction can be part of a fused superop
+  bool can_apply_fusion(const op_t& op) const override;
+
+  // Return true if the instruction is a Kraus channel or superoperator
+  bool is_channel(const op_t& op) const {
+    return op.type == optype_t::kraus || op.type == optype_t::superop;
+  }
+
+  // Only groups containing a channel are fused
+  bool is_fusion_target(const op_t& op) const override {
+    return is_channel(op);
+  }
+
+  // Estimated cost of the sweep of a dense superoperator on num_qubits
+  // qubits
+  double get_cost(uint_t num_qubits) const override {
+    return std::max(1., std::pow(2., 2. * num_qubits - 2.));
+  }
+
+  // Estimated cost of the sweep of an instruction
+  double get_cost(const op_t& op) const override {
+    return Fusion::is_diagonal_or_permutation(op) ? 0.25 : get_cost(op.qubits.size());
+  }
+
+  // Return a superop instruction for a group of instructions
+  op_t generate_fusion(const std::vector<op_t>& fusioned_ops) const override;
+
+  bool verbose_ = false;
+  bool active_ = true;
+
+  // Gates supported by the superoperator simulator
+  const stringset_t supported_gates_ = QubitSuperoperator::State<>().allowed_gates();
+};
+
+SuperopFusion::SuperopFusion(uint_t max_qubit, uint_t threshold):
+    GroupFusion(max_qubit, threshold) {
+}
+
+void SuperopFusion::set_config(const json_t &config) {
+
+  CircuitOptimization::set_config(config);
+
+  if (JSON::check_key("fusion_verbose", config_))
+    JSON::get_value(verbose_, "fusion_verbose", config_);
+
+  if (JSON::check_key("superop_fusion_enable", config_))
+    JSON::get_value(active_, "superop_fusion_enable", config_);
+
+  if (JSON::check_key("superop_fusion_max_qubit", config_))
+    JSON::get_value(max_qubit_, "superop_fusion_max_qubit", config_);
+
+  if (JSON::check_key("superop_fusion_threshold", config_))
+    JSON::get_value(threshold_, "superop_fusion_threshold", config_);
+}
+
+void SuperopFusion::optimize_circuit(Circuit& circ,
+                                     Noise::NoiseModel&,
+                                     const opset_t &allowed_opset,
+                                     OutputData &data) const {
+
+  if (!active_ || circ.num_qubits < threshold_ ||
+      allowed_opset.optypes.count(optype_t::superop) == 0)
+    return;
+
+  if (std::none_of(circ.ops.begin(), circ.ops.end(),
+                   [this](const op_t& op) {return is_channel(op);}))
+    return;
+
+  if (fuse_operations(circ.ops) && verbose_)
+    data.add_additional_data("metadata",
+                             json_t::object({{"superop_fusion_verbose", circ.ops}}));
+}
+
+bool SuperopFusion::can_apply_fusion(const op_t& op) const {
+  if (op.conditional || op.qubits.size() > max_qubit_)
+    return false;
+  switch (op.type) {
+  case optype_t::gate:
+    return supported_gates_.count(op.name) > 0;
+  case optype_t::matrix:
+    return op.mats.size() == 1;
+  case optype_t::kraus:
+  case optype_t::superop:
+    return true;
+  default:
+    return false;
+  }
+}
+
+op_t SuperopFusion::generate_fusion(const std::vector<op_t>& fusioned_ops) const {
+
+  reg_t qubits;
+  for (const op_t& op: fusioned_ops)
+    for (const uint_t qubit: op.qubits)
+      if (std::find(qubits.begin(), qubits.end(), qubit) == qubits.end())
+        qubits.push_back(qubit);
+  std::sort(qubits.begin(), qubits.end());
+
+  // Apply the instructions relabelled to the positions of their qubits
+  // to an identity superoperator
+  std::vector<op_t> local_ops(fusioned_ops);
+  for (op_t& op: local_ops)
+    for (uint_t& qubit: op.qubits)
+      qubit = std::distance(qubits.begin(),
+                            std::find(qubits.begin(), qubits.end(), qubit));
+
+  QubitSuperoperator::State<> superop;
+  superop.initialize_qreg(qubits.size());
+  OutputData data;
+  RngEngine rng(0);
+  superop.apply_ops(local_ops, data, rng);
+
+  return Operations::make_superop(qubits, superop.qreg().matrix());
+}
+
+//-------------------------------------------------------------------------
+} // end namespace Transpile
+} // end namespace AER
+//-------------------------------------------------------------------------
+#endif
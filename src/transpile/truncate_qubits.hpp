@@ -207,7 +207,8 @@ bool TruncateQubits::can_apply(const Operations::Op& op) const {
       "probabilities",
       "probabilities_with_variance",
       "expectation_value_pauli",
-      "expectation_value_pauli_with_variance"
+      "expectation_value_pauli_with_variance",
+      "expectation_value_pauli_gradient"
     });
     return allowed.find(op.name) != allowed.end();
   }
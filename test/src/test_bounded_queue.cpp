@@ -0,0 +1,71 @@
+#define CATCH_CONFIG_MAIN
+#include <thread>
+#include <vector>
+#include <catch.hpp>
+#include "framework/bounded_queue.hpp"
+
+namespace AER{
+namespace Test{
+
+TEST_CASE( "Bounded queue", "[bounded_queue]" ) {
+
+    SECTION( "Items are taken in order" ) {
+        BoundedQueue<int> queue(3);
+        REQUIRE(queue.capacity() == 3);
+        for (int j = 0; j < 3; j++)
+            REQUIRE(queue.push(int(j)));
+        REQUIRE(queue.size() == 3);
+        int item = -1;
+        for (int j = 0; j < 3; j++) {
+            REQUIRE(queue.pop(item));
+            REQUIRE(item == j);
+        }
+        REQUIRE(queue.size() == 0);
+    }
+
+    SECTION( "Closing fails pushes and pops once empty" ) {
+        BoundedQueue<int> queue(2);
+        REQUIRE(queue.push(1));
+        queue.close();
+        REQUIRE(queue.closed());
+        REQUIRE(!queue.push(2));
+        int item = 0;
+        REQUIRE(queue.pop(item));
+        REQUIRE(item == 1);
+        REQUIRE(!queue.pop(item));
+    }
+
+    SECTION( "Producer and consumer threads exchange all items in order" ) {
+        const int n = 10000;
+        BoundedQueue<std::vector<int>> queue(4);
+        std::thread producer([&]() {
+            for (int j = 0; j < n; j++)
+                queue.push(std::vector<int>(1 + j % 7, j));
+        });
+        bool in_order = true;
+        std::vector<int> item;
+        for (int j = 0; j < n; j++) {
+            REQUIRE(queue.pop(item));
+            in_order &= (item.size() == size_t(1 + j % 7) && item.back() == j);
+            REQUIRE(queue.size() <= queue.capacity());
+        }
+        producer.join();
+        REQUIRE(in_order);
+    }
+
+    SECTION( "Closing releases a blocked producer" ) {
+        BoundedQueue<int> queue(1);
+        REQUIRE(queue.push(0));
+        bool pushed = true;
+        std::thread producer([&]() {pushed = queue.push(1);});
+        queue.close();
+        producer.join();
+        REQUIRE(!pushed);
+    }
+}
+
+//------------------------------------------------------------------------------
+} // end namespace Test
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
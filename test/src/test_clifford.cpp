@@ -0,0 +1,154 @@
+#define CATCH_CONFIG_MAIN
+#include <random>
+#include <string>
+#include <vector>
+#include <catch.hpp>
+#include "framework/json.hpp"
+#include "framework/operations.hpp"
+#include "framework/types.hpp"
+#include "framework/utils.hpp"
+#include "simulators/stabilizer/stabilizer_state.hpp"
+#include "transpile/clifford_fusion.hpp"
+
+namespace AER{
+namespace Test{
+
+namespace {
+
+const std::vector<std::string> one_qubit_gates = {"x", "y", "z", "h", "s", "sdg"};
+const std::vector<std::string> two_qubit_gates = {"cx", "cz", "swap"};
+
+Operations::Op gate(const std::string &name, const reg_t &qubits) {
+    return Operations::json_to_op({{"name", name}, {"qubits", qubits}});
+}
+
+// Return the gates of a random Clifford circuit on num_qubits qubits
+std::vector<Operations::Op> random_gates(uint_t num_qubits, uint_t size, std::mt19937 &rng) {
+    std::uniform_int_distribution<uint_t> qubit(0, num_qubits - 1);
+    std::vector<Operations::Op> ops;
+    while (ops.size() < size) {
+        const uint_t q0 = qubit(rng), q1 = qubit(rng);
+        if (rng() % 2)
+            ops.push_back(gate(one_qubit_gates[rng() % one_qubit_gates.size()], {q0}));
+        else if (q0 != q1)
+            ops.push_back(gate(two_qubit_gates[rng() % two_qubit_gates.size()], {q0, q1}));
+    }
+    return ops;
+}
+
+// Return the state after applying the operations to |0...0>
+Stabilizer::State run(uint_t num_qubits, const std::vector<Operations::Op> &ops) {
+    Stabilizer::State state;
+    state.initialize_qreg(num_qubits);
+    state.initialize_creg(0, 0);
+    OutputData data;
+    RngEngine rng(0);
+    state.apply_ops(ops, data, rng);
+    return state;
+}
+
+// Require that the states have the same tableau, with signs
+void require_equal_tableau(const Stabilizer::State &state0, const Stabilizer::State &state1) {
+    const auto &table0 = state0.qreg().table();
+    const auto &table1 = state1.qreg().table();
+    REQUIRE(table0.size() == table1.size());
+    for (size_t row = 0; row < table0.size(); row++) {
+        REQUIRE(table0[row].str() == table1[row].str());
+        REQUIRE(state0.qreg().phases()[row] == state1.qreg().phases()[row]);
+    }
+}
+
+} // end anonymous namespace
+
+TEST_CASE( "Clifford instructions", "[clifford]" ) {
+    const uint_t num_qubits = 5;
+    std::mt19937 rng(13);
+    const auto prefix = random_gates(num_qubits, 40, rng);
+
+    SECTION( "Clifford matrices have the tableau of their gates" ) {
+        std::vector<std::pair<std::string, reg_t>> gates;
+        for (const auto &name : one_qubit_gates)
+            gates.push_back({name, {3}});
+        for (const auto &name : two_qubit_gates)
+            gates.push_back({name, {3, 1}});
+        for (const auto &item : gates) {
+            auto ops = prefix;
+            ops.push_back(gate(item.first, item.second));
+            json_t js = {{"name", "clifford"}, {"qubits", item.second}};
+            js["params"] = {Utils::Matrix::from_name(item.first)};
+            auto clifford_ops = prefix;
+            clifford_ops.push_back(Operations::json_to_op(js));
+            require_equal_tableau(run(num_qubits, ops), run(num_qubits, clifford_ops));
+        }
+    }
+
+    SECTION( "Clifford labels have the tableau of their gates" ) {
+        // CX with control 2 and target 0 followed by S on qubit 0
+        auto ops = prefix;
+        ops.push_back(gate("cx", {2, 0}));
+        ops.push_back(gate("s", {0}));
+        const json_t js = {{"name", "clifford"}, {"qubits", {0, 2}},
+                           {"destabilizers", {"YI", "YX"}},
+                           {"stabilizers", {"ZZ", "+IZ"}}};
+        auto clifford_ops = prefix;
+        clifford_ops.push_back(Operations::json_to_op(js));
+        require_equal_tableau(run(num_qubits, ops), run(num_qubits, clifford_ops));
+
+        // Y maps X and Z to -X and -Z
+        ops = prefix;
+        ops.push_back(gate("y", {4}));
+        const json_t js_y = {{"name", "clifford"}, {"qubits", {4}},
+                             {"destabilizers", {"-X"}}, {"stabilizers", {"-Z"}}};
+        clifford_ops = prefix;
+        clifford_ops.push_back(Operations::json_to_op(js_y));
+        require_equal_tableau(run(num_qubits, ops), run(num_qubits, clifford_ops));
+    }
+
+    SECTION( "Clifford instructions on too many qubits are rejected" ) {
+        const uint_t size = Operations::max_clifford_qubits + 1;
+        reg_t qubits;
+        std::vector<std::string> destabilizers, stabilizers;
+        for (uint_t q = 0; q < size; q++) {
+            qubits.push_back(q);
+            std::string label(size, 'I');
+            label[q] = 'X';
+            destabilizers.push_back(label);
+            label[q] = 'Z';
+            stabilizers.push_back(label);
+        }
+        const json_t js = {{"name", "clifford"}, {"qubits", qubits},
+                           {"destabilizers", destabilizers}, {"stabilizers", stabilizers}};
+        REQUIRE_THROWS_AS(Operations::json_to_op(js), std::invalid_argument);
+    }
+}
+
+TEST_CASE( "Clifford fusion", "[clifford][fusion]" ) {
+    const uint_t num_qubits = 6;
+    std::mt19937 rng(29);
+    Transpile::CliffordFusion fusion;
+    Operations::OpSet opset;
+    opset.optypes.insert(Operations::OpType::clifford);
+
+    for (const uint_t max_qubit : {2, 3}) {
+        fusion.set_config({{"clifford_fusion_threshold", 1},
+                           {"clifford_fusion_max_qubit", max_qubit}});
+        const auto ops = random_gates(num_qubits, 200, rng);
+        Circuit circ(ops);
+        Noise::NoiseModel noise;
+        OutputData data;
+        fusion.optimize_circuit(circ, noise, opset, data);
+
+        uint_t cliffords = 0;
+        for (const auto &op : circ.ops)
+            cliffords += (op.type == Operations::OpType::clifford);
+        REQUIRE(cliffords > 0);
+        REQUIRE(circ.ops.size() < ops.size());
+        require_equal_tableau(run(num_qubits, ops), run(num_qubits, circ.ops));
+    }
+}
+
+//------------------------------------------------------------------------------
+} // end namespace Test
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
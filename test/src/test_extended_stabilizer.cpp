@@ -0,0 +1,337 @@
+#define CATCH_CONFIG_MAIN
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <catch.hpp>
+#include "framework/rng.hpp"
+#include "framework/types.hpp"
+#include "simulators/extended_stabilizer/ch_runner.hpp"
+
+namespace AER{
+namespace Test{
+
+namespace {
+
+using CHSimulator::Gates;
+using CHSimulator::StabilizerState;
+
+struct Gate {
+    std::string name;
+    reg_t qubits;
+    double param;
+};
+
+const std::vector<std::string> one_qubit_gates = {"h", "s", "sdg", "x", "y", "z", "t", "tdg", "u1"};
+const std::vector<std::string> two_qubit_gates = {"cx", "cz", "swap"};
+const std::vector<std::string> three_qubit_gates = {"ccx", "ccz"};
+
+// Return a random circuit on num_qubits qubits, starting with a layer of
+// Hadamard gates
+std::vector<Gate> random_circuit(uint_t num_qubits, uint_t size, std::mt19937 &rng) {
+    std::vector<Gate> gates;
+    for (uint_t q = 0; q < num_qubits; q++)
+        gates.push_back({"h", {q}, 0.});
+    std::uniform_int_distribution<uint_t> qubit(0, num_qubits - 1);
+    std::uniform_real_distribution<double> angle(-4., 4.);
+    while (gates.size() < size) {
+        const uint_t q0 = qubit(rng), q1 = qubit(rng), q2 = qubit(rng);
+        switch (rng() % 4) {
+            case 0:
+            case 1:
+                gates.push_back({one_qubit_gates[rng() % one_qubit_gates.size()], {q0}, angle(rng)});
+                break;
+            case 2:
+                if (q0 != q1)
+                    gates.push_back({two_qubit_gates[rng() % two_qubit_gates.size()], {q0, q1}, 0.});
+                break;
+            default:
+                if (q0 != q1 && q0 != q2 && q1 != q2)
+                    gates.push_back({three_qubit_gates[rng() % three_qubit_gates.size()], {q0, q1, q2}, 0.});
+                break;
+        }
+    }
+    return gates;
+}
+
+// Apply the gates to the decomposition of the runner
+void apply(CHSimulator::Runner &runner, const std::vector<Gate> &gates, RngEngine &rng) {
+    for (const auto &gate : gates) {
+        const reg_t &q = gate.qubits;
+        if (gate.name == "h") runner.apply_h(q[0]);
+        else if (gate.name == "s") runner.apply_s(q[0]);
+        else if (gate.name == "sdg") runner.apply_sdag(q[0]);
+        else if (gate.name == "x") runner.apply_x(q[0]);
+        else if (gate.name == "y") runner.apply_y(q[0]);
+        else if (gate.name == "z") runner.apply_z(q[0]);
+        else if (gate.name == "t") runner.apply_t(q[0], rng);
+        else if (gate.name == "tdg") runner.apply_tdag(q[0], rng);
+        else if (gate.name == "u1") runner.apply_u1(q[0], gate.param, rng);
+        else if (gate.name == "cx") runner.apply_cx(q[0], q[1]);
+        else if (gate.name == "cz") runner.apply_cz(q[0], q[1]);
+        else if (gate.name == "swap") runner.apply_swap(q[0], q[1]);
+        else if (gate.name == "ccx") runner.apply_ccx(q[0], q[1], q[2], rng);
+        else if (gate.name == "ccz") runner.apply_ccz(q[0], q[1], q[2], rng);
+    }
+}
+
+// Decomposition stored as a vector of StabilizerState, with the gates
+// applied one state at a time. The branches of the non-Clifford gates are
+// sampled in the order of the states, as in the runner.
+struct ReferenceDecomposition {
+    std::vector<StabilizerState> states;
+    std::vector<complex_t> coefficients;
+
+    ReferenceDecomposition(uint_t num_qubits, uint_t num_states)
+        : states(num_states, StabilizerState(num_qubits)),
+          coefficients(num_states, complex_t(1., 0.)) {}
+
+    void apply_u1(StabilizerState &state, complex_t &coeff, uint_t qubit,
+                  const CHSimulator::U1Sample &sample, RngEngine &rng) {
+        const auto branch = sample.sample(rng.rand());
+        coeff *= branch.first;
+        if (branch.second == Gates::s)
+            state.S(qubit);
+        else if (branch.second == Gates::sdg)
+            state.Sdag(qubit);
+        else if (branch.second == Gates::z)
+            state.Z(qubit);
+    }
+
+    void apply_toffoli(StabilizerState &state, complex_t &coeff, const reg_t &q,
+                       bool ccz, RngEngine &rng) {
+        auto target = [&](uint_t c) {
+            if (ccz) state.CZ(c, q[2]);
+            else state.CX(c, q[2]);
+        };
+        switch (rng.rand_int(CHSimulator::ZERO, CHSimulator::TOFF_BRANCH_MAX)) {
+            case 1:
+                state.CZ(q[0], q[1]);
+                break;
+            case 2:
+                target(q[0]);
+                break;
+            case 3:
+                target(q[1]);
+                break;
+            case 4:
+                state.CZ(q[0], q[1]);
+                target(q[0]);
+                state.Z(q[0]);
+                break;
+            case 5:
+                state.CZ(q[0], q[1]);
+                target(q[1]);
+                state.Z(q[1]);
+                break;
+            case 6:
+                target(q[0]);
+                target(q[1]);
+                if (ccz) state.Z(q[2]);
+                else state.X(q[2]);
+                break;
+            case 7:
+                state.CZ(q[0], q[1]);
+                target(q[0]);
+                target(q[1]);
+                state.Z(q[0]);
+                state.Z(q[1]);
+                if (ccz) state.Z(q[2]);
+                else state.X(q[2]);
+                coeff *= -1;
+                break;
+            default:
+                break;
+        }
+    }
+
+    void apply(const std::vector<Gate> &gates, RngEngine &rng) {
+        for (const auto &gate : gates) {
+            for (size_t i = 0; i < states.size(); i++) {
+                StabilizerState &state = states[i];
+                if (state.Omega().eps == 0)
+                    continue;
+                const reg_t &q = gate.qubits;
+                if (gate.name == "h") state.H(q[0]);
+                else if (gate.name == "s") state.S(q[0]);
+                else if (gate.name == "sdg") state.Sdag(q[0]);
+                else if (gate.name == "x") state.X(q[0]);
+                else if (gate.name == "y") state.Y(q[0]);
+                else if (gate.name == "z") state.Z(q[0]);
+                else if (gate.name == "t") apply_u1(state, coefficients[i], q[0], CHSimulator::t_sample, rng);
+                else if (gate.name == "tdg") apply_u1(state, coefficients[i], q[0], CHSimulator::tdg_sample, rng);
+                else if (gate.name == "u1") apply_u1(state, coefficients[i], q[0], CHSimulator::U1Sample(gate.param), rng);
+                else if (gate.name == "cx") state.CX(q[0], q[1]);
+                else if (gate.name == "cz") state.CZ(q[0], q[1]);
+                else if (gate.name == "swap") {
+                    state.CX(q[0], q[1]);
+                    state.CX(q[1], q[0]);
+                    state.CX(q[0], q[1]);
+                }
+                else if (gate.name == "ccx") apply_toffoli(state, coefficients[i], q, false, rng);
+                else if (gate.name == "ccz") apply_toffoli(state, coefficients[i], q, true, rng);
+            }
+        }
+    }
+
+    complex_t amplitude(uint_t x) {
+        complex_t amp = 0.;
+        for (size_t i = 0; i < states.size(); i++)
+            amp += states[i].Amplitude(x).to_complex() * coefficients[i];
+        return amp;
+    }
+
+    // Metropolis sampling on the summed amplitudes, with the random draws
+    // of CHSimulator::Runner
+    std::vector<uint_t> metropolis(uint_t n_steps, uint_t n_shots, RngEngine &rng) {
+        const uint_t num_qubits = states[0].NQubits();
+        uint_t x = rng.rand_int(CHSimulator::ZERO, (1ULL << num_qubits) - 1);
+        complex_t old_amp = amplitude(x);
+        bool accept = false;
+        uint_t last_proposal = 0;
+        std::vector<uint_t> shots;
+        for (uint_t step = 0; step < n_steps + n_shots - 1; step++) {
+            const uint_t proposal = rng.rand(0ULL, num_qubits);
+            if (accept)
+                x ^= (1ULL << last_proposal);
+            const complex_t amp = amplitude(x ^ (1ULL << proposal));
+            const double p_threshold = std::norm(amp) / std::norm(old_amp);
+#ifdef __FAST_MATH__
+            const bool zero_amp = std::abs(std::norm(old_amp)) < 1e-8;
+#else
+            const bool zero_amp = std::isnan(p_threshold);
+#endif
+            accept = std::isinf(p_threshold) || zero_amp || rng.rand() < p_threshold;
+            if (accept) {
+                old_amp = amp;
+                last_proposal = proposal;
+            }
+            if (step + 1 >= n_steps)
+                shots.push_back(x);
+        }
+        return shots;
+    }
+};
+
+// Return a runner with num_states copies of |0...0>
+CHSimulator::Runner make_runner(uint_t num_qubits, uint_t num_states, uint_t threads) {
+    CHSimulator::Runner runner(num_qubits);
+    runner.initialize_omp(threads, 0);
+    runner.initialize_decomposition(num_states);
+    return runner;
+}
+
+void require_equal_amplitudes(CHSimulator::Runner &runner, ReferenceDecomposition &reference) {
+    const uint_t dim = 1ULL << runner.get_n_qubits();
+    for (uint_t x = 0; x < dim; x++) {
+        const complex_t expected = reference.amplitude(x);
+        const complex_t amp = runner.amplitude(x);
+        REQUIRE(amp.real() == Approx(expected.real()).margin(1e-12));
+        REQUIRE(amp.imag() == Approx(expected.imag()).margin(1e-12));
+    }
+}
+
+} // end anonymous namespace
+
+TEST_CASE( "Extended stabilizer decomposition", "[extended_stabilizer]" ) {
+    const uint_t num_qubits = 5;
+    const uint_t num_states = 8;
+    std::mt19937 circuit_rng(7);
+    const std::vector<Gate> gates = random_circuit(num_qubits, 60, circuit_rng);
+
+    for (const uint_t threads : {1, 2}) {
+        CHSimulator::Runner runner = make_runner(num_qubits, num_states, threads);
+        RngEngine rng(11);
+        apply(runner, gates, rng);
+        ReferenceDecomposition reference(num_qubits, num_states);
+        RngEngine reference_rng(11);
+        reference.apply(gates, reference_rng);
+
+        SECTION( "Amplitudes match the per-state decomposition, threads " + std::to_string(threads) ) {
+            require_equal_amplitudes(runner, reference);
+        }
+
+        SECTION( "Metropolis samples match the per-state decomposition, threads " + std::to_string(threads) ) {
+            RngEngine sample_rng(3);
+            const std::vector<uint_t> samples = runner.metropolis_estimation(200, 50, sample_rng);
+            RngEngine reference_sample_rng(3);
+            REQUIRE(samples == reference.metropolis(200, 50, reference_sample_rng));
+        }
+
+        SECTION( "Pauli projectors match the per-state decomposition, threads " + std::to_string(threads) ) {
+            std::vector<CHSimulator::pauli_t> generators(2);
+            generators[0].Z = 1ULL << 1;
+            generators[1].X = (1ULL << 0) | (1ULL << 3);
+            generators[1].Z = 1ULL << 3;
+            generators[1].e = 2;
+            runner.apply_pauli_projector(generators);
+            for (auto &state : reference.states)
+                state.MeasurePauliProjector(generators);
+            require_equal_amplitudes(runner, reference);
+        }
+    }
+}
+
+TEST_CASE( "Extended stabilizer norm estimate", "[extended_stabilizer]" ) {
+    const uint_t num_qubits = 5;
+    const uint_t num_states = 8;
+    std::mt19937 circuit_rng(7);
+    const std::vector<Gate> gates = random_circuit(num_qubits, 60, circuit_rng);
+    // The random quadratic forms are only reproducible with a single thread
+    CHSimulator::Runner runner = make_runner(num_qubits, num_states, 1);
+    RngEngine rng(11);
+    apply(runner, gates, rng);
+    ReferenceDecomposition reference(num_qubits, num_states);
+    RngEngine reference_rng(11);
+    reference.apply(gates, reference_rng);
+
+    // Samples of the random quadratic forms drawn as in Runner::norm_estimation
+    const uint_t n_samples = 20;
+    RngEngine norm_rng(5);
+    std::vector<uint_t> adiag_1(n_samples, 0ULL), adiag_2(n_samples, 0ULL);
+    std::vector<std::vector<uint_t>> a(n_samples, std::vector<uint_t>(num_qubits, 0ULL));
+    for (uint_t l = 0; l < n_samples; l++) {
+        for (uint_t i = 0; i < num_qubits; i++) {
+            for (uint_t j = i; j < num_qubits; j++) {
+                if (norm_rng.rand() < 0.5) {
+                    a[l][i] |= (1ULL << j);
+                    a[l][j] |= (1ULL << i);
+                }
+            }
+            adiag_1[l] |= (a[l][i] & (1ULL << i));
+            if (norm_rng.rand() < 0.5)
+                adiag_2[l] |= (1ULL << i);
+        }
+    }
+    const double expected = CHSimulator::NormEstimate(reference.states, reference.coefficients,
+                                                      adiag_1, adiag_2, a);
+    RngEngine runner_norm_rng(5);
+    REQUIRE(runner.norm_estimation(n_samples, runner_norm_rng) == Approx(expected).epsilon(1e-10));
+}
+
+TEST_CASE( "Extended stabilizer sampling of a single state", "[extended_stabilizer]" ) {
+    const uint_t num_qubits = 6;
+    std::mt19937 circuit_rng(19);
+    std::vector<Gate> gates;
+    for (const auto &gate : random_circuit(num_qubits, 80, circuit_rng))
+        if (gate.name != "t" && gate.name != "tdg" && gate.name != "u1" && gate.qubits.size() < 3)
+            gates.push_back(gate);
+
+    CHSimulator::Runner runner(num_qubits);
+    RngEngine rng(0);
+    apply(runner, gates, rng);
+    ReferenceDecomposition reference(num_qubits, 1);
+    reference.apply(gates, rng);
+    require_equal_amplitudes(runner, reference);
+
+    RngEngine sample_rng(23), reference_rng(23);
+    const std::vector<uint_t> samples = runner.stabilizer_sampler(100, sample_rng);
+    for (const auto sample : samples)
+        REQUIRE(sample == reference.states[0].Sample(reference_rng.rand_int(CHSimulator::ZERO, (1ULL << num_qubits) - 1)));
+}
+
+//------------------------------------------------------------------------------
+} // end namespace Test
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
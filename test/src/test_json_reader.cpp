@@ -0,0 +1,100 @@
+#define CATCH_CONFIG_MAIN
+#include <clocale>
+#include <sstream>
+#include <string>
+#include <catch.hpp>
+#include "framework/json_reader.hpp"
+#include "framework/types.hpp"
+
+namespace AER{
+namespace Test{
+
+TEST_CASE( "JSON streaming reader", "[json_reader]" ) {
+    const std::vector<std::string> texts = {
+        R"({"a": [1, -2, 3.5, 1e3, -0.25E-2], "b": {"c": null, "d": [true, false]}, "e": ""})",
+        R"([[], {}, [[]], "x\"y\\z\/\né😀", 18446744073709551615, -9223372036854775808])",
+        R"(  "string"  )",
+        R"(12345678901234567890123)",
+    };
+
+    SECTION( "Values are equal to the parsed JSON" ) {
+        for (const auto &text : texts) {
+            JSON::Reader reader(text);
+            REQUIRE(reader.value() == json_t::parse(text));
+            reader.end();
+        }
+    }
+
+    SECTION( "Stream input is read across blocks" ) {
+        for (const auto &text : texts) {
+            std::istringstream stream(text);
+            JSON::Reader reader(stream, 3);
+            REQUIRE(reader.value() == json_t::parse(text));
+            reader.end();
+        }
+    }
+
+    SECTION( "Invalid texts throw" ) {
+        const std::vector<std::string> invalid = {
+            "", "{", "[1,]", "[1 2]", R"({"a" 1})", R"({"a": 1,})", "[}",
+            "01", "1.", "-", "1e", "tru", R"("\x")", "\"a", "[1] 2",
+        };
+        for (const auto &text : invalid) {
+            JSON::Reader reader(text);
+            REQUIRE_THROWS_AS((reader.value(), reader.end()), std::invalid_argument);
+        }
+    }
+
+    SECTION( "Typed values are read directly" ) {
+        const std::string text = R"({"m": [[[1, 2], 3], [0, [0, -1]]], "v": [1, 2], "s": "x", "b": true})";
+        JSON::Reader reader(text);
+        cmatrix_t mat;
+        std::vector<uint_t> vec;
+        std::string str;
+        bool flag = false;
+        reader.begin_object();
+        std::string key;
+        while (reader.next_key(key)) {
+            if (key == "m") reader.read(mat);
+            else if (key == "v") reader.read(vec);
+            else if (key == "s") reader.read(str);
+            else reader.read(flag);
+        }
+        reader.end();
+        REQUIRE(mat.GetRows() == 2);
+        REQUIRE(mat.GetColumns() == 2);
+        REQUIRE(mat(0, 0) == complex_t(1, 2));
+        REQUIRE(mat(0, 1) == complex_t(3, 0));
+        REQUIRE(mat(1, 0) == complex_t(0, 0));
+        REQUIRE(mat(1, 1) == complex_t(0, -1));
+        REQUIRE(vec == std::vector<uint_t>({1, 2}));
+        REQUIRE(str == "x");
+        REQUIRE(flag);
+    }
+
+    SECTION( "Invalid matrices throw" ) {
+        for (const std::string text : {"[]", "[[1], [1, 2]]", "[1]"}) {
+            JSON::Reader reader(text);
+            cmatrix_t mat;
+            REQUIRE_THROWS_AS(reader.read(mat), std::invalid_argument);
+        }
+    }
+
+    SECTION( "Numbers do not depend on the decimal point of the locale" ) {
+        const std::string text = R"([3.5, -0.25E-2, 1e3])";
+        const std::string previous = std::setlocale(LC_NUMERIC, nullptr);
+        for (const char *name : {"de_DE.UTF-8", "fr_FR.UTF-8", "C"}) {
+            if (!std::setlocale(LC_NUMERIC, name))
+                continue;
+            JSON::Reader reader(text);
+            REQUIRE(reader.value() == json_t({3.5, -0.25E-2, 1e3}));
+        }
+        std::setlocale(LC_NUMERIC, previous.c_str());
+    }
+}
+
+//------------------------------------------------------------------------------
+} // end namespace Test
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
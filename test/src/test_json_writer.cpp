@@ -0,0 +1,99 @@
+#define CATCH_CONFIG_MAIN
+#include <limits>
+#include <sstream>
+#include <string>
+#include <catch.hpp>
+#include "framework/json_writer.hpp"
+#include "framework/types.hpp"
+
+namespace AER{
+namespace Test{
+
+TEST_CASE( "JSON streaming writer", "[json_writer]" ) {
+    const json_t js = json_t::parse(
+        R"({"b": [1, -2.5, 1e300, {"c": null, "d": [true, []]}], "a": {}, "e": "x\"é", "f": {"g": [[0.1, 2]]}})");
+    const std::vector<complex_t> vec = {{0.1, -0.25}, {1e-12, 3.0}, {0., -0.}, {1. / 3, 2e-20}};
+    const std::vector<complex_t> mat = {{1, 0}, {0, 2}, {0.5, 1e-15}, {-1, 1}, {2, 2}, {3, 3}};
+
+    SECTION( "Values are written as by dump" ) {
+        for (int indent : {-1, 0, 4}) {
+            std::string str;
+            JSON::Writer writer(str, indent);
+            writer.value(js);
+            REQUIRE(str == js.dump(indent));
+        }
+    }
+
+    SECTION( "Objects are merged with written members in key order" ) {
+        for (int indent : {-1, 4}) {
+            std::ostringstream stream;
+            {
+                JSON::Writer writer(stream, indent, 16);
+                JSON::Writer::Members members;
+                members["aa"] = [](JSON::Writer &w) {w.value(json_t(1));};
+                members["b"] = [](JSON::Writer &w) {
+                    w.begin_array();
+                    w.value(json_t("y"));
+                    w.begin_object();
+                    w.key("z");
+                    w.value(json_t(2));
+                    w.end_object();
+                    w.end_array();
+                };
+                writer.object(js, members);
+            }
+            json_t expected = js;
+            expected["aa"] = 1;
+            expected["b"] = json_t::parse(R"(["y", {"z": 2}])");
+            REQUIRE(stream.str() == expected.dump(indent));
+        }
+    }
+
+    SECTION( "Complex arrays are written as by their JSON conversion" ) {
+        for (int indent : {-1, 4}) {
+            for (double chop : {0., 1e-10}) {
+                for (int threads : {1, 3}) {
+                    const JSON::ComplexArray arr_vec(vec.data(), vec.size(), chop);
+                    const JSON::ComplexArray arr_mat(mat.data(), 2, 3, chop);
+                    std::string str;
+                    JSON::Writer writer(str, indent);
+                    writer.set_omp_threads(threads);
+                    writer.begin_array();
+                    arr_vec.write(writer);
+                    arr_mat.write(writer);
+                    writer.end_array();
+                    json_t expected = {arr_vec.json(), arr_mat.json()};
+                    REQUIRE(str == expected.dump(indent));
+                }
+            }
+        }
+        const JSON::ComplexArray arr_vec(vec.data(), vec.size(), 1e-10);
+        REQUIRE(arr_vec.json()[1] == json_t::parse("[0.0, 3.0]"));
+        REQUIRE(arr_vec.json()[3][1] == 0.);
+        const JSON::ComplexArray arr_mat(mat.data(), 2, 3, 0);
+        REQUIRE(arr_mat.json()[1] == json_t::parse("[[0.0, 2.0], [-1.0, 1.0], [3.0, 3.0]]"));
+    }
+
+    SECTION( "Large arrays are formatted in parallel" ) {
+        std::vector<complex_t> large(100000);
+        for (size_t j = 0; j < large.size(); j++)
+            large[j] = complex_t(1. / (j + 1), -std::sqrt(j));
+        large[7] = complex_t(std::numeric_limits<double>::infinity(), 0);
+        const JSON::ComplexArray arr(large.data(), large.size(), 0);
+        for (int threads : {1, 4}) {
+            std::ostringstream stream;
+            {
+                JSON::Writer writer(stream, -1, 1000);
+                writer.set_omp_threads(threads);
+                arr.write(writer);
+            }
+            REQUIRE(stream.str() == arr.json().dump());
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+} // end namespace Test
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
@@ -0,0 +1,673 @@
+#define CATCH_CONFIG_MAIN
+#include <cmath>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <catch.hpp>
+#include "framework/json.hpp"
+#include "framework/types.hpp"
+#include "framework/utils.hpp"
+#include "simulators/qasm/qasm_controller.hpp"
+#include "simulators/unitary/unitary_controller.hpp"
+
+namespace AER{
+namespace Test{
+
+namespace {
+
+// Return the qobj of a single experiment with the instructions
+json_t make_qobj(const json_t &instructions, uint_t num_qubits,
+                 const json_t &config) {
+    json_t experiment;
+    experiment["instructions"] = instructions;
+    experiment["config"] = {{"n_qubits", num_qubits}, {"memory_slots", num_qubits}};
+    experiment["header"] = json_t::object();
+    json_t qobj;
+    qobj["qobj_id"] = "test";
+    qobj["type"] = "QASM";
+    qobj["schema_version"] = "1.0";
+    qobj["config"] = config;
+    qobj["experiments"] = {experiment};
+    return qobj;
+}
+
+// Return the result of the single experiment of the qobj
+json_t run_qasm(const json_t &instructions, uint_t num_qubits,
+                const json_t &config) {
+    Simulator::QasmController controller;
+    const json_t result = controller.execute(make_qobj(instructions, num_qubits, config));
+    REQUIRE(result["success"].get<bool>());
+    return result["results"][0];
+}
+
+// Return the instructions of a circuit of layers of rotations and CX gates
+// on neighbouring qubits followed by the measurement of every qubit
+json_t layered_circuit(uint_t num_qubits, uint_t layers) {
+    json_t ops = json_t::array();
+    for (uint_t l = 0; l < layers; l++) {
+        for (uint_t q = 0; q < num_qubits; q++)
+            ops.push_back({{"name", "u3"}, {"qubits", {q}},
+                           {"params", {0.3 + 0.1 * q + 0.7 * l, 0.2 * l, 0.1 * q}}});
+        for (uint_t q = l % 2; q + 1 < num_qubits; q += 2)
+            ops.push_back({{"name", "cx"}, {"qubits", {q, q + 1}}});
+    }
+    return ops;
+}
+
+void add_measure(json_t &ops, uint_t num_qubits) {
+    json_t qubits = json_t::array();
+    for (uint_t q = 0; q < num_qubits; q++)
+        qubits.push_back(q);
+    ops.push_back({{"name", "measure"}, {"qubits", qubits}, {"memory", qubits}});
+}
+
+// Return the instructions of a circuit with a mid-circuit measurement
+// conditioning the following gates, followed by the measurement of every qubit
+json_t conditional_circuit() {
+    json_t ops = json_t::array();
+    ops.push_back({{"name", "u3"}, {"qubits", {0}}, {"params", {1.1, 0., 0.}}});
+    ops.push_back({{"name", "u3"}, {"qubits", {2}}, {"params", {0.6, 0., 0.}}});
+    ops.push_back({{"name", "measure"}, {"qubits", {0}}, {"memory", {0}}, {"register", {0}}});
+    ops.push_back({{"name", "x"}, {"qubits", {1}}, {"conditional", 0}});
+    ops.push_back({{"name", "cx"}, {"qubits", {1, 2}}});
+    add_measure(ops, 3);
+    return ops;
+}
+
+// Return the probability of each count of the result
+std::map<std::string, double> count_probabilities(const json_t &result, uint_t shots) {
+    std::map<std::string, double> probs;
+    for (const auto &item : result["data"]["counts"].items())
+        probs[item.key()] = item.value().get<double>() / shots;
+    return probs;
+}
+
+// Return the matrix of exp(-i theta/2 P) for the little-endian Pauli label P
+cmatrix_t pauli_rotation_matrix(const std::string &pauli, double theta) {
+    const std::map<char, cmatrix_t> paulis = {{'I', Utils::Matrix::I}, {'X', Utils::Matrix::X},
+                                              {'Y', Utils::Matrix::Y}, {'Z', Utils::Matrix::Z}};
+    cmatrix_t op;
+    for (const char c : pauli)
+        op = Utils::tensor_product(op, paulis.at(c));
+    const complex_t cos(std::cos(theta / 2), 0.), isin(0., std::sin(theta / 2));
+    cmatrix_t mat(op.GetRows(), op.GetColumns());
+    for (size_t i = 0; i < op.size(); i++)
+        mat[i] = (i % (op.GetRows() + 1) == 0 ? cos : 0.) - isin * op[i];
+    return mat;
+}
+
+} // end anonymous namespace
+
+TEST_CASE( "Qubit relabelling", "[qasm_controller][relabel]" ) {
+    const uint_t num_qubits = 6;
+    json_t ops = layered_circuit(num_qubits, 6);
+    // Gates on the high qubits are moved to low positions
+    for (uint_t j = 0; j < 20; j++)
+        ops.push_back({{"name", "cx"}, {"qubits", {num_qubits - 1, num_qubits - 2}}});
+    ops.push_back({{"name", "snapshot"}, {"type", "statevector"}, {"label", "sv"}});
+    add_measure(ops, num_qubits);
+
+    json_t config = {{"shots", 2000}, {"seed_simulator", 11},
+                     {"method", "statevector"}};
+    const json_t ideal = run_qasm(ops, num_qubits, config);
+    config["relabel_enable"] = true;
+    config["relabel_local_qubits"] = 2;
+    config["relabel_window"] = 10;
+    config["relabel_verbose"] = true;
+    const json_t relabelled = run_qasm(ops, num_qubits, config);
+
+    SECTION( "The circuit is remapped with relabel gates" ) {
+        bool found = false;
+        for (const auto &op : relabelled["metadata"]["relabel_verbose"])
+            found |= (op["name"] == "relabel");
+        REQUIRE(found);
+    }
+
+    SECTION( "Counts and statevector snapshots are unchanged" ) {
+        REQUIRE(relabelled["data"]["counts"] == ideal["data"]["counts"]);
+        const auto &sv0 = ideal["data"]["snapshots"]["statevector"]["sv"][0];
+        const auto &sv1 = relabelled["data"]["snapshots"]["statevector"]["sv"][0];
+        REQUIRE(sv0.size() == sv1.size());
+        for (size_t j = 0; j < sv0.size(); j++) {
+            REQUIRE(sv1[j][0].get<double>() == Approx(sv0[j][0].get<double>()).margin(1e-12));
+            REQUIRE(sv1[j][1].get<double>() == Approx(sv0[j][1].get<double>()).margin(1e-12));
+        }
+    }
+
+    SECTION( "Relabel gates are not allowed in qobj circuits" ) {
+        json_t invalid = {{{"name", "relabel"}, {"qubits", {0, 1}}}};
+        Simulator::QasmController controller;
+        const json_t result = controller.execute(make_qobj(invalid, 2, {{"shots", 1}}));
+        REQUIRE(!result["results"][0]["success"].get<bool>());
+    }
+}
+
+TEST_CASE( "Shot branching", "[qasm_controller][branching]" ) {
+    const uint_t shots = 4000;
+    const json_t ops = conditional_circuit();
+    json_t config = {{"shots", shots}, {"seed_simulator", 5},
+                     {"method", "statevector"}};
+    const auto branched = [](const json_t &result) {
+        return JSON::check_key("shot_branching", result["metadata"]);
+    };
+    const auto run = [&ops](const json_t &run_config) {
+        json_t qobj = make_qobj(ops, 3, run_config);
+        qobj["experiments"][0]["config"]["register_slots"] = 1;
+        Simulator::QasmController controller;
+        const json_t result = controller.execute(qobj);
+        REQUIRE(result["success"].get<bool>());
+        return result["results"][0];
+    };
+    json_t unbranched_config = config;
+    unbranched_config["shot_branching_enable"] = false;
+
+    SECTION( "Counts have the distribution of the unbranched shots" ) {
+        const json_t result = run(config);
+        const json_t reference = run(unbranched_config);
+        REQUIRE(branched(result));
+        REQUIRE(!branched(reference));
+        // The outcomes are 000, 001 and the final measurement of qubit 2
+        // flipped by the conditional gate
+        const double p0 = std::pow(std::sin(0.55), 2);
+        const double p2 = std::pow(std::sin(0.3), 2);
+        const std::map<std::string, double> expected = {
+            {"0x0", (1 - p0) * (1 - p2)}, {"0x4", (1 - p0) * p2},
+            {"0x7", p0 * (1 - p2)}, {"0x3", p0 * p2}};
+        for (const auto &probs : {count_probabilities(result, shots),
+                                  count_probabilities(reference, shots)}) {
+            REQUIRE(probs.size() == expected.size());
+            for (const auto &item : expected)
+                REQUIRE(probs.at(item.first) == Approx(item.second).margin(0.03));
+        }
+    }
+
+    SECTION( "Circuits returning memory or registers are not branched" ) {
+        for (const std::string key : {"memory", "register"}) {
+            json_t singleshot_config = config;
+            singleshot_config[key] = true;
+            json_t reference_config = unbranched_config;
+            reference_config[key] = true;
+            const json_t result = run(singleshot_config);
+            const json_t reference = run(reference_config);
+            REQUIRE(!branched(result));
+            REQUIRE(result["data"][key] == reference["data"][key]);
+            REQUIRE(result["data"]["counts"] == reference["data"]["counts"]);
+        }
+    }
+
+    SECTION( "Circuits with single-shot snapshots are not branched" ) {
+        json_t snapshot_ops = ops;
+        const json_t snapshot = {{"name", "snapshot"}, {"type", "statevector"}, {"label", "sv"}};
+        snapshot_ops.insert(snapshot_ops.begin() + 4, snapshot);
+        json_t qobj = make_qobj(snapshot_ops, 3, config);
+        qobj["experiments"][0]["config"]["register_slots"] = 1;
+        Simulator::QasmController controller;
+        const json_t result = controller.execute(qobj)["results"][0];
+        REQUIRE(result["success"].get<bool>());
+        REQUIRE(!branched(result));
+        REQUIRE(result["data"]["snapshots"]["statevector"]["sv"].size() == shots);
+    }
+
+    SECTION( "Averaged snapshots are weighted by the shots of each branch" ) {
+        // The reset of qubit 0 collapses qubit 1 without changing the memory,
+        // so both branches are averaged into the same snapshot
+        json_t snapshot_ops = json_t::array();
+        snapshot_ops.push_back({{"name", "u3"}, {"qubits", {0}}, {"params", {1.1, 0., 0.}}});
+        snapshot_ops.push_back({{"name", "cx"}, {"qubits", {0, 1}}});
+        snapshot_ops.push_back({{"name", "reset"}, {"qubits", {0}}});
+        snapshot_ops.push_back({{"name", "snapshot"}, {"type", "expectation_value_pauli_with_variance"},
+                                {"label", "z"}, {"qubits", {1}}, {"params", {{{1., 0.}, "Z"}}}});
+        snapshot_ops.push_back({{"name", "measure"}, {"qubits", {1}}, {"memory", {1}}});
+        const json_t result = run_qasm(snapshot_ops, 3, config);
+        REQUIRE(branched(result));
+
+        // The branch of each shot is given by its final measurement
+        const auto &counts = result["data"]["counts"];
+        const double n0 = JSON::check_key("0x0", counts) ? counts["0x0"].get<double>() : 0.;
+        const double n1 = JSON::check_key("0x2", counts) ? counts["0x2"].get<double>() : 0.;
+        REQUIRE(n0 + n1 == shots);
+        REQUIRE(n0 > 0);
+        REQUIRE(n1 > 0);
+        const auto &snapshot = result["data"]["snapshots"]["expectation_value"]["z"];
+        REQUIRE(snapshot.size() == 1);
+        const double mean = (n0 - n1) / shots;
+        REQUIRE(snapshot[0]["value"][0].get<double>() == Approx(mean).margin(1e-12));
+        REQUIRE(snapshot[0]["variance"][0].get<double>() ==
+                Approx((1 - mean * mean) / (shots - 1)).margin(1e-12));
+    }
+}
+
+TEST_CASE( "Noisy shots in parallel", "[qasm_controller][noise][parallel]" ) {
+    const uint_t num_qubits = 4;
+    json_t ops = layered_circuit(num_qubits, 3);
+    add_measure(ops, num_qubits);
+    // Pauli errors after every gate
+    const json_t u3_error = {{"type", "qerror"}, {"operations", {"u3"}},
+                             {"probabilities", {0.9, 0.06, 0.04}},
+                             {"instructions", {{{{"name", "id"}, {"qubits", {0}}}},
+                                               {{{"name", "x"}, {"qubits", {0}}}},
+                                               {{{"name", "z"}, {"qubits", {0}}}}}}};
+    const json_t cx_error = {{"type", "qerror"}, {"operations", {"cx"}},
+                             {"probabilities", {0.85, 0.15}},
+                             {"instructions", {{{{"name", "id"}, {"qubits", {0}}}},
+                                               {{{"name", "x"}, {"qubits", {1}}},
+                                                {{"name", "y"}, {"qubits", {0}}}}}}};
+    json_t config = {{"shots", 600}, {"seed_simulator", 17},
+                     {"method", "statevector"},
+                     {"noise_model", {{"errors", {u3_error, cx_error}}}}};
+
+    // The counts of a seeded circuit do not depend on the number of shot
+    // threads or of noise sampling threads
+    json_t reference;
+    for (const int shot_threads : {1, 2, 4}) {
+        for (const int samplers : {0, 1, 2}) {
+            config["_parallel_shots"] = shot_threads;
+            config["noise_sampling_threads"] = samplers;
+            const json_t result = run_qasm(ops, num_qubits, config);
+            REQUIRE(result["metadata"]["parallel_shots"].get<int>() == shot_threads);
+            if (reference.is_null()) {
+                reference = result["data"]["counts"];
+                REQUIRE(reference.size() > 1);
+            } else {
+                REQUIRE(result["data"]["counts"] == reference);
+            }
+        }
+    }
+}
+
+TEST_CASE( "Initialize on subsets of an entangled state", "[qasm_controller][initialize]" ) {
+    const uint_t num_qubits = 4;
+    // Normalized states of 1, 2 and 3 qubits
+    const auto state = [](uint_t n) {
+        const uint_t dim = 1ULL << n;
+        const double norm = std::sqrt(dim * (dim + 1) * (2 * dim + 1) / 6.);
+        json_t vec = json_t::array();
+        for (uint_t i = 0; i < dim; i++)
+            vec.push_back({(i + 1) * std::cos(0.7 * i) / norm, (i + 1) * std::sin(0.7 * i) / norm});
+        return vec;
+    };
+    // Entangle all qubits, initialize the qubits and take a snapshot, with
+    // an explicit reset of the qubits before the initialize if reset is set
+    const auto circuit = [&](const reg_t &qubits, bool reset) {
+        json_t ops = layered_circuit(num_qubits, 3);
+        if (reset)
+            ops.push_back({{"name", "reset"}, {"qubits", qubits}});
+        ops.push_back({{"name", "initialize"}, {"qubits", qubits},
+                       {"params", state(qubits.size())}});
+        ops.push_back({{"name", "snapshot"}, {"type", "statevector"}, {"label", "sv"}});
+        return ops;
+    };
+    const json_t config = {{"shots", 1}, {"seed_simulator", 29},
+                           {"method", "statevector"}};
+
+    for (const reg_t &qubits : std::vector<reg_t>({{2}, {3, 0}, {1, 3, 2}})) {
+        const json_t result = run_qasm(circuit(qubits, false), num_qubits, config);
+        const json_t reference = run_qasm(circuit(qubits, true), num_qubits, config);
+        const auto &sv = result["data"]["snapshots"]["statevector"]["sv"][0];
+        const auto &expected = reference["data"]["snapshots"]["statevector"]["sv"][0];
+        REQUIRE(sv.size() == (1ULL << num_qubits));
+        REQUIRE(sv.size() == expected.size());
+        for (size_t j = 0; j < sv.size(); j++) {
+            REQUIRE(sv[j][0].get<double>() == Approx(expected[j][0].get<double>()).margin(1e-12));
+            REQUIRE(sv[j][1].get<double>() == Approx(expected[j][1].get<double>()).margin(1e-12));
+        }
+    }
+}
+
+TEST_CASE( "Dry run", "[qasm_controller][dry_run]" ) {
+    const uint_t num_qubits = 5;
+    json_t ops = layered_circuit(num_qubits, 4);
+    add_measure(ops, num_qubits);
+    json_t config = {{"shots", 1000}, {"seed_simulator", 3}, {"dry_run", true}};
+
+    SECTION( "The estimate is returned without simulating the circuit" ) {
+        const json_t result = run_qasm(ops, num_qubits, config);
+        const auto &metadata = result["metadata"];
+        REQUIRE(metadata["dry_run"].get<bool>());
+        REQUIRE(metadata["method"] == "statevector");
+        REQUIRE(metadata["num_qubits"].get<uint_t>() == num_qubits);
+        REQUIRE(metadata["measure_sampling"].get<bool>());
+        REQUIRE(metadata["estimated_memory_mb"].get<double>() >= 0.);
+        REQUIRE(metadata["estimated_time"].get<double>() > 0.);
+        REQUIRE(!JSON::check_key("counts", result["data"]));
+    }
+
+    SECTION( "The method of the estimate is the automatic method" ) {
+        json_t clifford_ops = json_t::array();
+        for (uint_t q = 0; q + 1 < num_qubits; q++) {
+            clifford_ops.push_back({{"name", "h"}, {"qubits", {q}}});
+            clifford_ops.push_back({{"name", "cx"}, {"qubits", {q, q + 1}}});
+        }
+        add_measure(clifford_ops, num_qubits);
+        const json_t result = run_qasm(clifford_ops, num_qubits, config);
+        REQUIRE(result["metadata"]["method"] == "stabilizer");
+    }
+
+    SECTION( "The runtime estimate follows the calibration" ) {
+        const json_t result = run_qasm(ops, num_qubits, config);
+        // Doubling every calibration constant doubles the estimate
+        config["dry_run_calibration"] = {{"statevector", 3.2e-9}, {"operation", 1e-6},
+                                         {"shot", 1e-5}, {"noise", 1e-5}};
+        const json_t calibrated = run_qasm(ops, num_qubits, config);
+        REQUIRE(calibrated["metadata"]["estimated_time"].get<double>() ==
+                Approx(2 * result["metadata"]["estimated_time"].get<double>()));
+        REQUIRE(calibrated["metadata"]["estimated_memory_mb"] ==
+                result["metadata"]["estimated_memory_mb"]);
+    }
+}
+
+TEST_CASE( "Readout errors of sampled measurements", "[qasm_controller][readout_error]" ) {
+    const uint_t num_qubits = 3;
+    const uint_t shots = 20000;
+    const std::vector<double> angles = {0.4, 1.3, 2.2};
+    // Assignment probabilities of each qubit for the ideal values 0 and 1
+    const std::vector<std::vector<std::vector<double>>> assignment = {
+        {{0.95, 0.05}, {0.2, 0.8}},
+        {{0.9, 0.1}, {0.15, 0.85}},
+        {{0.97, 0.03}, {0.1, 0.9}}};
+    json_t ops = json_t::array();
+    for (uint_t q = 0; q < num_qubits; q++)
+        ops.push_back({{"name", "u3"}, {"qubits", {q}}, {"params", {angles[q], 0., 0.}}});
+    add_measure(ops, num_qubits);
+
+    // Exact distribution of the noisy outcomes
+    std::map<std::string, double> expected;
+    for (uint_t out = 0; out < 8; out++) {
+        double prob = 1.;
+        for (uint_t q = 0; q < num_qubits; q++) {
+            const double p1 = std::pow(std::sin(angles[q] / 2), 2);
+            const uint_t bit = (out >> q) & 1;
+            prob *= (1 - p1) * assignment[q][0][bit] + p1 * assignment[q][1][bit];
+        }
+        std::stringstream ss;
+        ss << "0x" << std::hex << out;
+        expected[ss.str()] = prob;
+    }
+
+    // Dense assignment matrix of the tensor product of the qubit errors
+    json_t dense = json_t::array();
+    for (uint_t ideal = 0; ideal < 8; ideal++) {
+        json_t row = json_t::array();
+        for (uint_t out = 0; out < 8; out++) {
+            double prob = 1.;
+            for (uint_t q = 0; q < num_qubits; q++)
+                prob *= assignment[q][(ideal >> q) & 1][(out >> q) & 1];
+            row.push_back(prob);
+        }
+        dense.push_back(row);
+    }
+    json_t factors = json_t::array();
+    for (uint_t q = 0; q < num_qubits; q++)
+        factors.push_back({{"qubits", {q}}, {"probabilities", assignment[q]}});
+
+    const auto run = [&](const json_t &error, bool memory) {
+        json_t roerror = {{"type", "roerror"}, {"operations", {"measure"}},
+                          {"gate_qubits", {{0, 1, 2}}}};
+        roerror.update(error);
+        json_t config = {{"shots", shots}, {"seed_simulator", 3},
+                         {"method", "statevector"}, {"memory", memory}};
+        config["noise_model"] = {{"errors", {roerror}}};
+        const json_t result = run_qasm(ops, num_qubits, config);
+        REQUIRE(result["metadata"]["measure_sampling"].get<bool>());
+        return result;
+    };
+    const auto check_distribution = [&](const json_t &result) {
+        const auto probs = count_probabilities(result, shots);
+        for (const auto &item : expected) {
+            const double prob = probs.count(item.first) ? probs.at(item.first) : 0.;
+            REQUIRE(prob == Approx(item.second).margin(0.015));
+        }
+    };
+
+    SECTION( "Dense errors are sampled for each shot" ) {
+        const json_t counts = run({{"probabilities", dense}}, false);
+        const json_t memory = run({{"probabilities", dense}}, true);
+        REQUIRE(counts["data"]["counts"] == memory["data"]["counts"]);
+        check_distribution(counts);
+    }
+
+    SECTION( "Factored errors have the same distribution with and without memory" ) {
+        check_distribution(run({{"factors", factors}}, false));
+        check_distribution(run({{"factors", factors}}, true));
+    }
+}
+
+TEST_CASE( "Pauli expectation value gradients", "[qasm_controller][gradient]" ) {
+    const uint_t num_qubits = 3;
+    const json_t pauli = {{{0.7, 0.}, "ZXY"}, {{0.3, 0.}, "XXI"}, {{-0.5, 0.}, "IZZ"}};
+    // Parameters of the u3, u2, u1, cu1 and pauli_rotation gates in circuit order
+    const std::vector<double> params = {0.3, 1.1, -0.4, 0.8, 2.1, 0.5, 1.7, -0.9};
+    const auto circuit = [&](const std::vector<double> &x, const std::string &snapshot) {
+        json_t ops = json_t::array();
+        for (uint_t q = 0; q < num_qubits; q++)
+            ops.push_back({{"name", "h"}, {"qubits", {q}}});
+        ops.push_back({{"name", "u3"}, {"qubits", {0}}, {"params", {x[0], x[1], x[2]}}});
+        ops.push_back({{"name", "u2"}, {"qubits", {1}}, {"params", {x[3], x[4]}}});
+        ops.push_back({{"name", "cx"}, {"qubits", {1, 2}}});
+        ops.push_back({{"name", "u1"}, {"qubits", {2}}, {"params", {x[5]}}});
+        ops.push_back({{"name", "cu1"}, {"qubits", {0, 1}}, {"params", {x[6]}}});
+        ops.push_back({{"name", "pauli_rotation"}, {"qubits", {0, 1, 2}},
+                       {"pauli", "XYZ"}, {"params", {x[7]}}});
+        ops.push_back({{"name", "snapshot"}, {"type", snapshot}, {"label", "H"},
+                       {"qubits", {0, 1, 2}}, {"params", pauli}});
+        return ops;
+    };
+    const json_t config = {{"shots", 1}, {"method", "statevector"}};
+    const auto expval = [&](const std::vector<double> &x) {
+        const json_t result = run_qasm(circuit(x, "expectation_value_pauli"), num_qubits, config);
+        return result["data"]["snapshots"]["expectation_value"]["H"][0]["value"][0].get<double>();
+    };
+
+    const json_t result = run_qasm(circuit(params, "expectation_value_pauli_gradient"),
+                                   num_qubits, config);
+    const auto grads = result["data"]["snapshots"]["expectation_value_gradient"]["H"][0]["value"];
+    REQUIRE(grads.size() == params.size());
+    // Every gate parameter has the parameter-shift rule with shifts of pi/2
+    for (size_t k = 0; k < params.size(); k++) {
+        auto plus = params, minus = params;
+        plus[k] += M_PI / 2;
+        minus[k] -= M_PI / 2;
+        const double shift = 0.5 * (expval(plus) - expval(minus));
+        REQUIRE(grads[k].get<double>() == Approx(shift).margin(1e-10));
+    }
+}
+
+TEST_CASE( "Real-amplitude statevector", "[qasm_controller][statevector_real]" ) {
+    const uint_t num_qubits = 4;
+    const double c = std::cos(0.4), s = std::sin(0.4);
+    json_t ops = json_t::array();
+    for (uint_t q = 0; q < num_qubits; q++)
+        ops.push_back({{"name", "u3"}, {"qubits", {q}}, {"params", {0.5 + 0.6 * q, 0., 0.}}});
+    ops.push_back({{"name", "cx"}, {"qubits", {0, 2}}});
+    ops.push_back({{"name", "cu1"}, {"qubits", {1, 3}}, {"params", {M_PI}}});
+    ops.push_back({{"name", "ccx"}, {"qubits", {3, 1, 0}}});
+    ops.push_back({{"name", "swap"}, {"qubits", {2, 1}}});
+    // Dense, diagonal and signed permutation matrices
+    ops.push_back({{"name", "unitary"}, {"qubits", {3}},
+                   {"params", {{{c, -s}, {s, c}}}}});
+    ops.push_back({{"name", "unitary"}, {"qubits", {0, 2}},
+                   {"params", {{{1, 0, 0, 0}, {0, -1, 0, 0}, {0, 0, -1, 0}, {0, 0, 0, 1}}}}});
+    ops.push_back({{"name", "unitary"}, {"qubits", {1, 3}},
+                   {"params", {{{0, 0, -1, 0}, {1, 0, 0, 0}, {0, 0, 0, 1}, {0, 1, 0, 0}}}}});
+    ops.push_back({{"name", "u3"}, {"qubits", {1}}, {"params", {1.9, 0., M_PI}}});
+    ops.push_back({{"name", "snapshot"}, {"type", "statevector"}, {"label", "sv"}});
+    ops.push_back({{"name", "snapshot"}, {"type", "probabilities"}, {"label", "probs"},
+                   {"qubits", {0, 2}}});
+    add_measure(ops, num_qubits);
+
+    json_t config = {{"shots", 1000}, {"seed_simulator", 17},
+                     {"method", "statevector"}};
+    const json_t real = run_qasm(ops, num_qubits, config);
+    config["statevector_real_enable"] = false;
+    const json_t complex = run_qasm(ops, num_qubits, config);
+
+    SECTION( "Real circuits use the real-amplitude statevector" ) {
+        REQUIRE(JSON::check_key("statevector_real", real["metadata"]));
+        REQUIRE(!JSON::check_key("statevector_real", complex["metadata"]));
+    }
+
+    SECTION( "Snapshots and counts are equal to the complex statevector" ) {
+        REQUIRE(real["data"]["counts"] == complex["data"]["counts"]);
+        const auto &sv0 = complex["data"]["snapshots"]["statevector"]["sv"][0];
+        const auto &sv1 = real["data"]["snapshots"]["statevector"]["sv"][0];
+        REQUIRE(sv0.size() == sv1.size());
+        for (size_t j = 0; j < sv0.size(); j++) {
+            REQUIRE(sv1[j][0].get<double>() == Approx(sv0[j][0].get<double>()).margin(1e-12));
+            REQUIRE(sv1[j][1].get<double>() == Approx(sv0[j][1].get<double>()).margin(1e-12));
+        }
+        const auto &probs0 = complex["data"]["snapshots"]["probabilities"]["probs"][0]["value"];
+        const auto &probs1 = real["data"]["snapshots"]["probabilities"]["probs"][0]["value"];
+        REQUIRE(probs0.size() == probs1.size());
+        for (const auto &item : probs0.items())
+            REQUIRE(probs1[item.key()].get<double>() == Approx(item.value().get<double>()).margin(1e-12));
+    }
+}
+
+TEST_CASE( "Superoperator fusion", "[qasm_controller][superop_fusion]" ) {
+    const uint_t num_qubits = 5;
+    const double gamma = 0.1;
+    // Amplitude damping channel
+    const json_t kraus = {{{{1, 0}, {0, 0}}, {{0, 0}, {std::sqrt(1 - gamma), 0}}},
+                          {{{0, 0}, {std::sqrt(gamma), 0}}, {{0, 0}, {0, 0}}}};
+    json_t ops = json_t::array();
+    for (uint_t l = 0; l < 3; l++) {
+        for (uint_t q = 0; q < num_qubits; q++) {
+            ops.push_back({{"name", "u3"}, {"qubits", {q}},
+                           {"params", {0.4 + 0.3 * q + 0.5 * l, 0.2 * l, 0.1 * q}}});
+            ops.push_back({{"name", "kraus"}, {"qubits", {q}}, {"params", kraus}});
+        }
+        for (uint_t q = l % 2; q + 1 < num_qubits; q += 2) {
+            ops.push_back({{"name", "cx"}, {"qubits", {q + 1, q}}});
+            ops.push_back({{"name", "kraus"}, {"qubits", {q}}, {"params", kraus}});
+        }
+    }
+    ops.push_back({{"name", "snapshot"}, {"type", "density_matrix"}, {"label", "rho"}});
+    ops.push_back({{"name", "snapshot"}, {"type", "probabilities"}, {"label", "probs"},
+                   {"qubits", {4, 1, 2}}});
+
+    json_t config = {{"shots", 1}, {"seed_simulator", 3},
+                     {"method", "density_matrix"}, {"fusion_verbose", true}};
+    const json_t fused = run_qasm(ops, num_qubits, config);
+    config["superop_fusion_enable"] = false;
+    const json_t unfused = run_qasm(ops, num_qubits, config);
+
+    SECTION( "Channels and gates are fused into superop instructions" ) {
+        REQUIRE(!JSON::check_key("superop_fusion_verbose", unfused["metadata"]));
+        const auto &fused_ops = fused["metadata"]["superop_fusion_verbose"];
+        uint_t superops = 0;
+        for (const auto &op : fused_ops)
+            superops += (op["name"] == "superop");
+        REQUIRE(superops > 0);
+        REQUIRE(fused_ops.size() < ops.size());
+    }
+
+    SECTION( "Density matrix snapshots are equal to the unfused circuit" ) {
+        const auto &rho0 = unfused["data"]["snapshots"]["density_matrix"]["rho"][0];
+        const auto &rho1 = fused["data"]["snapshots"]["density_matrix"]["rho"][0];
+        REQUIRE(rho0.size() == (1ULL << num_qubits));
+        REQUIRE(rho0.size() == rho1.size());
+        for (size_t i = 0; i < rho0.size(); i++) {
+            REQUIRE(rho0[i].size() == rho1[i].size());
+            for (size_t j = 0; j < rho0[i].size(); j++) {
+                REQUIRE(rho1[i][j][0].get<double>() == Approx(rho0[i][j][0].get<double>()).margin(1e-12));
+                REQUIRE(rho1[i][j][1].get<double>() == Approx(rho0[i][j][1].get<double>()).margin(1e-12));
+            }
+        }
+        const auto &probs0 = unfused["data"]["snapshots"]["probabilities"]["probs"][0]["value"];
+        const auto &probs1 = fused["data"]["snapshots"]["probabilities"]["probs"][0]["value"];
+        REQUIRE(probs0.size() == probs1.size());
+        for (const auto &item : probs0.items())
+            REQUIRE(probs1[item.key()].get<double>() == Approx(item.value().get<double>()).margin(1e-12));
+    }
+}
+
+TEST_CASE( "Pauli rotations", "[qasm_controller][pauli_rotation]" ) {
+    const uint_t num_qubits = 4;
+    const std::vector<std::tuple<std::string, reg_t, double>> rotations = {
+        std::make_tuple("XYZ", reg_t({3, 0, 2}), 0.7),
+        std::make_tuple("ZZ", reg_t({1, 3}), 1.3),
+        std::make_tuple("YX", reg_t({2, 1}), -0.9),
+        std::make_tuple("XIZY", reg_t({0, 1, 2, 3}), 2.1)};
+    json_t rotation_ops = json_t::array(), matrix_ops = json_t::array();
+    for (const auto &rotation : rotations) {
+        const std::string &pauli = std::get<0>(rotation);
+        const reg_t &qubits = std::get<1>(rotation);
+        const double theta = std::get<2>(rotation);
+        rotation_ops.push_back({{"name", "pauli_rotation"}, {"qubits", qubits},
+                                {"pauli", pauli}, {"params", {theta}}});
+        json_t mat = pauli_rotation_matrix(pauli, theta);
+        matrix_ops.push_back({{"name", "unitary"}, {"qubits", qubits}, {"params", {mat}}});
+    }
+
+    // Return the state snapshot after the rotations applied to an
+    // entangled state
+    const auto snapshot = [&](const json_t &ops, const std::string &method,
+                              const std::string &type) {
+        json_t circ = layered_circuit(num_qubits, 2);
+        circ.insert(circ.end(), ops.begin(), ops.end());
+        circ.push_back({{"name", "snapshot"}, {"type", type}, {"label", "state"}});
+        const json_t result = run_qasm(circ, num_qubits, {{"shots", 1}, {"method", method}});
+        return result["data"]["snapshots"][type]["state"][0];
+    };
+
+    // The MPS cannot apply matrices on more than 2 qubits, so its
+    // reference is the statevector
+    const std::vector<std::tuple<std::string, std::string, std::string>> methods = {
+        std::make_tuple("statevector", "statevector", "statevector"),
+        std::make_tuple("density_matrix", "density_matrix", "density_matrix"),
+        std::make_tuple("matrix_product_state", "statevector", "statevector")};
+    for (const auto &item : methods) {
+        const std::string &method = std::get<0>(item);
+        SECTION( "States are equal to the matrices with the " + method + " method" ) {
+            const json_t state = snapshot(rotation_ops, method, std::get<2>(item));
+            const json_t expected = snapshot(matrix_ops, std::get<1>(item), std::get<2>(item));
+            // Flatten the state vector or matrix of complex numbers
+            const auto flatten = [](const json_t &js) {
+                std::vector<double> vals;
+                std::function<void(const json_t &)> add = [&](const json_t &val) {
+                    if (val.is_number())
+                        vals.push_back(val.get<double>());
+                    else
+                        for (const auto &elt : val)
+                            add(elt);
+                };
+                add(js);
+                return vals;
+            };
+            const auto vals = flatten(state), expected_vals = flatten(expected);
+            REQUIRE(expected_vals.size() == 2 * (method == "density_matrix" ? 1ULL << (2 * num_qubits)
+                                                                            : 1ULL << num_qubits));
+            REQUIRE(vals.size() == expected_vals.size());
+            for (size_t j = 0; j < vals.size(); j++)
+                REQUIRE(vals[j] == Approx(expected_vals[j]).margin(1e-10));
+        }
+    }
+
+    SECTION( "Unitaries are equal to the matrices with the unitary simulator" ) {
+        const auto run_unitary = [&](const json_t &ops) {
+            Simulator::UnitaryController controller;
+            const json_t result = controller.execute(make_qobj(ops, num_qubits, json_t::object()));
+            REQUIRE(result["success"].get<bool>());
+            return result["results"][0]["data"]["unitary"];
+        };
+        const json_t unitary0 = run_unitary(matrix_ops);
+        const json_t unitary1 = run_unitary(rotation_ops);
+        REQUIRE(unitary0.size() == (1ULL << num_qubits));
+        REQUIRE(unitary0.size() == unitary1.size());
+        for (size_t i = 0; i < unitary0.size(); i++) {
+            for (size_t j = 0; j < unitary0[i].size(); j++) {
+                REQUIRE(unitary1[i][j][0].get<double>() == Approx(unitary0[i][j][0].get<double>()).margin(1e-12));
+                REQUIRE(unitary1[i][j][1].get<double>() == Approx(unitary0[i][j][1].get<double>()).margin(1e-12));
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+} // end namespace Test
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
@@ -0,0 +1,351 @@
+#define CATCH_CONFIG_MAIN
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+#include <catch.hpp>
+#include "framework/operations.hpp"
+#include "framework/types.hpp"
+#include "framework/utils.hpp"
+#include "simulators/densitymatrix/densitymatrix_state.hpp"
+#include "simulators/statevector/qubitvector.hpp"
+#include "simulators/statevector/statevector_state.hpp"
+#include "simulators/unitary/unitarymatrix.hpp"
+
+namespace AER{
+namespace Test{
+
+namespace {
+
+cvector_t random_vector(size_t size, std::mt19937 &rng) {
+    std::normal_distribution<double> dist;
+    cvector_t vec(size);
+    double norm = 0.;
+    for (auto &val : vec) {
+        val = complex_t(dist(rng), dist(rng));
+        norm += std::norm(val);
+    }
+    for (auto &val : vec)
+        val /= std::sqrt(norm);
+    return vec;
+}
+
+void initialize_random(QV::QubitVector<double> &qv, size_t num_qubits, std::mt19937 &rng) {
+    qv.set_num_qubits(num_qubits);
+    qv.initialize_from_vector(random_vector(1ULL << num_qubits, rng));
+}
+
+// Return the state after applying the matrix op to the initial state
+template <class state_t, class init_t>
+cvector_t apply_op(const Operations::Op &op, size_t num_qubits, const init_t &init) {
+    state_t state;
+    state.initialize_qreg(num_qubits, init);
+    state.initialize_creg(0, 0);
+    OutputData data;
+    RngEngine rng;
+    state.apply_ops({op}, data, rng);
+    return state.qreg().vector();
+}
+
+// Require that the structured matrix op gives the same state as its dense matrix
+template <class state_t, class init_t>
+void require_dense_equal(const Operations::Op &op, size_t num_qubits, const init_t &init) {
+    Operations::Op dense = op;
+    dense.mat_structure = Operations::MatrixStructure::dense;
+    const auto expected = apply_op<state_t>(dense, num_qubits, init);
+    const auto vec = apply_op<state_t>(op, num_qubits, init);
+    REQUIRE(vec.size() == expected.size());
+    for (size_t i = 0; i < vec.size(); i++)
+        REQUIRE(std::abs(vec[i] - expected[i]) < 1e-12);
+}
+
+// Return the index with the bits of the qubits replaced by the bits of val
+uint_t set_qubit_bits(uint_t index, const reg_t &qubits, uint_t val) {
+    for (size_t i = 0; i < qubits.size(); i++)
+        index = (index & ~(1ULL << qubits[i])) | (((val >> i) & 1ULL) << qubits[i]);
+    return index;
+}
+
+// Return the bits of the qubits of the index
+uint_t qubit_bits(uint_t index, const reg_t &qubits) {
+    uint_t val = 0;
+    for (size_t i = 0; i < qubits.size(); i++)
+        val |= ((index >> qubits[i]) & 1ULL) << i;
+    return val;
+}
+
+} // end anonymous namespace
+
+TEST_CASE( "QubitVector expectation values", "[qubitvector]" ) {
+    const size_t num_qubits = 8;
+    std::mt19937 rng(7);
+    QV::QubitVector<double> qv;
+    initialize_random(qv, num_qubits, rng);
+    qv.set_omp_threads(2);
+    qv.set_omp_threshold(1);
+
+    // Reference value from applying each matrix to a checkpointed copy
+    const auto expval_per_factor = [&](const std::vector<reg_t> &regs,
+                                       const std::vector<cvector_t> &mats,
+                                       const std::vector<QV::MatrixForm> &forms) {
+        QV::QubitVector<double> ref(num_qubits);
+        ref.initialize_from_data(qv.data(), qv.size());
+        ref.checkpoint();
+        for (size_t m = 0; m < regs.size(); m++) {
+            switch (forms[m]) {
+                case QV::MatrixForm::dense:
+                    ref.apply_matrix(regs[m], mats[m]);
+                    break;
+                case QV::MatrixForm::diagonal:
+                    ref.apply_diagonal_matrix(regs[m], mats[m]);
+                    break;
+                case QV::MatrixForm::projector:
+                    ref.apply_matrix(regs[m], Utils::vectorize_matrix(Utils::projector(mats[m])));
+                    break;
+            }
+        }
+        return ref.inner_product();
+    };
+
+    const auto check = [&](const std::vector<reg_t> &regs,
+                           const std::vector<QV::MatrixForm> &forms) {
+        std::vector<cvector_t> mats;
+        for (size_t m = 0; m < regs.size(); m++) {
+            const size_t dim = 1ULL << regs[m].size();
+            mats.push_back(random_vector(forms[m] == QV::MatrixForm::dense ? dim * dim : dim, rng));
+        }
+        const auto expected = expval_per_factor(regs, mats, forms);
+        const auto value = qv.expval_matrix(regs, mats, forms);
+        REQUIRE(std::abs(value - expected) < 1e-12);
+    };
+
+    SECTION( "Factors on disjoint qubits match the per-factor result" ) {
+        check({{0}, {5, 2}}, {QV::MatrixForm::dense, QV::MatrixForm::dense});
+        check({{3}, {1, 6}}, {QV::MatrixForm::diagonal, QV::MatrixForm::projector});
+    }
+
+    SECTION( "Factors on overlapping qubits match the per-factor result" ) {
+        check({{0, 1}, {1, 2}, {2, 0}},
+              {QV::MatrixForm::dense, QV::MatrixForm::projector, QV::MatrixForm::dense});
+        check({{4, 7}, {7}}, {QV::MatrixForm::diagonal, QV::MatrixForm::dense});
+    }
+
+    SECTION( "Factors on all qubits match the per-factor result" ) {
+        std::vector<reg_t> regs;
+        for (uint_t q = 0; q < num_qubits; q++)
+            regs.push_back({q});
+        check(regs, std::vector<QV::MatrixForm>(num_qubits, QV::MatrixForm::diagonal));
+        check(regs, std::vector<QV::MatrixForm>(num_qubits, QV::MatrixForm::dense));
+    }
+}
+
+TEST_CASE( "QubitVector multiplexers", "[qubitvector][multiplexer]" ) {
+    const size_t num_qubits = 6;
+    std::mt19937 rng(31);
+    QV::QubitVector<double> init;
+    initialize_random(init, num_qubits, rng);
+
+    // Require that the multiplexer gives the same state as the block
+    // diagonal matrix of its components on the target and control qubits
+    const auto check = [&](const reg_t &controls, const reg_t &targets) {
+        const uint_t columns = 1ULL << targets.size();
+        const uint_t blocks = 1ULL << controls.size();
+        const uint_t dim = columns * blocks;
+        std::vector<cvector_t> mats;
+        cvector_t dense(dim * dim, 0.);
+        for (uint_t b = 0; b < blocks; b++) {
+            mats.push_back(random_vector(columns * columns, rng));
+            for (uint_t i = 0; i < columns; i++)
+                for (uint_t j = 0; j < columns; j++)
+                    dense[i + b * columns + dim * (j + b * columns)] = mats[b][i + columns * j];
+        }
+        reg_t qubits = targets;
+        qubits.insert(qubits.end(), controls.begin(), controls.end());
+
+        QV::QubitVector<double> expected(num_qubits), qv(num_qubits);
+        expected.initialize_from_data(init.data(), init.size());
+        qv.initialize_from_data(init.data(), init.size());
+        expected.apply_matrix(qubits, dense);
+        qv.apply_multiplexer(controls, targets, mats);
+        for (size_t i = 0; i < qv.size(); i++)
+            REQUIRE(std::abs(qv[i] - expected[i]) < 1e-12);
+    };
+
+    SECTION( "One target qubit" ) {
+        check({4}, {1});
+        check({5, 0}, {3});
+        check({4, 1, 3}, {2});
+    }
+
+    SECTION( "Two target qubits" ) {
+        check({2}, {5, 0});
+        check({4, 1}, {3, 0});
+        check({5, 0, 3}, {4, 2});
+    }
+}
+
+TEST_CASE( "Structured matrices", "[qubitvector][matrix_structure]" ) {
+    const size_t num_qubits = 6;
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<double> angle(0., 2 * M_PI);
+    const auto phase = [&]() {return std::exp(complex_t(0., angle(rng)));};
+    const cvector_t psi = random_vector(1ULL << num_qubits, rng);
+    const cvector_t rho = Utils::vectorize_matrix(Utils::projector(psi));
+
+    // Apply the op with its structure and as a dense matrix to the
+    // statevector and the density matrix
+    const auto check = [&](const reg_t &qubits, const cmatrix_t &mat,
+                           Operations::MatrixStructure structure) {
+        const auto op = Operations::make_unitary(qubits, mat);
+        REQUIRE(op.mat_structure == structure);
+        require_dense_equal<Statevector::State<>>(op, num_qubits, psi);
+        require_dense_equal<DensityMatrix::State<>>(op, num_qubits, rho);
+    };
+
+    SECTION( "Diagonal matrices are equal to the dense matrix" ) {
+        for (const reg_t &qubits : {reg_t({4}), reg_t({5, 1}), reg_t({3, 0, 5})}) {
+            const size_t dim = 1ULL << qubits.size();
+            cmatrix_t mat(dim, dim);
+            for (size_t i = 0; i < dim; i++)
+                mat(i, i) = phase();
+            check(qubits, mat, Operations::MatrixStructure::diagonal);
+        }
+    }
+
+    SECTION( "Monomial matrices are equal to the dense matrix" ) {
+        for (const reg_t &qubits : {reg_t({2}), reg_t({5, 1}), reg_t({3, 0, 5})}) {
+            const size_t dim = 1ULL << qubits.size();
+            // Permutation other than the identity with phases
+            reg_t rows(dim);
+            for (size_t i = 0; i < dim; i++)
+                rows[i] = i;
+            std::shuffle(rows.begin(), rows.end(), rng);
+            if (std::is_sorted(rows.begin(), rows.end()))
+                std::reverse(rows.begin(), rows.end());
+            cmatrix_t mat(dim, dim);
+            for (size_t j = 0; j < dim; j++)
+                mat(rows[j], j) = phase();
+            check(qubits, mat, Operations::MatrixStructure::monomial);
+        }
+    }
+
+    SECTION( "Controlled matrices are equal to the dense matrix" ) {
+        // Controls at positions 0 and 2 of the matrix and target at 1,
+        // and control at position 1 with target at 0
+        const std::vector<std::pair<reg_t, reg_t>> cases = {
+            {reg_t({3, 0, 5}), reg_t({5, 7})},
+            {reg_t({4, 1}), reg_t({2, 3})}};
+        for (const auto &item : cases) {
+            const size_t dim = 1ULL << item.first.size();
+            const cmatrix_t target = Utils::Matrix::u3(angle(rng), angle(rng), angle(rng));
+            cmatrix_t mat = Utils::Matrix::identity(dim);
+            for (size_t i = 0; i < 2; i++)
+                for (size_t j = 0; j < 2; j++)
+                    mat(item.second[i], item.second[j]) = target(i, j);
+            check(item.first, mat, Operations::MatrixStructure::controlled);
+        }
+    }
+}
+
+TEST_CASE( "Unitary matrix GEMM", "[unitarymatrix][gemm]" ) {
+    const size_t num_qubits = 7;
+    std::mt19937 rng(47);
+    const auto init = random_vector(1ULL << (2 * num_qubits), rng);
+
+    // Require that the GEMM kernel gives the same matrix as apply_matrix
+    // for unsorted targets, with batches smaller than the matrix
+    auto require_gemm_equal = [&](int omp_threshold) {
+        for (const reg_t &qubits : std::vector<reg_t>({{5, 0, 3, 1},
+                                                       {6, 2, 4, 0, 3},
+                                                       {1, 6, 0, 5, 2, 4}})) {
+            const auto mat = random_vector(1ULL << (2 * qubits.size()), rng);
+            QV::UnitaryMatrix<double> expected, um;
+            for (auto *state : {&expected, &um}) {
+                state->set_num_qubits(num_qubits);
+                state->set_omp_threads(2);
+                state->set_omp_threshold(omp_threshold);
+                state->initialize_from_vector(init);
+            }
+            um.set_gemm_batch_size(1ULL << 9);
+            expected.apply_matrix(qubits, mat);
+            um.apply_matrix_gemm(qubits, mat);
+            const auto vec = um.vector();
+            const auto expected_vec = expected.vector();
+            REQUIRE(vec.size() == expected_vec.size());
+            for (size_t i = 0; i < vec.size(); i++)
+                REQUIRE(std::abs(vec[i] - expected_vec[i]) < 1e-12);
+        }
+    };
+
+    SECTION( "Serial GEMMs below the OpenMP threshold" ) {
+        require_gemm_equal(2 * num_qubits + 1);
+    }
+
+    SECTION( "Threaded GEMMs above the OpenMP threshold" ) {
+        require_gemm_equal(1);
+    }
+}
+
+TEST_CASE( "Density matrix reset and measurement", "[densitymatrix]" ) {
+    const size_t num_qubits = 5;
+    const size_t dim = 1ULL << num_qubits;
+    std::mt19937 rng(31);
+    // Mixed state of two random pure states
+    const cmatrix_t rho = 0.7 * Utils::projector(random_vector(dim, rng))
+                        + 0.3 * Utils::projector(random_vector(dim, rng));
+    const cvector_t vec = Utils::vectorize_matrix(rho);
+    const auto require_equal = [](const cmatrix_t &mat, const cmatrix_t &expected) {
+        for (size_t i = 0; i < expected.size(); i++)
+            REQUIRE(std::abs(mat[i] - expected[i]) < 1e-12);
+    };
+    const std::vector<reg_t> qubit_sets = {{3}, {2, 0}, {3, 0, 4}, {4, 1, 3, 0}};
+
+    SECTION( "Reset traces the qubits out into the |0> state" ) {
+        for (const auto &qubits : qubit_sets) {
+            QV::DensityMatrix<double> dm(num_qubits);
+            dm.initialize_from_vector(vec);
+            dm.apply_reset(qubits);
+            cmatrix_t expected(dim, dim);
+            for (uint_t r = 0; r < dim; r++)
+                for (uint_t c = 0; c < dim; c++)
+                    if (qubit_bits(r, qubits) == 0 && qubit_bits(c, qubits) == 0)
+                        for (uint_t i = 0; i < (1ULL << qubits.size()); i++)
+                            expected(r, c) += rho(set_qubit_bits(r, qubits, i),
+                                                  set_qubit_bits(c, qubits, i));
+            require_equal(dm.matrix(), expected);
+        }
+    }
+
+    SECTION( "Measurement collapses the qubits into the final state" ) {
+        for (const auto &qubits : qubit_sets) {
+            const uint_t size = 1ULL << qubits.size();
+            // Pairs of measured and final states
+            const std::vector<std::pair<uint_t, uint_t>> outcomes = {
+                {size - 1, 0}, {size / 2, size / 2}, {1, size - 2}};
+            for (const auto &outcome : outcomes) {
+                const uint_t meas = outcome.first, final_state = outcome.second;
+                double prob = 0.;
+                for (uint_t r = 0; r < dim; r++)
+                    if (qubit_bits(r, qubits) == meas)
+                        prob += std::real(rho(r, r));
+                QV::DensityMatrix<double> dm(num_qubits);
+                dm.initialize_from_vector(vec);
+                dm.apply_measure_collapse(qubits, meas, final_state, prob);
+                cmatrix_t expected(dim, dim);
+                for (uint_t r = 0; r < dim; r++)
+                    for (uint_t c = 0; c < dim; c++)
+                        if (qubit_bits(r, qubits) == final_state && qubit_bits(c, qubits) == final_state)
+                            expected(r, c) = rho(set_qubit_bits(r, qubits, meas),
+                                                 set_qubit_bits(c, qubits, meas)) / prob;
+                require_equal(dm.matrix(), expected);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+} // end namespace Test
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
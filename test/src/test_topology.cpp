@@ -0,0 +1,92 @@
+#define CATCH_CONFIG_MAIN
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <catch.hpp>
+#include "framework/topology.hpp"
+
+namespace AER{
+namespace Test{
+
+using Topology::cpuset_t;
+
+// Write a file of a fake sysfs tree, creating its directory
+static void write_file(const std::string &path, const std::string &text) {
+    const std::string dir = path.substr(0, path.rfind('/'));
+    REQUIRE(std::system(("mkdir -p " + dir).c_str()) == 0);
+    std::ofstream(path) << text << "\n";
+}
+
+TEST_CASE( "Machine topology", "[topology]" ) {
+
+    SECTION( "CPU lists are parsed and formatted" ) {
+        REQUIRE(Topology::parse_cpulist("0-3,8,10-11") == cpuset_t({0, 1, 2, 3, 8, 10, 11}));
+        REQUIRE(Topology::parse_cpulist(" 5,1-2 \n") == cpuset_t({1, 2, 5}));
+        REQUIRE(Topology::parse_cpulist("").empty());
+        REQUIRE(Topology::format_cpulist({0, 1, 2, 3, 8, 10, 11}) == "0-3,8,10-11");
+        REQUIRE_THROWS_AS(Topology::parse_cpulist("1-x"), std::invalid_argument);
+    }
+
+    SECTION( "Domains are read from sysfs" ) {
+        // Two sockets and NUMA nodes of 4 CPUs, with an L3 cache per 2 CPUs
+        const std::string sysfs = "test_topology_sysfs";
+        REQUIRE(std::system(("rm -rf " + sysfs).c_str()) == 0);
+        write_file(sysfs + "/cpu/online", "0-7");
+        write_file(sysfs + "/node/online", "0-1");
+        write_file(sysfs + "/node/node0/cpulist", "0-3");
+        write_file(sysfs + "/node/node1/cpulist", "4-7");
+        for (int cpu = 0; cpu < 8; cpu++) {
+            const std::string dir = sysfs + "/cpu/cpu" + std::to_string(cpu);
+            write_file(dir + "/topology/physical_package_id", std::to_string(cpu / 4));
+            write_file(dir + "/cache/index0/level", "1");
+            write_file(dir + "/cache/index1/level", "2");
+            write_file(dir + "/cache/index2/level", "3");
+            const int first = cpu - cpu % 2;
+            write_file(dir + "/cache/index2/shared_cpu_list",
+                       std::to_string(first) + "-" + std::to_string(first + 1));
+        }
+
+        const std::vector<cpuset_t> halves = {{0, 1, 2, 3}, {4, 5, 6, 7}};
+        REQUIRE(Topology::read_domains(Topology::Domain::numa, {}, sysfs) == halves);
+        REQUIRE(Topology::read_domains(Topology::Domain::socket, {}, sysfs) == halves);
+        const auto l3 = Topology::read_domains(Topology::Domain::l3, {}, sysfs);
+        REQUIRE(l3 == std::vector<cpuset_t>({{0, 1}, {2, 3}, {4, 5}, {6, 7}}));
+        REQUIRE(Topology::read_domains(Topology::Domain::l3, {1, 2, 3}, sysfs) ==
+                std::vector<cpuset_t>({{1}, {2, 3}}));
+        REQUIRE(Topology::read_domains(Topology::Domain::numa, {}, sysfs + "/missing").empty());
+
+        // Workers are spread evenly over the domains, one domain each
+        REQUIRE(Topology::worker_cpus(l3, 0, 8) == cpuset_t({0, 1}));
+        REQUIRE(Topology::worker_cpus(l3, 7, 8) == cpuset_t({6, 7}));
+        REQUIRE(Topology::worker_cpus(l3, 2, 4) == cpuset_t({4, 5}));
+        // Fewer workers than domains never span several domains
+        REQUIRE(Topology::worker_cpus(l3, 0, 2) == cpuset_t({0, 1}));
+        REQUIRE(Topology::worker_cpus(l3, 1, 2) == cpuset_t({4, 5}));
+        REQUIRE(Topology::worker_cpus(l3, 1, 3) == cpuset_t({2, 3}));
+        REQUIRE(Topology::worker_cpus(l3, 2, 3) == cpuset_t({4, 5}));
+        REQUIRE(Topology::worker_cpus(l3, 0, 1).empty());
+        REQUIRE(Topology::worker_cpus({{0, 1}}, 0, 2).empty());
+        REQUIRE(std::system(("rm -rf " + sysfs).c_str()) == 0);
+    }
+
+#ifdef __linux__
+    SECTION( "Threads are bound and restored" ) {
+        const auto allowed = Topology::thread_affinity();
+        REQUIRE(!allowed.empty());
+        {
+            Topology::ThreadBinding binding({allowed.front()}, 2);
+            REQUIRE(binding.bound());
+            REQUIRE(Topology::thread_affinity() == cpuset_t({allowed.front()}));
+            REQUIRE(Topology::bound_cpus() == 1);
+        }
+        REQUIRE(Topology::thread_affinity() == allowed);
+        REQUIRE(Topology::bound_cpus() == 0);
+    }
+#endif
+}
+
+//------------------------------------------------------------------------------
+} // end namespace Test
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
@@ -0,0 +1,120 @@
+#define CATCH_CONFIG_MAIN
+#include <string>
+#include <catch.hpp>
+#include "framework/json.hpp"
+#include "framework/types.hpp"
+#include "simulators/unitary/unitary_controller.hpp"
+
+namespace AER{
+namespace Test{
+
+namespace {
+
+// Return the qobj of a single experiment with the instructions
+json_t make_qobj(const json_t &instructions, uint_t num_qubits,
+                 const json_t &config) {
+    json_t experiment;
+    experiment["instructions"] = instructions;
+    experiment["config"] = {{"n_qubits", num_qubits}, {"memory_slots", 0}};
+    experiment["header"] = json_t::object();
+    json_t qobj;
+    qobj["qobj_id"] = "test";
+    qobj["type"] = "QASM";
+    qobj["schema_version"] = "1.0";
+    qobj["config"] = config;
+    qobj["experiments"] = {experiment};
+    return qobj;
+}
+
+// Return the result of the single experiment of the qobj
+json_t run_unitary(const json_t &instructions, uint_t num_qubits,
+                   const json_t &config) {
+    Simulator::UnitaryController controller;
+    const json_t result = controller.execute(make_qobj(instructions, num_qubits, config));
+    REQUIRE(result["success"].get<bool>());
+    return result["results"][0];
+}
+
+// Return the instructions of layers of rotations and of CX and CU1 gates
+// on neighbouring and distant qubits, for at least 3 qubits
+json_t layered_circuit(uint_t num_qubits, uint_t layers) {
+    json_t ops = json_t::array();
+    for (uint_t l = 0; l < layers; l++) {
+        for (uint_t q = 0; q < num_qubits; q++)
+            ops.push_back({{"name", "u3"}, {"qubits", {q}},
+                           {"params", {0.3 + 0.1 * q + 0.7 * l, 0.2 * l, 0.1 * q}}});
+        for (uint_t q = l % 2; q + 1 < num_qubits; q += 2)
+            ops.push_back({{"name", "cx"}, {"qubits", {q, q + 1}}});
+        ops.push_back({{"name", "cu1"}, {"qubits", {(l + 2) % num_qubits, l % num_qubits}},
+                       {"params", {0.4 + l}}});
+    }
+    return ops;
+}
+
+// Require that the unitaries of the results are equal
+void require_equal_unitary(const json_t &result0, const json_t &result1) {
+    const auto &unitary0 = result0["data"]["unitary"];
+    const auto &unitary1 = result1["data"]["unitary"];
+    REQUIRE(unitary0.size() == unitary1.size());
+    for (size_t i = 0; i < unitary0.size(); i++) {
+        REQUIRE(unitary0[i].size() == unitary1[i].size());
+        for (size_t j = 0; j < unitary0[i].size(); j++) {
+            REQUIRE(unitary1[i][j][0].get<double>() == Approx(unitary0[i][j][0].get<double>()).margin(1e-10));
+            REQUIRE(unitary1[i][j][1].get<double>() == Approx(unitary0[i][j][1].get<double>()).margin(1e-10));
+        }
+    }
+}
+
+} // end anonymous namespace
+
+TEST_CASE( "Unitary fusion", "[unitary_controller][fusion]" ) {
+    const uint_t num_qubits = 5;
+    const json_t ops = layered_circuit(num_qubits, 6);
+    json_t config = {{"fusion_enable", true}, {"fusion_threshold", 1},
+                     {"fusion_verbose", true}};
+    const json_t fused = run_unitary(ops, num_qubits, config);
+    config["fusion_enable"] = false;
+    const json_t unfused = run_unitary(ops, num_qubits, config);
+
+    SECTION( "Gates are fused into fewer instructions" ) {
+        REQUIRE(!JSON::check_key("fusion_verbose", unfused["metadata"]));
+        REQUIRE(fused["metadata"]["fusion_verbose"].size() < ops.size());
+    }
+
+    SECTION( "The unitary is equal to the unfused circuit" ) {
+        REQUIRE(unfused["data"]["unitary"].size() == (1ULL << num_qubits));
+        require_equal_unitary(fused, unfused);
+    }
+}
+
+TEST_CASE( "Unitary fusion across barriers", "[unitary_controller][fusion]" ) {
+    // Qubits 2 and 5 are idle, and barriers split the fusable runs
+    const uint_t num_qubits = 6;
+    const reg_t active = {0, 1, 3, 4};
+    json_t ops = json_t::array();
+    for (uint_t l = 0; l < 4; l++) {
+        for (const auto q : active)
+            ops.push_back({{"name", "u3"}, {"qubits", {q}},
+                           {"params", {0.5 + 0.2 * q + 0.3 * l, 0.1 * l, 0.4}}});
+        ops.push_back({{"name", "cx"}, {"qubits", {active[l % 4], active[(l + 1) % 4]}}});
+        ops.push_back({{"name", "cu1"}, {"qubits", {active[(l + 3) % 4], active[(l + 1) % 4]}},
+                       {"params", {0.6 + l}}});
+        if (l % 2 == 1)
+            ops.push_back({{"name", "barrier"}, {"qubits", {0, 1, 2, 3, 4, 5}}});
+    }
+    json_t config = {{"fusion_enable", true}, {"fusion_threshold", 1},
+                     {"fusion_verbose", true}};
+    const json_t fused = run_unitary(ops, num_qubits, config);
+    config["fusion_enable"] = false;
+    const json_t unfused = run_unitary(ops, num_qubits, config);
+
+    REQUIRE(fused["metadata"]["fusion_verbose"].size() < ops.size());
+    REQUIRE(unfused["data"]["unitary"].size() == (1ULL << num_qubits));
+    require_equal_unitary(fused, unfused);
+}
+
+//------------------------------------------------------------------------------
+} // end namespace Test
+//------------------------------------------------------------------------------
+} // end namespace AER
+//------------------------------------------------------------------------------
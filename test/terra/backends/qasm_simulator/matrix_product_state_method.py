@@ -20,7 +20,7 @@ import logging
 import pprint
 
 from test.terra import common
-from test.terra.reference import ref_1q_clifford, ref_2q_clifford
+from test.terra.reference import ref_1q_clifford, ref_2q_clifford, ref_reset
 
 from qiskit import *
 from qiskit.providers.aer import QasmSimulator
@@ -69,3 +69,12 @@ class QasmMatrixProductStateMethodTests:
                 self.is_completed(result)
                 self.compare_counts(result, circuits, targets, delta = delta*shots)
 
+    def test_method_reset_deterministic(self):
+        """Test matrix product state method reset with deterministic counts"""
+        shots = 100
+        circuits = ref_reset.reset_circuits_deterministic(final_measure=True)
+        targets = ref_reset.reset_counts_deterministic(shots)
+        job = execute(circuits, QasmSimulator(), backend_options=self.BACKEND_OPTS, shots=shots)
+        result = job.result()
+        self.is_completed(result)
+        self.compare_counts(result, circuits, targets, delta=0)